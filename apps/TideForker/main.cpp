@@ -75,10 +75,12 @@ int main(int argc, char* argv[])
         auto wallSwapSyncComm = MPICommunicator{worldComm, 0};
         auto masterWallComm = MPICommunicator{worldComm, 0};
         auto wallMasterComm = MPICommunicator{worldComm, 0};
+        auto masterWallPayloadComm = MPICommunicator{worldComm, 0};
 
         Q_UNUSED(wallSwapSyncComm);
         Q_UNUSED(masterWallComm);
         Q_UNUSED(wallMasterComm);
+        Q_UNUSED(masterWallPayloadComm);
 
         ProcessForker{masterForkerComm}.run();
     } // close MPI connections
@@ -91,6 +91,7 @@ int main(int argc, char* argv[])
         auto wallSwapSyncComm = MPICommunicator{worldComm, 0};
         auto masterWallComm = MPICommunicator{worldComm, 1};
         auto wallMasterComm = MPICommunicator{worldComm, 1};
+        auto masterWallPayloadComm = MPICommunicator{worldComm, 1};
 
         Q_UNUSED(wallSwapSyncComm);
 
@@ -98,7 +99,8 @@ int main(int argc, char* argv[])
         {
             const auto config = commandLine.getConfigFilename();
             MasterApplication app(argc, argv, config, masterWallComm,
-                                  wallMasterComm, masterForkerComm);
+                                  masterWallPayloadComm, wallMasterComm,
+                                  masterForkerComm);
 
             const auto& session = commandLine.getSessionFilename();
             if (!session.isEmpty())
@@ -0,0 +1,126 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "tide/core/data/TiffPyramidWriter.h"
+#include "tide/core/utils/CommandLineParser.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThreadPool>
+
+#include <iomanip>
+#include <iostream>
+
+class PyramidMakerOptions : public CommandLineParser
+{
+public:
+    PyramidMakerOptions()
+    {
+        using boost::program_options::value;
+
+        pos_desc.add("infile", 1);
+        pos_desc.add("outfile", 1);
+        desc.add_options()("infile", value<std::string>()->required(),
+                           "The source image to convert");
+        desc.add_options()("outfile", value<std::string>()->required(),
+                           "The target .tif image pyramid file to create");
+        desc.add_options()("tile-size", value<int>()->default_value(512),
+                           "Size of the tiles (multiple of 16)");
+        desc.add_options()("codec",
+                           value<std::string>()->default_value("jpeg"),
+                           "Tiles compression: jpeg|deflate|none");
+        desc.add_options()("quality", value<int>()->default_value(90),
+                           "Quality of the jpeg compression [0-100]");
+        desc.add_options()("threads", value<int>()->default_value(0),
+                           "Number of threads (default: all cores)");
+    }
+    std::string input() const { return vm["infile"].as<std::string>(); }
+    std::string output() const { return vm["outfile"].as<std::string>(); }
+    int threads() const { return vm["threads"].as<int>(); }
+    TiffPyramidWriter::Options options() const
+    {
+        const auto tileSize = vm["tile-size"].as<int>();
+        const auto codec = vm["codec"].as<std::string>();
+
+        TiffPyramidWriter::Options options;
+        options.tileSize = QSize(tileSize, tileSize);
+        options.quality = vm["quality"].as<int>();
+        if (codec == "jpeg")
+            options.codec = TiffPyramidWriter::Codec::jpeg;
+        else if (codec == "deflate")
+            options.codec = TiffPyramidWriter::Codec::deflate;
+        else if (codec == "none")
+            options.codec = TiffPyramidWriter::Codec::none;
+        else
+            throw std::invalid_argument("Unknown codec: " + codec);
+        return options;
+    }
+};
+
+int main(int argc, char* argv[])
+{
+    COMMAND_LINE_PARSER_CHECK(PyramidMakerOptions, "tidePyramidMaker");
+
+    QCoreApplication app{argc, argv};
+
+    if (commandLine.threads() > 0)
+        QThreadPool::globalInstance()->setMaxThreadCount(commandLine.threads());
+
+    try
+    {
+        auto writer = TiffPyramidWriter{commandLine.options()};
+        writer.setProgressCallback([](const double progress) {
+            std::cout << "\rprogress: " << std::setw(3) << int(progress * 100)
+                      << "%" << std::flush;
+        });
+
+        QElapsedTimer timer;
+        timer.start();
+        writer.write(QString::fromStdString(commandLine.input()),
+                     QString::fromStdString(commandLine.output()));
+        std::cout << std::endl
+                  << "done in " << timer.elapsed() / 1000.0 << "s" << std::endl;
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << std::endl
+                  << "conversion failed: " << e.what() << std::endl;
+    }
+    return EXIT_FAILURE;
+}
@@ -41,9 +41,11 @@
 #include "WallApplication.h"
 #include "WallConfiguration.h"
 #include "network/MPICommunicator.h"
+#include "network/MPIHierarchy.h"
 #include "utils/CommandLineParser.h"
 #include "utils/log.h"
 
+#include <QGuiApplication>
 #include <QThreadPool>
 
 #include <memory>
@@ -75,6 +77,9 @@ int main(int argc, char* argv[])
 
     setupEnvVariables();
 
+    // Let the render threads of all screens share the GPU textures of tiles
+    QGuiApplication::setAttribute(Qt::AA_ShareOpenGLContexts);
+
     {
         auto worldComm = MPICommunicator{argc, argv};
         if (worldComm.getSize() < 2)
@@ -93,11 +98,20 @@ int main(int argc, char* argv[])
         auto wallSwapSyncComm = MPICommunicator{worldComm, 1};
         auto masterWallComm = MPICommunicator{worldComm, 1};
         auto wallMasterComm = MPICommunicator{worldComm, 1};
+        // Only one wall process per host receives the payloads of broadcasts
+        auto masterWallHostComm =
+            MPICommunicator{wallToWallComm, MPISplitType::host};
+        const auto isHostLeader = masterWallHostComm.getRank() == 0;
+        auto masterWallPayloadComm =
+            MPICommunicator{worldComm, isHostLeader ? 1 : 2};
+        MPIHierarchy wallSwapSyncBarrier{wallSwapSyncComm};
 
         try
         {
-            WallApplication app(argc, argv, masterWallComm, wallMasterComm,
-                                wallToWallComm, wallSwapSyncComm);
+            WallApplication app(argc, argv, masterWallComm,
+                                masterWallPayloadComm, masterWallHostComm,
+                                wallMasterComm, wallToWallComm,
+                                wallSwapSyncBarrier);
             app.exec(); // enter Qt event loop
 
             print_log(LOG_DEBUG, LOG_GENERAL,
@@ -111,8 +125,7 @@ int main(int argc, char* argv[])
 
             // Always send QUIT to the master application that will wait on it
             // to exit (normally done by WallApplication destructor).
-            if (wallToWallComm.getRank() == 0)
-                masterWallComm.send(MessageType::QUIT, "", 0);
+            wallMasterComm.send(MessageType::QUIT, "", 0);
 
             return EXIT_FAILURE;
         }
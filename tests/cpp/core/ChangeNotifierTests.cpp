@@ -0,0 +1,143 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#define BOOST_TEST_MODULE ChangeNotifierTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "rest/ChangeNotifier.h"
+#include "scene/ContentFactory.h"
+#include "scene/DisplayGroup.h"
+#include "scene/Options.h"
+#include "scene/Scene.h"
+#include "json/json.h"
+
+#include "types.h"
+
+namespace
+{
+const QString imageUri{"wall.png"};
+const QSize wallSize{1000, 1000};
+
+struct Fixture
+{
+    DisplayGroupPtr group = DisplayGroup::create(wallSize);
+    ScenePtr scene = Scene::create(group);
+    OptionsPtr options = Options::create();
+    std::vector<QJsonObject> notifications;
+    ChangeNotifier notifier{*scene, *options, [this](const std::string& msg) {
+                                notifications.push_back(json::parse(msg));
+                            }};
+
+    WindowPtr makeWindow() const
+    {
+        auto content = ContentFactory::createContent(imageUri);
+        return std::make_shared<Window>(std::move(content));
+    }
+
+    QString lastMethod() const
+    {
+        return notifications.back()["method"].toString();
+    }
+
+    QJsonObject lastParams() const
+    {
+        return notifications.back()["params"].toObject();
+    }
+};
+}
+
+BOOST_FIXTURE_TEST_CASE(window_changes_are_notified_in_order, Fixture)
+{
+    BOOST_CHECK_EQUAL(notifier.getRevision(), 0u);
+
+    auto window = makeWindow();
+    group->add(window);
+    BOOST_REQUIRE_EQUAL(notifications.size(), 1u);
+    BOOST_CHECK_EQUAL(notifications.back()["jsonrpc"].toString(), "2.0");
+    BOOST_CHECK_EQUAL(lastMethod(), "tide/windows/added");
+    BOOST_CHECK_EQUAL(lastParams()["revision"].toInt(), 1);
+    BOOST_CHECK_EQUAL(lastParams()["surface"].toInt(), 0);
+    BOOST_CHECK_EQUAL(lastParams()["window"].toObject()["uri"].toString(),
+                      imageUri);
+
+    window->setCoordinates(QRectF{10, 20, 300, 200});
+    BOOST_REQUIRE_EQUAL(notifications.size(), 2u);
+    BOOST_CHECK_EQUAL(lastMethod(), "tide/windows/modified");
+    BOOST_CHECK_EQUAL(lastParams()["revision"].toInt(), 2);
+    BOOST_CHECK_EQUAL(lastParams()["window"].toObject()["x"].toDouble(), 10.0);
+
+    group->remove(window);
+    BOOST_REQUIRE_EQUAL(notifications.size(), 3u);
+    BOOST_CHECK_EQUAL(lastMethod(), "tide/windows/removed");
+    BOOST_CHECK_EQUAL(lastParams()["revision"].toInt(), 3);
+    BOOST_CHECK_EQUAL(lastParams()["uuid"].toString(),
+                      json::url_encode(window->getID()));
+    BOOST_CHECK_EQUAL(notifier.getRevision(), 3u);
+
+    // Removed windows are no longer watched
+    window->setCoordinates(QRectF{0, 0, 100, 100});
+    BOOST_CHECK_EQUAL(notifications.size(), 3u);
+}
+
+BOOST_FIXTURE_TEST_CASE(options_changes_are_notified, Fixture)
+{
+    options->setShowClock(!options->getShowClock());
+    BOOST_REQUIRE_EQUAL(notifications.size(), 1u);
+    BOOST_CHECK_EQUAL(lastMethod(), "tide/options/modified");
+    BOOST_CHECK_EQUAL(lastParams()["options"].toObject()["clock"].toBool(),
+                      options->getShowClock());
+}
+
+BOOST_FIXTURE_TEST_CASE(session_changes_are_detected_on_update, Fixture)
+{
+    auto info = SessionInfo();
+    notifier.update(info);
+    BOOST_CHECK(notifications.empty());
+
+    info.filepath = "/tmp/session.dcx";
+    notifier.update(info);
+    BOOST_REQUIRE_EQUAL(notifications.size(), 1u);
+    BOOST_CHECK_EQUAL(lastMethod(), "tide/session/modified");
+    BOOST_CHECK_EQUAL(lastParams()["session"].toObject()["filename"].toString(),
+                      "session");
+    BOOST_CHECK_EQUAL(notifier.getRevision(), 1u);
+
+    notifier.update(info);
+    BOOST_CHECK_EQUAL(notifications.size(), 1u);
+}
@@ -61,7 +61,6 @@ BOOST_AUTO_TEST_CASE(testCommandLineDefaults)
     BOOST_CHECK_EQUAL(options.webservicePort, 0);
     BOOST_CHECK_EQUAL(options.demoServiceUrl, "");
     BOOST_CHECK_EQUAL(options.showPowerButton, false);
-    BOOST_CHECK_EQUAL(options.saveDir, "");
 
     BOOST_CHECK_EQUAL(options.getCommandLine().toStdString(), "");
 }
@@ -77,7 +76,6 @@ void setOptionParameters(CommandLineOptions& options)
     options.webservicePort = 8888;
     options.demoServiceUrl = "http://demoservice.bbp.epfl.ch";
     options.showPowerButton = true;
-    options.saveDir = "/tmp/whiteboards";
 }
 
 void checkOptionParameters(const CommandLineOptions& options)
@@ -92,7 +90,6 @@ void checkOptionParameters(const CommandLineOptions& options)
     BOOST_CHECK_EQUAL(options.webservicePort, 8888);
     BOOST_CHECK_EQUAL(options.demoServiceUrl, "http://demoservice.bbp.epfl.ch");
     BOOST_CHECK_EQUAL(options.showPowerButton, true);
-    BOOST_CHECK_EQUAL(options.saveDir, "/tmp/whiteboards");
 
     BOOST_CHECK_EQUAL(options.getCommandLine().toStdString(),
                       "--streamid MyStreamer "
@@ -103,8 +100,7 @@ void checkOptionParameters(const CommandLineOptions& options)
                       "--sessionsDir /var/sessions "
                       "--webservicePort 8888 "
                       "--demoServiceUrl http://demoservice.bbp.epfl.ch "
-                      "--showPowerButton "
-                      "--saveDir /tmp/whiteboards");
+                      "--showPowerButton");
 }
 
 BOOST_AUTO_TEST_CASE(testCommandLineManualCreation)
@@ -148,6 +148,8 @@ BOOST_AUTO_TEST_CASE(test_minimal_configuration_default_values)
 
     BOOST_CHECK_EQUAL(config.master.headless, false);
     BOOST_CHECK_EQUAL(config.master.webservicePort, 8888);
+    BOOST_CHECK_EQUAL(config.master.uploadMaxSize, 0);
+    BOOST_CHECK_EQUAL(config.master.directStreaming, false);
 
     BOOST_CHECK_EQUAL((int)config.global.swapsync, (int)SwapSync::software);
 
@@ -156,6 +158,18 @@ BOOST_AUTO_TEST_CASE(test_minimal_configuration_default_values)
     BOOST_CHECK_EQUAL(config.settings.touchpointsToWakeup, 1);
     BOOST_CHECK_EQUAL(config.settings.contentMaxScale, 0.0);
     BOOST_CHECK_EQUAL(config.settings.contentMaxScaleVectorial, 0.0);
+    BOOST_CHECK_EQUAL(config.settings.streamFramesInFlight, 2);
+    BOOST_CHECK_EQUAL(config.settings.streamDropLateFrames, true);
+    BOOST_CHECK_EQUAL(config.settings.imagePyramidYUVTiles, true);
+    BOOST_CHECK_EQUAL(config.settings.imageTilingThreshold, 8192);
+    BOOST_CHECK_EQUAL(config.settings.sharedTileCache, true);
+    BOOST_CHECK_EQUAL(config.settings.pdfRenderAheadPages, 1);
+    BOOST_CHECK_EQUAL(config.settings.documentPoolSize, 2);
+    BOOST_CHECK_EQUAL(config.settings.progressiveRendering, true);
+    BOOST_CHECK_EQUAL(config.settings.skipUnchangedScreens, true);
+    BOOST_CHECK_EQUAL(config.settings.targetFrameRate, 60u);
+    BOOST_CHECK_EQUAL(config.settings.maxTileUploadsPerFrame, 32u);
+    BOOST_CHECK_EQUAL(config.settings.wallMemoryBudget, 0u);
 
     BOOST_CHECK_EQUAL(config.folders.contents, QDir::homePath());
     BOOST_CHECK_EQUAL(config.folders.sessions, QDir::homePath());
@@ -246,6 +260,17 @@ BOOST_AUTO_TEST_CASE(test_wall_configuration)
     BOOST_CHECK(screen.stereoMode == deflect::View::mono);
 }
 
+BOOST_AUTO_TEST_CASE(test_wall_configuration_shares_host_memory_budget)
+{
+    auto config_ = Configuration(CONFIG_TEST_FILENAME);
+    BOOST_CHECK_EQUAL(WallConfiguration(config_, 2).memoryBudget, 0u);
+
+    config_.settings.wallMemoryBudget = 3000;
+    const WallConfiguration config(config_, 2);
+    BOOST_REQUIRE_EQUAL(config.processCountForHost, 3);
+    BOOST_CHECK_EQUAL(config.memoryBudget, size_t(1000) << 20);
+}
+
 BOOST_AUTO_TEST_CASE(test_stereo_configuration)
 {
     const Configuration config(CONFIG_TEST_FILENAME_STEREO);
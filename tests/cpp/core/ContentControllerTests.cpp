@@ -51,6 +51,7 @@
 #include "control/MovieController.h"
 #endif
 #include "control/PixelStreamController.h"
+#include "control/WhiteboardController.h"
 #include "control/ZoomController.h"
 #include "scene/ContentFactory.h"
 #include "scene/Window.h"
@@ -122,4 +123,11 @@ BOOST_AUTO_TEST_CASE(factory_method)
     dummyContent.type = ContentType::image;
     controller = ContentController::create(window);
     BOOST_CHECK(dynamic_cast<ZoomController*>(controller.get()));
+
+    dummyContent.type = ContentType::whiteboard;
+    BOOST_CHECK_THROW(ContentController::create(window), std::bad_cast);
+    Window whiteboardWin(
+        ContentFactory::createWhiteboardContent("Whiteboard0", QSize()));
+    BOOST_CHECK_NO_THROW(controller = ContentController::create(whiteboardWin));
+    BOOST_CHECK(dynamic_cast<WhiteboardController*>(controller.get()));
 }
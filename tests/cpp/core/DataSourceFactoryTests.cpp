@@ -66,7 +66,8 @@ const std::vector<ContentType> contentTypes
 #if TIDE_USE_TIFF
         ContentType::image_pyramid,
 #endif
-        ContentType::pixel_stream, ContentType::svg, ContentType::image
+        ContentType::pixel_stream, ContentType::svg, ContentType::image,
+        ContentType::whiteboard
 };
 const std::vector<ContentType> unsupportedContentTypes{
     ContentType::invalid, ContentType::dynamic_texture};
@@ -46,6 +46,8 @@
 
 #include "DummyContent.h"
 
+#include <chrono>
+
 namespace
 {
 const QSize wallSize(1000, 1000);
@@ -153,3 +155,114 @@ BOOST_AUTO_TEST_CASE(find_window_by_filename)
     BOOST_CHECK(group->findWindow("ccc"));
     BOOST_CHECK(!group->findWindow("ddd"));
 }
+
+BOOST_AUTO_TEST_CASE(get_window_by_id)
+{
+    auto window0 = std::make_shared<Window>(makeDummyContent());
+    auto window1 = std::make_shared<Window>(makeDummyContent());
+
+    auto group = DisplayGroup::create(wallSize);
+    BOOST_CHECK(!group->getWindow(window0->getID()));
+
+    group->add(window0);
+    group->add(window1);
+    BOOST_CHECK_EQUAL(group->getWindow(window0->getID()), window0);
+    BOOST_CHECK_EQUAL(group->getWindow(window1->getID()), window1);
+
+    group->moveToFront(window0);
+    BOOST_CHECK_EQUAL(group->getWindow(window0->getID()), window0);
+
+    group->remove(window0);
+    BOOST_CHECK(!group->getWindow(window0->getID()));
+    BOOST_CHECK_EQUAL(group->getWindow(window1->getID()), window1);
+
+    group->clear();
+    BOOST_CHECK(!group->getWindow(window1->getID()));
+}
+
+BOOST_AUTO_TEST_CASE(find_lowest_window_with_same_filename)
+{
+    auto windowA1 = std::make_shared<Window>(makeDummyContent("aaa"));
+    auto windowA2 = std::make_shared<Window>(makeDummyContent("aaa"));
+    auto windowB = std::make_shared<Window>(makeDummyContent("bbb"));
+
+    auto group = DisplayGroup::create(wallSize);
+    group->add(windowA1);
+    group->add(windowB);
+    group->add(windowA2);
+    BOOST_CHECK_EQUAL(group->findWindow("aaa"), windowA1);
+
+    group->moveToFront(windowA1);
+    BOOST_CHECK_EQUAL(group->findWindow("aaa"), windowA2);
+
+    group->remove(windowA2);
+    BOOST_CHECK_EQUAL(group->findWindow("aaa"), windowA1);
+    BOOST_CHECK_EQUAL(group->findWindow("bbb"), windowB);
+
+    group->remove(windowA1);
+    BOOST_CHECK(!group->findWindow("aaa"));
+}
+
+BOOST_AUTO_TEST_CASE(find_window_after_content_is_replaced)
+{
+    auto windowA = std::make_shared<Window>(makeDummyContent("aaa"));
+    auto windowB = std::make_shared<Window>(makeDummyContent("bbb"));
+
+    auto group = DisplayGroup::create(wallSize);
+    group->add(windowA);
+    group->add(windowB);
+
+    windowB->setContent(makeDummyContent("aaa"));
+    BOOST_CHECK_EQUAL(group->findWindow("aaa"), windowA);
+    BOOST_CHECK(!group->findWindow("bbb"));
+
+    windowA->setContent(makeDummyContent("ccc"));
+    BOOST_CHECK_EQUAL(group->findWindow("aaa"), windowB);
+    BOOST_CHECK_EQUAL(group->findWindow("ccc"), windowA);
+}
+
+BOOST_AUTO_TEST_CASE(replace_windows_updates_lookups)
+{
+    auto windowA = std::make_shared<Window>(makeDummyContent("aaa"));
+    auto windowB = std::make_shared<Window>(makeDummyContent("bbb"));
+
+    auto group = DisplayGroup::create(wallSize);
+    group->add(windowA);
+    group->replaceWindows({windowB});
+
+    BOOST_CHECK(!group->getWindow(windowA->getID()));
+    BOOST_CHECK(!group->findWindow("aaa"));
+    BOOST_CHECK_EQUAL(group->getWindow(windowB->getID()), windowB);
+    BOOST_CHECK_EQUAL(group->findWindow("bbb"), windowB);
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_window_lookup_with_many_windows)
+{
+    const auto windowCount = 5000;
+
+    auto group = DisplayGroup::create(wallSize);
+    auto windows = WindowPtrs{};
+    for (auto i = 0; i < windowCount; ++i)
+    {
+        const auto uri = QString("file_%1.png").arg(i);
+        windows.push_back(std::make_shared<Window>(makeDummyContent(uri)));
+        group->add(windows.back());
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    auto found = 0;
+    for (auto i = 0; i < windowCount; ++i)
+    {
+        found += group->getWindow(windows[i]->getID()) == windows[i];
+        found += group->findWindow(QString("file_%1.png").arg(i)) == windows[i];
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    BOOST_TEST_MESSAGE(
+        "getWindow() + findWindow() with "
+        << windowCount << " windows: "
+        << std::chrono::duration<double, std::micro>(elapsed).count() /
+               windowCount
+        << " us per lookup pair");
+
+    BOOST_CHECK_EQUAL(found, 2 * windowCount);
+}
@@ -0,0 +1,174 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#define BOOST_TEST_MODULE DocumentPoolTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "tools/DocumentPool.h"
+
+#include <QThread>
+#include <QtConcurrent>
+
+#include <atomic>
+
+namespace
+{
+struct Document
+{
+    explicit Document(const int id_)
+        : id{id_}
+    {
+    }
+    const int id;
+    int page = 0;
+};
+
+using Pool = DocumentPool<Document>;
+
+struct Fixture
+{
+    Fixture() { DocumentPoolBase::setMaxInstances(2); }
+    std::atomic<int> created{0};
+    Pool pool{"test", [this] { return std::make_unique<Document>(++created); },
+              1024};
+};
+}
+
+BOOST_FIXTURE_TEST_CASE(testInstancesAreReused, Fixture)
+{
+    {
+        auto doc = pool.checkout();
+        BOOST_CHECK_EQUAL(doc->id, 1);
+    }
+    {
+        auto doc = pool.checkout();
+        BOOST_CHECK_EQUAL(doc->id, 1);
+    }
+    BOOST_CHECK_EQUAL(created, 1);
+    BOOST_CHECK_EQUAL(pool.getInstanceCount(), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(testInstancesAreCreatedUpToTheLimit, Fixture)
+{
+    auto doc1 = pool.checkout();
+    auto doc2 = pool.checkout();
+    BOOST_CHECK_NE(doc1->id, doc2->id);
+    BOOST_CHECK_EQUAL(pool.getInstanceCount(), 2);
+
+    std::atomic<bool> checkedOut{false};
+    auto future = QtConcurrent::run([&] {
+        auto doc3 = pool.checkout();
+        checkedOut = true;
+        return doc3->id;
+    });
+    QThread::msleep(50);
+    BOOST_CHECK(!checkedOut);
+
+    const auto releasedId = doc1->id;
+    {
+        auto released = std::move(doc1);
+    }
+    BOOST_CHECK_EQUAL(future.result(), releasedId);
+    BOOST_CHECK_EQUAL(created, 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(testPreferredInstanceIsSelected, Fixture)
+{
+    {
+        auto doc1 = pool.checkout();
+        auto doc2 = pool.checkout();
+        doc1->page = 7;
+        doc2->page = 3;
+    }
+    auto doc = pool.checkout([](const Document& d) { return d.page == 7; });
+    BOOST_CHECK_EQUAL(doc->page, 7);
+    BOOST_CHECK_EQUAL(doc->id, 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(testTryCheckoutOnlyTakesIdleInstances, Fixture)
+{
+    BOOST_CHECK(!pool.tryCheckout());
+    BOOST_CHECK_EQUAL(created, 0);
+
+    {
+        auto doc = pool.checkout();
+        BOOST_CHECK(!pool.tryCheckout());
+    }
+    {
+        auto doc = pool.tryCheckout();
+        BOOST_REQUIRE(doc);
+        BOOST_CHECK_EQUAL((*doc)->id, 1);
+        BOOST_CHECK(!pool.tryCheckout());
+    }
+    BOOST_CHECK_EQUAL(created, 1);
+}
+
+BOOST_AUTO_TEST_CASE(testFactoryErrorReleasesSlot)
+{
+    DocumentPoolBase::setMaxInstances(1);
+    auto fail = true;
+    Pool pool{"test",
+              [&fail] {
+                  if (fail)
+                      throw std::runtime_error("parse error");
+                  return std::make_unique<Document>(1);
+              },
+              1024};
+    BOOST_CHECK_THROW(pool.checkout(), std::runtime_error);
+    BOOST_CHECK_EQUAL(pool.getInstanceCount(), 0);
+
+    fail = false;
+    BOOST_CHECK_EQUAL(pool.checkout()->id, 1);
+}
+
+BOOST_AUTO_TEST_CASE(testSharedPoolPerUri)
+{
+    const auto factory = [] { return std::make_unique<Document>(0); };
+    auto pool1 = Pool::getShared("a.pdf", "test", factory, 1);
+    auto pool2 = Pool::getShared("a.pdf", "test", factory, 1);
+    auto pool3 = Pool::getShared("b.pdf", "test", factory, 1);
+    BOOST_CHECK_EQUAL(pool1, pool2);
+    BOOST_CHECK_NE(pool1, pool3);
+
+    pool1->checkout();
+    pool1.reset();
+    pool2.reset();
+    auto pool4 = Pool::getShared("a.pdf", "test", factory, 1);
+    BOOST_CHECK_EQUAL(pool4->getInstanceCount(), 0);
+}
@@ -52,6 +52,8 @@
 #include <QDir>
 #include <QFile>
 #include <QObject>
+#include <QThread>
+#include <QThreadPool>
 
 using namespace rockets;
 
@@ -91,6 +93,24 @@ http::Request _makeDataRequest(const QString& filename)
     return request;
 }
 
+http::Request _makeChunkedFileRequest(const QString& filename, const int size)
+{
+    http::Request request;
+    request.body =
+        json::dump(QJsonObject{{"filename", filename}, {"size", size}});
+    return request;
+}
+
+http::Request _makeChunkRequest(const QString& filename,
+                                const std::string& data, const size_t offset)
+{
+    http::Request request;
+    request.path = filename.toStdString();
+    request.query["offset"] = std::to_string(offset);
+    request.body = data;
+    return request;
+}
+
 QString _parseJsonResponse(const std::string& responseBody)
 {
     const auto object = json::parse(responseBody);
@@ -300,3 +320,132 @@ BOOST_AUTO_TEST_CASE(testUploadFileTwice)
     BOOST_CHECK(QFile::remove(_tempFile("wall_1.png")));
     BOOST_CHECK(QFile::remove(_tempFile(receivedUri2)));
 }
+
+BOOST_AUTO_TEST_CASE(testChunkedUpload)
+{
+    FileReceiver fileReceiver{QDir::tempPath()};
+
+    OpenListener listener{fileReceiver};
+
+    const auto imageName = "chunked.png";
+    const auto data = _readImageFile(imageUri);
+    const auto half = data.size() / 2;
+    const auto halfSize = static_cast<int>(half);
+
+    const auto uploadRequest = _makeChunkedFileRequest(imageName, data.size());
+    const auto uploadResponse = fileReceiver.prepareUpload(uploadRequest).get();
+    BOOST_REQUIRE_EQUAL(uploadResponse.code, 200);
+    const auto receivedUri = _parseJsonResponse(uploadResponse.body);
+
+    // Upload first half
+    const auto chunk1 = _makeChunkRequest(receivedUri, data.substr(0, half), 0);
+    const auto response1 = fileReceiver.handleUpload(chunk1).get();
+    BOOST_CHECK_EQUAL(response1.code, 202);
+    BOOST_CHECK_EQUAL(json::parse(response1.body).value("offset").toInt(),
+                      halfSize);
+    BOOST_CHECK_EQUAL(listener.open, false);
+
+    // Resume: query status, reject non-contiguous chunk
+    http::Request statusRequest;
+    statusRequest.path = receivedUri.toStdString();
+    const auto status = fileReceiver.getUploadStatus(statusRequest).get();
+    BOOST_CHECK_EQUAL(status.code, 200);
+    BOOST_CHECK_EQUAL(json::parse(status.body).value("offset").toInt(),
+                      halfSize);
+    BOOST_CHECK_EQUAL(json::parse(status.body).value("size").toInt(),
+                      static_cast<int>(data.size()));
+
+    const auto badChunk = _makeChunkRequest(receivedUri, data.substr(1), 1);
+    BOOST_CHECK_EQUAL(fileReceiver.handleUpload(badChunk).get().code, 409);
+
+    // Upload second half
+    const auto chunk2 = _makeChunkRequest(receivedUri, data.substr(half), half);
+    const auto response2 = fileReceiver.handleUpload(chunk2).get();
+    BOOST_CHECK_EQUAL(response2.code, 201);
+    BOOST_CHECK_EQUAL(listener.open, true);
+    BOOST_CHECK_EQUAL(listener.openUri, _tempFile(imageName));
+    BOOST_CHECK_EQUAL(_readImageFile(_tempFile(imageName)), data);
+
+    // cleanup
+    BOOST_CHECK(QFile::remove(_tempFile(imageName)));
+}
+
+BOOST_AUTO_TEST_CASE(testUploadSizeLimit)
+{
+    const auto data = _readImageFile(imageUri);
+    FileReceiver fileReceiver{QDir::tempPath(), qint64(data.size() - 1)};
+
+    OpenListener listener{fileReceiver};
+
+    const auto imageName = "toolarge.png";
+
+    // Declared size is rejected immediately
+    const auto chunkedRequest = _makeChunkedFileRequest(imageName, data.size());
+    BOOST_CHECK_EQUAL(fileReceiver.prepareUpload(chunkedRequest).get().code,
+                      413);
+
+    // Undeclared size is rejected when the data exceeds the limit
+    const auto uploadRequest = _makeFileRequestWithoutPosition(imageName);
+    const auto uploadResponse = fileReceiver.prepareUpload(uploadRequest).get();
+    BOOST_REQUIRE_EQUAL(uploadResponse.code, 200);
+    const auto receivedUri = _parseJsonResponse(uploadResponse.body);
+
+    const auto dataResponse =
+        fileReceiver.handleUpload(_makeDataRequest(receivedUri)).get();
+    BOOST_CHECK_EQUAL(dataResponse.code, 413);
+    BOOST_CHECK_EQUAL(listener.open, false);
+    BOOST_CHECK(!QFile(_tempFile(imageName)).exists());
+}
+
+BOOST_AUTO_TEST_CASE(testPartialHeaderIsNotRejected)
+{
+    FileReceiver fileReceiver{QDir::tempPath()};
+
+    OpenListener listener{fileReceiver};
+
+    const auto imageName = "partial.png";
+    const auto data = _readImageFile(imageUri);
+
+    const auto uploadRequest = _makeChunkedFileRequest(imageName, data.size());
+    const auto uploadResponse = fileReceiver.prepareUpload(uploadRequest).get();
+    BOOST_REQUIRE_EQUAL(uploadResponse.code, 200);
+    const auto receivedUri = _parseJsonResponse(uploadResponse.body);
+
+    // The first chunk is too short for the header to be read
+    const auto chunk1 = _makeChunkRequest(receivedUri, data.substr(0, 4), 0);
+    BOOST_CHECK_EQUAL(fileReceiver.handleUpload(chunk1).get().code, 202);
+    QThreadPool::globalInstance()->waitForDone();
+
+    const auto chunk2 = _makeChunkRequest(receivedUri, data.substr(4), 4);
+    BOOST_CHECK_EQUAL(fileReceiver.handleUpload(chunk2).get().code, 201);
+    BOOST_CHECK_EQUAL(listener.open, true);
+
+    // cleanup
+    BOOST_CHECK(QFile::remove(_tempFile(imageName)));
+}
+
+BOOST_AUTO_TEST_CASE(testIdleUploadIsAborted)
+{
+    FileReceiver fileReceiver{QDir::tempPath(), 0,
+                              std::chrono::milliseconds{10}};
+
+    const auto imageName = "idle.png";
+    const auto data = _readImageFile(imageUri);
+
+    const auto uploadRequest = _makeChunkedFileRequest(imageName, data.size());
+    const auto uploadResponse = fileReceiver.prepareUpload(uploadRequest).get();
+    BOOST_REQUIRE_EQUAL(uploadResponse.code, 200);
+    const auto receivedUri = _parseJsonResponse(uploadResponse.body);
+
+    const auto chunk = _makeChunkRequest(receivedUri, data.substr(0, 100), 0);
+    BOOST_CHECK_EQUAL(fileReceiver.handleUpload(chunk).get().code, 202);
+    BOOST_CHECK(QFile(_tempFile(imageName)).exists());
+
+    QThread::msleep(50);
+
+    http::Request statusRequest;
+    statusRequest.path = receivedUri.toStdString();
+    BOOST_CHECK_EQUAL(fileReceiver.getUploadStatus(statusRequest).get().code,
+                      404);
+    BOOST_CHECK(!QFile(_tempFile(imageName)).exists());
+}
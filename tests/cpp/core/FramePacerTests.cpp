@@ -0,0 +1,118 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#define BOOST_TEST_MODULE FramePacerTests
+#include <boost/test/unit_test.hpp>
+
+#include "tools/FramePacer.h"
+#include "tools/TileUploadBudget.h"
+
+namespace
+{
+using ms = std::chrono::milliseconds;
+const auto start = FramePacer::clock::time_point{} + std::chrono::hours(1);
+}
+
+BOOST_AUTO_TEST_CASE(frame_period_matches_target_frame_rate)
+{
+    BOOST_CHECK(FramePacer{60}.getFramePeriod() > ms(16));
+    BOOST_CHECK(FramePacer{60}.getFramePeriod() < ms(17));
+    BOOST_CHECK(FramePacer{30}.getFramePeriod() > ms(33));
+    BOOST_CHECK(FramePacer{120}.getFramePeriod() < ms(9));
+    BOOST_CHECK_EQUAL(FramePacer{120}.getTargetFrameRate(), 120u);
+
+    BOOST_CHECK_THROW(FramePacer{0}, std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(next_frame_waits_for_the_end_of_the_period)
+{
+    FramePacer pacer{50};
+    pacer.startFrame(start);
+    BOOST_CHECK(pacer.getDeadline() == start + ms(20));
+
+    BOOST_CHECK(pacer.endFrame(start + ms(5)));
+    BOOST_CHECK(pacer.getDelayToNextFrame(start + ms(5)) == ms(15));
+    BOOST_CHECK_EQUAL(pacer.getMissedDeadlines(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(late_frame_misses_deadline_and_next_starts_immediately)
+{
+    FramePacer pacer{50};
+    pacer.startFrame(start);
+
+    BOOST_CHECK(!pacer.endFrame(start + ms(30)));
+    BOOST_CHECK_EQUAL(pacer.getMissedDeadlines(), 1u);
+    BOOST_CHECK(pacer.getDelayToNextFrame(start + ms(30)) ==
+                FramePacer::clock::duration::zero());
+
+    // The following frame gets a full period again
+    pacer.startFrame(start + ms(30));
+    BOOST_CHECK(pacer.endFrame(start + ms(45)));
+    BOOST_CHECK(pacer.getDelayToNextFrame(start + ms(45)) == ms(5));
+    BOOST_CHECK_EQUAL(pacer.getMissedDeadlines(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(first_frame_starts_immediately)
+{
+    const FramePacer pacer{60};
+    BOOST_CHECK(pacer.getDelayToNextFrame(start) ==
+                FramePacer::clock::duration::zero());
+}
+
+BOOST_AUTO_TEST_CASE(tile_upload_budget_defers_uploads_beyond_limit)
+{
+    TileUploadBudget budget;
+    BOOST_CHECK(budget.consume());
+    BOOST_CHECK(!budget.hasDeferredUploads());
+
+    budget.reset(2);
+    BOOST_CHECK(budget.consume());
+    BOOST_CHECK(budget.consume());
+    BOOST_CHECK(!budget.hasDeferredUploads());
+    BOOST_CHECK(!budget.consume());
+    BOOST_CHECK(budget.hasDeferredUploads());
+
+    budget.reset(2);
+    BOOST_CHECK(!budget.hasDeferredUploads());
+    BOOST_CHECK(budget.consume());
+
+    budget.reset(0);
+    for (int i = 0; i < 100; ++i)
+        BOOST_CHECK(budget.consume());
+    BOOST_CHECK(!budget.hasDeferredUploads());
+}
@@ -0,0 +1,179 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#define BOOST_TEST_MODULE ImagePyramidCacheTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "data/TiffPyramidReader.h"
+#include "tools/ImagePyramidCache.h"
+
+#include "MinimalGlobalQtApp.h"
+
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+BOOST_GLOBAL_FIXTURE(MinimalGlobalQtApp);
+
+namespace
+{
+const QSize imageSize{1500, 700};
+
+QString _createImage(const QTemporaryDir& dir, const QColor& color,
+                     const QString& name = "image.png")
+{
+    auto image = QImage(imageSize, QImage::Format_RGB32);
+    image.fill(color);
+    const auto filename = dir.filePath(name);
+    BOOST_REQUIRE(image.save(filename));
+    return filename;
+}
+
+void _setLastUse(const QString& path, const int secondsAgo)
+{
+    const timespec times[2] = {{time(nullptr) - secondsAgo, 0},
+                               {0, UTIME_OMIT}};
+    const auto filename = QFile::encodeName(path);
+    BOOST_REQUIRE_EQUAL(utimensat(AT_FDCWD, filename.constData(), times, 0), 0);
+}
+}
+
+BOOST_AUTO_TEST_CASE(testPyramidIsGeneratedOnceAndReused)
+{
+    QTemporaryDir dir;
+    const auto image = _createImage(dir, Qt::red);
+    const auto cache = ImagePyramidCache{dir.filePath("cache")};
+
+    const auto path = cache.getPyramid(image);
+    BOOST_CHECK_EQUAL(path, cache.getPyramidPath(image));
+    BOOST_REQUIRE(QFileInfo::exists(path));
+    BOOST_CHECK(!QFileInfo::exists(path + ".tmp"));
+
+    TiffPyramidReader reader{path};
+    BOOST_CHECK_EQUAL(reader.getImageSize(), imageSize);
+    BOOST_CHECK_EQUAL(reader.getTileSize(),
+                      QSize(ImagePyramidCache::tileSize,
+                            ImagePyramidCache::tileSize));
+    BOOST_CHECK_EQUAL(reader.findTopPyramidLevel(), 2);
+
+    const auto modified = QFileInfo(path).lastModified();
+    BOOST_CHECK_EQUAL(cache.getPyramid(image), path);
+    BOOST_CHECK_EQUAL(QFileInfo(path).lastModified(), modified);
+}
+
+BOOST_AUTO_TEST_CASE(testModifiedImageGetsNewPyramid)
+{
+    QTemporaryDir dir;
+    const auto cache = ImagePyramidCache{dir.filePath("cache")};
+
+    const auto image = _createImage(dir, Qt::red);
+    const auto path = cache.getPyramidPath(image);
+
+    QFile file{image};
+    BOOST_REQUIRE(file.open(QIODevice::Append));
+    file.write("modified");
+    file.close();
+
+    BOOST_CHECK_NE(cache.getPyramidPath(image), path);
+}
+
+BOOST_AUTO_TEST_CASE(testInvalidImageThrows)
+{
+    QTemporaryDir dir;
+    const auto cache = ImagePyramidCache{dir.filePath("cache")};
+    const auto invalid = dir.filePath("invalid.png");
+
+    BOOST_CHECK_THROW(cache.getPyramid(invalid), std::runtime_error);
+    BOOST_CHECK(!QFileInfo::exists(cache.getPyramidPath(invalid)));
+}
+
+BOOST_AUTO_TEST_CASE(testPyramidIsGeneratedInTheBackground)
+{
+    QTemporaryDir dir;
+    const auto image = _createImage(dir, Qt::red);
+    const auto cache = ImagePyramidCache{dir.filePath("cache")};
+
+    auto future = cache.generatePyramid(image);
+    BOOST_CHECK_EQUAL(future.result(), cache.getPyramidPath(image));
+    BOOST_CHECK(QFileInfo::exists(future.result()));
+
+    // Errors are reported with an empty path
+    future = cache.generatePyramid(dir.filePath("invalid.png"));
+    BOOST_CHECK(future.result().isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(testLeastRecentlyUsedPyramidsAreEvictedAboveSizeLimit)
+{
+    QTemporaryDir dir;
+    const auto cache = ImagePyramidCache{dir.filePath("cache")};
+    const auto older = cache.getPyramid(_createImage(dir, Qt::red, "a.png"));
+    const auto newer = cache.getPyramid(_createImage(dir, Qt::blue, "b.png"));
+    _setLastUse(older, 3 * 3600);
+    _setLastUse(newer, 2 * 3600);
+
+    const auto size = QFileInfo(older).size() + QFileInfo(newer).size();
+    ImagePyramidCache{dir.filePath("cache"), size}.evict();
+    BOOST_CHECK(QFileInfo::exists(older));
+    BOOST_CHECK(QFileInfo::exists(newer));
+
+    ImagePyramidCache{dir.filePath("cache"), size - 1}.evict();
+    BOOST_CHECK(!QFileInfo::exists(older));
+    BOOST_CHECK(QFileInfo::exists(newer));
+}
+
+BOOST_AUTO_TEST_CASE(testUnusedPyramidsExpireAndRecentOnesAreKept)
+{
+    QTemporaryDir dir;
+    const auto cache = ImagePyramidCache{dir.filePath("cache")};
+    const auto unused = cache.getPyramid(_createImage(dir, Qt::red, "a.png"));
+    const auto recent = cache.getPyramid(_createImage(dir, Qt::blue, "b.png"));
+    _setLastUse(unused, (ImagePyramidCache::maxUnusedDays + 1) * 24 * 3600);
+    _setLastUse(recent, 7 * 24 * 3600);
+    ImagePyramidCache::markUsed(recent);
+
+    cache.evict();
+    BOOST_CHECK(!QFileInfo::exists(unused));
+    BOOST_CHECK(QFileInfo::exists(recent));
+
+    // Recently used pyramids are kept even above the size limit
+    ImagePyramidCache{dir.filePath("cache"), 0}.evict();
+    BOOST_CHECK(QFileInfo::exists(recent));
+}
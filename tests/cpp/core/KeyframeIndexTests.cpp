@@ -0,0 +1,82 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#define BOOST_TEST_MODULE KeyframeIndexTests
+#include <boost/test/unit_test.hpp>
+
+#include "data/KeyframeIndex.h"
+
+BOOST_AUTO_TEST_CASE(empty_index_returns_requested_frame)
+{
+    const KeyframeIndex index;
+    BOOST_CHECK(index.isEmpty());
+    BOOST_CHECK_EQUAL(index.getSize(), 0u);
+    BOOST_CHECK_EQUAL(index.findNearest(42), 42);
+    BOOST_CHECK(!index.hasKeyframeBetween(0, 1000));
+}
+
+BOOST_AUTO_TEST_CASE(keyframes_are_sorted_and_unique)
+{
+    const KeyframeIndex index{{250, 0, 500, 250}};
+    BOOST_CHECK(!index.isEmpty());
+    BOOST_CHECK_EQUAL(index.getSize(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(find_nearest_keyframe)
+{
+    const KeyframeIndex index{{0, 250, 500}};
+    BOOST_CHECK_EQUAL(index.findNearest(0), 0);
+    BOOST_CHECK_EQUAL(index.findNearest(124), 0);
+    BOOST_CHECK_EQUAL(index.findNearest(125), 0);
+    BOOST_CHECK_EQUAL(index.findNearest(126), 250);
+    BOOST_CHECK_EQUAL(index.findNearest(250), 250);
+    BOOST_CHECK_EQUAL(index.findNearest(499), 500);
+    BOOST_CHECK_EQUAL(index.findNearest(10000), 500);
+    BOOST_CHECK_EQUAL(index.findNearest(-5), 0);
+}
+
+BOOST_AUTO_TEST_CASE(keyframe_between_excludes_start_and_includes_end)
+{
+    const KeyframeIndex index{{0, 250, 500}};
+    BOOST_CHECK(!index.hasKeyframeBetween(0, 249));
+    BOOST_CHECK(index.hasKeyframeBetween(0, 250));
+    BOOST_CHECK(!index.hasKeyframeBetween(250, 499));
+    BOOST_CHECK(index.hasKeyframeBetween(249, 1000));
+    BOOST_CHECK(!index.hasKeyframeBetween(500, 1000));
+    BOOST_CHECK(!index.hasKeyframeBetween(300, 200));
+}
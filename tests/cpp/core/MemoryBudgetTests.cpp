@@ -0,0 +1,203 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#define BOOST_TEST_MODULE MemoryBudgetTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "tools/MemoryBudget.h"
+
+#include <vector>
+
+namespace
+{
+const size_t MB = 1024 * 1024;
+
+struct Fixture
+{
+    MemoryBudget& budget = MemoryBudget::instance();
+    MemoryBudget::clock::time_point start;
+
+    ~Fixture()
+    {
+        // Leave the over limit state for the next test
+        budget.setLimit(1024 * MB);
+        budget.enforce(start + std::chrono::hours{1});
+        budget.setLimit(0);
+        budget.setConstrained(false);
+    }
+};
+}
+
+BOOST_FIXTURE_TEST_CASE(testAccountsAreSummedByCategory, Fixture)
+{
+    {
+        MemoryBudget::Account tiles{MemoryCategory::tiles};
+        MemoryBudget::Account movies{MemoryCategory::movies};
+        tiles.add(3 * MB);
+        tiles.add(-1 * MB);
+        movies.set(5 * MB);
+        movies.set(4 * MB);
+
+        BOOST_CHECK_EQUAL(tiles.get(), 2 * MB);
+        BOOST_CHECK_EQUAL(budget.getUsage(MemoryCategory::tiles), 2 * MB);
+        BOOST_CHECK_EQUAL(budget.getUsage(MemoryCategory::movies), 4 * MB);
+        BOOST_CHECK_EQUAL(budget.getUsage(MemoryCategory::streams), 0);
+        BOOST_CHECK_EQUAL(budget.getUsage(), 6 * MB);
+    }
+    BOOST_CHECK_EQUAL(budget.getUsage(), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(testNoLimitNeverReclaims, Fixture)
+{
+    MemoryBudget::Account tiles{MemoryCategory::tiles};
+    tiles.set(100 * MB);
+
+    auto calls = 0;
+    MemoryBudget::Reclaimer reclaimer{MemoryCategory::tiles, [&](size_t) {
+                                          ++calls;
+                                          return size_t{0};
+                                      }};
+    BOOST_CHECK(!budget.enforce(start));
+    BOOST_CHECK_EQUAL(calls, 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(testReclaimersAreCalledInCategoryOrder, Fixture)
+{
+    budget.setLimit(100 * MB);
+
+    MemoryBudget::Account tiles{MemoryCategory::tiles};
+    MemoryBudget::Account documents{MemoryCategory::documents};
+    tiles.set(10 * MB);
+    documents.set(90 * MB);
+
+    std::vector<MemoryCategory> calls;
+    auto makeReclaimer = [&](MemoryCategory category,
+                             MemoryBudget::Account& account) {
+        return [&, category](const size_t bytes) {
+            calls.push_back(category);
+            const auto reclaimed = std::min(bytes, account.get());
+            account.add(-int64_t(reclaimed));
+            return reclaimed;
+        };
+    };
+    MemoryBudget::Reclaimer documentsReclaimer{
+        MemoryCategory::documents,
+        makeReclaimer(MemoryCategory::documents, documents)};
+    MemoryBudget::Reclaimer tilesReclaimer{
+        MemoryCategory::tiles, makeReclaimer(MemoryCategory::tiles, tiles)};
+
+    // Under the limit: nothing to do
+    BOOST_CHECK(!budget.enforce(start));
+    BOOST_CHECK(calls.empty());
+
+    // Over the limit: reclaim down to the target, tiles first
+    documents.set(95 * MB);
+    BOOST_CHECK(!budget.enforce(start));
+    BOOST_REQUIRE_EQUAL(calls.size(), 2);
+    BOOST_CHECK(calls[0] == MemoryCategory::tiles);
+    BOOST_CHECK(calls[1] == MemoryCategory::documents);
+    BOOST_CHECK_EQUAL(tiles.get(), 0);
+    BOOST_CHECK_EQUAL(budget.getUsage(),
+                      size_t(100 * MB * MemoryBudget::reclaimTarget));
+
+    // Enough released by the first category
+    calls.clear();
+    tiles.set(25 * MB);
+    BOOST_CHECK(!budget.enforce(start));
+    BOOST_REQUIRE_EQUAL(calls.size(), 1);
+    BOOST_CHECK(calls[0] == MemoryCategory::tiles);
+}
+
+BOOST_FIXTURE_TEST_CASE(testOverLimitUntilLowWatermarkForSomeTime, Fixture)
+{
+    budget.setLimit(100 * MB);
+
+    MemoryBudget::Account movies{MemoryCategory::movies};
+    movies.set(120 * MB);
+    BOOST_CHECK(budget.enforce(start));
+
+    // Under the low watermark, but not for long enough
+    movies.set(50 * MB);
+    BOOST_CHECK(budget.enforce(start + std::chrono::seconds{1}));
+
+    // Under the limit but above the low watermark
+    movies.set(80 * MB);
+    BOOST_CHECK(budget.enforce(start + std::chrono::seconds{20}));
+
+    movies.set(50 * MB);
+    BOOST_CHECK(!budget.enforce(start + std::chrono::seconds{20}));
+    BOOST_CHECK(!budget.enforce(start + std::chrono::seconds{30}));
+}
+
+BOOST_FIXTURE_TEST_CASE(testOverLimitReclaimsDownToLowWatermark, Fixture)
+{
+    budget.setLimit(100 * MB);
+
+    MemoryBudget::Account tiles{MemoryCategory::tiles};
+    MemoryBudget::Account streams{MemoryCategory::streams};
+    streams.set(110 * MB);
+
+    size_t requested = 0;
+    MemoryBudget::Reclaimer reclaimer{MemoryCategory::tiles,
+                                      [&](const size_t bytes) {
+                                          requested = bytes;
+                                          const auto freed =
+                                              std::min(bytes, tiles.get());
+                                          tiles.add(-int64_t(freed));
+                                          return freed;
+                                      }};
+    BOOST_CHECK(budget.enforce(start));
+
+    // Recently over the limit: reclaim down to the low watermark
+    streams.set(60 * MB);
+    tiles.set(40 * MB);
+    BOOST_CHECK(budget.enforce(start + std::chrono::seconds{1}));
+    BOOST_CHECK_EQUAL(requested,
+                      100 * MB - size_t(100 * MB * MemoryBudget::lowWatermark));
+    BOOST_CHECK_EQUAL(tiles.get(), 15 * MB);
+}
+
+BOOST_FIXTURE_TEST_CASE(testConstrainedState, Fixture)
+{
+    BOOST_CHECK(!budget.isConstrained());
+    budget.setConstrained(true);
+    BOOST_CHECK(budget.isConstrained());
+    budget.setConstrained(false);
+    BOOST_CHECK(!budget.isConstrained());
+}
@@ -0,0 +1,188 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#define BOOST_TEST_MODULE MetricsRegistryTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "metrics/MetricsRegistry.h"
+#include "metrics/prometheus.h"
+#include "serialization/utils.h"
+#include "tools/MetricsAggregator.h"
+
+#include <algorithm>
+
+namespace
+{
+const auto help = "test metric";
+
+const MetricFamily& findFamily(const MetricFamilies& families,
+                               const std::string& name)
+{
+    const auto it = std::find_if(families.begin(), families.end(),
+                                 [&name](const MetricFamily& family) {
+                                     return family.name == name;
+                                 });
+    if (it == families.end())
+        throw std::runtime_error("no such metric: " + name);
+    return *it;
+}
+
+bool contains(const std::string& text, const std::string& line)
+{
+    return text.find(line) != std::string::npos;
+}
+}
+
+BOOST_AUTO_TEST_CASE(testCounterAndGauge)
+{
+    MetricsRegistry registry;
+
+    auto& counter = registry.counter("counter", help);
+    counter.increment();
+    counter.increment(2.5);
+    BOOST_CHECK_EQUAL(counter.get(), 3.5);
+    BOOST_CHECK_EQUAL(&registry.counter("counter", help), &counter);
+
+    auto& gauge = registry.gauge("gauge", help, {{"uri", "a"}});
+    gauge.set(10.0);
+    gauge.add(-4.0);
+    BOOST_CHECK_EQUAL(gauge.get(), 6.0);
+    BOOST_CHECK_NE(&registry.gauge("gauge", help, {{"uri", "b"}}), &gauge);
+
+    BOOST_CHECK_THROW(registry.gauge("counter", help), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(testHistogramBuckets)
+{
+    MetricsRegistry registry;
+
+    auto& histogram = registry.histogram("histogram", help, {}, {1.0, 2.0});
+    histogram.observe(0.5);
+    histogram.observe(1.0);
+    histogram.observe(1.5);
+    histogram.observe(3.0);
+
+    const auto sample = histogram.getSample();
+    BOOST_CHECK_EQUAL(sample.count, 4u);
+    BOOST_CHECK_EQUAL(sample.value, 6.0);
+    BOOST_REQUIRE_EQUAL(sample.buckets.size(), 2u);
+    BOOST_CHECK_EQUAL(sample.buckets[0], 2u);
+    BOOST_CHECK_EQUAL(sample.buckets[1], 3u);
+
+    BOOST_CHECK_THROW(MetricHistogram({2.0, 1.0}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(testRemoveSeries)
+{
+    MetricsRegistry registry;
+    registry.gauge("fps", help, {{"uri", "a"}}).set(1.0);
+    registry.gauge("fps", help, {{"uri", "b"}}).set(2.0);
+
+    registry.remove("fps", {{"uri", "a"}});
+
+    const auto families = registry.snapshot();
+    const auto& fps = findFamily(families, "fps");
+    BOOST_REQUIRE_EQUAL(fps.samples.size(), 1u);
+    BOOST_CHECK_EQUAL(fps.samples[0].labels.at("uri"), "b");
+    BOOST_CHECK_EQUAL(fps.samples[0].value, 2.0);
+}
+
+BOOST_AUTO_TEST_CASE(testSnapshotSerialization)
+{
+    MetricsRegistry registry;
+    registry.counter("bytes", help, {{"type", "PIXELSTREAM"}}).increment(42);
+    registry.histogram("time", help, {}, {0.1}).observe(0.05);
+
+    const auto snapshot = registry.snapshot();
+    const auto data = serialization::toBinary(snapshot);
+    const auto families = serialization::get<MetricFamilies>(data);
+
+    BOOST_REQUIRE_EQUAL(families.size(), 2u);
+    const auto& bytes = findFamily(families, "bytes");
+    BOOST_CHECK(bytes.type == MetricType::counter);
+    BOOST_CHECK_EQUAL(bytes.samples.at(0).labels.at("type"), "PIXELSTREAM");
+    BOOST_CHECK_EQUAL(bytes.samples.at(0).value, 42.0);
+
+    const auto& time = findFamily(families, "time");
+    BOOST_CHECK(time.type == MetricType::histogram);
+    BOOST_CHECK_EQUAL(time.bounds.size(), 1u);
+    BOOST_CHECK_EQUAL(time.samples.at(0).count, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(testPrometheusTextFormat)
+{
+    MetricsRegistry registry;
+    registry.counter("requests_total", "Requests", {{"path", "a\"b"}})
+        .increment(3);
+    auto& histogram = registry.histogram("latency", "Latency", {}, {0.5, 1.0});
+    histogram.observe(0.25);
+    histogram.observe(2.0);
+
+    const auto text = prometheus::toText(registry.snapshot());
+
+    BOOST_CHECK(contains(text, "# HELP requests_total Requests\n"));
+    BOOST_CHECK(contains(text, "# TYPE requests_total counter\n"));
+    BOOST_CHECK(contains(text, "requests_total{path=\"a\\\"b\"} 3\n"));
+    BOOST_CHECK(contains(text, "# TYPE latency histogram\n"));
+    BOOST_CHECK(contains(text, "latency_bucket{le=\"0.5\"} 1\n"));
+    BOOST_CHECK(contains(text, "latency_bucket{le=\"1\"} 1\n"));
+    BOOST_CHECK(contains(text, "latency_bucket{le=\"+Inf\"} 2\n"));
+    BOOST_CHECK(contains(text, "latency_sum 2.25\n"));
+    BOOST_CHECK(contains(text, "latency_count 2\n"));
+}
+
+BOOST_AUTO_TEST_CASE(testAggregatorLabelsWallProcesses)
+{
+    MetricsRegistry wall;
+    wall.counter("test_aggregator_frames_total", help).increment(5);
+
+    MetricsAggregator aggregator;
+    aggregator.update(0, wall.snapshot());
+    aggregator.update(1, wall.snapshot());
+
+    const auto families = aggregator.getMetrics();
+    const auto& frames = findFamily(families, "test_aggregator_frames_total");
+    BOOST_REQUIRE_EQUAL(frames.samples.size(), 2u);
+    BOOST_CHECK_EQUAL(frames.samples[0].labels.at("process"), "wall0");
+    BOOST_CHECK_EQUAL(frames.samples[1].labels.at("process"), "wall1");
+
+    const auto text = aggregator.toPrometheus();
+    BOOST_CHECK(contains(
+        text, "test_aggregator_frames_total{process=\"wall1\"} 5\n"));
+}
@@ -0,0 +1,170 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#define BOOST_TEST_MODULE MovieUpdaterTests
+#include <boost/test/unit_test.hpp>
+
+#include "datasources/MovieUpdater.h"
+#include "scene/MovieContent.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+namespace
+{
+using clock = PlaybackSchedule::clock;
+const auto start = clock::time_point{} + std::chrono::hours(1);
+const int movieSize = 16;
+const int movieFrames = 50;
+
+// Write an uncompressed 25 fps movie that FFMPEG reads without any codec
+QString writeMovie(const QTemporaryDir& dir)
+{
+    const auto filename = dir.filePath("movie.y4m");
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly))
+        return QString();
+
+    file.write(QString("YUV4MPEG2 W%1 H%1 F25:1 Ip A1:1 C420jpeg\n")
+                   .arg(movieSize)
+                   .toLatin1());
+    const auto frameBytes = movieSize * movieSize * 3 / 2;
+    for (int i = 0; i < movieFrames; ++i)
+    {
+        file.write("FRAME\n");
+        file.write(QByteArray(frameBytes, char(i * 4)));
+    }
+    return filename;
+}
+
+struct Fixture
+{
+    QTemporaryDir dir;
+    QString uri = writeMovie(dir);
+    MovieContent content{uri};
+    std::unique_ptr<MovieUpdater> updater;
+    int pictureUpdates = 0;
+
+    Fixture()
+    {
+        BOOST_REQUIRE(content.readMetadata());
+        BOOST_REQUIRE_GT(content.getFrameDuration(), 0.0);
+        content.play();
+
+        updater = std::make_unique<MovieUpdater>(uri);
+        updater->update(content);
+        QObject::connect(updater.get(), &MovieUpdater::pictureUpdated,
+                         [this] { ++pictureUpdates; });
+    }
+
+    // Half a frame off the frame boundaries to be robust to rounding
+    clock::time_point at(const double frames) const
+    {
+        const auto seconds = (frames + 0.5) * content.getFrameDuration();
+        return start + std::chrono::duration_cast<clock::duration>(
+                           std::chrono::duration<double>(seconds));
+    }
+
+    void swap(const double frames)
+    {
+        updater->allowNextFrame();
+        updater->advanceFrame(at(frames));
+    }
+};
+}
+
+BOOST_FIXTURE_TEST_CASE(frames_advance_with_the_clock_once_swapped, Fixture)
+{
+    updater->advanceFrame(at(0));
+    BOOST_CHECK_EQUAL(pictureUpdates, 1);
+
+    // No new frame until the previous one was swapped on all processes
+    updater->advanceFrame(at(1));
+    BOOST_CHECK_EQUAL(pictureUpdates, 1);
+
+    swap(2);
+    BOOST_CHECK_EQUAL(pictureUpdates, 2);
+    BOOST_CHECK_CLOSE(updater->getPosition(),
+                      2 * content.getFrameDuration() / content.getDuration(),
+                      1e-6);
+}
+
+BOOST_FIXTURE_TEST_CASE(playback_resumes_after_a_late_swap, Fixture)
+{
+    updater->advanceFrame(at(0));
+    BOOST_REQUIRE_EQUAL(pictureUpdates, 1);
+
+    // The frame was swapped too late, the time stands still for one frame
+    swap(10);
+    BOOST_CHECK_EQUAL(pictureUpdates, 1);
+    BOOST_CHECK_EQUAL(updater->getPosition(), 0.0);
+
+    // ...then playback continues from the frame that was late
+    updater->advanceFrame(at(11));
+    BOOST_CHECK_EQUAL(pictureUpdates, 2);
+    BOOST_CHECK_CLOSE(updater->getPosition(),
+                      content.getFrameDuration() / content.getDuration(),
+                      1e-6);
+
+    swap(12);
+    BOOST_CHECK_EQUAL(pictureUpdates, 3);
+}
+
+BOOST_FIXTURE_TEST_CASE(playback_resumes_after_a_long_pause, Fixture)
+{
+    updater->advanceFrame(at(0));
+    swap(1);
+    BOOST_REQUIRE_EQUAL(pictureUpdates, 2);
+
+    content.pause();
+    updater->update(content);
+    swap(2);
+    BOOST_CHECK_EQUAL(pictureUpdates, 3);
+    swap(3);
+    BOOST_CHECK_EQUAL(pictureUpdates, 3);
+
+    // Resuming much later than the last frame request is not a late swap
+    content.play();
+    updater->update(content);
+    swap(20);
+    BOOST_CHECK_EQUAL(pictureUpdates, 3);
+    swap(21);
+    BOOST_CHECK_EQUAL(pictureUpdates, 4);
+    swap(22);
+    BOOST_CHECK_EQUAL(pictureUpdates, 5);
+}
@@ -551,3 +551,17 @@ BOOST_AUTO_TEST_CASE(testTileSizeIsDivisorOf512)
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(testTilesWithoutDataHaveNoImage)
+{
+    const auto image = TestImage(REF_IMAGE_SIZE, -1);
+    const auto frame = createTestFrame(image, deflect::RowOrder::top_down);
+
+    // Tiles culled by the master application have no data
+    frame->tiles[0].imageData = QByteArray();
+
+    PixelStreamChannelAssembler assembler{frame, 0};
+    deflect::server::TileDecoder decoder;
+    BOOST_CHECK(!assembler.getTileImage(0, decoder));
+    BOOST_CHECK(assembler.getTileImage(3, decoder));
+}
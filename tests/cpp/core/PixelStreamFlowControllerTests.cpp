@@ -0,0 +1,182 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#define BOOST_TEST_MODULE PixelStreamFlowControllerTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "tools/PixelStreamFlowController.h"
+
+#include <deflect/server/Frame.h>
+
+namespace
+{
+const QString streamUri("test_stream");
+
+struct Fixture
+{
+    PixelStreamFlowController controller{3};
+    size_t requests = 0;
+
+    Fixture()
+    {
+        QObject::connect(&controller, &PixelStreamFlowController::requestFrame,
+                         [this](const QString uri) {
+                             BOOST_CHECK_EQUAL(uri, streamUri);
+                             ++requests;
+                         });
+    }
+
+    void sendFrame()
+    {
+        auto frame = std::make_shared<deflect::server::Frame>();
+        frame->uri = streamUri;
+        controller.registerFrame(frame);
+    }
+};
+}
+
+BOOST_FIXTURE_TEST_CASE(testRestartRequestsFirstFrame, Fixture)
+{
+    controller.restart(streamUri);
+    BOOST_CHECK_EQUAL(requests, 1);
+    BOOST_CHECK_EQUAL(controller.getFramesInFlight(streamUri), 0);
+    BOOST_CHECK_EQUAL(controller.getWindow(streamUri), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(testWindowGrowsUpToMaximum, Fixture)
+{
+    controller.restart(streamUri);
+
+    // Window of 1 frame: wait for the credit before requesting more
+    sendFrame();
+    BOOST_CHECK_EQUAL(requests, 1);
+    BOOST_CHECK_EQUAL(controller.getFramesInFlight(streamUri), 1);
+
+    controller.returnCredits(streamUri, 1, 0);
+    BOOST_CHECK_EQUAL(controller.getWindow(streamUri), 2);
+    BOOST_CHECK_EQUAL(requests, 2);
+
+    // Window of 2 frames: the next frame is requested immediately
+    sendFrame();
+    BOOST_CHECK_EQUAL(requests, 3);
+    sendFrame();
+    BOOST_CHECK_EQUAL(requests, 3);
+    BOOST_CHECK_EQUAL(controller.getFramesInFlight(streamUri), 2);
+
+    controller.returnCredits(streamUri, 1, 0);
+    controller.returnCredits(streamUri, 1, 0);
+    BOOST_CHECK_EQUAL(controller.getWindow(streamUri), 3);
+    BOOST_CHECK_EQUAL(controller.getFramesInFlight(streamUri), 0);
+    BOOST_CHECK_EQUAL(requests, 4);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        sendFrame();
+        controller.returnCredits(streamUri, 1, 0);
+    }
+    BOOST_CHECK_EQUAL(controller.getWindow(streamUri), 3);
+}
+
+BOOST_FIXTURE_TEST_CASE(testOneDroppedFramePerSwapKeepsWindow, Fixture)
+{
+    controller.restart(streamUri);
+    sendFrame();
+    controller.returnCredits(streamUri, 1, 0);
+    sendFrame();
+    sendFrame();
+    BOOST_REQUIRE_EQUAL(controller.getWindow(streamUri), 2);
+    BOOST_REQUIRE_EQUAL(requests, 3);
+
+    // The second frame replaced the first one before it was displayed
+    for (int i = 0; i < 3; ++i)
+    {
+        controller.returnCredits(streamUri, 2, 1);
+        BOOST_CHECK_EQUAL(controller.getWindow(streamUri), 2);
+        BOOST_CHECK_EQUAL(controller.getFramesInFlight(streamUri), 0);
+        sendFrame();
+        sendFrame();
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(testDroppedFramesShrinkWindow, Fixture)
+{
+    controller.restart(streamUri);
+    sendFrame();
+    controller.returnCredits(streamUri, 1, 0);
+    sendFrame();
+    sendFrame();
+    controller.returnCredits(streamUri, 1, 0);
+    controller.returnCredits(streamUri, 1, 0);
+    sendFrame();
+    sendFrame();
+    sendFrame();
+    BOOST_REQUIRE_EQUAL(controller.getWindow(streamUri), 3);
+    BOOST_REQUIRE_EQUAL(requests, 6);
+
+    controller.returnCredits(streamUri, 3, 2);
+    BOOST_CHECK_EQUAL(controller.getWindow(streamUri), 1);
+    BOOST_CHECK_EQUAL(controller.getFramesInFlight(streamUri), 0);
+    BOOST_CHECK_EQUAL(requests, 7);
+}
+
+BOOST_FIXTURE_TEST_CASE(testCreditsAfterRestartAreIgnored, Fixture)
+{
+    controller.restart(streamUri);
+    sendFrame();
+    controller.restart(streamUri);
+    BOOST_CHECK_EQUAL(requests, 2);
+
+    controller.returnCredits(streamUri, 1, 0);
+    BOOST_CHECK_EQUAL(controller.getFramesInFlight(streamUri), 0);
+    BOOST_CHECK_EQUAL(requests, 2);
+
+    controller.returnCredits("unknown_stream", 1, 0);
+    BOOST_CHECK_EQUAL(requests, 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(testRemovedStreamIsForgotten, Fixture)
+{
+    controller.restart(streamUri);
+    sendFrame();
+    controller.remove(streamUri);
+    BOOST_CHECK_EQUAL(controller.getFramesInFlight(streamUri), 0);
+
+    controller.returnCredits(streamUri, 1, 0);
+    BOOST_CHECK_EQUAL(requests, 1);
+}
@@ -0,0 +1,234 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#define BOOST_TEST_MODULE PixelStreamRouterTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "configuration/Configuration.h"
+#include "network/PixelStreamRouter.h"
+#include "scene/PixelStreamContent.h"
+#include "scene/Scene.h"
+#include "scene/Window.h"
+
+#include "MinimalGlobalQtApp.h"
+BOOST_GLOBAL_FIXTURE(MinimalGlobalQtApp);
+
+namespace
+{
+const QString streamUri("test_stream");
+const QSize streamSize(8000, 4000);
+const int tileSize = 1000;
+
+// Two processes with one 1000x1000 screen each, side by side
+Configuration makeConfig()
+{
+    Configuration config;
+    SurfaceConfig surface;
+    surface.displayWidth = 1000;
+    surface.displayHeight = 1000;
+    surface.screenCountX = 2;
+    config.surfaces.push_back(surface);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        Screen screen;
+        screen.globalIndex = QPoint(i, 0);
+        config.processes.push_back(Process{"localhost", {screen}});
+    }
+    return config;
+}
+
+deflect::server::Frame makeFrame(const uint channel = 0)
+{
+    deflect::server::Frame frame;
+    frame.uri = streamUri;
+    for (int y = 0; y < streamSize.height(); y += tileSize)
+    {
+        for (int x = 0; x < streamSize.width(); x += tileSize)
+        {
+            deflect::server::Tile tile;
+            tile.x = x;
+            tile.y = y;
+            tile.width = tileSize;
+            tile.height = tileSize;
+            tile.channel = channel;
+            tile.imageData = QByteArray("jpeg");
+            frame.tiles.push_back(tile);
+        }
+    }
+    return frame;
+}
+
+WindowPtr addStreamWindow(Scene& scene)
+{
+    auto content = new PixelStreamContent(streamUri, streamSize, false);
+    auto window = std::make_shared<Window>(ContentPtr(content));
+    window->setCoordinates(QRectF(0, 0, 2000, 1000));
+    scene.getGroup(0).add(window);
+    return window;
+}
+
+// The frames are sent in full until the walls have the new windows
+std::vector<deflect::server::Frame> splitAfterChange(
+    PixelStreamRouter& router, const deflect::server::Frame& frame,
+    const Scene& scene)
+{
+    for (uint i = 0; i < PixelStreamRouter::fullFramesAfterChange; ++i)
+        BOOST_CHECK(router.split(frame, scene).empty());
+    return router.split(frame, scene);
+}
+
+std::vector<int> getSentTilesX(const deflect::server::Frame& frame)
+{
+    std::vector<int> sent;
+    for (const auto& tile : frame.tiles)
+    {
+        if (!tile.imageData.isEmpty() && tile.y == 0)
+            sent.push_back(tile.x);
+    }
+    return sent;
+}
+}
+
+BOOST_AUTO_TEST_CASE(testEachProcessGetsOnlyItsVisibleTiles)
+{
+    const auto config = makeConfig();
+    auto scene = Scene::create(config.surfaces);
+    addStreamWindow(*scene);
+
+    PixelStreamRouter router(config);
+    const auto frame = makeFrame();
+    const auto frames = splitAfterChange(router, frame, *scene);
+
+    BOOST_REQUIRE_EQUAL(frames.size(), 2);
+    for (const auto& processFrame : frames)
+    {
+        BOOST_CHECK_EQUAL(processFrame.uri, streamUri);
+        BOOST_CHECK_EQUAL(processFrame.tiles.size(), frame.tiles.size());
+    }
+
+    // Each screen shows 4000 stream pixels horizontally, plus the margin
+    const auto expected0 = std::vector<int>{0, 1000, 2000, 3000, 4000};
+    const auto expected1 = std::vector<int>{3000, 4000, 5000, 6000, 7000};
+    const auto sent0 = getSentTilesX(frames[0]);
+    const auto sent1 = getSentTilesX(frames[1]);
+    BOOST_CHECK_EQUAL_COLLECTIONS(sent0.begin(), sent0.end(), expected0.begin(),
+                                  expected0.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(sent1.begin(), sent1.end(), expected1.begin(),
+                                  expected1.end());
+}
+
+BOOST_AUTO_TEST_CASE(testProcessWithoutWindowGetsNoTiles)
+{
+    const auto config = makeConfig();
+    auto scene = Scene::create(config.surfaces);
+    auto window = addStreamWindow(*scene);
+    window->setCoordinates(QRectF(1000, 0, 1000, 500));
+
+    PixelStreamRouter router(config);
+    const auto frames = splitAfterChange(router, makeFrame(), *scene);
+
+    BOOST_REQUIRE_EQUAL(frames.size(), 2);
+    BOOST_CHECK(getSentTilesX(frames[0]).empty());
+    BOOST_CHECK_EQUAL(getSentTilesX(frames[1]).size(), 8);
+}
+
+BOOST_AUTO_TEST_CASE(testFullFrameIsSentWhileWindowIsMoving)
+{
+    const auto config = makeConfig();
+    auto scene = Scene::create(config.surfaces);
+    auto window = addStreamWindow(*scene);
+    window->setState(Window::MOVING);
+
+    PixelStreamRouter router(config);
+    splitAfterChange(router, makeFrame(), *scene);
+    BOOST_CHECK(router.split(makeFrame(), *scene).empty());
+}
+
+BOOST_AUTO_TEST_CASE(testFullFramesAreSentAfterZoomChange)
+{
+    const auto config = makeConfig();
+    auto scene = Scene::create(config.surfaces);
+    auto window = addStreamWindow(*scene);
+
+    PixelStreamRouter router(config);
+    const auto frame = makeFrame();
+    splitAfterChange(router, frame, *scene);
+
+    // The walls may still show the previous zoom
+    window->getContent().setZoomRect(QRectF(0.0, 0.0, 0.5, 0.5));
+    const auto frames = splitAfterChange(router, frame, *scene);
+
+    // Each screen shows 2000 stream pixels horizontally, plus the margin
+    BOOST_REQUIRE_EQUAL(frames.size(), 2);
+    const auto expected0 = std::vector<int>{0, 1000, 2000};
+    const auto expected1 = std::vector<int>{1000, 2000, 3000, 4000};
+    const auto sent0 = getSentTilesX(frames[0]);
+    const auto sent1 = getSentTilesX(frames[1]);
+    BOOST_CHECK_EQUAL_COLLECTIONS(sent0.begin(), sent0.end(), expected0.begin(),
+                                  expected0.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(sent1.begin(), sent1.end(), expected1.begin(),
+                                  expected1.end());
+}
+
+BOOST_AUTO_TEST_CASE(testNoTilesAreSentForStreamWithoutWindow)
+{
+    const auto config = makeConfig();
+    const auto scene = Scene::create(config.surfaces);
+
+    PixelStreamRouter router(config);
+    const auto frames = router.split(makeFrame(), *scene);
+
+    BOOST_REQUIRE_EQUAL(frames.size(), 2);
+    BOOST_CHECK(getSentTilesX(frames[0]).empty());
+    BOOST_CHECK(getSentTilesX(frames[1]).empty());
+}
+
+BOOST_AUTO_TEST_CASE(testTilesOfOtherChannelsAreAlwaysSent)
+{
+    const auto config = makeConfig();
+    const auto scene = Scene::create(config.surfaces);
+
+    PixelStreamRouter router(config);
+    const auto frames = router.split(makeFrame(1), *scene);
+
+    BOOST_REQUIRE_EQUAL(frames.size(), 2);
+    BOOST_CHECK_EQUAL(getSentTilesX(frames[0]).size(), 8);
+    BOOST_CHECK_EQUAL(getSentTilesX(frames[1]).size(), 8);
+}
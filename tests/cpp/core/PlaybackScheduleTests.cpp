@@ -0,0 +1,156 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#define BOOST_TEST_MODULE PlaybackScheduleTests
+#include <boost/test/unit_test.hpp>
+
+#include "tools/PlaybackSchedule.h"
+
+namespace
+{
+using ms = std::chrono::milliseconds;
+using clock = PlaybackSchedule::clock;
+const auto start = clock::time_point{} + std::chrono::hours(1);
+const double duration = 10.0;
+const double frameDuration = 0.04;
+
+PlaybackSchedule makeSchedule()
+{
+    PlaybackSchedule schedule;
+    schedule.setTimeline(duration, frameDuration);
+    return schedule;
+}
+}
+
+BOOST_AUTO_TEST_CASE(schedule_starts_paused_at_the_beginning)
+{
+    const auto schedule = makeSchedule();
+    BOOST_CHECK(schedule.isPaused());
+    BOOST_CHECK_EQUAL(schedule.getTimestamp(start), 0.0);
+    BOOST_CHECK_EQUAL(schedule.getTimestamp(start + ms(500)), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(playing_follows_the_clock)
+{
+    auto schedule = makeSchedule();
+    schedule.play(start);
+    BOOST_CHECK(!schedule.isPaused());
+    BOOST_CHECK_CLOSE(schedule.getTimestamp(start + ms(500)), 0.5, 1e-6);
+    BOOST_CHECK_CLOSE(schedule.getTimestamp(start + ms(2500)), 2.5, 1e-6);
+
+    // play() while playing does not re-anchor the schedule
+    schedule.play(start + ms(1000));
+    BOOST_CHECK_CLOSE(schedule.getTimestamp(start + ms(2500)), 2.5, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(frame_timestamp_is_a_multiple_of_frame_duration)
+{
+    auto schedule = makeSchedule();
+    schedule.play(start);
+    BOOST_CHECK_EQUAL(schedule.getFrameTimestamp(start + ms(39)), 0.0);
+    BOOST_CHECK_CLOSE(schedule.getFrameTimestamp(start + ms(40)), 0.04, 1e-6);
+    BOOST_CHECK_CLOSE(schedule.getFrameTimestamp(start + ms(119)), 0.08, 1e-6);
+    BOOST_CHECK_CLOSE(schedule.getFrameTimestamp(start + ms(120)), 0.12, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(pause_freezes_and_play_resumes_from_the_same_timestamp)
+{
+    auto schedule = makeSchedule();
+    schedule.play(start);
+    schedule.pause(start + ms(1000));
+    BOOST_CHECK(schedule.isPaused());
+    BOOST_CHECK_CLOSE(schedule.getTimestamp(start + ms(5000)), 1.0, 1e-6);
+
+    schedule.play(start + ms(5000));
+    BOOST_CHECK_CLOSE(schedule.getTimestamp(start + ms(5500)), 1.5, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(seek_keeps_play_state)
+{
+    auto schedule = makeSchedule();
+    schedule.seek(4.0, start);
+    BOOST_CHECK(schedule.isPaused());
+    BOOST_CHECK_CLOSE(schedule.getTimestamp(start + ms(1000)), 4.0, 1e-6);
+
+    schedule.play(start);
+    schedule.seek(2.0, start + ms(1000));
+    BOOST_CHECK(!schedule.isPaused());
+    BOOST_CHECK_CLOSE(schedule.getTimestamp(start + ms(1500)), 2.5, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(looping_wraps_around_and_non_looping_stops_at_last_frame)
+{
+    auto schedule = makeSchedule();
+    schedule.play(start);
+    BOOST_CHECK_CLOSE(schedule.getTimestamp(start + ms(12000)), 2.0, 1e-6);
+
+    schedule.setLoop(false);
+    BOOST_CHECK_CLOSE(schedule.getTimestamp(start + ms(12000)),
+                      duration - frameDuration, 1e-6);
+    BOOST_CHECK_CLOSE(schedule.getFrameTimestamp(start + ms(12000)),
+                      duration - frameDuration, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(rate_change_is_effective_from_now)
+{
+    auto schedule = makeSchedule();
+    schedule.play(start);
+    schedule.setRate(2.0, start + ms(1000));
+    BOOST_CHECK_EQUAL(schedule.getRate(), 2.0);
+    BOOST_CHECK_CLOSE(schedule.getTimestamp(start + ms(1000)), 1.0, 1e-6);
+    BOOST_CHECK_CLOSE(schedule.getTimestamp(start + ms(2000)), 3.0, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(schedules_anchored_identically_select_the_same_frames)
+{
+    auto first = makeSchedule();
+    auto second = makeSchedule();
+    first.play(start);
+    second.play(start);
+    first.pause(start + ms(777));
+    second.pause(start + ms(777));
+    first.play(start + ms(900));
+    second.play(start + ms(900));
+
+    for (int i = 0; i < 600; ++i)
+    {
+        const auto now = start + ms(900 + i * 16);
+        BOOST_CHECK_EQUAL(first.getFrameTimestamp(now),
+                          second.getFrameTimestamp(now));
+    }
+}
@@ -0,0 +1,178 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#define BOOST_TEST_MODULE ScreenDamageTests
+#include <boost/test/unit_test.hpp>
+
+#include "scene/Background.h"
+#include "scene/ContextMenu.h"
+#include "scene/DisplayGroup.h"
+#include "scene/Markers.h"
+#include "scene/Surface.h"
+#include "scene/Window.h"
+#include "serialization/utils.h"
+#include "tools/ScreenDamage.h"
+
+#include "DummyContent.h"
+
+namespace
+{
+const QSize surfaceSize(4000, 1000);
+const QSize size(200, 200);
+const QRect leftScreen(0, 0, 1000, 1000);
+const QRect rightScreen(3000, 0, 1000, 1000);
+
+WindowPtr makeWindow(const QPointF& position)
+{
+    auto window =
+        std::make_shared<Window>(std::make_unique<DummyContent>(size));
+    window->setCoordinates(QRectF(position, size));
+    return window;
+}
+}
+
+struct Fixture
+{
+    Fixture()
+    {
+        surface->getGroup().add(leftWindow);
+        surface->getGroup().add(rightWindow);
+    }
+
+    SurfacePtr copy() const { return serialization::binaryCopy(surface); }
+    SurfacePtr surface{new Surface{0, DisplayGroup::create(surfaceSize)}};
+    WindowPtr leftWindow = makeWindow(QPointF(100, 100));
+    WindowPtr rightWindow = makeWindow(QPointF(3500, 100));
+    ScreenDamage left{leftScreen};
+    ScreenDamage right{rightScreen};
+};
+
+BOOST_FIXTURE_TEST_CASE(unchanged_surface_does_not_damage_screens, Fixture)
+{
+    const auto previous = copy();
+    const auto next = copy();
+    BOOST_CHECK(!left.isDamaged(*previous, *next));
+    BOOST_CHECK(!right.isDamaged(*previous, *next));
+}
+
+BOOST_FIXTURE_TEST_CASE(moving_window_damages_only_its_screen, Fixture)
+{
+    const auto previous = copy();
+    rightWindow->setCoordinates(QRectF(QPointF(3600, 200), size));
+    const auto next = copy();
+
+    BOOST_CHECK(!left.isDamaged(*previous, *next));
+    BOOST_CHECK(right.isDamaged(*previous, *next));
+}
+
+BOOST_FIXTURE_TEST_CASE(moving_window_across_screens_damages_both, Fixture)
+{
+    const auto previous = copy();
+    leftWindow->setCoordinates(QRectF(QPointF(3200, 600), size));
+    const auto next = copy();
+
+    BOOST_CHECK(left.isDamaged(*previous, *next));
+    BOOST_CHECK(right.isDamaged(*previous, *next));
+}
+
+BOOST_FIXTURE_TEST_CASE(window_decorations_damage_neighbour_screen, Fixture)
+{
+    const auto previous = copy();
+    rightWindow->setCoordinates(QRectF(QPointF(2900, 100), size));
+    const auto next = copy();
+
+    BOOST_CHECK(!left.isDamaged(*previous, *next));
+    BOOST_CHECK(right.isDamaged(*previous, *next));
+
+    rightWindow->setCoordinates(QRectF(QPointF(1150, 100), size));
+    BOOST_CHECK(left.isDamaged(*next, *copy()));
+}
+
+BOOST_FIXTURE_TEST_CASE(adding_and_removing_windows, Fixture)
+{
+    const auto previous = copy();
+    surface->getGroup().add(makeWindow(QPointF(3100, 500)));
+    const auto next = copy();
+
+    BOOST_CHECK(!left.isDamaged(*previous, *next));
+    BOOST_CHECK(right.isDamaged(*previous, *next));
+
+    surface->getGroup().remove(leftWindow);
+    const auto last = copy();
+    BOOST_CHECK(left.isDamaged(*next, *last));
+    BOOST_CHECK(!right.isDamaged(*next, *last));
+}
+
+BOOST_FIXTURE_TEST_CASE(stack_order_change_damages_screens_of_windows, Fixture)
+{
+    const auto previous = copy();
+    surface->getGroup().moveToFront(leftWindow);
+    const auto next = copy();
+
+    BOOST_CHECK(left.isDamaged(*previous, *next));
+    BOOST_CHECK(right.isDamaged(*previous, *next));
+}
+
+BOOST_FIXTURE_TEST_CASE(background_and_context_menu_damage_all, Fixture)
+{
+    const auto previous = copy();
+    surface->getBackground().setColor(Qt::red);
+    const auto next = copy();
+    BOOST_CHECK(left.isDamaged(*previous, *next));
+    BOOST_CHECK(right.isDamaged(*previous, *next));
+
+    surface->getContextMenu().setVisible(true);
+    const auto last = copy();
+    BOOST_CHECK(left.isDamaged(*next, *last));
+    BOOST_CHECK(right.isDamaged(*next, *last));
+}
+
+BOOST_AUTO_TEST_CASE(markers_damage_only_their_screen)
+{
+    const auto left = ScreenDamage{leftScreen};
+    const auto right = ScreenDamage{rightScreen};
+
+    const auto noMarkers = Markers::create(0);
+    const auto markers = Markers::create(0);
+    markers->addMarker(0, QPointF(3500, 500));
+
+    BOOST_CHECK(!left.isDamaged(*noMarkers, *markers));
+    BOOST_CHECK(right.isDamaged(*noMarkers, *markers));
+    BOOST_CHECK(right.isDamaged(*markers, *noMarkers));
+    BOOST_CHECK(!right.isDamaged(*noMarkers, *noMarkers));
+}
@@ -0,0 +1,164 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#define BOOST_TEST_MODULE SharedTileCacheTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "data/QtImage.h"
+#include "tools/SharedTileCache.h"
+
+#include "MinimalGlobalQtApp.h"
+
+#include <QUuid>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+BOOST_GLOBAL_FIXTURE(MinimalGlobalQtApp);
+
+namespace
+{
+const QSize tileSize{64, 32};
+
+QString _uniqueKey(const uint tileId = 0,
+                   const deflect::View view = deflect::View::mono)
+{
+    // Unique uri per test so that leftover tiles can not interfere
+    static const auto uri = QUuid::createUuid().toString();
+    return SharedTileCache::makeKey(uri, tileSize, tileId, view);
+}
+
+ImagePtr _createTile(const QColor& color)
+{
+    auto image = QImage{tileSize, QImage::Format_ARGB32};
+    image.fill(color);
+    return std::make_shared<QtImage>(image);
+}
+}
+
+BOOST_AUTO_TEST_CASE(testKeyIdentifiesTileAndView)
+{
+    BOOST_CHECK_EQUAL(_uniqueKey(3), _uniqueKey(3));
+    BOOST_CHECK_NE(_uniqueKey(3), _uniqueKey(4));
+    BOOST_CHECK_NE(_uniqueKey(3, deflect::View::left_eye),
+                   _uniqueKey(3, deflect::View::right_eye));
+    const auto mono = deflect::View::mono;
+    BOOST_CHECK_NE(SharedTileCache::makeKey("a", tileSize, 0, mono),
+                   SharedTileCache::makeKey("a", tileSize * 2, 0, mono));
+}
+
+BOOST_AUTO_TEST_CASE(testTileIsDecodedOnceAndShared)
+{
+    const auto key = _uniqueKey(1);
+    auto decodeCount = 0;
+    const auto decode = [&decodeCount] {
+        ++decodeCount;
+        return _createTile(Qt::red);
+    };
+
+    const auto first = SharedTileCache::getTile(key, decode);
+    const auto second = SharedTileCache::getTile(key, decode);
+    BOOST_CHECK_EQUAL(decodeCount, 1);
+
+    const auto reference = _createTile(Qt::red);
+    BOOST_CHECK_EQUAL(second->getWidth(), tileSize.width());
+    BOOST_CHECK_EQUAL(second->getHeight(), tileSize.height());
+    BOOST_CHECK_EQUAL(second->getViewPort(), reference->getViewPort());
+    BOOST_CHECK(second->getFormat() == TextureFormat::rgba);
+    BOOST_CHECK_EQUAL(second->getGLPixelFormat(),
+                      reference->getGLPixelFormat());
+    BOOST_REQUIRE_EQUAL(second->getDataSize(), reference->getDataSize());
+    BOOST_CHECK(std::equal(second->getData(),
+                           second->getData() + second->getDataSize(),
+                           reference->getData()));
+    BOOST_CHECK(!second->getData(1));
+    BOOST_CHECK_EQUAL(second->getDataSize(1), 0);
+}
+
+BOOST_AUTO_TEST_CASE(testConcurrentRequestsWaitForTheDecodedTile)
+{
+    const auto key = _uniqueKey(4);
+    std::atomic<int> decodeCount{0};
+    const auto decode = [&decodeCount] {
+        ++decodeCount;
+        std::this_thread::sleep_for(std::chrono::milliseconds{200});
+        return _createTile(Qt::yellow);
+    };
+
+    ImagePtr first;
+    ImagePtr second;
+    std::thread thread{[&] { first = SharedTileCache::getTile(key, decode); }};
+    second = SharedTileCache::getTile(key, decode);
+    thread.join();
+
+    BOOST_CHECK_EQUAL(decodeCount, 1);
+    BOOST_REQUIRE(first && second);
+    BOOST_CHECK(first->getData() == second->getData());
+}
+
+BOOST_AUTO_TEST_CASE(testTileIsReleasedWithItsLastUser)
+{
+    const auto key = _uniqueKey(2);
+    auto decodeCount = 0;
+    const auto decode = [&decodeCount] {
+        ++decodeCount;
+        return _createTile(Qt::green);
+    };
+
+    SharedTileCache::getTile(key, decode);
+    SharedTileCache::getTile(key, decode);
+    BOOST_CHECK_EQUAL(decodeCount, 2);
+}
+
+BOOST_AUTO_TEST_CASE(testDecodeErrorReleasesClaim)
+{
+    const auto key = _uniqueKey(3);
+    BOOST_CHECK_THROW(SharedTileCache::getTile(
+                          key,
+                          []() -> ImagePtr {
+                              throw std::runtime_error("decode error");
+                          }),
+                      std::runtime_error);
+
+    const auto tile = SharedTileCache::getTile(key, [] {
+        return _createTile(Qt::blue);
+    });
+    BOOST_CHECK_EQUAL(tile->getWidth(), tileSize.width());
+}
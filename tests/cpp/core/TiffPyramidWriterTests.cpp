@@ -0,0 +1,192 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#define BOOST_TEST_MODULE TiffPyramidWriterTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "data/TiffPyramidReader.h"
+#include "data/TiffPyramidWriter.h"
+
+#include "MinimalGlobalQtApp.h"
+
+#include <QTemporaryDir>
+
+BOOST_GLOBAL_FIXTURE(MinimalGlobalQtApp);
+
+namespace
+{
+const QSize imageSize{1000, 600};
+const QSize tileSize{256, 256};
+const QColor color{200, 100, 50};
+
+TiffPyramidWriter::ReadStripFunc _makeUniformImage(const QColor& fill)
+{
+    return [fill](const int, const int height) {
+        auto strip = QImage(imageSize.width(), height, QImage::Format_ARGB32);
+        strip.fill(fill);
+        return strip;
+    };
+}
+
+TiffPyramidWriter::Options _makeOptions(const TiffPyramidWriter::Codec codec)
+{
+    auto options = TiffPyramidWriter::Options();
+    options.tileSize = tileSize;
+    options.codec = codec;
+    return options;
+}
+
+bool _isClose(const QColor& a, const QColor& b, const int tolerance)
+{
+    return std::abs(a.red() - b.red()) <= tolerance &&
+           std::abs(a.green() - b.green()) <= tolerance &&
+           std::abs(a.blue() - b.blue()) <= tolerance;
+}
+}
+
+BOOST_AUTO_TEST_CASE(testLevelCount)
+{
+    BOOST_CHECK_EQUAL(TiffPyramidWriter::getLevelCount({512, 512}, tileSize),
+                      2);
+    BOOST_CHECK_EQUAL(TiffPyramidWriter::getLevelCount({256, 256}, tileSize),
+                      1);
+    BOOST_CHECK_EQUAL(TiffPyramidWriter::getLevelCount({100, 1025}, tileSize),
+                      4);
+    BOOST_CHECK_EQUAL(TiffPyramidWriter::getLevelCount(imageSize, tileSize), 3);
+}
+
+BOOST_AUTO_TEST_CASE(testInvalidOptions)
+{
+    auto options = TiffPyramidWriter::Options();
+    options.tileSize = QSize(100, 100);
+    BOOST_CHECK_THROW(TiffPyramidWriter{options}, std::invalid_argument);
+
+    options = TiffPyramidWriter::Options();
+    options.quality = 101;
+    BOOST_CHECK_THROW(TiffPyramidWriter{options}, std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(testWrittenPyramidCanBeReadForAllCodecs)
+{
+    using Codec = TiffPyramidWriter::Codec;
+    QTemporaryDir dir;
+    const auto filename = dir.filePath("pyramid.tif");
+
+    for (const auto codec : {Codec::jpeg, Codec::deflate, Codec::none})
+    {
+        const auto writer = TiffPyramidWriter{_makeOptions(codec)};
+        writer.write(imageSize, false, _makeUniformImage(color), filename);
+
+        TiffPyramidReader reader{filename};
+        BOOST_CHECK_EQUAL(reader.getImageSize(), imageSize);
+        BOOST_CHECK_EQUAL(reader.getTileSize(), tileSize);
+        BOOST_CHECK_EQUAL(reader.getBytesPerPixel(), 3);
+        BOOST_CHECK_EQUAL(reader.findTopPyramidLevel(), 2);
+        BOOST_CHECK_EQUAL(reader.readSize(1), QSize(500, 300));
+        BOOST_CHECK_EQUAL(reader.readSize(2), QSize(250, 150));
+
+        const auto tolerance = codec == Codec::jpeg ? 3 : 0;
+        const auto tile = reader.readTile(1, 1, 0);
+        BOOST_REQUIRE_EQUAL(tile.size(), tileSize);
+        BOOST_CHECK(_isClose(tile.pixelColor(10, 10), color, tolerance));
+
+        const auto top = reader.readTopLevelImage();
+        BOOST_REQUIRE_EQUAL(top.size(), QSize(250, 150));
+        BOOST_CHECK(_isClose(top.pixelColor(125, 75), color, tolerance));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testImageWithAlphaUsesLosslessCompression)
+{
+    QTemporaryDir dir;
+    const auto filename = dir.filePath("pyramid.tif");
+    const auto transparent = QColor{0, 0, 255, 128};
+
+    auto options = _makeOptions(TiffPyramidWriter::Codec::jpeg);
+    TiffPyramidWriter{options}.write(imageSize, true,
+                                     _makeUniformImage(transparent), filename);
+
+    TiffPyramidReader reader{filename};
+    BOOST_CHECK_EQUAL(reader.getBytesPerPixel(), 4);
+    BOOST_CHECK(reader.hasAlphaChannel());
+
+    const auto pixel = reader.readTile(0, 0, 1).pixelColor(0, 0);
+    BOOST_CHECK(_isClose(pixel, transparent, 1));
+    BOOST_CHECK_LE(std::abs(pixel.alpha() - transparent.alpha()), 1);
+}
+
+BOOST_AUTO_TEST_CASE(testProgressIsReportedForEachStrip)
+{
+    QTemporaryDir dir;
+    const auto options = _makeOptions(TiffPyramidWriter::Codec::none);
+    auto writer = TiffPyramidWriter{options};
+
+    std::vector<double> progress;
+    writer.setProgressCallback(
+        [&progress](const double value) { progress.push_back(value); });
+    writer.write(imageSize, false, _makeUniformImage(color),
+                 dir.filePath("pyramid.tif"));
+
+    BOOST_REQUIRE_EQUAL(progress.size(), 3); // ceil(600 / 256)
+    BOOST_CHECK_EQUAL(progress.back(), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(testReadCompressedJpegTiles)
+{
+    using Codec = TiffPyramidWriter::Codec;
+    QTemporaryDir dir;
+    const auto jpegFile = dir.filePath("jpeg.tif");
+    const auto deflateFile = dir.filePath("deflate.tif");
+    TiffPyramidWriter{_makeOptions(Codec::jpeg)}.write(
+        imageSize, false, _makeUniformImage(color), jpegFile);
+    TiffPyramidWriter{_makeOptions(Codec::deflate)}.write(
+        imageSize, false, _makeUniformImage(color), deflateFile);
+
+    TiffPyramidReader jpegReader{jpegFile};
+    const auto data = jpegReader.readJpegTile(3, 2, 0);
+    BOOST_REQUIRE(data.startsWith("\xFF\xD8"));
+
+    // Padded tiles have the full tile size
+    const auto tile = QImage::fromData(data, "JPG");
+    BOOST_REQUIRE_EQUAL(tile.size(), tileSize);
+    BOOST_CHECK(_isClose(tile.pixelColor(10, 10), color, 3));
+
+    BOOST_CHECK(jpegReader.readJpegTile(4, 0, 0).isEmpty()); // out of range
+    BOOST_CHECK(TiffPyramidReader{deflateFile}.readJpegTile(0, 0, 0).isEmpty());
+}
@@ -46,6 +46,8 @@
 
 #include "DummyContent.h"
 
+#include <chrono>
+
 namespace
 {
 const QSize groupSize(800, 600);
@@ -76,9 +78,14 @@ struct Fixture
                             QRectF(QPointF(0, 0), size));
     }
 
+    // Like the wall, use a new helper for each state of the group
+    VisibilityHelper helper() const
+    {
+        return {*group, viewRect, alphaBlending};
+    }
+
     DisplayGroupPtr group{DisplayGroup::create(groupSize)};
     WindowPtr window{new Window{makeDummyContent()}};
-    VisibilityHelper helper{*group, viewRect, alphaBlending};
 };
 
 BOOST_FIXTURE_TEST_CASE(testSingleWindow, Fixture)
@@ -86,34 +93,34 @@ BOOST_FIXTURE_TEST_CASE(testSingleWindow, Fixture)
     const auto& coord = window->getCoordinates();
 
     // Fully inside
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), coord);
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window), coord);
 
     // Fully outside
     window->setCoordinates(QRectF(QPointF(400, 0), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), QRectF());
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window), QRectF());
 
     // Half-inside horizontally
     window->setCoordinates(QRectF(QPointF(300, 0), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window),
                       QRectF(QPointF(0, 0), QSize(100, 200)));
 
     window->setCoordinates(QRectF(QPointF(-100, 0), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window),
                       QRectF(QPointF(100, 0), QSize(100, 200)));
 
     // Half-inside vertically, bottom cut
     window->setCoordinates(QRectF(QPointF(0, 500), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window),
                       QRectF(QPointF(0, 0), QSize(200, 100)));
 
     // Half-inside vertically, top cut
     window->setCoordinates(QRectF(QPointF(0, -100), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window),
                       QRectF(QPointF(0, 100), QSize(200, 100)));
 
     // Corner view cut
     window->setCoordinates(QRectF(QPointF(300, 500), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window),
                       QRectF(QPointF(0, 0), QSize(100, 100)));
 }
 
@@ -130,33 +137,33 @@ BOOST_FIXTURE_TEST_CASE(testSingleWindowCenteredViewRect, Fixture)
 BOOST_FIXTURE_TEST_CASE(testOverlappingWindow, Fixture)
 {
     const auto& coord = window->getCoordinates();
-    BOOST_REQUIRE_EQUAL(helper.getVisibleArea(*window), coord);
+    BOOST_REQUIRE_EQUAL(helper().getVisibleArea(*window), coord);
 
     auto otherWindow = std::make_shared<Window>(makeDummyContent());
     group->add(otherWindow);
 
     // Full overlap
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), QRectF());
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window), QRectF());
 
     // Focused
     window->setFocusedCoordinates(coord);
     window->setMode(Window::WindowMode::FOCUSED);
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), coord);
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window), coord);
     window->setMode(Window::WindowMode::STANDARD);
 
     // Half-above horizonally
     otherWindow->setCoordinates(QRectF(QPointF(100, 0), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window),
                       QRectF(QPointF(0, 0), QSize(100, 200)));
 
     // Half-above vertically
     otherWindow->setCoordinates(QRectF(QPointF(0, 100), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window),
                       QRectF(QPointF(0, 0), QSize(200, 100)));
 
     // Corner overlap (no cut)
     otherWindow->setCoordinates(QRectF(QPointF(100, 100), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window),
                       QRectF(QPointF(0, 0), QSize(200, 200)));
 }
 
@@ -166,34 +173,36 @@ BOOST_FIXTURE_TEST_CASE(testUnderlyingWindow, Fixture)
 
     auto otherWindow = std::make_shared<Window>(makeDummyContent());
     group->add(otherWindow);
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), QRectF());
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*otherWindow), coord);
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window), QRectF());
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*otherWindow), coord);
 
     group->moveToFront(window);
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*otherWindow), QRectF());
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), coord);
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*otherWindow), QRectF());
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window), coord);
 }
 
 BOOST_FIXTURE_TEST_CASE(transparentWindowDoesNotObstructWhenAlphaBlendingIsOn,
                         Fixture)
 {
-    auto alphaHelper = VisibilityHelper{*group, viewRect, true};
+    const auto alphaHelper = [this] {
+        return VisibilityHelper{*group, viewRect, true};
+    };
     const auto& coord = window->getCoordinates();
 
     auto transparentWindow = std::make_shared<Window>(makeTransparentContent());
     group->add(transparentWindow);
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*transparentWindow), coord);
-    BOOST_CHECK(helper.getVisibleArea(*window).isEmpty());
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*transparentWindow), coord);
+    BOOST_CHECK(helper().getVisibleArea(*window).isEmpty());
 
-    BOOST_CHECK_EQUAL(alphaHelper.getVisibleArea(*transparentWindow), coord);
-    BOOST_CHECK_EQUAL(alphaHelper.getVisibleArea(*window), coord);
+    BOOST_CHECK_EQUAL(alphaHelper().getVisibleArea(*transparentWindow), coord);
+    BOOST_CHECK_EQUAL(alphaHelper().getVisibleArea(*window), coord);
 
     group->moveToFront(window);
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), coord);
-    BOOST_CHECK(helper.getVisibleArea(*transparentWindow).isEmpty());
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window), coord);
+    BOOST_CHECK(helper().getVisibleArea(*transparentWindow).isEmpty());
 
-    BOOST_CHECK_EQUAL(alphaHelper.getVisibleArea(*window), coord);
-    BOOST_CHECK(alphaHelper.getVisibleArea(*transparentWindow).isEmpty());
+    BOOST_CHECK_EQUAL(alphaHelper().getVisibleArea(*window), coord);
+    BOOST_CHECK(alphaHelper().getVisibleArea(*transparentWindow).isEmpty());
 }
 
 BOOST_FIXTURE_TEST_CASE(testViewCutCombinedWithOverlappingWindow, Fixture)
@@ -203,17 +212,17 @@ BOOST_FIXTURE_TEST_CASE(testViewCutCombinedWithOverlappingWindow, Fixture)
 
     // Corner view cut
     window->setCoordinates(QRectF(QPointF(300, 500), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window),
                       QRectF(QPointF(0, 0), QSize(100, 100)));
 
     // Partial corner overlap (no cut)
     otherWindow->setCoordinates(QRectF(QPointF(150, 350), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window),
                       QRectF(QPointF(0, 0), QSize(100, 100)));
 
     // Full corner overlap
     otherWindow->setCoordinates(QRectF(QPointF(200, 400), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), QRectF());
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window), QRectF());
 }
 
 BOOST_FIXTURE_TEST_CASE(testFullscreenWindowOverlapEverything, Fixture)
@@ -222,23 +231,23 @@ BOOST_FIXTURE_TEST_CASE(testFullscreenWindowOverlapEverything, Fixture)
 
     auto otherWindow = std::make_shared<Window>(makeDummyContent());
     group->add(otherWindow);
-    BOOST_REQUIRE_EQUAL(helper.getVisibleArea(*window), QRectF());
-    BOOST_REQUIRE_EQUAL(helper.getVisibleArea(*otherWindow), coord);
+    BOOST_REQUIRE_EQUAL(helper().getVisibleArea(*window), QRectF());
+    BOOST_REQUIRE_EQUAL(helper().getVisibleArea(*otherWindow), coord);
 
     // Even a "small" fullscreen window should overlap everything...
     window->setMode(Window::WindowMode::FULLSCREEN);
     group->setFullscreenWindow(window);
     const QRectF fullscreen(QPointF(), window->getCoordinates().size() / 2);
     window->setFullscreenCoordinates(fullscreen);
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*otherWindow), QRectF());
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), fullscreen);
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*otherWindow), QRectF());
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window), fullscreen);
 
     // ...including focused windows
     auto focusWindow = std::make_shared<Window>(makeDummyContent());
     group->add(focusWindow);
     group->addFocusedWindow(focusWindow);
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*focusWindow), QRectF());
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), fullscreen);
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*focusWindow), QRectF());
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window), fullscreen);
 }
 
 BOOST_FIXTURE_TEST_CASE(testHiddenWindowNotObstructingOthers, Fixture)
@@ -248,9 +257,103 @@ BOOST_FIXTURE_TEST_CASE(testHiddenWindowNotObstructingOthers, Fixture)
     auto otherWindow = std::make_shared<Window>(makeDummyContent());
     group->add(otherWindow);
     otherWindow->setState(Window::WindowState::HIDDEN);
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), coord);
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window), coord);
 
     otherWindow->setState(Window::WindowState::NONE);
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), QRectF());
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*otherWindow), coord);
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window), QRectF());
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*otherWindow), coord);
+}
+
+BOOST_FIXTURE_TEST_CASE(testRemovedWindowNotObstructingOthers, Fixture)
+{
+    const auto& coord = window->getCoordinates();
+
+    auto otherWindow = std::make_shared<Window>(makeDummyContent());
+    group->add(otherWindow);
+    BOOST_REQUIRE_EQUAL(helper().getVisibleArea(*window), QRectF());
+
+    group->remove(otherWindow);
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window), coord);
+
+    group->add(otherWindow);
+    otherWindow->setCoordinates(QRectF(QPointF(0, 100), size));
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window),
+                      QRectF(QPointF(0, 0), QSize(200, 100)));
+}
+
+BOOST_FIXTURE_TEST_CASE(testWindowPartiallyOutsideOfGroup, Fixture)
+{
+    auto otherWindow = std::make_shared<Window>(makeDummyContent());
+    group->add(otherWindow);
+
+    otherWindow->setCoordinates(QRectF(QPointF(-100, 0), size));
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*window),
+                      QRectF(QPointF(100, 0), QSize(100, 200)));
+
+    const QRect largeViewRect(-200, -200, 1000, 1000);
+    VisibilityHelper largeViewRectHelper(*group, largeViewRect, alphaBlending);
+    BOOST_CHECK_EQUAL(largeViewRectHelper.getVisibleArea(*otherWindow),
+                      QRectF(QPointF(0, 0), size));
+    BOOST_CHECK_EQUAL(largeViewRectHelper.getVisibleArea(*window),
+                      QRectF(QPointF(100, 0), QSize(100, 200)));
+}
+
+BOOST_AUTO_TEST_CASE(benchmarkVisibleAreaOfManyWindows)
+{
+    // A 4x2 wall of 4K screens with 40x10 overlapping windows
+    const QSize wallSize(15360, 4320);
+    const QRect wallRect(QPoint(), wallSize);
+    const QSizeF step(wallSize.width() / 40.0, wallSize.height() / 10.0);
+
+    auto group = DisplayGroup::create(wallSize);
+
+    auto windows = WindowPtrs{};
+    for (auto y = 0; y < 10; ++y)
+    {
+        for (auto x = 0; x < 40; ++x)
+        {
+            auto window = std::make_shared<Window>(makeDummyContent());
+            window->setCoordinates(QRectF(QPointF(x * step.width(),
+                                                  y * step.height()),
+                                          step * 1.5));
+            group->add(window);
+            windows.push_back(window);
+        }
+    }
+
+    // Each scene update creates a helper and queries all the windows
+    const auto helper = [&] {
+        return VisibilityHelper{*group, wallRect, alphaBlending};
+    };
+    const auto iterations = 10;
+    const auto start = std::chrono::steady_clock::now();
+    auto visibleWindows = size_t{0};
+    for (auto i = 0; i < iterations; ++i)
+    {
+        const auto updateHelper = helper();
+        for (const auto& window : windows)
+            visibleWindows += !updateHelper.getVisibleArea(*window).isEmpty();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const auto queries = iterations * windows.size();
+    const auto elapsedUs =
+        std::chrono::duration<double, std::micro>(elapsed).count();
+    BOOST_TEST_MESSAGE("VisibilityHelper with "
+                       << windows.size() << " windows: "
+                       << elapsedUs / iterations << " us per scene update, "
+                       << elapsedUs / queries << " us per window");
+
+    BOOST_CHECK_EQUAL(visibleWindows, queries);
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*windows.back()),
+                      QRectF(QPointF(), step));
+
+    // Moves and stacking order changes are taken into account
+    group->moveToFront(windows.front());
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*windows.front()),
+                      QRectF(QPointF(), step * 1.5));
+    windows.back()->setCoordinates(windows.front()->getCoordinates());
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*windows.front()),
+                      QRectF(QPointF(), step * 1.5));
+    group->moveToFront(windows.back());
+    BOOST_CHECK_EQUAL(helper().getVisibleArea(*windows.front()), QRectF());
 }
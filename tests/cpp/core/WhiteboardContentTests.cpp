@@ -0,0 +1,249 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#define BOOST_TEST_MODULE WhiteboardContentTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "control/WhiteboardController.h"
+#include "scene/WhiteboardContent.h"
+#include "scene/Window.h"
+#include "serialization/utils.h"
+
+namespace
+{
+const QSize size{400, 200};
+const QString red = QColor{Qt::red}.name();
+const QString blue = QColor{Qt::blue}.name();
+const QString white = QColor{Qt::white}.name();
+
+std::shared_ptr<WhiteboardContent> makeWhiteboardWithStrokes()
+{
+    auto whiteboard = std::make_shared<WhiteboardContent>("Whiteboard0", size);
+    whiteboard->setBrushColor(Qt::red);
+    whiteboard->setBrushSize(10.0);
+    const auto index = whiteboard->beginStroke({10.0, 20.0});
+    whiteboard->extendStroke(index, {50.0, 60.0});
+    whiteboard->extendStroke(index, {90.0, 20.0});
+    return whiteboard;
+}
+
+void checkStrokes(const WhiteboardContent& whiteboard)
+{
+    BOOST_REQUIRE_EQUAL(whiteboard.getStrokeCount(), 1);
+    const auto& stroke = whiteboard.getStrokes()[0];
+    BOOST_CHECK_EQUAL(stroke.color.name(), red);
+    BOOST_CHECK_EQUAL(stroke.width, 10.0);
+    BOOST_REQUIRE_EQUAL(stroke.points.size(), 3);
+    BOOST_CHECK_EQUAL(stroke.points[1], QPointF(50.0, 60.0));
+}
+}
+
+BOOST_AUTO_TEST_CASE(testDefaultState)
+{
+    const WhiteboardContent whiteboard{"Whiteboard0", size};
+
+    BOOST_CHECK_EQUAL(whiteboard.getType(), ContentType::whiteboard);
+    BOOST_CHECK_EQUAL(whiteboard.getUri(), "Whiteboard0");
+    BOOST_CHECK_EQUAL(whiteboard.getDimensions(), size);
+    BOOST_CHECK_EQUAL(whiteboard.getStrokeCount(), 0);
+    BOOST_CHECK(whiteboard.canBeZoomed());
+    BOOST_CHECK(whiteboard.getCaptureInteraction());
+    BOOST_CHECK(!contentTypeIsFile(whiteboard.getType()));
+}
+
+BOOST_AUTO_TEST_CASE(testStrokesUseCurrentBrush)
+{
+    const auto whiteboard = makeWhiteboardWithStrokes();
+    checkStrokes(*whiteboard);
+
+    whiteboard->setBrushColor(Qt::blue);
+    whiteboard->beginStroke({0.0, 0.0});
+    BOOST_REQUIRE_EQUAL(whiteboard->getStrokeCount(), 2);
+    const auto& strokes = whiteboard->getStrokes();
+    BOOST_CHECK_EQUAL(strokes[1].color.name(), blue);
+    BOOST_CHECK_EQUAL(strokes[0].color.name(), red);
+}
+
+BOOST_AUTO_TEST_CASE(testExtendInvalidStrokeIsIgnored)
+{
+    const auto whiteboard = makeWhiteboardWithStrokes();
+    whiteboard->extendStroke(5, {0.0, 0.0});
+    checkStrokes(*whiteboard);
+}
+
+BOOST_AUTO_TEST_CASE(testExtendStrokeSendsOnlyTheNewPoint)
+{
+    const auto whiteboard = makeWhiteboardWithStrokes();
+
+    size_t modified = 0;
+    WhiteboardStrokeUpdatePtr update;
+    QObject::connect(whiteboard.get(), &Content::modified,
+                     [&modified] { ++modified; });
+    QObject::connect(whiteboard.get(), &WhiteboardContent::strokeExtended,
+                     [&update](WhiteboardStrokeUpdatePtr update_) {
+                         update = update_;
+                     });
+
+    whiteboard->extendStroke(0, {120.0, 30.0});
+    BOOST_CHECK_EQUAL(modified, 0);
+    BOOST_REQUIRE(update);
+    BOOST_CHECK(update->whiteboardId == whiteboard->getId());
+    BOOST_CHECK_EQUAL(update->strokeIndex, 0);
+    BOOST_CHECK_EQUAL(update->offset, 3);
+    BOOST_REQUIRE_EQUAL(update->points.size(), 1);
+    BOOST_CHECK_EQUAL(update->points[0], QPointF(120.0, 30.0));
+
+    whiteboard->beginStroke({0.0, 0.0});
+    whiteboard->clear();
+    BOOST_CHECK_EQUAL(modified, 2);
+}
+
+BOOST_AUTO_TEST_CASE(testStrokeUpdateExtendsACopyOfTheStrokes)
+{
+    const auto whiteboard = makeWhiteboardWithStrokes();
+    auto strokes = whiteboard->getStrokes();
+
+    WhiteboardStrokeUpdatePtr update;
+    QObject::connect(whiteboard.get(), &WhiteboardContent::strokeExtended,
+                     [&update](WhiteboardStrokeUpdatePtr update_) {
+                         update = update_;
+                     });
+    whiteboard->extendStroke(0, {120.0, 30.0});
+
+    const auto copy = serialization::binaryCopy(update);
+    BOOST_REQUIRE(copy);
+    BOOST_CHECK(copy->applyTo(strokes));
+    BOOST_CHECK(strokes == whiteboard->getStrokes());
+
+    // Applying the same update again has no effect
+    BOOST_CHECK(copy->applyTo(strokes));
+    BOOST_CHECK(strokes == whiteboard->getStrokes());
+}
+
+BOOST_AUTO_TEST_CASE(testStrokeUpdateWithMissingPointsIsRejected)
+{
+    const auto whiteboard = makeWhiteboardWithStrokes();
+    auto strokes = whiteboard->getStrokes();
+
+    auto update = WhiteboardStrokeUpdate();
+    update.strokeIndex = 0;
+    update.offset = 4;
+    update.points = {{0.0, 0.0}};
+    BOOST_CHECK(!update.applyTo(strokes));
+
+    update.strokeIndex = 1;
+    update.offset = 0;
+    BOOST_CHECK(!update.applyTo(strokes));
+
+    BOOST_CHECK(strokes == whiteboard->getStrokes());
+}
+
+BOOST_AUTO_TEST_CASE(testClear)
+{
+    const auto whiteboard = makeWhiteboardWithStrokes();
+    whiteboard->clear();
+    BOOST_CHECK_EQUAL(whiteboard->getStrokeCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(testStrokeBoundingRectIncludesWidth)
+{
+    const auto whiteboard = makeWhiteboardWithStrokes();
+    const auto rect = whiteboard->getStrokes()[0].getBoundingRect();
+    BOOST_CHECK_EQUAL(rect, QRectF(5.0, 15.0, 90.0, 50.0));
+}
+
+BOOST_AUTO_TEST_CASE(testBinarySerialization)
+{
+    const auto copy = serialization::binaryCopy(makeWhiteboardWithStrokes());
+    BOOST_REQUIRE(copy);
+    checkStrokes(*copy);
+    BOOST_CHECK_EQUAL(copy->getBrushColor().name(), red);
+    BOOST_CHECK_EQUAL(copy->getBrushSize(), 10.0);
+}
+
+BOOST_AUTO_TEST_CASE(testXmlSerialization)
+{
+    const auto copy = serialization::xmlCopy(makeWhiteboardWithStrokes());
+    BOOST_REQUIRE(copy);
+    BOOST_CHECK_EQUAL(copy->getDimensions(), size);
+    checkStrokes(*copy);
+}
+
+BOOST_AUTO_TEST_CASE(testToImage)
+{
+    const auto whiteboard = makeWhiteboardWithStrokes();
+
+    const auto image = whiteboard->toImage();
+    BOOST_CHECK_EQUAL(image.size(), size);
+    BOOST_CHECK_EQUAL(QColor(image.pixel(30, 40)).name(), red);
+    BOOST_CHECK_EQUAL(QColor(image.pixel(300, 150)).name(), white);
+
+    const auto thumbnail = whiteboard->toImage({100, 50});
+    BOOST_CHECK_EQUAL(thumbnail.size(), QSize(100, 50));
+    BOOST_CHECK_NE(QColor(thumbnail.pixel(7, 9)).name(), white);
+}
+
+BOOST_AUTO_TEST_CASE(testControllerDrawsOneStrokePerTouchPoint)
+{
+    Window window{std::make_unique<WhiteboardContent>("Whiteboard0", size)};
+    window.setCoordinates({0.0, 0.0, 200.0, 100.0}); // half the content size
+    const auto& whiteboard =
+        static_cast<const WhiteboardContent&>(window.getContent());
+
+    WhiteboardController controller{window};
+    controller.addTouchPoint(0, {10.0, 10.0});
+    controller.addTouchPoint(1, {100.0, 50.0});
+    controller.updateTouchPoint(0, {20.0, 10.0});
+    controller.removeTouchPoint(0, {30.0, 10.0});
+    controller.removeTouchPoint(1, {100.0, 50.0});
+
+    BOOST_REQUIRE_EQUAL(whiteboard.getStrokeCount(), 2);
+    const auto& first = whiteboard.getStrokes()[0].points;
+    BOOST_REQUIRE_EQUAL(first.size(), 3);
+    BOOST_CHECK_EQUAL(first[0], QPointF(20.0, 20.0));
+    BOOST_CHECK_EQUAL(first[2], QPointF(60.0, 20.0));
+    BOOST_CHECK_EQUAL(whiteboard.getStrokes()[1].points.size(), 1);
+
+    // Points of released touches are ignored
+    controller.updateTouchPoint(0, {50.0, 50.0});
+    BOOST_CHECK_EQUAL(first.size(), 3);
+
+    controller.clear();
+    BOOST_CHECK_EQUAL(whiteboard.getStrokeCount(), 0);
+}
@@ -0,0 +1,114 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#define BOOST_TEST_MODULE MPIHierarchyTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "network/MPICommunicator.h"
+#include "network/MPIHierarchy.h"
+#include "network/MPISharedBuffer.h"
+
+#include <algorithm>
+#include <memory>
+
+// These tests are run under mpirun with various numbers of processes, see
+// TIDE_MPI_TEST_PROCESSES in tests/cpp/CMakeLists.txt.
+
+namespace
+{
+std::unique_ptr<MPICommunicator> communicator;
+}
+
+struct GlobalFixture
+{
+    GlobalFixture()
+    {
+        auto& suite = boost::unit_test::framework::master_test_suite();
+        communicator.reset(new MPICommunicator{suite.argc, suite.argv});
+    }
+    ~GlobalFixture() { communicator.reset(); }
+};
+
+BOOST_GLOBAL_FIXTURE(GlobalFixture);
+
+struct Fixture
+{
+    MPIHierarchy hierarchy{*communicator};
+    const int rank = communicator->getRank();
+    const int size = communicator->getSize();
+};
+
+BOOST_FIXTURE_TEST_CASE(testTopologyOfSingleHost, Fixture)
+{
+    BOOST_CHECK_EQUAL(hierarchy.getHostCount(), 1);
+    BOOST_CHECK_EQUAL(hierarchy.getHostSize(), size);
+    BOOST_CHECK_EQUAL(hierarchy.isHostLeader(), rank == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(testHierarchicalCollectives, Fixture)
+{
+    BOOST_CHECK_EQUAL(hierarchy.globalSum(1), size);
+    BOOST_CHECK_EQUAL(hierarchy.globalSum(rank), size * (size - 1) / 2);
+    BOOST_CHECK_EQUAL(hierarchy.globalMin(rank), 0);
+    BOOST_CHECK_EQUAL(hierarchy.globalMin(size - rank), 1);
+    hierarchy.globalBarrier();
+}
+
+BOOST_AUTO_TEST_CASE(testSharedBufferIsVisibleToAllProcesses)
+{
+    const MPICommunicator hostComm{*communicator, MPISplitType::host};
+    MPISharedBuffer buffer{hostComm};
+
+    for (size_t i = 1; i <= 4; ++i)
+    {
+        const auto size = i * i * 1000;
+        const auto value = char('a' + i);
+
+        buffer.synchronize();
+        buffer.setSize(size);
+        BOOST_REQUIRE_EQUAL(buffer.size(), size);
+        if (hostComm.getRank() == 0)
+            std::fill(buffer.data(), buffer.data() + size, value);
+        buffer.synchronize();
+
+        const auto count =
+            std::count(buffer.data(), buffer.data() + size, value);
+        BOOST_CHECK_EQUAL(size_t(count), size);
+    }
+}
@@ -0,0 +1,106 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#define BOOST_TEST_MODULE WallToWallChannelTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "network/MPICommunicator.h"
+#include "network/WallToWallChannel.h"
+
+#include <memory>
+
+// These tests are run under mpirun with various numbers of processes, see
+// TIDE_MPI_TEST_PROCESSES in tests/cpp/CMakeLists.txt.
+
+namespace
+{
+std::unique_ptr<MPICommunicator> communicator;
+}
+
+struct GlobalFixture
+{
+    GlobalFixture()
+    {
+        auto& suite = boost::unit_test::framework::master_test_suite();
+        communicator.reset(new MPICommunicator{suite.argc, suite.argv});
+    }
+    ~GlobalFixture() { communicator.reset(); }
+};
+
+BOOST_GLOBAL_FIXTURE(GlobalFixture);
+
+struct Fixture
+{
+    WallToWallChannel channel{*communicator};
+    const int rank = communicator->getRank();
+    const int size = communicator->getSize();
+};
+
+BOOST_FIXTURE_TEST_CASE(testNoCandidateElectsNoLeader, Fixture)
+{
+    BOOST_CHECK_EQUAL(channel.electLeader(false), -1);
+}
+
+BOOST_FIXTURE_TEST_CASE(testLowestRankedCandidateIsElected, Fixture)
+{
+    BOOST_CHECK_EQUAL(channel.electLeader(true), 0);
+    BOOST_CHECK_EQUAL(channel.electLeader(rank % 2 == 1), size > 1 ? 1 : -1);
+    BOOST_CHECK_EQUAL(channel.electLeader(rank >= size / 2), size / 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(testEachRankCanBeElectedAlone, Fixture)
+{
+    for (auto candidate = 0; candidate < size; ++candidate)
+        BOOST_CHECK_EQUAL(channel.electLeader(rank == candidate), candidate);
+}
+
+BOOST_FIXTURE_TEST_CASE(testRanksBeyond32CanBeElected, Fixture)
+{
+    // A bitmask of candidates in an int used to overflow past rank 31
+    BOOST_CHECK_EQUAL(channel.electLeader(rank == size - 1), size - 1);
+    if (size > 32)
+        BOOST_CHECK_EQUAL(channel.electLeader(rank >= 32), 32);
+}
+
+BOOST_FIXTURE_TEST_CASE(testCollectives, Fixture)
+{
+    BOOST_CHECK_EQUAL(channel.globalSum(1), size);
+    BOOST_CHECK(channel.allReady(true));
+    BOOST_CHECK(!channel.allReady(rank != size - 1));
+}
@@ -38,6 +38,7 @@
 /*********************************************************************/
 
 #include "network/MPICommunicator.h"
+#include "network/MPISharedBuffer.h"
 #include "network/ReceiveBuffer.h"
 #include "serialization/utils.h"
 #include "utils/CommandLineParser.h"
@@ -58,6 +59,14 @@
 // Time to send 100 objects: 3.445
 // Time per object: 0.03445
 // Throughput [Mbytes/sec]: 1741.66
+//
+// With --host-relay, only one process per host receives the data from the
+// network and shares it in memory with the others. The bytes received from the
+// network by each host and the bandwidth saved are reported in both modes:
+// mpirun -n 9 -H host1:4,host2:4,host3:1 ./tideBenchmarkMPI -s 60 -p 100 -r
+//
+// Host of rank 1: 4 processes, received from network [Mbytes]: 6000,
+// saved [Mbytes]: 18000, saved [Mbytes/sec]: 5224.96
 
 namespace
 {
@@ -90,12 +99,36 @@ public:
              "Size of each data packet [MB]")
             ("packets,p", po::value<size_t>()->default_value( 0u ),
              "number of packets to transmit")
+            ("host-relay,r", "receive once per host and share in memory")
         ;
         // clang-format on
     }
     size_t dataSize() const { return vm["datasize"].as<float>() * MEGABYTE; }
     size_t packetsCount() const { return vm["packets"].as<size_t>(); }
+    bool hostRelay() const { return vm.count("host-relay"); }
 };
+
+void printHostReport(const std::vector<uint64_t>& hostSizes,
+                     const size_t bytesPerProcess, const bool hostRelay,
+                     const float time)
+{
+    for (size_t rank = 0; rank < hostSizes.size(); ++rank)
+    {
+        const auto processes = hostSizes[rank];
+        if (processes == 0)
+            continue;
+
+        const auto received = hostRelay ? bytesPerProcess
+                                        : processes * bytesPerProcess;
+        const auto saved = processes * bytesPerProcess - received;
+        std::cout << "Host of rank " << rank << ": " << processes
+                  << " processes, received from network [Mbytes]: "
+                  << (float)received / MEGABYTE
+                  << ", saved [Mbytes]: " << (float)saved / MEGABYTE
+                  << ", saved [Mbytes/sec]: " << saved / time / MEGABYTE
+                  << std::endl;
+    }
+}
 }
 
 /**
@@ -106,6 +139,18 @@ int main(int argc, char** argv)
     COMMAND_LINE_PARSER_CHECK(BenchmarkOptions, "tideBenchmarkMPI");
 
     MPICommunicator mpiComm(argc, argv);
+    const auto isSender = mpiComm.getRank() == RANK0;
+
+    // The receivers are grouped by host, the sender is alone in its group.
+    // With the host relay, only the sender and one receiver per host take part
+    // in the broadcast of the payload.
+    MPICommunicator receiversComm(mpiComm, isSender ? 0 : 1);
+    MPICommunicator hostComm(receiversComm, MPISplitType::host);
+    const auto isHostLeader = !isSender && hostComm.getRank() == RANK0;
+    const auto hostRelay = commandLine.hostRelay();
+    const auto receivesPayload = isSender || isHostLeader || !hostRelay;
+    MPICommunicator payloadComm(mpiComm, receivesPayload ? 0 : 1);
+    MPISharedBuffer sharedBuffer(hostComm);
 
     // Send buffer
     std::vector<char> noiseBuffer(commandLine.dataSize());
@@ -123,18 +168,32 @@ int main(int argc, char** argv)
 
     while (counter < commandLine.packetsCount())
     {
-        if (mpiComm.getRank() == RANK0)
-            mpiComm.broadcast(MessageType::NONE, serializedData);
+        if (isSender)
+            mpiComm.broadcast(MessageType::NONE, serializedData, payloadComm);
+        else if (hostRelay)
+        {
+            const auto header = mpiComm.receiveBroadcastHeader(RANK0);
+            sharedBuffer.synchronize();
+            sharedBuffer.setSize(header.size);
+            if (isHostLeader)
+            {
+                payloadComm.receiveBroadcast(RANK0, sharedBuffer.data(),
+                                             header.size);
+            }
+            sharedBuffer.synchronize();
+        }
         else
         {
             const auto header = mpiComm.receiveBroadcastHeader(RANK0);
             buffer.setSize(header.size);
-            mpiComm.receiveBroadcast(RANK0, buffer.data(), header.size);
+            payloadComm.receiveBroadcast(RANK0, buffer.data(), header.size);
         }
         ++counter;
     }
 
     const float time = timer.elapsed();
+    const auto hostSizes = mpiComm.gatherAll(isHostLeader ? hostComm.getSize()
+                                                          : 0);
 
     if (mpiComm.getRank() == RANK0)
     {
@@ -149,6 +208,8 @@ int main(int argc, char** argv)
         std::cout << "Throughput [Gbit/sec]: "
                   << counter * serializedData.size() * BITS / time / GIGABYTE
                   << std::endl;
+        printHostReport(hostSizes, counter * serializedData.size(), hostRelay,
+                        time);
     }
 
     return EXIT_SUCCESS;
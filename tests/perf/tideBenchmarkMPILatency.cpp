@@ -0,0 +1,206 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "network/MPICommunicator.h"
+#include "network/ReceiveBuffer.h"
+#include "utils/CommandLineParser.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#define RANK0 0
+
+// Example ways to run this program:
+// mpirun -n 6 -H localhost ./tideBenchmarkMPILatency --frames 1000
+//
+// Compares the wait strategies of the MPICommunicator on the messages that
+// synchronize each frame (frame clock broadcast, frame requests and the
+// "all ready" global sum), and the CPU usage of processes waiting idle.
+
+namespace
+{
+using clock = std::chrono::steady_clock;
+
+namespace po = boost::program_options;
+
+class BenchmarkOptions : public CommandLineParser
+{
+public:
+    BenchmarkOptions()
+    {
+        // clang-format off
+        desc.add_options()
+            ("frames,f", po::value<size_t>()->default_value(1000u),
+             "number of frames to synchronize per strategy")
+            ("idle,i", po::value<size_t>()->default_value(500u),
+             "duration of the idle wait [ms]")
+            ("spin,s", po::value<size_t>()->default_value(50u),
+             "busy-polling duration of spin modes [us]")
+        ;
+        // clang-format on
+    }
+    size_t frames() const { return vm["frames"].as<size_t>(); }
+    size_t idle() const { return vm["idle"].as<size_t>(); }
+    size_t spin() const { return vm["spin"].as<size_t>(); }
+};
+
+struct Strategy
+{
+    const char* name;
+    MPIWaitMode mode;
+};
+
+const std::vector<Strategy> strategies{
+    {"backoff", MPIWaitMode::backoff},
+    {"spin", MPIWaitMode::spin_then_sleep},
+    {"progress", MPIWaitMode::progress_thread},
+    {"hybrid", MPIWaitMode::hybrid}};
+
+double _toMicroseconds(const clock::duration duration)
+{
+    return std::chrono::duration<double, std::micro>{duration}.count();
+}
+
+/** One frame of synchronization, as done by the master and wall processes. */
+void _synchronizeFrame(MPICommunicator& comm, ReceiveBuffer& buffer)
+{
+    if (comm.getRank() == RANK0)
+    {
+        comm.broadcast(MessageType::FRAME_CLOCK);
+        for (int i = 1; i < comm.getSize(); ++i)
+        {
+            const auto result = comm.probe();
+            buffer.setSize(result.size);
+            comm.receive(result.src, buffer.data(), buffer.size(),
+                         int(result.messageType));
+        }
+    }
+    else
+    {
+        comm.receiveBroadcastHeader(RANK0);
+        comm.send(MessageType::REQUEST_FRAME, "uri", RANK0);
+    }
+    comm.globalSum(1);
+}
+
+/** @return the CPU time spent by this process while waiting for a message. */
+double _measureIdleCpuTime(MPICommunicator& comm, const size_t idleMs)
+{
+    comm.globalBarrier();
+    const auto cpuStart = std::clock();
+    if (comm.getRank() == RANK0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(idleMs));
+        comm.broadcast(MessageType::NONE);
+    }
+    else
+        comm.receiveBroadcastHeader(RANK0);
+    return double(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+}
+}
+
+/**
+ * Benchmark the latency and CPU usage of the MPI wait strategies.
+ */
+int main(int argc, char** argv)
+{
+    COMMAND_LINE_PARSER_CHECK(BenchmarkOptions, "tideBenchmarkMPILatency");
+
+    MPICommunicator comm(argc, argv);
+    ReceiveBuffer buffer;
+
+    if (comm.getRank() == RANK0)
+    {
+        std::cout << std::setw(10) << "strategy" << std::setw(12) << "mean[us]"
+                  << std::setw(12) << "p50[us]" << std::setw(12) << "p99[us]"
+                  << std::setw(16) << "idle cpu[%]" << std::endl;
+    }
+
+    for (const auto& strategy : strategies)
+    {
+        auto waitStrategy = MPIWaitStrategy();
+        waitStrategy.mode = strategy.mode;
+        waitStrategy.spinTime = std::chrono::microseconds{commandLine.spin()};
+        comm.setWaitStrategy(waitStrategy);
+
+        std::vector<double> latencies;
+        latencies.reserve(commandLine.frames());
+
+        comm.globalBarrier();
+        for (size_t i = 0; i < commandLine.frames(); ++i)
+        {
+            const auto start = clock::now();
+            _synchronizeFrame(comm, buffer);
+            latencies.push_back(_toMicroseconds(clock::now() - start));
+        }
+
+        const auto cpuTime = _measureIdleCpuTime(comm, commandLine.idle());
+        const auto cpuTimes = comm.gatherAll(uint64_t(cpuTime * 1e6));
+
+        if (comm.getRank() != RANK0 || latencies.empty())
+            continue;
+
+        std::sort(latencies.begin(), latencies.end());
+        const auto percentile = [&latencies](const double p) {
+            return latencies[size_t(p * (latencies.size() - 1))];
+        };
+        auto sum = 0.0;
+        for (const auto latency : latencies)
+            sum += latency;
+
+        // Average idle CPU usage of the waiting processes
+        auto idleCpu = 0.0;
+        for (size_t i = 1; i < cpuTimes.size(); ++i)
+            idleCpu += cpuTimes[i] / 1e6;
+        if (cpuTimes.size() > 1)
+            idleCpu /= cpuTimes.size() - 1;
+        const auto idleCpuPercent = 100.0 * idleCpu * 1000 / commandLine.idle();
+
+        std::cout << std::setw(10) << strategy.name << std::setw(12)
+                  << sum / latencies.size() << std::setw(12) << percentile(0.5)
+                  << std::setw(12) << percentile(0.99) << std::setw(16)
+                  << idleCpuPercent << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
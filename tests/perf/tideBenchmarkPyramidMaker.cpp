@@ -0,0 +1,161 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "data/TiffPyramidWriter.h"
+#include "utils/CommandLineParser.h"
+
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QThreadPool>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+// Example ways to run this program:
+// ./tideBenchmarkPyramidMaker --width 32768 --height 16384 --threads 8
+//
+// Converts a synthetic image to a TIFF pyramid with each codec and reports the
+// conversion throughput and the size of the resulting files.
+
+namespace
+{
+using clock = std::chrono::steady_clock;
+using Codec = TiffPyramidWriter::Codec;
+
+namespace po = boost::program_options;
+
+class BenchmarkOptions : public CommandLineParser
+{
+public:
+    BenchmarkOptions()
+    {
+        // clang-format off
+        desc.add_options()
+            ("width,w", po::value<int>()->default_value(16384),
+             "width of the synthetic image [px]")
+            ("height,h", po::value<int>()->default_value(16384),
+             "height of the synthetic image [px]")
+            ("tile-size,t", po::value<int>()->default_value(512),
+             "size of the tiles [px]")
+            ("threads,n", po::value<int>()->default_value(0),
+             "number of threads (default: all cores)")
+        ;
+        // clang-format on
+    }
+    QSize size() const
+    {
+        return QSize(vm["width"].as<int>(), vm["height"].as<int>());
+    }
+    int tileSize() const { return vm["tile-size"].as<int>(); }
+    int threads() const { return vm["threads"].as<int>(); }
+};
+
+struct Benchmark
+{
+    const char* name;
+    Codec codec;
+};
+
+const std::vector<Benchmark> benchmarks{{"jpeg", Codec::jpeg},
+                                        {"deflate", Codec::deflate},
+                                        {"none", Codec::none}};
+
+/** Gradient with some high-frequency details to be realistic for codecs. */
+TiffPyramidWriter::ReadStripFunc _makeSyntheticImage(const QSize& size)
+{
+    return [size](const int y0, const int height) {
+        auto strip = QImage(size.width(), height, QImage::Format_RGB888);
+        for (int y = 0; y < height; ++y)
+        {
+            auto pixel = strip.scanLine(y);
+            for (int x = 0; x < size.width(); ++x)
+            {
+                *pixel++ = uchar(x * 255 / size.width());
+                *pixel++ = uchar((y0 + y) * 255 / size.height());
+                *pixel++ = uchar(((x / 8) ^ ((y0 + y) / 8)) & 0xff);
+            }
+        }
+        return strip;
+    };
+}
+}
+
+/**
+ * Benchmark the conversion of large images to TIFF pyramids.
+ */
+int main(int argc, char** argv)
+{
+    COMMAND_LINE_PARSER_CHECK(BenchmarkOptions, "tideBenchmarkPyramidMaker");
+
+    QCoreApplication app{argc, argv};
+
+    if (commandLine.threads() > 0)
+        QThreadPool::globalInstance()->setMaxThreadCount(commandLine.threads());
+
+    const auto size = commandLine.size();
+    const auto megapixels = double(size.width()) * size.height() / 1e6;
+    QTemporaryDir dir;
+
+    const auto threads = QThreadPool::globalInstance()->maxThreadCount();
+    std::cout << "image: " << size.width() << "x" << size.height()
+              << ", threads: " << threads << std::endl;
+    std::cout << std::setw(10) << "codec" << std::setw(12) << "time[s]"
+              << std::setw(12) << "MPix/s" << std::setw(14) << "size[MB]"
+              << std::endl;
+
+    for (const auto& benchmark : benchmarks)
+    {
+        auto options = TiffPyramidWriter::Options();
+        options.tileSize = {commandLine.tileSize(), commandLine.tileSize()};
+        options.codec = benchmark.codec;
+
+        const auto filename = dir.filePath(QString(benchmark.name) + ".tif");
+        const auto start = clock::now();
+        const auto writer = TiffPyramidWriter{options};
+        writer.write(size, false, _makeSyntheticImage(size), filename);
+        const auto elapsed =
+            std::chrono::duration<double>{clock::now() - start}.count();
+
+        std::cout << std::setw(10) << benchmark.name << std::setw(12) << elapsed
+                  << std::setw(12) << megapixels / elapsed << std::setw(14)
+                  << QFileInfo(filename).size() / 1e6 << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
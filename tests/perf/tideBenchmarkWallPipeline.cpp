@@ -0,0 +1,730 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "DataProvider.h"
+#include "config.h"
+#include "datasources/CachedDataSource.h"
+#include "network/MPICommunicator.h"
+#include "network/WallToWallChannel.h"
+#include "qml/Tile.h"
+#include "scene/ContentFactory.h"
+#include "scene/DisplayGroup.h"
+#include "scene/Scene.h"
+#include "scene/Window.h"
+#include "synchronizers/ContentSynchronizer.h"
+#include "tools/VisibilityHelper.h"
+#include "utils/CommandLineParser.h"
+
+#if TIDE_ENABLE_MOVIE_SUPPORT
+#include "scene/MovieContent.h"
+#endif
+#if TIDE_USE_TIFF
+#include "data/TiffPyramidWriter.h"
+#endif
+
+#include <deflect/server/Frame.h>
+
+#include <QBuffer>
+#include <QFile>
+#include <QGuiApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPainter>
+#include <QPdfWriter>
+#include <QProcess>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <random>
+#include <thread>
+
+// Example ways to run this program:
+// ./tideBenchmarkWallPipeline --width 3840 --height 2160 --output wall.json
+// ./tideBenchmarkWallPipeline --scenarios movie,stream --frames 600
+//
+// Runs the tile pipeline of a wall process (DataProvider, synchronizers and
+// tiles) without any display: the tiles are kept by offscreen windows which
+// only count the images they receive instead of uploading them to the GPU.
+// For each scenario, a single window covering the wall shows:
+// - pyramid: a synthetic TIFF image pyramid
+// - pdf: a generated multi-page PDF document
+// - svg: a generated SVG drawing
+// - movie: the --movie file, or a test pattern generated with ffmpeg
+// - stream: synthetic jpeg-compressed Deflect frames
+// Static contents run until all the visible tiles show full quality images,
+// dynamic ones for a fixed number of frames. The results are printed as a table
+// and can be written to a JSON file for automated comparisons.
+
+namespace
+{
+using clock = std::chrono::steady_clock;
+
+namespace po = boost::program_options;
+
+const int streamTileSize = 512;
+const int streamFrameCount = 8;
+
+class BenchmarkOptions : public CommandLineParser
+{
+public:
+    BenchmarkOptions()
+    {
+        // clang-format off
+        desc.add_options()
+            ("scenarios,s", po::value<std::string>()->default_value(
+                 "pyramid,pdf,svg,movie,stream"),
+             "comma-separated list of scenarios to run")
+            ("width", po::value<int>()->default_value(3840),
+             "width of the wall [px]")
+            ("height", po::value<int>()->default_value(2160),
+             "height of the wall [px]")
+            ("pyramid-size", po::value<int>()->default_value(16384),
+             "size of the synthetic image pyramid [px]")
+            ("frames,f", po::value<size_t>()->default_value(300u),
+             "number of frames to render for dynamic contents")
+            ("fps", po::value<int>()->default_value(60),
+             "target frame rate of the wall")
+            ("timeout,t", po::value<double>()->default_value(60.0),
+             "maximum duration of a scenario [s]")
+            ("no-progressive",
+             "disable the coarse tiles of SVG contents, to compare the time "
+             "to full quality with and without them")
+            ("movie,m", po::value<std::string>()->default_value(""),
+             "movie file to play (default: generate one with ffmpeg)")
+            ("output,o", po::value<std::string>()->default_value(""),
+             "write the results to this JSON file")
+        ;
+        // clang-format on
+    }
+    QStringList scenarios() const
+    {
+        const auto list = vm["scenarios"].as<std::string>();
+        return QString::fromStdString(list).split(',',
+                                                  QString::SkipEmptyParts);
+    }
+    QSize wallSize() const
+    {
+        return QSize(vm["width"].as<int>(), vm["height"].as<int>());
+    }
+    int pyramidSize() const { return vm["pyramid-size"].as<int>(); }
+    size_t frames() const { return vm["frames"].as<size_t>(); }
+    int fps() const { return vm["fps"].as<int>(); }
+    double timeout() const { return vm["timeout"].as<double>(); }
+    bool progressive() const { return !vm.count("no-progressive"); }
+    QString movie() const
+    {
+        return QString::fromStdString(vm["movie"].as<std::string>());
+    }
+    QString output() const
+    {
+        return QString::fromStdString(vm["output"].as<std::string>());
+    }
+};
+
+/** The content of a scenario and how to feed it with frames. */
+struct Source
+{
+    ContentPtr content;
+    bool dynamic = false;
+    std::function<deflect::server::FramePtr()> nextFrame;
+    QString skipReason;
+};
+
+struct Stats
+{
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+struct Result
+{
+    QString name;
+    QString skipReason;
+    bool complete = false;
+    size_t frames = 0;
+    size_t tiles = 0;
+    size_t images = 0;
+    size_t coarseTiles = 0;
+    double duration = 0.0;
+    double timeToFirstImage = -1.0;
+    double timeToFullQuality = -1.0;
+    Stats framePrep; // [ms]
+};
+
+double _secondsSince(const clock::time_point start)
+{
+    return std::chrono::duration<double>{clock::now() - start}.count();
+}
+
+Stats _computeStats(std::vector<double> values)
+{
+    auto stats = Stats();
+    if (values.empty())
+        return stats;
+
+    std::sort(values.begin(), values.end());
+    const auto percentile = [&values](const double p) {
+        return values[size_t(p * (values.size() - 1))];
+    };
+    stats.mean = std::accumulate(values.begin(), values.end(), 0.0) /
+                 values.size();
+    stats.p50 = percentile(0.5);
+    stats.p99 = percentile(0.99);
+    stats.max = values.back();
+    return stats;
+}
+
+/**
+ * Offscreen replacement for the WindowRenderer.
+ *
+ * Keeps the tiles of a window and connects them to their synchronizer like the
+ * WindowRenderer does, but without any QML item: the images are counted and
+ * swapped but never uploaded to the GPU.
+ */
+class HeadlessWindow
+{
+public:
+    HeadlessWindow(std::unique_ptr<ContentSynchronizer> synchronizer,
+                   const clock::time_point start)
+        : _synchronizer{std::move(synchronizer)}
+        , _start{start}
+    {
+        const auto sync = _synchronizer.get();
+        QObject::connect(sync, &ContentSynchronizer::addTile, sync,
+                         [this](TilePtr tile, uint) { _addTile(tile); });
+        QObject::connect(sync, &ContentSynchronizer::removeTile, sync,
+                         [this](const uint id) { _removeTile(id); });
+        QObject::connect(sync, &ContentSynchronizer::updateTile, sync,
+                         [this](const uint id, const QRect& rect) {
+                             const auto it = _tiles.find(id);
+                             if (it != _tiles.end())
+                                 it->second->update(rect);
+                         });
+    }
+
+    void update(const Window& window, const QRectF& visibleArea)
+    {
+        _synchronizer->update(window, visibleArea);
+    }
+
+    /** @return true when all the tiles show a full quality image. */
+    bool isComplete() const
+    {
+        return !_tiles.empty() &&
+               std::all_of(_tiles.begin(), _tiles.end(), [](const auto& it) {
+                   return it.second->isVisible() && !it.second->isCoarse();
+               });
+    }
+
+    size_t getTileCount() const { return _tiles.size(); }
+    size_t getImageCount() const { return _images; }
+    size_t getCoarseTileCount() const { return _coarseTiles; }
+    double getTimeToFirstImage() const { return _timeToFirstImage; }
+private:
+    std::unique_ptr<ContentSynchronizer> _synchronizer;
+    std::map<uint, TilePtr> _tiles;
+    const clock::time_point _start;
+    size_t _images = 0;
+    size_t _coarseTiles = 0;
+    double _timeToFirstImage = -1.0;
+
+    void _addTile(TilePtr tile)
+    {
+        const auto sync = _synchronizer.get();
+        QObject::connect(tile.get(), &Tile::readyToSwap, sync,
+                         [this](TilePtr) { _countImage(); });
+        QObject::connect(tile.get(), &Tile::readyToSwap, sync,
+                         &ContentSynchronizer::onSwapReady);
+        QObject::connect(tile.get(), &Tile::requestNextFrame, sync,
+                         &ContentSynchronizer::onRequestNextFrame);
+        QObject::connect(tile.get(), &Tile::coarseChanged, sync,
+                         [this, item = tile.get()] {
+                             if (item->isCoarse())
+                                 ++_coarseTiles;
+                         });
+        _tiles[tile->getId()] = tile;
+        tile->requestNextFrame(tile);
+    }
+
+    void _removeTile(const uint id)
+    {
+        const auto it = _tiles.find(id);
+        if (it == _tiles.end())
+            return;
+        it->second->disconnect(_synchronizer.get());
+        _tiles.erase(it);
+    }
+
+    void _countImage()
+    {
+        if (_images++ == 0)
+            _timeToFirstImage = _secondsSince(_start);
+    }
+};
+
+Result _run(const QString& name, Source source,
+            const BenchmarkOptions& options, WallToWallChannel& channel)
+{
+    auto result = Result();
+    result.name = name;
+
+    const auto wallSize = options.wallSize();
+    const auto screenRect = QRect(QPoint(), wallSize);
+    auto scene = Scene::create(wallSize);
+    auto& group = scene->getGroup(0);
+    auto window = std::make_shared<Window>(std::move(source.content));
+    window->setCoordinates(QRectF(QPointF(), QSizeF(wallSize)));
+    group.add(window);
+
+    // Frame credits given by the wall, as the master application would count
+    // them before sending the next frame of a stream.
+    size_t frameCredits = 0;
+    DataProvider provider;
+    QObject::connect(&provider, &DataProvider::requestPixelStreamFrame,
+                     [&frameCredits] {
+                         frameCredits = std::max(frameCredits, size_t(1));
+                     });
+    QObject::connect(&provider, &DataProvider::pixelStreamFramesConsumed,
+                     [&frameCredits](QString, const uint frames, uint) {
+                         frameCredits += frames;
+                     });
+
+    const auto start = clock::now();
+    provider.updateDataSources(*scene);
+    HeadlessWindow headless{provider.createSynchronizer(*window,
+                                                        deflect::View::mono),
+                            start};
+    const auto helper = VisibilityHelper{group, screenRect, false};
+    headless.update(*window, helper.getVisibleArea(*window));
+
+    const auto period = std::chrono::microseconds{1000000 / options.fps()};
+    std::vector<double> framePrepTimes;
+    while (true)
+    {
+        const auto frameStart = clock::now();
+        if (source.nextFrame && frameCredits > 0)
+        {
+            --frameCredits;
+            provider.setNewFrame(source.nextFrame());
+        }
+        channel.synchronizeClock();
+        provider.synchronizeTilesSwap(channel);
+        provider.synchronizeTilesUpdate(channel);
+        QCoreApplication::processEvents();
+        framePrepTimes.push_back(_secondsSince(frameStart) * 1000.0);
+
+        ++result.frames;
+        if (!source.dynamic && headless.isComplete())
+        {
+            result.complete = true;
+            result.timeToFullQuality = _secondsSince(start);
+            break;
+        }
+        if (source.dynamic && result.frames >= options.frames())
+        {
+            result.complete = true;
+            break;
+        }
+        if (_secondsSince(start) > options.timeout())
+            break;
+
+        std::this_thread::sleep_until(frameStart + period);
+    }
+
+    result.duration = _secondsSince(start);
+    result.tiles = headless.getTileCount();
+    result.images = headless.getImageCount();
+    result.coarseTiles = headless.getCoarseTileCount();
+    result.timeToFirstImage = headless.getTimeToFirstImage();
+    result.framePrep = _computeStats(std::move(framePrepTimes));
+    return result;
+}
+
+Source _skip(const QString& reason)
+{
+    auto source = Source();
+    source.skipReason = reason;
+    return source;
+}
+
+Source _createFileSource(const QString& filename)
+{
+    auto source = Source();
+    try
+    {
+        source.content = ContentFactory::createContent(filename);
+    }
+    catch (const std::exception& e)
+    {
+        return _skip(QString("cannot open %1: %2").arg(filename, e.what()));
+    }
+    return source;
+}
+
+Source _createPyramid(const QTemporaryDir& dir, const BenchmarkOptions& options)
+{
+#if TIDE_USE_TIFF
+    const auto size = QSize(options.pyramidSize(), options.pyramidSize());
+    const auto filename = dir.filePath("pyramid.tif");
+
+    // Gradient with some high-frequency details to be realistic for codecs
+    const auto readStrip = [size](const int y0, const int height) {
+        auto strip = QImage(size.width(), height, QImage::Format_RGB888);
+        for (int y = 0; y < height; ++y)
+        {
+            auto pixel = strip.scanLine(y);
+            for (int x = 0; x < size.width(); ++x)
+            {
+                *pixel++ = uchar(x * 255 / size.width());
+                *pixel++ = uchar((y0 + y) * 255 / size.height());
+                *pixel++ = uchar(((x / 8) ^ ((y0 + y) / 8)) & 0xff);
+            }
+        }
+        return strip;
+    };
+    TiffPyramidWriter{}.write(size, false, readStrip, filename);
+    return _createFileSource(filename);
+#else
+    Q_UNUSED(dir);
+    Q_UNUSED(options);
+    return _skip("built without TIFF support");
+#endif
+}
+
+Source _createPDF(const QTemporaryDir& dir, const BenchmarkOptions&)
+{
+#if TIDE_ENABLE_PDF_SUPPORT
+    const auto filename = dir.filePath("document.pdf");
+    {
+        QPdfWriter writer{filename};
+        writer.setPageSize(QPageSize{QPageSize::A4});
+        QPainter painter{&writer};
+        const auto page = painter.viewport();
+        for (int i = 0; i < 10; ++i)
+        {
+            if (i > 0)
+                writer.newPage();
+            painter.setFont(QFont("Sans", 14));
+            for (int line = 0; line < 40; ++line)
+            {
+                const auto y = page.height() * (line + 1) / 42;
+                painter.drawText(page.width() / 10, y,
+                                 QString("Page %1, line %2: the quick brown "
+                                         "fox jumps over the lazy dog")
+                                     .arg(i + 1)
+                                     .arg(line + 1));
+            }
+            painter.drawEllipse(page.center(), page.width() / 4,
+                                page.width() / 4);
+        }
+    }
+    return _createFileSource(filename);
+#else
+    Q_UNUSED(dir);
+    return _skip("built without PDF support");
+#endif
+}
+
+Source _createSVG(const QTemporaryDir& dir, const BenchmarkOptions&)
+{
+    const auto filename = dir.filePath("drawing.svg");
+    QFile file{filename};
+    if (!file.open(QIODevice::WriteOnly))
+        return _skip("cannot write " + filename);
+
+    auto random = std::mt19937{42};
+    auto coordinate = std::uniform_int_distribution<int>{0, 1920};
+    auto radius = std::uniform_int_distribution<int>{5, 200};
+    auto color = std::uniform_int_distribution<int>{0, 0xffffff};
+
+    QString svg = "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"1920\" "
+                  "height=\"1080\" viewBox=\"0 0 1920 1080\">\n";
+    for (int i = 0; i < 2000; ++i)
+    {
+        svg += QString("<circle cx=\"%1\" cy=\"%2\" r=\"%3\" fill=\"#%4\" "
+                       "fill-opacity=\"0.5\" stroke=\"black\"/>\n")
+                   .arg(coordinate(random))
+                   .arg(coordinate(random) * 1080 / 1920)
+                   .arg(radius(random))
+                   .arg(color(random), 6, 16, QChar('0'));
+    }
+    svg += "</svg>\n";
+    file.write(svg.toUtf8());
+    file.close();
+    return _createFileSource(filename);
+}
+
+Source _createMovie(const QTemporaryDir& dir, const BenchmarkOptions& options)
+{
+#if TIDE_ENABLE_MOVIE_SUPPORT
+    auto filename = options.movie();
+    if (filename.isEmpty())
+    {
+        filename = dir.filePath("movie.mp4");
+        const auto size = options.wallSize();
+        const auto pattern = QString("testsrc2=size=%1x%2:rate=30")
+                                 .arg(size.width())
+                                 .arg(size.height());
+        QProcess ffmpeg;
+        ffmpeg.start("ffmpeg", {"-y", "-loglevel", "error", "-f", "lavfi",
+                                "-i", pattern, "-t", "10", "-pix_fmt",
+                                "yuv420p", filename});
+        if (!ffmpeg.waitForStarted())
+            return _skip("no --movie given and ffmpeg is not available");
+        ffmpeg.waitForFinished(-1);
+        if (ffmpeg.exitCode() != 0)
+            return _skip("ffmpeg could not generate a movie");
+    }
+    auto source = _createFileSource(filename);
+    if (auto movie = dynamic_cast<MovieContent*>(source.content.get()))
+        movie->play();
+    source.dynamic = true;
+    return source;
+#else
+    Q_UNUSED(dir);
+    Q_UNUSED(options);
+    return _skip("built without movie support");
+#endif
+}
+
+deflect::server::Frame _createStreamFrame(const QString& uri,
+                                          const QSize& size, const int index)
+{
+    auto frame = deflect::server::Frame();
+    frame.uri = uri;
+    for (int y = 0; y < size.height(); y += streamTileSize)
+    {
+        for (int x = 0; x < size.width(); x += streamTileSize)
+        {
+            const auto width = std::min(streamTileSize, size.width() - x);
+            const auto height = std::min(streamTileSize, size.height() - y);
+
+            auto image = QImage(width, height, QImage::Format_RGB32);
+            image.fill(QColor::fromHsv((x / 8 + y / 8 + index * 45) % 360,
+                                       200, 255));
+            QPainter painter{&image};
+            painter.drawText(image.rect(), Qt::AlignCenter,
+                             QString("frame %1").arg(index));
+            painter.end();
+
+            QBuffer buffer;
+            buffer.open(QIODevice::WriteOnly);
+            image.save(&buffer, "JPG", 75);
+
+            auto tile = deflect::server::Tile();
+            tile.x = x;
+            tile.y = y;
+            tile.width = width;
+            tile.height = height;
+            tile.format = deflect::Format::jpeg;
+            tile.imageData = buffer.data();
+            frame.tiles.push_back(tile);
+        }
+    }
+    return frame;
+}
+
+Source _createStream(const QTemporaryDir&, const BenchmarkOptions& options)
+{
+    const auto uri = QString("tideBenchmarkWallPipeline");
+    const auto size = options.wallSize();
+
+    // Encoding is done upfront, only the decoding is part of the benchmark
+    auto frames = std::make_shared<std::vector<deflect::server::Frame>>();
+    for (int i = 0; i < streamFrameCount; ++i)
+        frames->push_back(_createStreamFrame(uri, size, i));
+
+    auto source = Source();
+    source.content = ContentFactory::createPixelStreamContent(uri, size);
+    source.dynamic = true;
+    source.nextFrame = [frames, index = size_t(0)]() mutable {
+        // Copies are cheap (implicitly shared data) and can be modified by the
+        // decoder without altering the original frames.
+        const auto& frame = (*frames)[index++ % frames->size()];
+        return std::make_shared<deflect::server::Frame>(frame);
+    };
+    return source;
+}
+
+using SourceFactory =
+    std::function<Source(const QTemporaryDir&, const BenchmarkOptions&)>;
+
+const std::map<QString, SourceFactory> factories{{"pyramid", _createPyramid},
+                                                 {"pdf", _createPDF},
+                                                 {"svg", _createSVG},
+                                                 {"movie", _createMovie},
+                                                 {"stream", _createStream}};
+
+QJsonObject _toJson(const Stats& stats)
+{
+    return QJsonObject{{"mean", stats.mean},
+                       {"p50", stats.p50},
+                       {"p99", stats.p99},
+                       {"max", stats.max}};
+}
+
+QJsonObject _toJson(const Result& result)
+{
+    if (!result.skipReason.isEmpty())
+    {
+        return QJsonObject{{"name", result.name},
+                           {"skipped", true},
+                           {"reason", result.skipReason}};
+    }
+    const auto imagesPerSecond = result.images / result.duration;
+    return QJsonObject{{"name", result.name},
+                       {"skipped", false},
+                       {"complete", result.complete},
+                       {"frames", double(result.frames)},
+                       {"tiles", double(result.tiles)},
+                       {"images", double(result.images)},
+                       {"coarse_tiles", double(result.coarseTiles)},
+                       {"images_per_second", imagesPerSecond},
+                       {"duration_s", result.duration},
+                       {"time_to_first_image_s", result.timeToFirstImage},
+                       {"time_to_full_quality_s", result.timeToFullQuality},
+                       {"frame_prep_ms", _toJson(result.framePrep)}};
+}
+
+void _printHeader()
+{
+    std::cout << std::setw(9) << "scenario" << std::setw(8) << "frames"
+              << std::setw(7) << "tiles" << std::setw(10) << "images/s"
+              << std::setw(10) << "first[s]" << std::setw(9) << "full[s]"
+              << std::setw(10) << "mean[ms]" << std::setw(9) << "p99[ms]"
+              << std::setw(9) << "max[ms]" << std::endl;
+}
+
+void _print(const Result& result)
+{
+    std::cout << std::setw(9) << result.name.toStdString();
+    if (!result.skipReason.isEmpty())
+    {
+        std::cout << "  skipped: " << result.skipReason.toStdString()
+                  << std::endl;
+        return;
+    }
+    std::cout << std::fixed << std::setprecision(2) << std::setw(8)
+              << result.frames << std::setw(7) << result.tiles << std::setw(10)
+              << result.images / result.duration << std::setw(10)
+              << result.timeToFirstImage << std::setw(9)
+              << result.timeToFullQuality << std::setw(10)
+              << result.framePrep.mean << std::setw(9) << result.framePrep.p99
+              << std::setw(9) << result.framePrep.max
+              << (result.complete ? "" : "  (timeout)") << std::endl;
+}
+}
+
+/**
+ * Benchmark the tile pipeline of a wall process without any display.
+ */
+int main(int argc, char** argv)
+{
+    COMMAND_LINE_PARSER_CHECK(BenchmarkOptions, "tideBenchmarkWallPipeline");
+
+    if (qgetenv("QT_QPA_PLATFORM").isEmpty())
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app{argc, argv};
+
+    MPICommunicator comm{argc, argv};
+    WallToWallChannel channel{comm};
+
+    CachedDataSource::setProgressiveRendering(commandLine.progressive());
+
+    const auto size = commandLine.wallSize();
+    std::cout << "wall: " << size.width() << "x" << size.height()
+              << ", fps: " << commandLine.fps() << ", progressive: "
+              << (commandLine.progressive() ? "on" : "off") << std::endl;
+    _printHeader();
+
+    QTemporaryDir dir;
+    QJsonArray scenarios;
+    for (const auto& name : commandLine.scenarios())
+    {
+        const auto factory = factories.find(name);
+        if (factory == factories.end())
+        {
+            std::cerr << "unknown scenario: " << name.toStdString()
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        auto source = factory->second(dir, commandLine);
+        auto result = Result();
+        if (source.skipReason.isEmpty())
+            result = _run(name, std::move(source), commandLine, channel);
+        else
+        {
+            result.name = name;
+            result.skipReason = source.skipReason;
+        }
+        _print(result);
+        scenarios.append(_toJson(result));
+    }
+
+    if (!commandLine.output().isEmpty())
+    {
+        const auto wall = QJsonObject{{"width", size.width()},
+                                      {"height", size.height()},
+                                      {"fps", commandLine.fps()},
+                                      {"progressive",
+                                       commandLine.progressive()}};
+        const auto root =
+            QJsonObject{{"benchmark", "tideBenchmarkWallPipeline"},
+                        {"wall", wall},
+                        {"scenarios", scenarios}};
+        QFile file{commandLine.output()};
+        if (!file.open(QIODevice::WriteOnly))
+        {
+            std::cerr << "cannot write " << commandLine.output().toStdString()
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+        file.write(QJsonDocument{root}.toJson());
+    }
+    return EXIT_SUCCESS;
+}
@@ -40,6 +40,7 @@
 #include "config.h"
 #include "types.h"
 
+#include "metrics/MetricsRegistry.h"
 #include "network/MessageHeader.h"
 #include "scene/Window.h"
 
@@ -66,12 +67,17 @@ struct MetaTypeRegistration
         qRegisterMetaType<ImagePtr>("ImagePtr");
         qRegisterMetaType<MarkersPtr>("MarkersPtr");
         qRegisterMetaType<MessageType>("MessageType");
+        qRegisterMetaType<MetricFamilies>("MetricFamilies");
         qRegisterMetaType<OptionsPtr>("OptionsPtr");
         qRegisterMetaType<QUuid>("QUuid");
         qRegisterMetaType<ScreenLockPtr>("ScreenLockPtr");
         qRegisterMetaType<std::string>("std::string");
+        qRegisterMetaType<std::vector<std::string>>(
+            "std::vector<std::string>");
         qRegisterMetaType<TilePtr>("TilePtr");
         qRegisterMetaType<TileWeakPtr>("TileWeakPtr");
+        qRegisterMetaType<WhiteboardStrokeUpdatePtr>(
+            "WhiteboardStrokeUpdatePtr");
         qRegisterMetaTypeStreamOperators<QUuid>("QUuid");
     }
 };
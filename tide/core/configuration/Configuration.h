@@ -114,6 +114,12 @@ public:
 
         /** Port for the WebService server to listen for incoming requests. */
         uint16_t webservicePort = 8888;
+
+        /** Maximum size in MB of files uploaded via web interface, 0: none. */
+        uint uploadMaxSize = 0;
+
+        /** Send each wall process only the stream tiles that it displays. */
+        bool directStreaming = false;
     } master;
 
     struct Settings
@@ -132,6 +138,42 @@ public:
 
         /** Maximum scaling factor for vectorial contents. */
         double contentMaxScaleVectorial = 0.0;
+
+        /** Maximum number of stream frames sent ahead of their display. */
+        uint streamFramesInFlight = 2;
+
+        /** Skip the stream frames that the wall is too slow to display. */
+        bool streamDropLateFrames = true;
+
+        /** Upload the JPEG tiles of image pyramids as YUV instead of RGB. */
+        bool imagePyramidYUVTiles = true;
+
+        /** Size above which regular images are displayed as pyramids. */
+        uint imageTilingThreshold = 8192;
+
+        /** Share decoded tiles between the wall processes of each host. */
+        bool sharedTileCache = true;
+
+        /** Number of PDF pages before and after the current one to render. */
+        uint pdfRenderAheadPages = 1;
+
+        /** Max parsed instances of each PDF/SVG document per wall process. */
+        uint documentPoolSize = 2;
+
+        /** Show coarse SVG tiles while rendering them at full quality. */
+        bool progressiveRendering = true;
+
+        /** Skip rendering screens without changes (software swap sync). */
+        bool skipUnchangedScreens = true;
+
+        /** Target frame rate of the wall processes. */
+        uint targetFrameRate = 60;
+
+        /** Max tile textures uploaded per frame and screen (0: no limit). */
+        uint maxTileUploadsPerFrame = 32;
+
+        /** Memory budget in MB of the wall processes of a host (0: none). */
+        uint wallMemoryBudget = 0;
     } settings;
 
     struct Webbrowser
@@ -53,7 +53,18 @@ extern "C"
 #include "FFMPEGVideoStream.h"
 #include "utils/log.h"
 
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QLockFile>
+#include <QSaveFile>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <chrono>
 #include <cmath>
+#include <cstring>
 
 #pragma clang diagnostic ignored "-Wdeprecated"
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
@@ -103,6 +114,129 @@ AVFormatContextPtr _createAvFormatContext(const QString& uri)
     return avFormatContext;
 }
 
+// Demux (without decoding) a separate instance of the movie to collect the
+// timestamps of the keyframes of the given stream.
+std::vector<int64_t> _scanKeyframes(const QString& uri, const int streamIndex,
+                                    const std::atomic<bool>& abort)
+{
+    std::vector<int64_t> timestamps;
+    try
+    {
+        auto avFormatContext = _createAvFormatContext(uri);
+
+        AVPacket packet;
+        av_init_packet(&packet);
+        while (!abort && av_read_frame(avFormatContext.get(), &packet) >= 0)
+        {
+            if (packet.stream_index == streamIndex &&
+                (packet.flags & AV_PKT_FLAG_KEY))
+            {
+                timestamps.push_back(packet.pts != AV_NOPTS_VALUE ? packet.pts
+                                                                  : packet.dts);
+            }
+            av_free_packet(&packet);
+        }
+    }
+    catch (const std::runtime_error& e)
+    {
+        print_log(LOG_WARN, LOG_AV, "Could not index keyframes of '%s': %s",
+                  uri.toLocal8Bit().constData(), e.what());
+        return {};
+    }
+    return abort ? std::vector<int64_t>() : timestamps;
+}
+
+// The keyframe indexes are shared by the processes of the host through files
+QString _getKeyframeIndexFile(const QString& uri, const int streamIndex)
+{
+    const auto info = QFileInfo{uri};
+    const auto id = QString("%1|%2|%3|%4")
+                        .arg(info.absoluteFilePath())
+                        .arg(info.size())
+                        .arg(info.lastModified().toMSecsSinceEpoch())
+                        .arg(streamIndex);
+    const auto hash =
+        QCryptographicHash::hash(id.toUtf8(), QCryptographicHash::Sha1);
+    return QString("%1/tide-keyframes-%2/%3.idx")
+        .arg(QDir::tempPath())
+        .arg(qgetenv("USER").constData())
+        .arg(hash.toHex().constData());
+}
+
+bool _readKeyframeIndex(const QString& filename,
+                        std::vector<int64_t>& timestamps)
+{
+    QFile file{filename};
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    const auto data = file.readAll();
+    if (data.isEmpty() || data.size() % sizeof(int64_t) != 0)
+        return false;
+
+    timestamps.resize(data.size() / sizeof(int64_t));
+    std::memcpy(timestamps.data(), data.constData(), data.size());
+    return true;
+}
+
+void _writeKeyframeIndex(const QString& filename,
+                         const std::vector<int64_t>& timestamps)
+{
+    QSaveFile file{filename};
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    file.write(reinterpret_cast<const char*>(timestamps.data()),
+               timestamps.size() * sizeof(int64_t));
+    file.commit();
+}
+
+// The first process of the host scans the movie while the others wait for the
+// index it writes, instead of all demuxing the whole file at once.
+std::vector<int64_t> _getKeyframes(const QString& uri, const int streamIndex,
+                                   const std::atomic<bool>& abort)
+{
+    if (abort)
+        return {};
+
+    const auto filename = _getKeyframeIndexFile(uri, streamIndex);
+    QDir().mkpath(QFileInfo{filename}.path());
+
+    QLockFile lock{filename + ".lock"};
+    while (!lock.tryLock(100))
+    {
+        if (abort)
+            return {};
+        if (lock.error() != QLockFile::LockFailedError)
+            return _scanKeyframes(uri, streamIndex, abort); // no sharing
+    }
+
+    std::vector<int64_t> timestamps;
+    if (_readKeyframeIndex(filename, timestamps))
+        return timestamps;
+
+    timestamps = _scanKeyframes(uri, streamIndex, abort);
+    if (!timestamps.empty())
+        _writeKeyframeIndex(filename, timestamps);
+    return timestamps;
+}
+
+QThreadPool& _keyframeScanPool()
+{
+    // Not the global pool, which loads the tiles of all the contents
+    static auto pool = [] {
+        auto threadPool = new QThreadPool;
+        threadPool->setMaxThreadCount(1);
+        return threadPool;
+    }();
+    return *pool;
+}
+
+double _secondsSince(const std::chrono::steady_clock::time_point start)
+{
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double>(elapsed).count();
+}
+
 struct FFMPEGStaticInit
 {
     FFMPEGStaticInit()
@@ -117,8 +251,10 @@ static FFMPEGStaticInit instance;
 } // namespace
 
 FFMPEGMovie::FFMPEGMovie(const QString& uri)
-    : _avFormatContext{_createAvFormatContext(uri)}
+    : _uri{uri}
+    , _avFormatContext{_createAvFormatContext(uri)}
     , _videoStream{std::make_unique<FFMPEGVideoStream>(*_avFormatContext)}
+    , _keyframes{_videoStream->getIndexedKeyframes()}
 {
     const auto format = _videoStream->getAVFormat();
     if (!FFMPEGUtils::isSupportedOutputFormat(format))
@@ -134,7 +270,11 @@ FFMPEGMovie::FFMPEGMovie(const QString& uri)
     }
 }
 
-FFMPEGMovie::~FFMPEGMovie() = default;
+FFMPEGMovie::~FFMPEGMovie()
+{
+    _abortKeyframeScan = true;
+    _keyframeScan.waitForFinished();
+}
 
 unsigned int FFMPEGMovie::getWidth() const
 {
@@ -166,25 +306,57 @@ double FFMPEGMovie::getFrameDuration() const
     return _videoStream->getFrameDuration();
 }
 
-PicturePtr FFMPEGMovie::getFrame(double posInSeconds)
+void FFMPEGMovie::indexKeyframes()
+{
+    if (!_keyframes.isEmpty() || _keyframeScan.isRunning())
+        return;
+
+    const auto streamIndex = _videoStream->getStreamIndex();
+    auto pool = &_keyframeScanPool();
+    _keyframeScan = QtConcurrent::run(pool, [ this, uri = _uri, streamIndex ] {
+        return _getKeyframes(uri, streamIndex, _abortKeyframeScan);
+    });
+}
+
+size_t FFMPEGMovie::getKeyframeCount() const
+{
+    return _keyframes.getSize();
+}
+
+double FFMPEGMovie::getLastSeekTime() const
 {
+    return _lastSeekTime;
+}
+
+PicturePtr FFMPEGMovie::getFrame(double posInSeconds, const SeekMode mode)
+{
+    _collectKeyframeScan();
+    _lastSeekTime = 0.0;
+
     posInSeconds = std::max(0.0, std::min(posInSeconds, getDuration()));
     const auto frameDuration = _videoStream->getFrameDuration();
     const auto target = std::max(0.0, posInSeconds - frameDuration);
-    const auto frameIndex = _videoStream->getFrameIndex(target);
+    auto frameIndex = _videoStream->getFrameIndex(target);
+
+    // A keyframe is displayed after a single decode, which keeps scrubbing
+    // responsive on movies with long groups of pictures.
+    const bool toKeyframe = mode == SeekMode::keyframe && !_keyframes.isEmpty();
+    if (toKeyframe)
+    {
+        frameIndex = _keyframes.findNearest(frameIndex);
+        posInSeconds = (frameIndex + 1) * frameDuration;
+        posInSeconds = std::min(posInSeconds, getDuration());
+    }
 
     _frameIndex = frameIndex;
     _streamPosition = posInSeconds;
     int64_t frameIndexCurr = _frameLastDecode;
     _frameLastDecode = _frameIndex;
 
-    // Seek back for loop or forward if too far away
-    const auto streamDelta = frameIndex - frameIndexCurr;
-    if (streamDelta < 0 || std::abs(streamDelta) > MIN_SEEK_DELTA_FRAMES)
-    {
-        if (!_videoStream->seekToNearestFullframe(frameIndex))
-            return nullptr;
-    }
+    const auto seekStart = std::chrono::steady_clock::now();
+    const bool seek = toKeyframe || _needsSeek(frameIndexCurr, frameIndex);
+    if (seek && !_videoStream->seekToNearestFullframe(frameIndex))
+        return nullptr;
 
     const auto targetTimestamp = _videoStream->getTimestamp(frameIndex);
     if (targetTimestamp == AV_NOPTS_VALUE)
@@ -214,9 +386,41 @@ PicturePtr FFMPEGMovie::getFrame(double posInSeconds)
         }
     }
 
+    if (seek)
+        _lastSeekTime = _secondsSince(seekStart);
+
     // handle (rare) EOF case
     if (avReadStatus < 0)
         picture = PicturePtr();
 
     return picture;
 }
+
+void FFMPEGMovie::_collectKeyframeScan()
+{
+    if (!_keyframeScan.isFinished() || _keyframeScan.resultCount() == 0)
+        return;
+
+    auto keyframes = _keyframeScan.result();
+    for (auto& timestamp : keyframes)
+        timestamp = _videoStream->getFrameIndex(timestamp);
+    _keyframes = KeyframeIndex{std::move(keyframes)};
+    _keyframeScan = QFuture<std::vector<int64_t>>();
+}
+
+bool FFMPEGMovie::_needsSeek(const int64_t fromFrame,
+                             const int64_t toFrame) const
+{
+    // Seek back for loop or forward if too far away
+    const auto streamDelta = toFrame - fromFrame;
+    if (streamDelta < 0)
+        return true;
+    if (streamDelta <= MIN_SEEK_DELTA_FRAMES)
+        return false;
+
+    // Seeking would land on the keyframe that started the current group of
+    // pictures if there is none up to the target, then decode the same frames
+    // again; decoding forward from the current position is always cheaper.
+    return _keyframes.isEmpty() ||
+           _keyframes.hasKeyframeBetween(fromFrame, toFrame);
+}
@@ -41,9 +41,21 @@
 #define FFMPEGMOVIE_H
 
 #include "FFMPEGWrappers.h"
+#include "KeyframeIndex.h"
 
 #include "types.h"
 
+#include <QFuture>
+
+#include <atomic>
+
+/** How to position a movie when getting a frame. */
+enum class SeekMode
+{
+    exact,   // the frame at the requested position
+    keyframe // the keyframe nearest to the requested position (faster)
+};
+
 /**
  * Read and play movies using the FFMPEG library.
  */
@@ -81,17 +93,46 @@ public:
      * Get a frame at the given position in seconds.
      *
      * @param posInSeconds request position in seconds; clamped if out-of-bounds
+     * @param mode exact position or nearest keyframe; the latter falls back to
+     *        exact positioning until the keyframe index is available.
      * @return the decoded movie image that was closest to posInSeconds, nullptr
      *         otherwise
      */
-    PicturePtr getFrame(double posInSeconds);
+    PicturePtr getFrame(double posInSeconds, SeekMode mode = SeekMode::exact);
+
+    /**
+     * Build the keyframe index in the background, unless it could be read from
+     * the container when opening the movie.
+     *
+     * The movie is scanned on a dedicated thread by only one process of the
+     * host, which shares the index with the others through a temporary file.
+     */
+    void indexKeyframes();
+
+    /** @return the number of keyframes currently indexed. */
+    size_t getKeyframeCount() const;
+
+    /**
+     * @return the time in seconds that the last getFrame() spent seeking and
+     *         decoding up to the target, 0 if it did not have to seek.
+     */
+    double getLastSeekTime() const;
 
 private:
+    const QString _uri;
     AVFormatContextPtr _avFormatContext;
     std::unique_ptr<FFMPEGVideoStream> _videoStream;
     int64_t _frameIndex = 0;
     int64_t _frameLastDecode = 0;
     double _streamPosition = 0.0;
+    double _lastSeekTime = 0.0;
+
+    KeyframeIndex _keyframes;
+    QFuture<std::vector<int64_t>> _keyframeScan;
+    std::atomic<bool> _abortKeyframeScan{false};
+
+    void _collectKeyframeScan();
+    bool _needsSeek(int64_t fromFrame, int64_t toFrame) const;
 };
 
 #endif
@@ -50,6 +50,10 @@
 // FFMPEG 4.0
 #define HAS_FFMPEG_4_API (LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(58, 18, 100))
 
+// FFMPEG 4.4
+#define HAS_INDEX_ENTRY_API \
+    (LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100))
+
 extern "C"
 {
 #include <libavutil/stereo3d.h>
@@ -212,6 +216,37 @@ bool FFMPEGVideoStream::seekToNearestFullframe(const int64_t frameIndex)
     return true;
 }
 
+int FFMPEGVideoStream::getStreamIndex() const
+{
+    return _videoStream->index;
+}
+
+std::vector<int64_t> FFMPEGVideoStream::getIndexedKeyframes() const
+{
+    std::vector<int64_t> keyframes;
+#if HAS_INDEX_ENTRY_API
+    const auto count = avformat_index_get_entries_count(_videoStream);
+#else
+    const auto count = _videoStream->nb_index_entries;
+#endif
+    // Some containers only index a subset of the keyframes (e.g. Matroska
+    // cues), which would hide the groups of pictures between them.
+    if (count < _numFrames - 1)
+        return keyframes;
+
+    for (int i = 0; i < count; ++i)
+    {
+#if HAS_INDEX_ENTRY_API
+        const auto& entry = *avformat_index_get_entry(_videoStream, i);
+#else
+        const auto& entry = _videoStream->index_entries[i];
+#endif
+        if (entry.flags & AVINDEX_KEYFRAME)
+            keyframes.push_back(getFrameIndex(entry.timestamp));
+    }
+    return keyframes;
+}
+
 void FFMPEGVideoStream::_findVideoStream()
 {
     for (unsigned int i = 0; i < _avFormatContext.nb_streams; ++i)
@@ -52,6 +52,8 @@ extern "C"
 
 #include "types.h"
 
+#include <vector>
+
 /** A video stream from an FFMPEG file. */
 class FFMPEGVideoStream
 {
@@ -111,6 +113,16 @@ public:
     /** Seek to the nearest full frame in the video. */
     bool seekToNearestFullframe(int64_t frameIndex);
 
+    /** @return the index of the video stream in the format context. */
+    int getStreamIndex() const;
+
+    /**
+     * Get the keyframes listed in the index of the container.
+     * @return the frame indices of the keyframes, or an empty list if the
+     *         index of the container does not cover all the frames.
+     */
+    std::vector<int64_t> getIndexedKeyframes() const;
+
 private:
     AVFormatContext& _avFormatContext;
 
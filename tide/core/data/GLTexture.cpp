@@ -0,0 +1,211 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "GLTexture.h"
+
+#include <QOpenGLContext>
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLFunctions>
+
+#include <map>
+
+namespace
+{
+// Enough for re-rendering the visible tiles of a few windows
+const size_t maxRecycledTextures = 16;
+
+std::pair<int, int> _key(const QSize& size)
+{
+    return {size.width(), size.height()};
+}
+
+uint _createTexture(const QSize& size)
+{
+    auto gl = QOpenGLContext::currentContext()->functions();
+
+    auto textureID = GLuint{0};
+    gl->glGenTextures(1, &textureID);
+    gl->glBindTexture(GL_TEXTURE_2D, textureID);
+    gl->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size.width(), size.height(), 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    gl->glBindTexture(GL_TEXTURE_2D, 0);
+    return textureID;
+}
+}
+
+/** The textures of a GL share group, protected by the global mutex. */
+struct GLTextureShareGroup
+{
+    std::multimap<std::pair<int, int>, uint> recycledTextures;
+    std::vector<uint> texturesToDelete;
+    std::vector<GLsync> fencesToDelete;
+    // Cleared when the share group is destroyed, along with its textures
+    bool alive = true;
+};
+
+namespace
+{
+std::mutex mutex;
+std::map<QOpenGLContextGroup*, std::shared_ptr<GLTextureShareGroup>>
+    shareGroups;
+
+/** @return the textures of the share group of the current context. */
+std::shared_ptr<GLTextureShareGroup> _getShareGroup(const bool create)
+{
+    const auto context = QOpenGLContext::currentContext();
+    if (!context)
+        return nullptr;
+
+    const auto group = context->shareGroup();
+    const auto it = shareGroups.find(group);
+    if (it != shareGroups.end())
+        return it->second;
+    if (!create)
+        return nullptr;
+
+    auto shareGroup = std::make_shared<GLTextureShareGroup>();
+    shareGroups.emplace(group, shareGroup);
+    QObject::connect(group, &QObject::destroyed, [group] {
+        const std::lock_guard<std::mutex> lock{mutex};
+        const auto it = shareGroups.find(group);
+        it->second->alive = false;
+        shareGroups.erase(it);
+    });
+    return shareGroup;
+}
+}
+
+GLTexturePtr GLTexture::acquire(const QSize& size)
+{
+    deleteReleasedTextures();
+
+    auto id = uint{0};
+    std::shared_ptr<GLTextureShareGroup> shareGroup;
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        shareGroup = _getShareGroup(true);
+        auto& recycled = shareGroup->recycledTextures;
+        const auto it = recycled.find(_key(size));
+        if (it != recycled.end())
+        {
+            id = it->second;
+            recycled.erase(it);
+        }
+    }
+
+    if (id == 0)
+        id = _createTexture(size);
+
+    return GLTexturePtr{new GLTexture{id, size, std::move(shareGroup)}};
+}
+
+bool GLTexture::isSharingAvailable()
+{
+    const auto context = QOpenGLContext::currentContext();
+    const auto shareContext = QOpenGLContext::globalShareContext();
+    return context && shareContext &&
+           QOpenGLContext::areSharing(context, shareContext);
+}
+
+void GLTexture::deleteReleasedTextures()
+{
+    std::vector<uint> textures;
+    std::vector<GLsync> fences;
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        const auto shareGroup = _getShareGroup(false);
+        if (!shareGroup)
+            return;
+        std::swap(textures, shareGroup->texturesToDelete);
+        std::swap(fences, shareGroup->fencesToDelete);
+    }
+
+    const auto context = QOpenGLContext::currentContext();
+    if (!textures.empty())
+        context->functions()->glDeleteTextures(textures.size(),
+                                               textures.data());
+    for (auto fence : fences)
+        context->extraFunctions()->glDeleteSync(fence);
+}
+
+GLTexture::GLTexture(const uint id, const QSize& size,
+                     std::shared_ptr<GLTextureShareGroup> shareGroup)
+    : _id{id}
+    , _size{size}
+    , _shareGroup{std::move(shareGroup)}
+{
+}
+
+GLTexture::~GLTexture()
+{
+    const std::lock_guard<std::mutex> lock{mutex};
+    if (!_shareGroup->alive)
+        return;
+
+    if (_fence)
+        _shareGroup->fencesToDelete.push_back(_fence);
+
+    if (_shareGroup->recycledTextures.size() < maxRecycledTextures)
+        _shareGroup->recycledTextures.emplace(_key(_size), _id);
+    else
+        _shareGroup->texturesToDelete.push_back(_id);
+}
+
+void GLTexture::setRenderingFence()
+{
+    auto gl = QOpenGLContext::currentContext()->extraFunctions();
+
+    const std::lock_guard<std::mutex> lock{_fenceMutex};
+    if (_fence)
+        gl->glDeleteSync(_fence);
+    _fence = gl->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    // The other contexts can only wait for a fence which has been flushed
+    gl->glFlush();
+}
+
+void GLTexture::waitForRendering() const
+{
+    const std::lock_guard<std::mutex> lock{_fenceMutex};
+    if (!_fence)
+        return;
+
+    auto gl = QOpenGLContext::currentContext()->extraFunctions();
+    gl->glWaitSync(_fence, 0, GL_TIMEOUT_IGNORED);
+    gl->glDeleteSync(_fence);
+    _fence = nullptr;
+}
@@ -0,0 +1,117 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef GLTEXTURE_H
+#define GLTEXTURE_H
+
+#include "types.h"
+
+#include <qopengl.h>
+
+#include <mutex>
+
+struct GLTextureShareGroup;
+
+/**
+ * An RGBA OpenGL texture shared by the render contexts of a wall process.
+ *
+ * Released textures are not deleted but recycled for the next texture of the
+ * same size in the same share group. This avoids reallocating GPU memory when
+ * tiles are re-rendered, and allows releasing textures from any thread. The
+ * textures which can not be recycled are deleted later by a context of their
+ * share group, @see deleteReleasedTextures().
+ */
+class GLTexture
+{
+public:
+    /**
+     * Get a texture, recycled or created in the current GL context.
+     *
+     * Must be called from a thread with a current GL context which shares its
+     * objects with all the render contexts, @see isSharingAvailable().
+     * @param size of the texture
+     */
+    static GLTexturePtr acquire(const QSize& size);
+
+    /**
+     * @return true if the current GL context shares its objects with the
+     *         global share context (Qt::AA_ShareOpenGLContexts).
+     */
+    static bool isSharingAvailable();
+
+    /**
+     * Delete the released textures of the share group of the current GL
+     * context which could not be recycled. Called after each frame by the
+     * render threads, does nothing without a current context.
+     */
+    static void deleteReleasedTextures();
+
+    /** Release the texture for recycling. */
+    ~GLTexture();
+
+    /** @return the OpenGL texture id. */
+    uint getId() const { return _id; }
+    /** @return the size of the texture. */
+    QSize getSize() const { return _size; }
+    /**
+     * Insert a fence after the commands which render the texture.
+     *
+     * Must be called in the context which rendered the texture, before handing
+     * it over to the render contexts.
+     */
+    void setRenderingFence();
+
+    /**
+     * Make the current GL context wait for the rendering of the texture before
+     * using it, without blocking the calling thread.
+     */
+    void waitForRendering() const;
+
+private:
+    GLTexture(uint id, const QSize& size,
+              std::shared_ptr<GLTextureShareGroup> shareGroup);
+
+    const uint _id;
+    const QSize _size;
+    const std::shared_ptr<GLTextureShareGroup> _shareGroup;
+
+    mutable std::mutex _fenceMutex;
+    mutable GLsync _fence = nullptr;
+};
+
+#endif
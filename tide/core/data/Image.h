@@ -108,6 +108,12 @@ public:
      * isGpuImage() is true;
      */
     virtual bool generateGpuImage() const { return false; }
+
+    /**
+     * @return the texture holding the image if it is resident on the GPU, in
+     *         which case getData() returns nullptr.
+     */
+    virtual GLTexturePtr getGLTexture() const { return GLTexturePtr(); }
 };
 
 #endif
@@ -0,0 +1,83 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "KeyframeIndex.h"
+
+#include <algorithm>
+
+KeyframeIndex::KeyframeIndex(std::vector<int64_t> keyframes)
+    : _keyframes{std::move(keyframes)}
+{
+    std::sort(_keyframes.begin(), _keyframes.end());
+    _keyframes.erase(std::unique(_keyframes.begin(), _keyframes.end()),
+                     _keyframes.end());
+}
+
+bool KeyframeIndex::isEmpty() const
+{
+    return _keyframes.empty();
+}
+
+size_t KeyframeIndex::getSize() const
+{
+    return _keyframes.size();
+}
+
+int64_t KeyframeIndex::findNearest(const int64_t frame) const
+{
+    if (_keyframes.empty())
+        return frame;
+
+    const auto next =
+        std::lower_bound(_keyframes.begin(), _keyframes.end(), frame);
+    if (next == _keyframes.begin())
+        return *next;
+    if (next == _keyframes.end())
+        return _keyframes.back();
+
+    const auto previous = *std::prev(next);
+    return frame - previous <= *next - frame ? previous : *next;
+}
+
+bool KeyframeIndex::hasKeyframeBetween(const int64_t from,
+                                       const int64_t to) const
+{
+    const auto next =
+        std::upper_bound(_keyframes.begin(), _keyframes.end(), from);
+    return next != _keyframes.end() && *next <= to;
+}
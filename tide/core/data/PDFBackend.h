@@ -42,6 +42,9 @@
 
 #include <QImage>
 
+#include <cstdlib>
+#include <iterator>
+
 /**
  * An abstract interface for PDF backends.
  *
@@ -73,6 +76,31 @@ public:
      */
     virtual QImage renderToImage(const QSize& imageSize,
                                  const QRectF& region) const = 0;
+
+protected:
+    /** Page objects kept open, to avoid fetching them again for each tile. */
+    static constexpr size_t maxCachedPages = 8;
+
+    /**
+     * Close the open pages farthest from the current one, keeping at most
+     * maxCachedPages of them.
+     * @param pages the open pages, ordered by page number
+     * @param pageNumber the current page
+     */
+    template <typename Pages>
+    static void evictPagesFarthestFrom(Pages& pages, const int pageNumber)
+    {
+        while (pages.size() > maxCachedPages)
+        {
+            const auto first = pages.begin();
+            const auto last = std::prev(pages.end());
+            if (std::abs(first->first - pageNumber) >
+                std::abs(last->first - pageNumber))
+                pages.erase(first);
+            else
+                pages.erase(last);
+        }
+    }
 };
 
 #endif
@@ -44,6 +44,7 @@
 #include "CairoWrappers.h"
 
 #include <cstring> // std::memset
+#include <map>
 
 struct PopplerPageDeleter
 {
@@ -60,7 +61,8 @@ using PopplerDocumentPtr = std::unique_ptr<PopplerDocument, PopplerDocDeleter>;
 struct PDFPopplerCairoBackend::Impl
 {
     PopplerDocumentPtr document;
-    PopplerPagePtr page;
+    std::map<int, PopplerPagePtr> pages;
+    PopplerPage* page = nullptr;
 };
 
 std::string _getFilepath(const QString& uri)
@@ -86,7 +88,7 @@ PDFPopplerCairoBackend::~PDFPopplerCairoBackend() {}
 QSize PDFPopplerCairoBackend::getSize() const
 {
     QSizeF size;
-    poppler_page_get_size(_impl->page.get(), &size.rwidth(), &size.rheight());
+    poppler_page_get_size(_impl->page, &size.rwidth(), &size.rheight());
     return size.toSize();
 }
 
@@ -97,12 +99,19 @@ int PDFPopplerCairoBackend::getPageCount() const
 
 bool PDFPopplerCairoBackend::setPage(const int pageNumber)
 {
-    auto page = PopplerPagePtr{
-        poppler_document_get_page(_impl->document.get(), pageNumber)};
+    auto& page = _impl->pages[pageNumber];
     if (!page)
-        return false;
-
-    _impl->page = std::move(page);
+    {
+        const auto document = _impl->document.get();
+        page.reset(poppler_document_get_page(document, pageNumber));
+        if (!page)
+        {
+            _impl->pages.erase(pageNumber);
+            return false;
+        }
+    }
+    _impl->page = page.get();
+    evictPagesFarthestFrom(_impl->pages, pageNumber);
     return true;
 }
 
@@ -164,7 +173,7 @@ QImage PDFPopplerCairoBackend::renderToImage(const QSize& imageSize,
     cairo_translate(context.get(), -topLeft.x(), -topLeft.y());
 
     cairo_save(context.get());
-    _threadSafeRenderPage(_impl->page.get(), context.get());
+    _threadSafeRenderPage(_impl->page, context.get());
     cairo_restore(context.get());
 
     // Then the image is painted on top of a white "page".
@@ -71,11 +71,18 @@ int PDFPopplerQtBackend::getPageCount() const
 
 bool PDFPopplerQtBackend::setPage(const int pageNumber)
 {
-    Poppler::Page* page = _pdfDoc->page(pageNumber);
+    auto& page = _pages[pageNumber];
     if (!page)
-        return false;
-
-    _pdfPage.reset(page);
+    {
+        page.reset(_pdfDoc->page(pageNumber));
+        if (!page)
+        {
+            _pages.erase(pageNumber);
+            return false;
+        }
+    }
+    _pdfPage = page.get();
+    evictPagesFarthestFrom(_pages, pageNumber);
     return true;
 }
 
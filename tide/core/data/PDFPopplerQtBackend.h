@@ -44,6 +44,8 @@
 
 #include "types.h"
 
+#include <map>
+
 namespace Poppler
 {
 class Document;
@@ -80,7 +82,8 @@ public:
 
 private:
     std::unique_ptr<Poppler::Document> _pdfDoc;
-    std::unique_ptr<Poppler::Page> _pdfPage;
+    std::map<int, std::unique_ptr<Poppler::Page>> _pages;
+    Poppler::Page* _pdfPage = nullptr;
 };
 
 #endif
@@ -105,3 +105,9 @@ QImage SVG::renderToImage(const QSize& imageSize, const QRectF& region) const
 {
     return _impl->svg->renderToImage(imageSize, region);
 }
+
+GLTexturePtr SVG::renderToTexture(const QSize& imageSize,
+                                  const QRectF& region) const
+{
+    return _impl->svg->renderToTexture(imageSize, region);
+}
@@ -92,6 +92,17 @@ public:
     QImage renderToImage(const QSize& imageSize,
                          const QRectF& region = UNIT_RECTF) const;
 
+    /**
+     * Render the document to a GPU texture, without reading it back.
+     * @param imageSize the desired size for the texture
+     * @param region the target area of the svg to render, in normalized coord.
+     * @return the texture, or nullptr if the backend can't render to textures.
+     * @note must be called from a thread with an active OpenGL context which
+     *       shares its objects with the render contexts.
+     */
+    GLTexturePtr renderToTexture(const QSize& imageSize,
+                                 const QRectF& region = UNIT_RECTF) const;
+
 private:
     struct Impl;
     std::unique_ptr<Impl> _impl;
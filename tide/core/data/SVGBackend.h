@@ -40,6 +40,8 @@
 #ifndef SVGBACKEND
 #define SVGBACKEND
 
+#include "types.h"
+
 #include <QImage>
 
 /**
@@ -64,6 +66,20 @@ public:
      */
     virtual QImage renderToImage(const QSize& imageSize,
                                  const QRectF& region) const = 0;
+
+    /**
+     * Render the document to a GPU texture.
+     * @param imageSize the desired size for the texture
+     * @param region the target area of the svg to render, in normalized coord.
+     * @return the texture, or nullptr if unsupported by the backend.
+     */
+    virtual GLTexturePtr renderToTexture(const QSize& imageSize,
+                                         const QRectF& region) const
+    {
+        Q_UNUSED(imageSize);
+        Q_UNUSED(region);
+        return GLTexturePtr();
+    }
 };
 
 #endif
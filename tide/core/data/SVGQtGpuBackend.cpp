@@ -39,7 +39,10 @@
 
 #include "SVGQtGpuBackend.h"
 
+#include "GLTexture.h"
+
 #include <QOpenGLContext>
+#include <QOpenGLExtraFunctions>
 #include <QOpenGLFramebufferObject>
 #include <QOpenGLFunctions>
 #include <QOpenGLPaintDevice>
@@ -112,6 +115,51 @@ QRectF _getViewBox(const QRectF& zoomRect, const QRectF& svgExtents)
 
 QImage SVGQtGpuBackend::renderToImage(const QSize& imageSize,
                                       const QRectF& region) const
+{
+    auto renderFbo = _renderMultisampled(imageSize, region);
+
+    // Blit to target texture FBO
+    const QRect blitRect(0, 0, renderFbo->width(), renderFbo->height());
+    QOpenGLFramebufferObject targetFbo(renderFbo->size());
+    QOpenGLFramebufferObject::blitFramebuffer(&targetFbo, blitRect,
+                                              renderFbo.get(), blitRect);
+
+    return targetFbo.toImage();
+}
+
+GLTexturePtr SVGQtGpuBackend::renderToTexture(const QSize& imageSize,
+                                              const QRectF& region) const
+{
+    auto renderFbo = _renderMultisampled(imageSize, region);
+    auto texture = GLTexture::acquire(imageSize);
+
+    // Resolve the multisampled FBO directly into the texture
+    auto context = QOpenGLContext::currentContext();
+    auto gl = context->extraFunctions();
+    auto targetFbo = GLuint{0};
+    gl->glGenFramebuffers(1, &targetFbo);
+    gl->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, targetFbo);
+    gl->glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                               GL_TEXTURE_2D, texture->getId(), 0);
+    gl->glBindFramebuffer(GL_READ_FRAMEBUFFER, renderFbo->handle());
+    gl->glBlitFramebuffer(0, 0, imageSize.width(), imageSize.height(), 0, 0,
+                          imageSize.width(), imageSize.height(),
+                          GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    QOpenGLFramebufferObject::bindDefault();
+    gl->glDeleteFramebuffers(1, &targetFbo);
+
+    gl->glBindTexture(GL_TEXTURE_2D, texture->getId());
+    gl->glGenerateMipmap(GL_TEXTURE_2D);
+    gl->glBindTexture(GL_TEXTURE_2D, 0);
+
+    // The texture is used by the other render contexts of the process
+    texture->setRenderingFence();
+
+    return texture;
+}
+
+std::unique_ptr<QOpenGLFramebufferObject> SVGQtGpuBackend::_renderMultisampled(
+    const QSize& imageSize, const QRectF& region) const
 {
     _saveGLState();
 
@@ -136,11 +184,5 @@ QImage SVGQtGpuBackend::renderToImage(const QSize& imageSize,
     renderFbo->release();
     _restoreGLState();
 
-    // Blit to target texture FBO
-    const QRect blitRect(0, 0, renderFbo->width(), renderFbo->height());
-    QOpenGLFramebufferObject targetFbo(renderFbo->size());
-    QOpenGLFramebufferObject::blitFramebuffer(&targetFbo, blitRect,
-                                              renderFbo.get(), blitRect);
-
-    return targetFbo.toImage();
+    return renderFbo;
 }
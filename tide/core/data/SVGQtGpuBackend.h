@@ -45,6 +45,8 @@
 #include <QMutex>
 #include <QSvgRenderer>
 
+class QOpenGLFramebufferObject;
+
 /**
  * Renders an svg document into a texure using hardware antialiasing.
  */
@@ -68,9 +70,19 @@ public:
     QImage renderToImage(const QSize& imageSize,
                          const QRectF& region) const final;
 
+    /**
+     * Render the specified area into a texture which stays on the GPU.
+     * This function must be called on a thread with an active GL context.
+     */
+    GLTexturePtr renderToTexture(const QSize& imageSize,
+                                 const QRectF& region) const final;
+
 private:
     mutable QMutex _mutex;
     mutable QSvgRenderer _svgRenderer; // mutable because paint() is not const
+
+    std::unique_ptr<QOpenGLFramebufferObject> _renderMultisampled(
+        const QSize& imageSize, const QRectF& region) const;
 };
 
 #endif
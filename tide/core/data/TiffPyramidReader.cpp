@@ -133,6 +133,52 @@ struct TiffPyramidReader::Impl
     {
         if (!TIFFSetDirectory(tif.get(), lod))
             throw std::runtime_error("Invalid pyramid level");
+
+        // Let libjpeg convert YCbCr tiles (e.g. from tidePyramidMaker) to RGB
+        if (hasYCbCrJpegTiles())
+            TIFFSetField(tif.get(), TIFFTAG_JPEGCOLORMODE, JPEGCOLORMODE_RGB);
+    }
+
+    bool hasYCbCrJpegTiles()
+    {
+        uint16_t compression = 0;
+        uint16_t photometric = 0;
+        TIFFGetField(tif.get(), TIFFTAG_COMPRESSION, &compression);
+        TIFFGetField(tif.get(), TIFFTAG_PHOTOMETRIC, &photometric);
+        return compression == COMPRESSION_JPEG &&
+               photometric == PHOTOMETRIC_YCBCR;
+    }
+
+    QByteArray readJpegTile(const QPoint& tileCoord)
+    {
+        validate(tileCoord);
+        const auto index =
+            TIFFComputeTile(tif.get(), tileCoord.x(), tileCoord.y(), 0, 0);
+
+        uint64_t* byteCounts = nullptr;
+        if (!TIFFGetField(tif.get(), TIFFTAG_TILEBYTECOUNTS, &byteCounts) ||
+            !byteCounts)
+        {
+            throw std::runtime_error("Missing tile byte counts");
+        }
+
+        auto data = QByteArray(byteCounts[index], Qt::Uninitialized);
+        if (TIFFReadRawTile(tif.get(), index, data.data(), data.size()) < 0)
+            throw std::runtime_error("Could not read raw tile");
+
+        // Abbreviated tiles refer to the tables shared by the whole level:
+        // merge [SOI tables EOI] and [SOI tile EOI] into [SOI tables tile EOI]
+        uint32_t tablesSize = 0;
+        void* tables = nullptr;
+        if (TIFFGetField(tif.get(), TIFFTAG_JPEGTABLES, &tablesSize, &tables) &&
+            tablesSize > 4)
+        {
+            auto image = QByteArray(static_cast<const char*>(tables),
+                                    int(tablesSize) - 2);
+            image.append(data.constData() + 2, data.size() - 2);
+            return image;
+        }
+        return data;
     }
 
     void readTile(const QPoint& tileCoord, const int bytesPerPixel,
@@ -149,7 +195,7 @@ struct TiffPyramidReader::Impl
 
     void readGrayscaleWithAlphaTile(const QPoint& tileCoord, QImage& image)
     {
-        if (!hasAssociatedAlpha())
+        if (!hasAlpha())
             throw std::runtime_error("Unknown data layout");
 
         auto buffer = std::vector<uint16_t>(image.width() * image.height());
@@ -169,7 +215,7 @@ struct TiffPyramidReader::Impl
             throw std::runtime_error("Invalid coordinates");
     }
 
-    bool hasAssociatedAlpha()
+    bool hasAlpha()
     {
         uint16_t extra = EXTRASAMPLE_UNSPECIFIED;
         // WAR to avoid random segfaults when TIFFTAG_EXTRASAMPLES exists.
@@ -185,7 +231,8 @@ struct TiffPyramidReader::Impl
         // first variable...
         std::array<int16_t, 10> overflowBuffer;
         TIFFGetField(tif.get(), TIFFTAG_EXTRASAMPLES, &extra, &overflowBuffer);
-        return extra == EXTRASAMPLE_ASSOCALPHA;
+        return extra == EXTRASAMPLE_ASSOCALPHA ||
+               extra == EXTRASAMPLE_UNASSALPHA;
     }
 };
 
@@ -221,7 +268,7 @@ int TiffPyramidReader::getBytesPerPixel() const
 
 bool TiffPyramidReader::hasAlphaChannel() const
 {
-    return _impl->hasAssociatedAlpha();
+    return _impl->hasAlpha();
 }
 
 uint TiffPyramidReader::findTopPyramidLevel()
@@ -273,6 +320,28 @@ QImage TiffPyramidReader::readTile(const int i, const int j, const uint lod)
     }
 }
 
+QByteArray TiffPyramidReader::readJpegTile(const int i, const int j,
+                                           const uint lod)
+{
+    try
+    {
+        _impl->setDirectory(lod);
+        if (!_impl->hasYCbCrJpegTiles())
+            return QByteArray();
+
+        const auto tileSize = getTileSize();
+        const auto tileCoord =
+            QPoint{i * tileSize.width(), j * tileSize.height()};
+        return _impl->readJpegTile(tileCoord);
+    }
+    catch (const std::runtime_error& e)
+    {
+        print_log(LOG_WARN, LOG_TIFF, "%s for tile (%d, %d) @ LOD %d", e.what(),
+                  i, j, lod);
+        return QByteArray();
+    }
+}
+
 QImage TiffPyramidReader::readTopLevelImage()
 {
     auto image = readTile(0, 0, findTopPyramidLevel());
@@ -40,6 +40,7 @@
 #ifndef TIFFPYRAMIDREADER_H
 #define TIFFPYRAMIDREADER_H
 
+#include <QByteArray>
 #include <QImage>
 #include <memory>
 
@@ -99,6 +100,14 @@ public:
     /** Read a tile at the given indices and level of detail. */
     QImage readTile(int i, int j, uint lod);
 
+    /**
+     * Read the compressed data of a tile without decoding it.
+     *
+     * @return a standalone JPEG image of the full tile size, or an empty array
+     *         if the level is not JPEG compressed in the YCbCr color space.
+     */
+    QByteArray readJpegTile(int i, int j, uint lod);
+
     /** Read the image at the top of the pyramid (i.e. <= tileSize). */
     QImage readTopLevelImage();
 
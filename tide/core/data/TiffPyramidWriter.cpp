@@ -0,0 +1,521 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "TiffPyramidWriter.h"
+
+#include "utils/log.h"
+
+#include <QBuffer>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QImageWriter>
+#include <QTemporaryFile>
+#include <QtConcurrent>
+
+#include <tiffio.h>
+
+#include <cstring>
+#include <numeric>
+
+namespace
+{
+struct TIFFDeleter
+{
+    void operator()(TIFF* file) { TIFFClose(file); }
+};
+using TIFFPtr = std::unique_ptr<TIFF, TIFFDeleter>;
+
+using Codec = TiffPyramidWriter::Codec;
+
+// Use BigTIFF when the uncompressed image could exceed the 4GB limit
+const qint64 bigTiffThreshold = qint64(1) << 31;
+
+// TiffPyramidReader expects non-premultiplied pixels tagged as associated alpha
+QImage::Format _getFormat(const bool alpha)
+{
+    return alpha ? QImage::Format_RGBA8888 : QImage::Format_RGB888;
+}
+
+bool _isTiff(const QString& filename)
+{
+    const auto suffix = QFileInfo(filename).suffix().toLower();
+    return suffix == "tif" || suffix == "tiff";
+}
+
+/** Downsample an image by a factor two using a box filter. */
+QImage _downsample(const QImage& image)
+{
+    const int bytesPerPixel = image.depth() / 8;
+    auto result = QImage(image.width() / 2, image.height() / 2, image.format());
+
+    std::vector<int> rows(result.height());
+    std::iota(rows.begin(), rows.end(), 0);
+    QtConcurrent::blockingMap(rows, [&image, &result, bytesPerPixel](int y) {
+        const auto src0 = image.constScanLine(2 * y);
+        const auto src1 = image.constScanLine(2 * y + 1);
+        auto dst = result.scanLine(y);
+        const auto count = result.width() * bytesPerPixel;
+        for (int i = 0; i < count; ++i)
+        {
+            const auto x = (i / bytesPerPixel) * bytesPerPixel + i;
+            const auto sum = src0[x] + src0[x + bytesPerPixel] + src1[x] +
+                             src1[x + bytesPerPixel];
+            dst[i] = static_cast<uchar>((sum + 2) / 4);
+        }
+    });
+    return result;
+}
+
+QByteArray _toRawData(const QImage& tile)
+{
+    const auto bytesPerLine = tile.width() * tile.depth() / 8;
+    QByteArray data;
+    data.reserve(bytesPerLine * tile.height());
+    for (int y = 0; y < tile.height(); ++y)
+        data.append(reinterpret_cast<const char*>(tile.constScanLine(y)),
+                    bytesPerLine);
+    return data;
+}
+
+QByteArray _encode(const QImage& tile, const Codec codec, const int quality)
+{
+    switch (codec)
+    {
+    case Codec::jpeg:
+    {
+        QByteArray data;
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        QImageWriter writer(&buffer, "jpg");
+        writer.setQuality(quality);
+        if (!writer.write(tile))
+            throw std::runtime_error("JPEG compression failed: " +
+                                     writer.errorString().toStdString());
+        return data;
+    }
+    case Codec::deflate:
+        // Strip the size header added by Qt to get a plain zlib stream
+        return qCompress(_toRawData(tile)).mid(4);
+    case Codec::none:
+    default:
+        return _toRawData(tile);
+    }
+}
+
+/** Read TIFF images in strips, whatever their internal layout. */
+class TiffStripReader
+{
+public:
+    TiffStripReader(const QString& filename)
+        : _tif{TIFFOpen(filename.toLocal8Bit().constData(), "r")}
+    {
+        char error[1024];
+        if (!_tif || !TIFFRGBAImageOK(_tif.get(), error) ||
+            !TIFFRGBAImageBegin(&_image, _tif.get(), 0, error))
+        {
+            throw std::runtime_error("Unsupported TIFF image: " +
+                                     filename.toStdString());
+        }
+        _image.req_orientation = ORIENTATION_TOPLEFT;
+    }
+
+    ~TiffStripReader() { TIFFRGBAImageEnd(&_image); }
+    QSize getSize() const { return QSize(_image.width, _image.height); }
+    bool hasAlpha() const { return _image.alpha != 0; }
+    QImage read(const int y, const int height)
+    {
+        // libtiff returns premultiplied RGBA pixels packed in 32 bits
+        auto strip = QImage(_image.width, height,
+                            QImage::Format_RGBA8888_Premultiplied);
+        _image.row_offset = y;
+        _image.col_offset = 0;
+        auto raster = reinterpret_cast<uint32_t*>(strip.bits());
+        if (!TIFFRGBAImageGet(&_image, raster, _image.width, height))
+            throw std::runtime_error("Error reading TIFF image");
+        return strip;
+    }
+
+private:
+    TIFFPtr _tif;
+    TIFFRGBAImage _image;
+};
+
+/** Build all the levels of the pyramid from the strips of the base level. */
+class PyramidBuilder
+{
+public:
+    PyramidBuilder(const QString& target, const QSize& size, const bool alpha,
+                   const TiffPyramidWriter::Options& options)
+        : _tileSize{options.tileSize}
+        , _codec{alpha && options.codec == Codec::jpeg ? Codec::deflate
+                                                       : options.codec}
+        , _quality{options.quality}
+        , _alpha{alpha}
+    {
+        if (_codec != options.codec)
+            print_log(LOG_INFO, LOG_TIFF,
+                      "JPEG does not support transparency, using deflate");
+
+        const auto levelCount =
+            TiffPyramidWriter::getLevelCount(size, _tileSize);
+        for (uint i = 0; i < levelCount; ++i)
+        {
+            const auto levelSize = QSize(size.width() >> i, size.height() >> i);
+            _levels.emplace_back(levelSize, _tileSize, _getFormat(alpha));
+        }
+
+        const auto rawSize = qint64(size.width()) * size.height() * 4;
+        const auto mode = rawSize > bigTiffThreshold ? "w8" : "w";
+        _tif.reset(TIFFOpen(target.toLocal8Bit().constData(), mode));
+        if (!_tif)
+            throw std::runtime_error("Could not create " +
+                                     target.toStdString());
+
+        if (levelCount > 1 && !_tmpFile.open())
+            throw std::runtime_error("Could not create temporary file");
+
+        _setFields(0);
+    }
+
+    void addStrip(const QImage& strip)
+    {
+        _append(0, strip.convertToFormat(_getFormat(_alpha)));
+        _processTiles();
+    }
+
+    void finish()
+    {
+        for (size_t i = 1; i < _levels.size(); ++i)
+        {
+            if (!TIFFWriteDirectory(_tif.get()))
+                throw std::runtime_error("Error writing TIFF directory");
+            _setFields(i);
+            _copyStoredTiles(_levels[i]);
+        }
+        _tif.reset();
+    }
+
+private:
+    struct StoredTile
+    {
+        uint index;
+        qint64 offset;
+        qint64 size;
+    };
+
+    struct Level
+    {
+        Level(const QSize& size_, const QSize& tileSize, QImage::Format format)
+            : size{size_}
+            , band{size.width(), tileSize.height(), format}
+        {
+            band.fill(0);
+        }
+        QSize size;
+        QImage band;
+        int bandRows = 0;
+        int bandY = 0;
+        std::vector<StoredTile> storedTiles;
+    };
+
+    struct Tile
+    {
+        size_t level;
+        uint index;
+        QImage image;
+        QByteArray data;
+    };
+
+    const QSize _tileSize;
+    const Codec _codec;
+    const int _quality;
+    const bool _alpha;
+    std::vector<Level> _levels;
+    std::vector<Tile> _tiles;
+    TIFFPtr _tif;
+    QTemporaryFile _tmpFile;
+
+    void _setFields(const size_t index)
+    {
+        auto tif = _tif.get();
+        const auto& size = _levels[index].size;
+
+        TIFFSetField(tif, TIFFTAG_SUBFILETYPE,
+                     index > 0 ? FILETYPE_REDUCEDIMAGE : 0);
+        TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, uint32_t(size.width()));
+        TIFFSetField(tif, TIFFTAG_IMAGELENGTH, uint32_t(size.height()));
+        TIFFSetField(tif, TIFFTAG_TILEWIDTH, uint32_t(_tileSize.width()));
+        TIFFSetField(tif, TIFFTAG_TILELENGTH, uint32_t(_tileSize.height()));
+        TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, 8);
+        TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, _alpha ? 4 : 3);
+        TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+        if (_alpha)
+        {
+            // The QImage::Format_RGBA8888 pixels are not premultiplied
+            const uint16_t extraSample = EXTRASAMPLE_UNASSALPHA;
+            TIFFSetField(tif, TIFFTAG_EXTRASAMPLES, 1, &extraSample);
+        }
+        switch (_codec)
+        {
+        case Codec::jpeg:
+            // The YCbCr subsampling is deduced from the tiles by the readers
+            TIFFSetField(tif, TIFFTAG_COMPRESSION, COMPRESSION_JPEG);
+            TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_YCBCR);
+            break;
+        case Codec::deflate:
+            TIFFSetField(tif, TIFFTAG_COMPRESSION, COMPRESSION_ADOBE_DEFLATE);
+            TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_RGB);
+            break;
+        case Codec::none:
+        default:
+            TIFFSetField(tif, TIFFTAG_COMPRESSION, COMPRESSION_NONE);
+            TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_RGB);
+            break;
+        }
+    }
+
+    void _append(const size_t index, const QImage& rows)
+    {
+        auto& level = _levels[index];
+        const auto bytesPerLine = rows.width() * rows.depth() / 8;
+
+        int y = 0;
+        while (y < rows.height())
+        {
+            const auto count = std::min(_tileSize.height() - level.bandRows,
+                                        rows.height() - y);
+            for (int i = 0; i < count; ++i)
+                std::memcpy(level.band.scanLine(level.bandRows + i),
+                            rows.constScanLine(y + i), bytesPerLine);
+            level.bandRows += count;
+            y += count;
+
+            const auto lastRow = level.bandY + level.bandRows;
+            if (level.bandRows == _tileSize.height() ||
+                lastRow == level.size.height())
+            {
+                _flushBand(index);
+            }
+        }
+    }
+
+    void _flushBand(const size_t index)
+    {
+        auto& level = _levels[index];
+
+        const auto tilesX = (level.size.width() - 1) / _tileSize.width() + 1;
+        const auto row = level.bandY / _tileSize.height();
+        for (int x = 0; x < tilesX; ++x)
+        {
+            // Areas outside of the image are padded with zeros
+            const auto rect = QRect({x * _tileSize.width(), 0}, _tileSize);
+            _tiles.push_back({index, uint(row * tilesX + x),
+                              level.band.copy(rect), QByteArray()});
+        }
+
+        if (index + 1 < _levels.size())
+        {
+            const auto rows = QRect(0, 0, level.size.width(), level.bandRows);
+            _append(index + 1, _downsample(level.band.copy(rows)));
+        }
+
+        level.bandY += level.bandRows;
+        level.bandRows = 0;
+        level.band.fill(0);
+    }
+
+    void _processTiles()
+    {
+        const auto codec = _codec;
+        const auto quality = _quality;
+        QtConcurrent::blockingMap(_tiles, [codec, quality](Tile& tile) {
+            tile.data = _encode(tile.image, codec, quality);
+            tile.image = QImage();
+        });
+
+        for (auto& tile : _tiles)
+        {
+            if (tile.level == 0)
+                _writeTile(tile.index, tile.data);
+            else
+            {
+                const auto offset = _tmpFile.pos();
+                if (_tmpFile.write(tile.data) != tile.data.size())
+                    throw std::runtime_error("Error writing temporary file");
+                _levels[tile.level].storedTiles.push_back(
+                    {tile.index, offset, tile.data.size()});
+            }
+        }
+        _tiles.clear();
+    }
+
+    void _copyStoredTiles(const Level& level)
+    {
+        for (const auto& tile : level.storedTiles)
+        {
+            if (!_tmpFile.seek(tile.offset))
+                throw std::runtime_error("Error reading temporary file");
+            _writeTile(tile.index, _tmpFile.read(tile.size));
+        }
+        _tmpFile.seek(_tmpFile.size());
+    }
+
+    void _writeTile(const uint index, const QByteArray& data)
+    {
+        auto buffer = const_cast<char*>(data.constData());
+        if (TIFFWriteRawTile(_tif.get(), index, buffer, data.size()) < 0)
+            throw std::runtime_error("Error writing TIFF tile");
+    }
+};
+}
+
+TiffPyramidWriter::TiffPyramidWriter(const Options& options)
+    : _options{options}
+{
+    const auto& tileSize = _options.tileSize;
+    if (tileSize.isEmpty() || tileSize.width() % 16 ||
+        tileSize.height() % 16)
+    {
+        throw std::invalid_argument("Tile size must be a multiple of 16");
+    }
+    if (_options.quality < 0 || _options.quality > 100)
+        throw std::invalid_argument("Quality must be in range [0, 100]");
+}
+
+void TiffPyramidWriter::setProgressCallback(ProgressFunc callback)
+{
+    _progress = std::move(callback);
+}
+
+void TiffPyramidWriter::write(const QString& source,
+                              const QString& target) const
+{
+    if (_isTiff(source))
+    {
+        auto reader = std::make_shared<TiffStripReader>(source);
+        write(reader->getSize(), reader->hasAlpha(),
+              [reader](const int y, const int height) {
+                  return reader->read(y, height);
+              },
+              target);
+        return;
+    }
+
+    // Qt image plugins can only decode full images (clip rects are still
+    // decoded from the start of the file), so other formats are read at once.
+    QImageReader reader(source);
+    const auto alpha = QImage(1, 1, reader.imageFormat()).hasAlphaChannel();
+    const auto image = reader.read();
+    if (image.isNull())
+        throw std::runtime_error("Error reading image: " +
+                                 reader.errorString().toStdString());
+    write(image.size(), alpha,
+          [&image](const int y, const int height) {
+              return image.copy(0, y, image.width(), height);
+          },
+          target);
+}
+
+void TiffPyramidWriter::write(const QSize& size, const bool alpha,
+                              const ReadStripFunc& readStrip,
+                              const QString& target) const
+{
+    if (size.isEmpty())
+        throw std::runtime_error("Invalid image size");
+
+    PyramidBuilder builder{target, size, alpha, _options};
+
+    const auto stripHeight = _options.tileSize.height();
+    std::string error;
+    const auto read = [&readStrip, &size, &error, stripHeight](const int y) {
+        try
+        {
+            return readStrip(y, std::min(stripHeight, size.height() - y));
+        }
+        catch (const std::exception& e)
+        {
+            error = e.what();
+            return QImage();
+        }
+    };
+
+    // Read the next strip while the current one is processed
+    auto nextStrip = QtConcurrent::run(read, 0);
+    try
+    {
+        for (int y = 0; y < size.height(); y += stripHeight)
+        {
+            const auto height = std::min(stripHeight, size.height() - y);
+            const auto strip = nextStrip.result();
+            if (strip.size() != QSize(size.width(), height))
+            {
+                throw std::runtime_error(
+                    "Error reading source image: " +
+                    (error.empty() ? std::string("invalid strip") : error));
+            }
+            if (y + height < size.height())
+                nextStrip = QtConcurrent::run(read, y + height);
+
+            builder.addStrip(strip);
+
+            if (_progress)
+                _progress(double(y + height) / size.height());
+        }
+    }
+    catch (...)
+    {
+        nextStrip.waitForFinished(); // it references local variables
+        throw;
+    }
+    builder.finish();
+}
+
+uint TiffPyramidWriter::getLevelCount(const QSize& imageSize,
+                                      const QSize& tileSize)
+{
+    uint count = 1;
+    auto size = imageSize;
+    while ((size.width() > tileSize.width() ||
+            size.height() > tileSize.height()) &&
+           size.width() > 1 && size.height() > 1)
+    {
+        size /= 2;
+        ++count;
+    }
+    return count;
+}
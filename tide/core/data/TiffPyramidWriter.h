@@ -0,0 +1,128 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef TIFFPYRAMIDWRITER_H
+#define TIFFPYRAMIDWRITER_H
+
+#include <QImage>
+#include <QString>
+
+#include <functional>
+
+/**
+ * Writer for TIFF image pyramid files that can be read by TiffPyramidReader.
+ *
+ * The source image is read in horizontal strips of one tile height and all the
+ * levels of the pyramid are built in a single pass, so that the memory usage
+ * only depends on the width of the image. Strips are downsampled and tiles are
+ * compressed in parallel using the global QThreadPool.
+ *
+ * The tiles of the lower resolution levels are kept in a temporary file until
+ * the full resolution level has been written.
+ */
+class TiffPyramidWriter
+{
+public:
+    /** Compression of the tiles. */
+    enum class Codec
+    {
+        jpeg,
+        deflate,
+        none
+    };
+
+    /** Options for writing pyramids. */
+    struct Options
+    {
+        /** Size of the tiles, must be a multiple of 16. */
+        QSize tileSize{512, 512};
+
+        /** Compression, images with transparency fall back to deflate. */
+        Codec codec = Codec::jpeg;
+
+        /** Quality of the jpeg compression [0-100]. */
+        int quality = 90;
+    };
+
+    /** Function to read the rows [y, y + height[ of a source image. */
+    using ReadStripFunc = std::function<QImage(int y, int height)>;
+
+    /** Function called with the progress in the range [0, 1]. */
+    using ProgressFunc = std::function<void(double progress)>;
+
+    /**
+     * Create a writer.
+     * @param options for the pyramids to write
+     * @throw std::invalid_argument if the options are invalid
+     */
+    explicit TiffPyramidWriter(const Options& options = Options());
+
+    /** Set a function to be called after each processed strip. */
+    void setProgressCallback(ProgressFunc callback);
+
+    /**
+     * Write the pyramid of an image file.
+     *
+     * TIFF files are read in strips using libtiff, other formats are loaded
+     * at once using Qt's image plugins.
+     * @param source the image file to convert
+     * @param target the TIFF pyramid file to create
+     * @throw std::runtime_error if an error occurs
+     */
+    void write(const QString& source, const QString& target) const;
+
+    /**
+     * Write the pyramid of an image read in strips.
+     * @param size of the source image
+     * @param alpha true if the source image has an alpha channel
+     * @param readStrip function to read the source image in strips
+     * @param target the TIFF pyramid file to create
+     * @throw std::runtime_error if an error occurs
+     */
+    void write(const QSize& size, bool alpha, const ReadStripFunc& readStrip,
+               const QString& target) const;
+
+    /** @return the number of levels of a pyramid. */
+    static uint getLevelCount(const QSize& imageSize, const QSize& tileSize);
+
+private:
+    Options _options;
+    ProgressFunc _progress;
+};
+
+#endif
@@ -211,6 +211,9 @@ QJsonObject serialize(const Configuration& config)
                      {"display", config.master.display},
                      {"headless", config.master.headless},
                      {"webservicePort", config.master.webservicePort},
+                     {"uploadMaxSize",
+                      static_cast<int>(config.master.uploadMaxSize)},
+                     {"directStreaming", config.master.directStreaming},
                      {"planarSerialPort", config.master.planarSerialPort}}},
         {"settings",
          QJsonObject{{"infoName", config.settings.infoName},
@@ -220,7 +223,31 @@ QJsonObject serialize(const Configuration& config)
                       static_cast<int>(config.settings.inactivityTimeout)},
                      {"contentMaxScale", config.settings.contentMaxScale},
                      {"contentMaxScaleVectorial",
-                      config.settings.contentMaxScaleVectorial}}},
+                      config.settings.contentMaxScaleVectorial},
+                     {"streamFramesInFlight",
+                      static_cast<int>(config.settings.streamFramesInFlight)},
+                     {"streamDropLateFrames",
+                      config.settings.streamDropLateFrames},
+                     {"imagePyramidYUVTiles",
+                      config.settings.imagePyramidYUVTiles},
+                     {"imageTilingThreshold",
+                      static_cast<int>(config.settings.imageTilingThreshold)},
+                     {"sharedTileCache", config.settings.sharedTileCache},
+                     {"pdfRenderAheadPages",
+                      static_cast<int>(config.settings.pdfRenderAheadPages)},
+                     {"documentPoolSize",
+                      static_cast<int>(config.settings.documentPoolSize)},
+                     {"progressiveRendering",
+                      config.settings.progressiveRendering},
+                     {"skipUnchangedScreens",
+                      config.settings.skipUnchangedScreens},
+                     {"targetFrameRate",
+                      static_cast<int>(config.settings.targetFrameRate)},
+                     {"maxTileUploadsPerFrame",
+                      static_cast<int>(
+                          config.settings.maxTileUploadsPerFrame)},
+                     {"wallMemoryBudget",
+                      static_cast<int>(config.settings.wallMemoryBudget)}}},
         {"webbrowser", QJsonObject{{"defaultUrl", config.webbrowser.defaultUrl},
                                    {"defaultSize",
                                     serialize(config.webbrowser.defaultSize)}}},
@@ -436,6 +463,8 @@ bool deserialize(const QJsonObject& object, Configuration& config)
     deserialize(masterObj["display"], config.master.display);
     deserialize(masterObj["headless"], config.master.headless);
     deserialize(masterObj["webservicePort"], config.master.webservicePort);
+    deserialize(masterObj["uploadMaxSize"], config.master.uploadMaxSize);
+    deserialize(masterObj["directStreaming"], config.master.directStreaming);
     deserialize(masterObj["planarSerialPort"], config.master.planarSerialPort);
 
     const auto settingsObj = object["settings"].toObject();
@@ -448,6 +477,30 @@ bool deserialize(const QJsonObject& object, Configuration& config)
                 config.settings.contentMaxScale);
     deserialize(settingsObj["contentMaxScaleVectorial"],
                 config.settings.contentMaxScaleVectorial);
+    deserialize(settingsObj["streamFramesInFlight"],
+                config.settings.streamFramesInFlight);
+    deserialize(settingsObj["streamDropLateFrames"],
+                config.settings.streamDropLateFrames);
+    deserialize(settingsObj["imagePyramidYUVTiles"],
+                config.settings.imagePyramidYUVTiles);
+    deserialize(settingsObj["imageTilingThreshold"],
+                config.settings.imageTilingThreshold);
+    deserialize(settingsObj["sharedTileCache"],
+                config.settings.sharedTileCache);
+    deserialize(settingsObj["pdfRenderAheadPages"],
+                config.settings.pdfRenderAheadPages);
+    deserialize(settingsObj["documentPoolSize"],
+                config.settings.documentPoolSize);
+    deserialize(settingsObj["progressiveRendering"],
+                config.settings.progressiveRendering);
+    deserialize(settingsObj["skipUnchangedScreens"],
+                config.settings.skipUnchangedScreens);
+    deserialize(settingsObj["targetFrameRate"],
+                config.settings.targetFrameRate);
+    deserialize(settingsObj["maxTileUploadsPerFrame"],
+                config.settings.maxTileUploadsPerFrame);
+    deserialize(settingsObj["wallMemoryBudget"],
+                config.settings.wallMemoryBudget);
 
     const auto webbrowserObj = object["webbrowser"].toObject();
     deserialize(webbrowserObj["defaultUrl"], config.webbrowser.defaultUrl);
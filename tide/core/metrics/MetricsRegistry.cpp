@@ -0,0 +1,228 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "MetricsRegistry.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+void _atomicAdd(std::atomic<double>& target, const double value)
+{
+    auto current = target.load();
+    while (!target.compare_exchange_weak(current, current + value))
+    {
+    }
+}
+
+template <typename Map, typename... Args>
+typename Map::mapped_type::element_type& _getOrCreate(Map& map,
+                                                      const MetricLabels& key,
+                                                      Args&&... args)
+{
+    auto& metric = map[key];
+    if (!metric)
+        metric.reset(new typename Map::mapped_type::element_type(
+            std::forward<Args>(args)...));
+    return *metric;
+}
+}
+
+void MetricCounter::increment(const double value)
+{
+    _atomicAdd(_value, value);
+}
+
+void MetricGauge::add(const double value)
+{
+    _atomicAdd(_value, value);
+}
+
+MetricHistogram::MetricHistogram(std::vector<double> bounds)
+    : _bounds{std::move(bounds)}
+    , _counts(_bounds.size(), 0u)
+{
+    if (!std::is_sorted(_bounds.begin(), _bounds.end()))
+        throw std::invalid_argument("histogram bounds must be sorted");
+}
+
+void MetricHistogram::observe(const double value)
+{
+    const auto it = std::lower_bound(_bounds.begin(), _bounds.end(), value);
+    const auto index = std::distance(_bounds.begin(), it);
+
+    const std::lock_guard<std::mutex> lock{_mutex};
+    if (it != _bounds.end())
+        ++_counts[index];
+    ++_count;
+    _sum += value;
+}
+
+MetricSample MetricHistogram::getSample() const
+{
+    MetricSample sample;
+
+    const std::lock_guard<std::mutex> lock{_mutex};
+    sample.value = _sum;
+    sample.count = _count;
+    sample.buckets.reserve(_counts.size());
+    auto cumulativeCount = uint64_t{0};
+    for (const auto count : _counts)
+    {
+        cumulativeCount += count;
+        sample.buckets.push_back(cumulativeCount);
+    }
+    return sample;
+}
+
+MetricsRegistry& MetricsRegistry::instance()
+{
+    static MetricsRegistry registry;
+    return registry;
+}
+
+const std::vector<double>& MetricsRegistry::durationBounds()
+{
+    static const std::vector<double> bounds{0.001, 0.0025, 0.005, 0.01,
+                                            0.0167, 0.025, 0.0333, 0.05,
+                                            0.1,    0.25,  0.5,    1.0,
+                                            2.5,    5.0};
+    return bounds;
+}
+
+MetricCounter& MetricsRegistry::counter(const std::string& name,
+                                        const std::string& help,
+                                        const MetricLabels& labels)
+{
+    const std::lock_guard<std::mutex> lock{_mutex};
+    auto& family = _getFamily(name, help, MetricType::counter);
+    return _getOrCreate(family.counters, labels);
+}
+
+MetricGauge& MetricsRegistry::gauge(const std::string& name,
+                                    const std::string& help,
+                                    const MetricLabels& labels)
+{
+    const std::lock_guard<std::mutex> lock{_mutex};
+    auto& family = _getFamily(name, help, MetricType::gauge);
+    return _getOrCreate(family.gauges, labels);
+}
+
+MetricHistogram& MetricsRegistry::histogram(const std::string& name,
+                                            const std::string& help,
+                                            const MetricLabels& labels,
+                                            const std::vector<double>& bounds)
+{
+    const std::lock_guard<std::mutex> lock{_mutex};
+    auto& family = _getFamily(name, help, MetricType::histogram);
+    if (family.bounds.empty())
+        family.bounds = bounds;
+    return _getOrCreate(family.histograms, labels, family.bounds);
+}
+
+void MetricsRegistry::remove(const std::string& name,
+                             const MetricLabels& labels)
+{
+    const std::lock_guard<std::mutex> lock{_mutex};
+    const auto it = _families.find(name);
+    if (it == _families.end())
+        return;
+
+    auto& family = it->second;
+    family.counters.erase(labels);
+    family.gauges.erase(labels);
+    family.histograms.erase(labels);
+}
+
+MetricFamilies MetricsRegistry::snapshot() const
+{
+    MetricFamilies families;
+
+    const std::lock_guard<std::mutex> lock{_mutex};
+    families.reserve(_families.size());
+    for (const auto& it : _families)
+    {
+        const auto& family = it.second;
+
+        MetricFamily snapshot;
+        snapshot.name = it.first;
+        snapshot.help = family.help;
+        snapshot.type = family.type;
+        snapshot.bounds = family.bounds;
+
+        for (const auto& counter : family.counters)
+        {
+            MetricSample sample;
+            sample.labels = counter.first;
+            sample.value = counter.second->get();
+            snapshot.samples.emplace_back(std::move(sample));
+        }
+        for (const auto& gauge : family.gauges)
+        {
+            MetricSample sample;
+            sample.labels = gauge.first;
+            sample.value = gauge.second->get();
+            snapshot.samples.emplace_back(std::move(sample));
+        }
+        for (const auto& histogram : family.histograms)
+        {
+            auto sample = histogram.second->getSample();
+            sample.labels = histogram.first;
+            snapshot.samples.emplace_back(std::move(sample));
+        }
+        families.emplace_back(std::move(snapshot));
+    }
+    return families;
+}
+
+MetricsRegistry::Family& MetricsRegistry::_getFamily(const std::string& name,
+                                                     const std::string& help,
+                                                     const MetricType type)
+{
+    auto it = _families.find(name);
+    if (it == _families.end())
+    {
+        it = _families.emplace(name, Family()).first;
+        it->second.help = help;
+        it->second.type = type;
+    }
+    else if (it->second.type != type)
+        throw std::logic_error("metric '" + name + "' has a different type");
+    return it->second;
+}
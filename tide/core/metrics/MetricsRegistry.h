@@ -0,0 +1,246 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef METRICSREGISTRY_H
+#define METRICSREGISTRY_H
+
+#include "serialization/includes.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/** The type of a metric, following the Prometheus data model. */
+enum class MetricType
+{
+    counter,
+    gauge,
+    histogram
+};
+
+/** The set of labels identifying a time series within a metric family. */
+using MetricLabels = std::map<std::string, std::string>;
+
+/**
+ * A snapshot of a single time series of a metric family.
+ */
+struct MetricSample
+{
+    /** The labels of the series. */
+    MetricLabels labels;
+
+    /** The value of counters and gauges, or the sum of all observations. */
+    double value = 0.0;
+
+    /** The number of observations (histograms only). */
+    uint64_t count = 0;
+
+    /** The cumulative count per bucket (histograms only). */
+    std::vector<uint64_t> buckets;
+
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int)
+    {
+        // clang-format off
+        ar & labels;
+        ar & value;
+        ar & count;
+        ar & buckets;
+        // clang-format on
+    }
+};
+
+/**
+ * A snapshot of all the time series of a metric.
+ */
+struct MetricFamily
+{
+    /** The name of the metric. */
+    std::string name;
+
+    /** A short description of the metric. */
+    std::string help;
+
+    /** The type of the metric. */
+    MetricType type = MetricType::gauge;
+
+    /** The upper bounds of the buckets (histograms only). */
+    std::vector<double> bounds;
+
+    /** The time series of the metric. */
+    std::vector<MetricSample> samples;
+
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int)
+    {
+        // clang-format off
+        ar & name;
+        ar & help;
+        ar & type;
+        ar & bounds;
+        ar & samples;
+        // clang-format on
+    }
+};
+
+using MetricFamilies = std::vector<MetricFamily>;
+
+/**
+ * A monotonically increasing value.
+ */
+class MetricCounter
+{
+public:
+    /** Increment the counter, threadsafe. */
+    void increment(double value = 1.0);
+
+    /** @return the current value. */
+    double get() const { return _value; }
+private:
+    std::atomic<double> _value{0.0};
+};
+
+/**
+ * A value that can go up and down.
+ */
+class MetricGauge
+{
+public:
+    /** Set the value, threadsafe. */
+    void set(double value) { _value = value; }
+    /** Add to the value (can be negative), threadsafe. */
+    void add(double value);
+
+    /** @return the current value. */
+    double get() const { return _value; }
+private:
+    std::atomic<double> _value{0.0};
+};
+
+/**
+ * A distribution of observed values counted in configurable buckets.
+ */
+class MetricHistogram
+{
+public:
+    /**
+     * Create a histogram.
+     * @param bounds the upper bounds of the buckets, in increasing order.
+     */
+    explicit MetricHistogram(std::vector<double> bounds);
+
+    /** Add an observation, threadsafe. */
+    void observe(double value);
+
+    /** @return the upper bounds of the buckets. */
+    const std::vector<double>& getBounds() const { return _bounds; }
+    /** @return a snapshot of the histogram (labels are not set). */
+    MetricSample getSample() const;
+
+private:
+    const std::vector<double> _bounds;
+    mutable std::mutex _mutex;
+    std::vector<uint64_t> _counts;
+    uint64_t _count = 0;
+    double _sum = 0.0;
+};
+
+/**
+ * Process-wide registry of counters, gauges and histograms.
+ *
+ * Metrics are created on first access and remain valid for the lifetime of the
+ * registry, so callers on hot paths can keep a reference to them. All the
+ * functions of the registry and of the metrics are threadsafe.
+ */
+class MetricsRegistry
+{
+public:
+    /** @return the registry of the current process. */
+    static MetricsRegistry& instance();
+
+    /** Default bucket bounds for durations, in seconds. */
+    static const std::vector<double>& durationBounds();
+
+    /** @return the counter for the given name and labels. */
+    MetricCounter& counter(const std::string& name, const std::string& help,
+                           const MetricLabels& labels = MetricLabels());
+
+    /** @return the gauge for the given name and labels. */
+    MetricGauge& gauge(const std::string& name, const std::string& help,
+                       const MetricLabels& labels = MetricLabels());
+
+    /**
+     * @return the histogram for the given name and labels.
+     * @param bounds of the buckets, only used when the metric is created.
+     */
+    MetricHistogram& histogram(const std::string& name, const std::string& help,
+                               const MetricLabels& labels = MetricLabels(),
+                               const std::vector<double>& bounds =
+                                   durationBounds());
+
+    /**
+     * Remove a time series, for instance when a content is closed.
+     * @warning any reference obtained for this series becomes invalid.
+     */
+    void remove(const std::string& name, const MetricLabels& labels);
+
+    /** @return a snapshot of all the metrics. */
+    MetricFamilies snapshot() const;
+
+private:
+    struct Family
+    {
+        std::string help;
+        MetricType type;
+        std::vector<double> bounds;
+        std::map<MetricLabels, std::unique_ptr<MetricCounter>> counters;
+        std::map<MetricLabels, std::unique_ptr<MetricGauge>> gauges;
+        std::map<MetricLabels, std::unique_ptr<MetricHistogram>> histograms;
+    };
+
+    mutable std::mutex _mutex;
+    std::map<std::string, Family> _families;
+
+    Family& _getFamily(const std::string& name, const std::string& help,
+                       MetricType type);
+};
+
+#endif
@@ -0,0 +1,162 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "prometheus.h"
+
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+const int doublePrecision = 15;
+
+std::string _escape(const std::string& text, const bool quotes)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (const auto c : text)
+    {
+        if (c == '\\')
+            escaped += "\\\\";
+        else if (c == '\n')
+            escaped += "\\n";
+        else if (c == '"' && quotes)
+            escaped += "\\\"";
+        else
+            escaped += c;
+    }
+    return escaped;
+}
+
+const char* _toString(const MetricType type)
+{
+    switch (type)
+    {
+    case MetricType::counter:
+        return "counter";
+    case MetricType::gauge:
+        return "gauge";
+    case MetricType::histogram:
+        return "histogram";
+    default:
+        throw std::logic_error("unsupported MetricType");
+    }
+}
+
+void _writeLabels(std::ostream& out, const MetricLabels& labels,
+                  const std::string& le = std::string())
+{
+    if (labels.empty() && le.empty())
+        return;
+
+    out << '{';
+    auto separator = "";
+    for (const auto& label : labels)
+    {
+        out << separator << label.first << "=\"" << _escape(label.second, true)
+            << '"';
+        separator = ",";
+    }
+    if (!le.empty())
+        out << separator << "le=\"" << le << '"';
+    out << '}';
+}
+
+std::string _toString(const double value)
+{
+    std::ostringstream stream;
+    stream << std::setprecision(doublePrecision) << value;
+    return stream.str();
+}
+
+void _writeHistogram(std::ostream& out, const MetricFamily& family,
+                     const MetricSample& sample)
+{
+    const auto& name = family.name;
+    for (size_t i = 0; i < family.bounds.size() && i < sample.buckets.size();
+         ++i)
+    {
+        out << name << "_bucket";
+        _writeLabels(out, sample.labels, _toString(family.bounds[i]));
+        out << ' ' << sample.buckets[i] << '\n';
+    }
+    out << name << "_bucket";
+    _writeLabels(out, sample.labels, "+Inf");
+    out << ' ' << sample.count << '\n';
+
+    out << name << "_sum";
+    _writeLabels(out, sample.labels);
+    out << ' ' << _toString(sample.value) << '\n';
+
+    out << name << "_count";
+    _writeLabels(out, sample.labels);
+    out << ' ' << sample.count << '\n';
+}
+}
+
+namespace prometheus
+{
+std::string toText(const MetricFamilies& families)
+{
+    std::ostringstream out;
+    for (const auto& family : families)
+    {
+        if (family.samples.empty())
+            continue;
+
+        out << "# HELP " << family.name << ' ' << _escape(family.help, false)
+            << '\n';
+        out << "# TYPE " << family.name << ' ' << _toString(family.type)
+            << '\n';
+
+        for (const auto& sample : family.samples)
+        {
+            if (family.type == MetricType::histogram)
+            {
+                _writeHistogram(out, family, sample);
+                continue;
+            }
+            out << family.name;
+            _writeLabels(out, sample.labels);
+            out << ' ' << _toString(sample.value) << '\n';
+        }
+    }
+    return out.str();
+}
+}
@@ -1,7 +1,5 @@
 /*********************************************************************/
-/* Copyright (c) 2016-2017, EPFL/Blue Brain Project                  */
-/*                          Raphael Dumusc <raphael.dumusc@epfl.ch>  */
-/*                          Pawel Podhajski <pawel.podhajski@epfl.ch>*/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
 /* All rights reserved.                                              */
 /*                                                                   */
 /* Redistribution and use in source and binary forms, with or        */
@@ -38,30 +36,25 @@
 /* or implied, of Ecole polytechnique federale de Lausanne.          */
 /*********************************************************************/
 
-#include "Whiteboard.h"
+#ifndef PROMETHEUS_H
+#define PROMETHEUS_H
 
-#include "tide/core/utils/log.h"
-#include "tide/master/localstreamer/CommandLineOptions.h"
+#include "metrics/MetricsRegistry.h"
 
-int main(int argc, char** argv)
+/**
+ * Export of metrics in the Prometheus text exposition format (v0.0.4).
+ */
+namespace prometheus
 {
-    logger_id = "whiteboard";
-    qInstallMessageHandler(qtMessageLogger);
+/** The content type of the text exposition format. */
+constexpr auto contentType = "text/plain; version=0.0.4";
 
-    COMMAND_LINE_PARSER_CHECK(CommandLineOptions, "tideWhiteboard");
-
-    // Load virtualkeyboard input context plugin
-    qputenv("QT_IM_MODULE", QByteArray("virtualkeyboard"));
-
-    std::unique_ptr<Whiteboard> whiteboard;
-    try
-    {
-        whiteboard.reset(new Whiteboard(argc, argv));
-    }
-    catch (const std::exception& e)
-    {
-        print_log(LOG_FATAL, LOG_GENERAL, "failed to start: %s", e.what());
-        return EXIT_FAILURE;
-    }
-    return whiteboard->exec();
+/**
+ * Convert metric families to the Prometheus text exposition format.
+ * @param families to convert, each family name should be unique.
+ * @return the text representation of all the samples.
+ */
+std::string toText(const MetricFamilies& families);
 }
+
+#endif
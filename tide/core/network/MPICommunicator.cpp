@@ -42,8 +42,11 @@
 #include "MPIContext.h"
 #include "MPINospin.h"
 
+#include "metrics/MetricsRegistry.h"
 #include "utils/log.h"
 
+#include <cassert>
+
 // WAR some deadlocks receiving MPI_IBcast with OpenMPI (version 1.10.2)
 #ifdef OPEN_MPI
 #define DISBALE_MPI_IBCAST
@@ -57,20 +60,103 @@
             print_log(LOG_ERROR, LOG_MPI, "Error detected! (%d)", err); \
     }
 
+namespace
+{
+const char* _toString(const MessageType type)
+{
+    switch (type)
+    {
+    case MessageType::NONE:
+        return "NONE";
+    case MessageType::FRAME_CLOCK:
+        return "FRAME_CLOCK";
+    case MessageType::QUIT:
+        return "QUIT";
+    case MessageType::SCENE:
+        return "SCENE";
+    case MessageType::PIXELSTREAM:
+        return "PIXELSTREAM";
+    case MessageType::OPTIONS:
+        return "OPTIONS";
+    case MessageType::MARKERS:
+        return "MARKERS";
+    case MessageType::REQUEST_FRAME:
+        return "REQUEST_FRAME";
+    case MessageType::TIMESTAMP:
+        return "TIMESTAMP";
+    case MessageType::START_PROCESS:
+        return "START_PROCESS";
+    case MessageType::IMAGE:
+        return "IMAGE";
+    case MessageType::COUNTDOWN_STATUS:
+        return "COUNTDOWN_STATUS";
+    case MessageType::PIXELSTREAM_CLOSE:
+        return "PIXELSTREAM_CLOSE";
+    case MessageType::LOCK:
+        return "LOCK";
+    case MessageType::CONFIG:
+        return "CONFIG";
+    case MessageType::METRICS:
+        return "METRICS";
+    case MessageType::PIXELSTREAM_DIRECT:
+        return "PIXELSTREAM_DIRECT";
+    case MessageType::PIXELSTREAM_CREDIT:
+        return "PIXELSTREAM_CREDIT";
+    case MessageType::WHITEBOARD_STROKE:
+        return "WHITEBOARD_STROKE";
+    }
+    // No default case so that -Wswitch reports any type not named above;
+    // this is only reached by invalid values received over the network.
+    return "UNKNOWN";
+}
+
+void _countSentMessage(const MessageType type, const size_t size)
+{
+    auto& registry = MetricsRegistry::instance();
+    const auto labels = MetricLabels{{"type", _toString(type)}};
+    registry
+        .counter("tide_mpi_sent_bytes_total",
+                 "Payload bytes sent over MPI per message type", labels)
+        .increment(size);
+    registry
+        .counter("tide_mpi_sent_messages_total",
+                 "Messages sent over MPI per message type", labels)
+        .increment();
+}
+}
+
 MPICommunicator::MPICommunicator(int argc, char* argv[])
     : _mpiContext{new MPIContext{argc, argv}}
     , _mpiComm{MPI_COMM_WORLD}
+    , _waitStrategy{MPIWaitStrategy::fromEnvironment()}
 {
     _initRankAndSize();
 }
 
 MPICommunicator::MPICommunicator(const MPICommunicator& parent, const int color)
     : _mpiContext{parent._mpiContext}
+    , _waitStrategy{parent._waitStrategy}
 {
     MPI_Comm_split(parent._mpiComm, color, parent.getRank(), &_mpiComm);
     _initRankAndSize();
 }
 
+MPICommunicator::MPICommunicator(const MPICommunicator& parent,
+                                 const MPISplitType type)
+    : _mpiContext{parent._mpiContext}
+    , _waitStrategy{parent._waitStrategy}
+{
+    switch (type)
+    {
+    case MPISplitType::host:
+        MPI_CHECK(MPI_Comm_split_type(parent._mpiComm, MPI_COMM_TYPE_SHARED,
+                                      parent.getRank(), MPI_INFO_NULL,
+                                      &_mpiComm));
+        break;
+    }
+    _initRankAndSize();
+}
+
 MPICommunicator::~MPICommunicator()
 {
     if (_mpiComm != MPI_COMM_WORLD)
@@ -87,25 +173,43 @@ int MPICommunicator::getSize() const
     return _mpiSize;
 }
 
+void MPICommunicator::setWaitStrategy(const MPIWaitStrategy& strategy)
+{
+    _waitStrategy = strategy;
+}
+
+const MPIWaitStrategy& MPICommunicator::getWaitStrategy() const
+{
+    return _waitStrategy;
+}
+
 void MPICommunicator::globalBarrier() const
 {
-    MPI_Barrier(_mpiComm);
+    MPI_CHECK(MPI_Barrier_Nospin(_mpiComm, _waitStrategy));
 }
 
 int MPICommunicator::globalSum(const int localValue) const
 {
     int globalValue = 0;
-    MPI_Allreduce((void*)&localValue, (void*)&globalValue, 1, MPI_INT, MPI_SUM,
-                  _mpiComm);
+    MPI_CHECK(MPI_Allreduce_Nospin(&localValue, &globalValue, 1, MPI_INT,
+                                   MPI_SUM, _mpiComm, _waitStrategy));
+    return globalValue;
+}
+
+int MPICommunicator::globalMin(const int localValue) const
+{
+    int globalValue = 0;
+    MPI_CHECK(MPI_Allreduce_Nospin(&localValue, &globalValue, 1, MPI_INT,
+                                   MPI_MIN, _mpiComm, _waitStrategy));
     return globalValue;
 }
 
 std::vector<uint64_t> MPICommunicator::gatherAll(const uint64_t value)
 {
     std::vector<uint64_t> results(_mpiSize);
-    MPI_CHECK(MPI_Allgather((void*)&value, 1, MPI_LONG_LONG_INT,
-                            (void*)results.data(), 1, MPI_LONG_LONG_INT,
-                            _mpiComm));
+    MPI_CHECK(MPI_Allgather_Nospin(&value, 1, MPI_LONG_LONG_INT,
+                                   results.data(), 1, MPI_LONG_LONG_INT,
+                                   _mpiComm, _waitStrategy));
     return results;
 }
 
@@ -121,15 +225,16 @@ void MPICommunicator::send(const MessageType type,
     if (!_isValidAndNotSelf(dest))
         return;
 
+    _countSentMessage(type, serializedData.size());
     MPI_CHECK(MPI_Send_Nospin((void*)serializedData.data(),
                               serializedData.size(), MPI_BYTE, dest, int(type),
-                              _mpiComm));
+                              _mpiComm, _waitStrategy));
 }
 
 ProbeResult MPICommunicator::probe(const int src, const int tag)
 {
     MPI_Status status;
-    MPI_CHECK(MPI_Probe_Nospin(src, tag, _mpiComm, &status));
+    MPI_CHECK(MPI_Probe_Nospin(src, tag, _mpiComm, &status, _waitStrategy));
 
     int count = MPI_UNDEFINED;
     MPI_CHECK(MPI_Get_count(&status, MPI_BYTE, &count));
@@ -142,7 +247,7 @@ void MPICommunicator::receive(const int src, char* dataBuffer,
 {
     MPI_Status status;
     MPI_CHECK(MPI_Recv_Nospin((void*)dataBuffer, messageSize, MPI_BYTE, src,
-                              tag, _mpiComm, &status));
+                              tag, _mpiComm, &status, _waitStrategy));
 
     // Validate the number of bytes received
     int count = 0;
@@ -164,10 +269,28 @@ void MPICommunicator::broadcast(const MessageType type, const std::string& data)
 
 void MPICommunicator::broadcast(const MessageType type, const QByteArray& data)
 {
+    _countSentMessage(type, data.size());
     _broadcast(MessageHeader{type, (uint)data.size()});
     _broadcast(data.constData(), data.size());
 }
 
+void MPICommunicator::broadcast(const MessageType type, const std::string& data,
+                                MPICommunicator& payloadComm)
+{
+    broadcast(type, QByteArray::fromRawData(data.data(), data.size()),
+              payloadComm);
+}
+
+void MPICommunicator::broadcast(const MessageType type, const QByteArray& data,
+                                MPICommunicator& payloadComm)
+{
+    assert(payloadComm.getRank() == getRank());
+
+    _countSentMessage(type, data.size());
+    _broadcast(MessageHeader{type, (uint)data.size()});
+    payloadComm._broadcast(data.constData(), data.size());
+}
+
 MessageHeader MPICommunicator::receiveBroadcastHeader(const int src)
 {
     // No-spin so that waiting for a message in a thread does not burn 100% CPU.
@@ -175,10 +298,10 @@ MessageHeader MPICommunicator::receiveBroadcastHeader(const int src)
     MessageHeader mh;
 #ifdef DISBALE_MPI_IBCAST
     MPI_CHECK(MPI_Recv_Nospin((void*)&mh, sizeof(MessageHeader), MPI_BYTE, src,
-                              0, _mpiComm, MPI_STATUS_IGNORE));
+                              0, _mpiComm, MPI_STATUS_IGNORE, _waitStrategy));
 #else
     MPI_CHECK(MPI_Bcast_Nospin((void*)&mh, sizeof(MessageHeader), MPI_BYTE, src,
-                               _mpiComm));
+                               _mpiComm, _waitStrategy));
 #endif
     return mh;
 }
@@ -201,12 +324,12 @@ void MPICommunicator::_broadcast(const MessageHeader& mh)
         if (_isValidAndNotSelf(i))
         {
             MPI_CHECK(MPI_Send_Nospin((void*)&mh, sizeof(MessageHeader),
-                                      MPI_BYTE, i, 0, _mpiComm));
+                                      MPI_BYTE, i, 0, _mpiComm, _waitStrategy));
         }
     }
 #else
     MPI_CHECK(MPI_Bcast_Nospin((void*)&mh, sizeof(MessageHeader), MPI_BYTE,
-                               _mpiRank, _mpiComm));
+                               _mpiRank, _mpiComm, _waitStrategy));
 #endif
 }
 
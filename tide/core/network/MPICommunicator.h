@@ -41,6 +41,7 @@
 #define MPICOMMUNICATOR_H
 
 #include "NetworkBarrier.h"
+#include "network/MPIWaitStrategy.h"
 #include "network/MessageHeader.h"
 #include "types.h"
 
@@ -48,6 +49,15 @@
 
 class MPIContext;
 
+/**
+ * Topology-aware ways of splitting a communicator.
+ */
+enum class MPISplitType
+{
+    /** Group the processes which can share memory, i.e. on the same host. */
+    host
+};
+
 /**
  * The result of a probe operation on the network communicator.
  */
@@ -94,6 +104,16 @@ public:
      */
     MPICommunicator(const MPICommunicator& parent, int color);
 
+    /**
+     * Create a communicator by splitting a parent one according to topology.
+     *
+     * The new ranks are ordered according to the ranks in the parent.
+     *
+     * @param parent The parent context to split, sharing the same MPIContext.
+     * @param type The type of split, for instance one group per host.
+     */
+    MPICommunicator(const MPICommunicator& parent, MPISplitType type);
+
     /** Destructor, closes the MPI communicator. */
     ~MPICommunicator();
 
@@ -103,6 +123,17 @@ public:
     /** Get the number of processes in this group. */
     int getSize() const;
 
+    /**
+     * Set how blocking operations wait for completion.
+     *
+     * The default strategy is read from the environment by the primary
+     * communicator and inherited by the communicators split from it.
+     */
+    void setWaitStrategy(const MPIWaitStrategy& strategy);
+
+    /** @return the strategy used by blocking operations. */
+    const MPIWaitStrategy& getWaitStrategy() const;
+
     /** @name One-to-one communication. */
     //@{
     /**
@@ -154,6 +185,24 @@ public:
     void broadcast(MessageType type, const std::string& data);
     void broadcast(MessageType type, const QByteArray& data);
 
+    /**
+     * Brodcast a message to all other processes, sending the payload only to
+     * the processes of a second communicator.
+     *
+     * The processes of payloadComm relay the payload to the others, typically
+     * one process per host sharing it in memory with its neighbours.
+     *
+     * @see receiveBroadcastHeader()
+     * @param type The message type
+     * @param data The serialized payload
+     * @param payloadComm The communicator of the relays, in which this process
+     *        must have the same rank as in this communicator.
+     */
+    void broadcast(MessageType type, const std::string& data,
+                   MPICommunicator& payloadComm);
+    void broadcast(MessageType type, const QByteArray& data,
+                   MPICommunicator& payloadComm);
+
     /**
      * Receive a header broadcast by a specific process.
      * This call is blocking.
@@ -186,6 +235,13 @@ public:
      */
     int globalSum(int localValue) const;
 
+    /**
+     * Get the minimum of the given local values across all processes.
+     * @param localValue The value to compare
+     * @return the smallest of the localValues
+     */
+    int globalMin(int localValue) const;
+
     /**
      * Gather the values accross all the processes.
      * @param value The local value
@@ -195,10 +251,13 @@ public:
     //@}
 
 private:
+    friend class MPISharedBuffer;
+
     std::shared_ptr<MPIContext> _mpiContext;
     MPI_Comm _mpiComm{MPI_COMM_NULL};
     int _mpiRank = -1;
     int _mpiSize = -1;
+    MPIWaitStrategy _waitStrategy;
 
     void _initRankAndSize();
     void _broadcast(const MessageHeader& mh);
@@ -0,0 +1,96 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "MPIHierarchy.h"
+
+#include <limits>
+
+namespace
+{
+const int LEADER = 0;
+const int LEADERS_COLOR = 0;
+const int OTHERS_COLOR = 1;
+}
+
+MPIHierarchy::MPIHierarchy(const MPICommunicator& parent)
+    : _hostComm{parent, MPISplitType::host}
+    , _leadersComm{parent, _hostComm.getRank() == LEADER ? LEADERS_COLOR
+                                                         : OTHERS_COLOR}
+    , _hostCount{parent.globalSum(isHostLeader() ? 1 : 0)}
+{
+}
+
+bool MPIHierarchy::isHostLeader() const
+{
+    return _hostComm.getRank() == LEADER;
+}
+
+int MPIHierarchy::getHostSize() const
+{
+    return _hostComm.getSize();
+}
+
+int MPIHierarchy::getHostCount() const
+{
+    return _hostCount;
+}
+
+void MPIHierarchy::globalBarrier() const
+{
+    _hostComm.globalBarrier();
+    if (isHostLeader())
+        _leadersComm.globalBarrier();
+    _hostComm.globalBarrier();
+}
+
+int MPIHierarchy::globalSum(const int localValue) const
+{
+    const auto hostSum = _hostComm.globalSum(localValue);
+    const auto sum = isHostLeader() ? _leadersComm.globalSum(hostSum) : 0;
+    // Share the result of the leader with the other processes of the host
+    return _hostComm.globalSum(sum);
+}
+
+int MPIHierarchy::globalMin(const int localValue) const
+{
+    const auto hostMin = _hostComm.globalMin(localValue);
+    const auto min = isHostLeader() ? _leadersComm.globalMin(hostMin)
+                                    : std::numeric_limits<int>::max();
+    // Share the result of the leader with the other processes of the host
+    return _hostComm.globalMin(min);
+}
@@ -0,0 +1,100 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef MPIHIERARCHY_H
+#define MPIHIERARCHY_H
+
+#include "network/MPICommunicator.h"
+#include "network/NetworkBarrier.h"
+
+/**
+ * Hierarchical collective operations for processes spread over several hosts.
+ *
+ * The operations are performed amongst the processes of each host first, then
+ * amongst one leader process per host, so that only one process per host
+ * communicates over the network.
+ */
+class MPIHierarchy : public NetworkBarrier
+{
+public:
+    /**
+     * Create the hierarchy by splitting a parent communicator.
+     *
+     * This is a collective operation on all the processes of the parent.
+     *
+     * @param parent The communicator of all the processes.
+     */
+    explicit MPIHierarchy(const MPICommunicator& parent);
+
+    /** @return true if this process is the leader of its host. */
+    bool isHostLeader() const;
+
+    /** @return the number of processes on the host of this process. */
+    int getHostSize() const;
+
+    /** @return the number of hosts. */
+    int getHostCount() const;
+
+    /** @name Collective operations. */
+    //@{
+    /** Block execution until all participants have reached the barrier. */
+    void globalBarrier() const final;
+
+    /**
+     * Get the sum of the given local values across all processes.
+     * @param localValue The value to sum
+     * @return the sum of the localValues
+     */
+    int globalSum(int localValue) const;
+
+    /**
+     * Get the minimum of the given local values across all processes.
+     * @param localValue The value to compare
+     * @return the smallest of the localValues
+     */
+    int globalMin(int localValue) const;
+    //@}
+
+private:
+    MPICommunicator _hostComm;
+    // The non-leaders form a group of their own which is never used
+    MPICommunicator _leadersComm;
+    int _hostCount = 0;
+};
+
+#endif
@@ -46,53 +46,251 @@
 
 #include <algorithm>
 #include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #define TIDE_DISABLE_MPI_NOSPIN 0 // switch for debugging purposes only
 
 namespace
 {
-const size_t nsec_start = 1000;
-const size_t nsec_max = 100000;
+using clock = std::chrono::steady_clock;
 
-int _waitForCompletion(MPI_Request req, MPI_Status* status)
+/** Non-blocking test of an MPI operation, sets flag to true on completion. */
+using TestFunc = std::function<int(int& flag)>;
+
+/** Poll with a backoff: optional busy-polling, then exponential sleep. */
+class Poller
+{
+public:
+    Poller(const MPIWaitStrategy& strategy, const bool spin)
+        : _strategy(strategy)
+        , _spinEnd{clock::now() + (spin ? strategy.spinTime
+                                        : std::chrono::microseconds{0})}
+        , _sleep{strategy.minSleep}
+    {
+    }
+
+    /** @return the duration to wait before the next poll, 0 when spinning. */
+    std::chrono::nanoseconds next()
+    {
+        if (clock::now() < _spinEnd)
+            return std::chrono::nanoseconds{0};
+        const auto sleep = _sleep;
+        _sleep = std::min(_sleep * 2, _strategy.maxSleep);
+        return sleep;
+    }
+
+    void wait()
+    {
+        const auto sleep = next();
+        if (sleep.count() > 0)
+            std::this_thread::sleep_for(sleep);
+    }
+
+private:
+    const MPIWaitStrategy& _strategy;
+    const clock::time_point _spinEnd;
+    std::chrono::nanoseconds _sleep;
+};
+
+int _poll(const TestFunc& test, const MPIWaitStrategy& strategy,
+          const bool spin)
 {
-    auto sleep_ns = nsec_start;
     int flag = 0;
-    while (!flag)
+    int ret = test(flag);
+    Poller poller{strategy, spin};
+    while (ret == MPI_SUCCESS && !flag)
+    {
+        poller.wait();
+        ret = test(flag);
+    }
+    return ret;
+}
+
+/**
+ * A single thread polling all the pending operations of the process, so that
+ * the threads waiting on them consume no CPU.
+ */
+class ProgressThread
+{
+public:
+    static ProgressThread& instance(const MPIWaitStrategy& strategy)
+    {
+        static ProgressThread progressThread{strategy};
+        return progressThread;
+    }
+
+    ~ProgressThread()
+    {
+        {
+            const std::lock_guard<std::mutex> lock{_mutex};
+            _stop = true;
+        }
+        _condition.notify_all();
+        _thread.join();
+    }
+
+    int wait(TestFunc test)
+    {
+        // Operations often complete immediately, don't wait for the thread
+        int flag = 0;
+        const int ret = test(flag);
+        if (flag || ret != MPI_SUCCESS)
+            return ret;
+
+        Waiter waiter{std::move(test)};
+
+        std::unique_lock<std::mutex> lock{_mutex};
+        _waiters.push_back(&waiter);
+        ++_changes;
+        _condition.notify_all();
+        _condition.wait(lock, [&waiter] { return waiter.done; });
+        return waiter.result;
+    }
+
+private:
+    struct Waiter
+    {
+        TestFunc test;
+        int result = MPI_SUCCESS;
+        bool done = false;
+    };
+
+    const MPIWaitStrategy _strategy;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::vector<Waiter*> _waiters;
+    size_t _changes = 0; // incremented when _waiters is modified
+    bool _stop = false;
+    std::thread _thread;
+
+    ProgressThread(const MPIWaitStrategy& strategy)
+        : _strategy(strategy)
+        , _thread{&ProgressThread::_run, this}
     {
-        std::this_thread::sleep_for(std::chrono::nanoseconds(sleep_ns));
-        sleep_ns = std::min(size_t(sleep_ns << 1), nsec_max);
-        MPI_Request_get_status(req, &flag, status);
     }
+
+    void _run()
+    {
+        std::unique_ptr<Poller> poller;
+        size_t changes = 0;
+        while (true)
+        {
+            std::vector<Waiter*> waiters;
+            {
+                std::unique_lock<std::mutex> lock{_mutex};
+                _condition.wait(lock, [this] {
+                    return _stop || !_waiters.empty();
+                });
+                if (_stop)
+                    return;
+                // Restart the backoff for new operations
+                if (changes != _changes)
+                {
+                    changes = _changes;
+                    poller.reset();
+                }
+                waiters = _waiters;
+            }
+
+            // Waiters stay blocked until marked done, so they can be tested
+            // outside of the lock.
+            std::vector<Waiter*> completed;
+            for (auto waiter : waiters)
+            {
+                int flag = 0;
+                waiter->result = waiter->test(flag);
+                if (flag || waiter->result != MPI_SUCCESS)
+                    completed.push_back(waiter);
+            }
+
+            if (completed.empty())
+            {
+                if (!poller)
+                    poller.reset(new Poller{_strategy, true});
+                const auto sleep = poller->next();
+                if (sleep.count() == 0)
+                    continue;
+
+                // New waiters interrupt the sleep to be tested immediately
+                std::unique_lock<std::mutex> lock{_mutex};
+                _condition.wait_for(lock, sleep, [this, changes] {
+                    return _stop || _changes != changes;
+                });
+                continue;
+            }
+            poller.reset();
+
+            {
+                const std::lock_guard<std::mutex> lock{_mutex};
+                for (auto waiter : completed)
+                {
+                    waiter->done = true;
+                    _waiters.erase(std::remove(_waiters.begin(),
+                                               _waiters.end(), waiter),
+                                   _waiters.end());
+                }
+                ++_changes;
+            }
+            _condition.notify_all();
+        }
+    }
+};
+
+int _wait(const TestFunc& test, const MPIWaitStrategy& strategy,
+          const bool collective)
+{
+    switch (strategy.mode)
+    {
+    case MPIWaitMode::spin_then_sleep:
+        return _poll(test, strategy, true);
+    case MPIWaitMode::progress_thread:
+        return ProgressThread::instance(strategy).wait(test);
+    case MPIWaitMode::hybrid:
+        if (collective)
+            return _poll(test, strategy, true);
+        return ProgressThread::instance(strategy).wait(test);
+    case MPIWaitMode::backoff:
+    default:
+        return _poll(test, strategy, false);
+    }
+}
+
+int _waitForCompletion(MPI_Request req, MPI_Status* status,
+                       const MPIWaitStrategy& strategy, const bool collective)
+{
+    const auto ret = _wait(
+        [&req, status](int& flag) {
+            return MPI_Request_get_status(req, &flag, status);
+        },
+        strategy, collective);
+    if (ret != MPI_SUCCESS)
+        return ret;
     return MPI_Wait(&req, status);
 }
 }
 
 int MPI_Probe_Nospin(const int source, const int tag, MPI_Comm comm,
-                     MPI_Status* status)
+                     MPI_Status* status, const MPIWaitStrategy& strategy)
 {
 #if TIDE_DISABLE_MPI_NOSPIN
     return MPI_Probe(source, tag, comm, status);
 #else
-    int flag = 0;
-    int ret = MPI_Iprobe(source, tag, comm, &flag, status);
-    if (ret != MPI_SUCCESS)
-        return ret;
-
-    timespec ts{0, nsec_start};
-    while (!flag)
-    {
-        nanosleep(&ts, nullptr);
-        ts.tv_nsec = std::min(size_t(ts.tv_nsec << 1), nsec_max);
-        ret = MPI_Iprobe(source, tag, comm, &flag, status);
-    }
-    return ret;
+    return _wait(
+        [source, tag, comm, status](int& flag) {
+            return MPI_Iprobe(source, tag, comm, &flag, status);
+        },
+        strategy, false);
 #endif
 }
 
 int MPI_Send_Nospin(void* buff, const int count, MPI_Datatype datatype,
-                    const int dest, const int tag, MPI_Comm comm)
+                    const int dest, const int tag, MPI_Comm comm,
+                    const MPIWaitStrategy& strategy)
 {
 #if TIDE_DISABLE_MPI_NOSPIN
     return MPI_Send(buff, count, datatype, dest, tag, comm);
@@ -102,13 +300,13 @@ int MPI_Send_Nospin(void* buff, const int count, MPI_Datatype datatype,
     if (ret != MPI_SUCCESS)
         return ret;
 
-    return _waitForCompletion(req, MPI_STATUS_IGNORE);
+    return _waitForCompletion(req, MPI_STATUS_IGNORE, strategy, false);
 #endif
 }
 
 int MPI_Recv_Nospin(void* buff, const int count, MPI_Datatype datatype,
                     const int from, const int tag, MPI_Comm comm,
-                    MPI_Status* status)
+                    MPI_Status* status, const MPIWaitStrategy& strategy)
 {
 #if TIDE_DISABLE_MPI_NOSPIN
     return MPI_Recv(buff, count, datatype, from, tag, comm, status);
@@ -118,12 +316,13 @@ int MPI_Recv_Nospin(void* buff, const int count, MPI_Datatype datatype,
     if (ret != MPI_SUCCESS)
         return ret;
 
-    return _waitForCompletion(req, status);
+    return _waitForCompletion(req, status, strategy, false);
 #endif
 }
 
 int MPI_Bcast_Nospin(void* buff, const int count, MPI_Datatype datatype,
-                     const int root, MPI_Comm comm)
+                     const int root, MPI_Comm comm,
+                     const MPIWaitStrategy& strategy)
 {
 #if TIDE_DISABLE_MPI_NOSPIN
     MPI_Bcast(buff, count, datatype, root, comm);
@@ -133,6 +332,56 @@ int MPI_Bcast_Nospin(void* buff, const int count, MPI_Datatype datatype,
     if (ret != MPI_SUCCESS)
         return ret;
 
-    return _waitForCompletion(req, MPI_STATUS_IGNORE);
+    return _waitForCompletion(req, MPI_STATUS_IGNORE, strategy, true);
+#endif
+}
+
+int MPI_Barrier_Nospin(MPI_Comm comm, const MPIWaitStrategy& strategy)
+{
+#if TIDE_DISABLE_MPI_NOSPIN
+    return MPI_Barrier(comm);
+#else
+    MPI_Request req;
+    const int ret = MPI_Ibarrier(comm, &req);
+    if (ret != MPI_SUCCESS)
+        return ret;
+
+    return _waitForCompletion(req, MPI_STATUS_IGNORE, strategy, true);
+#endif
+}
+
+int MPI_Allreduce_Nospin(const void* sendbuf, void* recvbuf, const int count,
+                         MPI_Datatype datatype, MPI_Op op, MPI_Comm comm,
+                         const MPIWaitStrategy& strategy)
+{
+#if TIDE_DISABLE_MPI_NOSPIN
+    return MPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm);
+#else
+    MPI_Request req;
+    const int ret =
+        MPI_Iallreduce(sendbuf, recvbuf, count, datatype, op, comm, &req);
+    if (ret != MPI_SUCCESS)
+        return ret;
+
+    return _waitForCompletion(req, MPI_STATUS_IGNORE, strategy, true);
+#endif
+}
+
+int MPI_Allgather_Nospin(const void* sendbuf, const int sendcount,
+                         MPI_Datatype sendtype, void* recvbuf,
+                         const int recvcount, MPI_Datatype recvtype,
+                         MPI_Comm comm, const MPIWaitStrategy& strategy)
+{
+#if TIDE_DISABLE_MPI_NOSPIN
+    return MPI_Allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount,
+                         recvtype, comm);
+#else
+    MPI_Request req;
+    const int ret = MPI_Iallgather(sendbuf, sendcount, sendtype, recvbuf,
+                                   recvcount, recvtype, comm, &req);
+    if (ret != MPI_SUCCESS)
+        return ret;
+
+    return _waitForCompletion(req, MPI_STATUS_IGNORE, strategy, true);
 #endif
 }
@@ -40,33 +40,66 @@
 #ifndef MPISENDRECV_H
 #define MPISENDRECV_H
 
+#include "MPIWaitStrategy.h"
+
 #include <mpi.h>
 
 /**
  * Implements a blocking, non-spinning MPI_Probe to minimize CPU usage.
+ *
+ * The progress thread used by the progress_thread and hybrid modes is created
+ * on first use with the strategy of that call.
  * @see MPI_Probe
  */
-int MPI_Probe_Nospin(int source, int tag, MPI_Comm comm, MPI_Status* status);
+int MPI_Probe_Nospin(int source, int tag, MPI_Comm comm, MPI_Status* status,
+                     const MPIWaitStrategy& strategy = MPIWaitStrategy());
 
 /**
  * Implements a blocking, non-spinning MPI_Send to minimize CPU usage.
  * @see MPI_Send
  */
 int MPI_Send_Nospin(void* buff, int count, MPI_Datatype datatype, int dest,
-                    int tag, MPI_Comm comm);
+                    int tag, MPI_Comm comm,
+                    const MPIWaitStrategy& strategy = MPIWaitStrategy());
 
 /**
  * Implements a blocking, non-spinning MPI_Recv to minimize CPU usage.
  * @see MPI_Recv
  */
 int MPI_Recv_Nospin(void* buff, int count, MPI_Datatype datatype, int from,
-                    int tag, MPI_Comm comm, MPI_Status* status);
+                    int tag, MPI_Comm comm, MPI_Status* status,
+                    const MPIWaitStrategy& strategy = MPIWaitStrategy());
 
 /**
  * Implements a blocking, non-spinning MPI_Bcast to minimize CPU usage.
  * @see MPI_Bcast
  */
 int MPI_Bcast_Nospin(void* buff, int count, MPI_Datatype datatype, int root,
-                     MPI_Comm comm);
+                     MPI_Comm comm,
+                     const MPIWaitStrategy& strategy = MPIWaitStrategy());
+
+/**
+ * Implements a blocking, non-spinning MPI_Barrier to minimize CPU usage.
+ * @see MPI_Barrier
+ */
+int MPI_Barrier_Nospin(MPI_Comm comm,
+                       const MPIWaitStrategy& strategy = MPIWaitStrategy());
+
+/**
+ * Implements a blocking, non-spinning MPI_Allreduce to minimize CPU usage.
+ * @see MPI_Allreduce
+ */
+int MPI_Allreduce_Nospin(const void* sendbuf, void* recvbuf, int count,
+                         MPI_Datatype datatype, MPI_Op op, MPI_Comm comm,
+                         const MPIWaitStrategy& strategy = MPIWaitStrategy());
+
+/**
+ * Implements a blocking, non-spinning MPI_Allgather to minimize CPU usage.
+ * @see MPI_Allgather
+ */
+int MPI_Allgather_Nospin(const void* sendbuf, int sendcount,
+                         MPI_Datatype sendtype, void* recvbuf, int recvcount,
+                         MPI_Datatype recvtype, MPI_Comm comm,
+                         const MPIWaitStrategy& strategy = MPIWaitStrategy());
 
 #endif
@@ -0,0 +1,111 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "MPISharedBuffer.h"
+
+#include "MPICommunicator.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+const int RANK0 = 0;
+}
+
+MPISharedBuffer::MPISharedBuffer(const MPICommunicator& hostComm)
+    : _hostComm{hostComm}
+{
+}
+
+MPISharedBuffer::~MPISharedBuffer()
+{
+    _free();
+}
+
+void MPISharedBuffer::setSize(const size_t minSize)
+{
+    // All processes take the same decision from the same size, the growth
+    // factor avoids reallocating for small variations (e.g. jpeg frames).
+    if (_capacity < minSize)
+        _allocate(std::max(minSize, 2 * _capacity));
+    _size = minSize;
+}
+
+void MPISharedBuffer::synchronize()
+{
+    if (_window != MPI_WIN_NULL)
+        MPI_Win_sync(_window);
+    _hostComm.globalBarrier();
+    if (_window != MPI_WIN_NULL)
+        MPI_Win_sync(_window);
+}
+
+void MPISharedBuffer::_allocate(const size_t capacity)
+{
+    _free();
+
+    const auto localSize = _hostComm.getRank() == RANK0 ? capacity : 0;
+    char* localData = nullptr;
+    if (MPI_Win_allocate_shared(localSize, 1, MPI_INFO_NULL,
+                                _hostComm._mpiComm, &localData,
+                                &_window) != MPI_SUCCESS)
+    {
+        throw std::runtime_error("could not allocate MPI shared memory");
+    }
+
+    MPI_Aint size = 0;
+    int dispUnit = 0;
+    MPI_Win_shared_query(_window, RANK0, &size, &dispUnit, &_data);
+    _capacity = capacity;
+
+    // Passive target epoch for the lifetime of the window, the processes
+    // synchronize themselves with MPI_Win_sync() and barriers.
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, _window);
+}
+
+void MPISharedBuffer::_free()
+{
+    if (_window == MPI_WIN_NULL)
+        return;
+
+    MPI_Win_unlock_all(_window);
+    MPI_Win_free(&_window);
+    _data = nullptr;
+    _capacity = 0;
+}
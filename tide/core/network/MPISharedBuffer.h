@@ -0,0 +1,101 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef MPISHAREDBUFFER_H
+#define MPISHAREDBUFFER_H
+
+#include "types.h"
+
+#include <boost/noncopyable.hpp>
+#include <mpi.h>
+
+/**
+ * A buffer in memory shared by the processes of a host (MPI-3 shared window).
+ *
+ * The memory is allocated by the process of rank 0 and directly accessible by
+ * all the others, so that it can receive data from the network once for all of
+ * them. It follows the ReceiveBuffer interface, so that serialization::get<T>()
+ * can deserialize an object in place.
+ *
+ * All the functions except size() and data() are collective on the processes
+ * of the communicator.
+ */
+class MPISharedBuffer : boost::noncopyable
+{
+public:
+    /**
+     * Create an empty buffer.
+     * @param hostComm a communicator of processes on the same host.
+     */
+    explicit MPISharedBuffer(const MPICommunicator& hostComm);
+
+    /** Free the shared memory. */
+    ~MPISharedBuffer();
+
+    /**
+     * Set the new size of the buffer and grow the storage if necessary.
+     * @param minSize the minimum size required for a following deserialization.
+     * @throw std::runtime_error if the processes can't share memory.
+     */
+    void setSize(size_t minSize);
+
+    /** @return the current size of the buffer. */
+    size_t size() const { return _size; }
+    /** Direct write access to the buffer, don't write beyond size(). */
+    char* data() { return _data; }
+    /** Direct read access to the buffer, don't read beyond size(). */
+    const char* data() const { return _data; }
+
+    /**
+     * Make the writes of each process visible to the others and wait for all of
+     * them, typically after rank 0 has written new data or before it does.
+     */
+    void synchronize();
+
+private:
+    const MPICommunicator& _hostComm;
+    MPI_Win _window{MPI_WIN_NULL};
+    char* _data = nullptr;
+    size_t _capacity = 0;
+    size_t _size = 0;
+
+    void _allocate(size_t capacity);
+    void _free();
+};
+
+#endif
@@ -0,0 +1,93 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "MPIWaitStrategy.h"
+
+#include "utils/log.h"
+
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+std::string _getEnv(const char* name)
+{
+    const auto value = getenv(name);
+    return value != nullptr ? value : "";
+}
+
+template <typename Duration>
+void _parseDuration(const char* name, Duration& duration)
+{
+    const auto valueStr = _getEnv(name);
+    if (valueStr.empty())
+        return;
+    try
+    {
+        duration = std::chrono::microseconds{std::stoul(valueStr)};
+    }
+    catch (...)
+    {
+        print_log(LOG_WARN, LOG_MPI, "Could not parse %s: %s", name,
+                  valueStr.c_str());
+    }
+}
+}
+
+MPIWaitStrategy MPIWaitStrategy::fromEnvironment()
+{
+    MPIWaitStrategy strategy;
+
+    const auto mode = _getEnv("TIDE_MPI_WAIT");
+    if (mode == "spin")
+        strategy.mode = MPIWaitMode::spin_then_sleep;
+    else if (mode == "progress")
+        strategy.mode = MPIWaitMode::progress_thread;
+    else if (mode == "hybrid")
+        strategy.mode = MPIWaitMode::hybrid;
+    else if (!mode.empty() && mode != "backoff")
+        print_log(LOG_WARN, LOG_MPI, "Unknown TIDE_MPI_WAIT mode: %s",
+                  mode.c_str());
+
+    _parseDuration("TIDE_MPI_SPIN_US", strategy.spinTime);
+    _parseDuration("TIDE_MPI_MAX_SLEEP_US", strategy.maxSleep);
+    if (strategy.maxSleep < strategy.minSleep)
+        strategy.minSleep = strategy.maxSleep;
+
+    return strategy;
+}
@@ -0,0 +1,91 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef MPIWAITSTRATEGY_H
+#define MPIWAITSTRATEGY_H
+
+#include <chrono>
+
+/**
+ * How blocking MPI operations wait for completion.
+ */
+enum class MPIWaitMode
+{
+    /** Sleep between polls with an exponential backoff (lowest CPU usage). */
+    backoff,
+    /** Busy-poll for a short period, then sleep with exponential backoff. */
+    spin_then_sleep,
+    /**
+     * Waiting threads block on a condition variable while a single dedicated
+     * thread polls all pending operations of the process.
+     */
+    progress_thread,
+    /**
+     * Use spin-then-sleep for collectives on the frame synchronization path
+     * and the progress thread for point-to-point operations.
+     */
+    hybrid
+};
+
+/**
+ * Parameters of the wait strategy of blocking MPI operations.
+ */
+struct MPIWaitStrategy
+{
+    MPIWaitMode mode = MPIWaitMode::backoff;
+
+    /** Duration of busy-polling before sleeping (spin modes only). */
+    std::chrono::microseconds spinTime{50};
+
+    /** Initial sleep duration between two polls. */
+    std::chrono::nanoseconds minSleep{1000};
+
+    /** Maximum sleep duration between two polls. */
+    std::chrono::nanoseconds maxSleep{100000};
+
+    /**
+     * Get the strategy defined by the environment.
+     *
+     * TIDE_MPI_WAIT: backoff (default), spin, progress or hybrid.
+     * TIDE_MPI_SPIN_US: busy-polling duration in microseconds.
+     * TIDE_MPI_MAX_SLEEP_US: maximum sleep duration in microseconds.
+     */
+    static MPIWaitStrategy fromEnvironment();
+};
+
+#endif
@@ -59,7 +59,11 @@ enum class MessageType
     COUNTDOWN_STATUS,
     PIXELSTREAM_CLOSE,
     LOCK,
-    CONFIG
+    CONFIG,
+    METRICS,
+    PIXELSTREAM_DIRECT,
+    PIXELSTREAM_CREDIT,
+    WHITEBOARD_STROKE
 };
 
 /** Fixed-size message header. */
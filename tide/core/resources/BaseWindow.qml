@@ -85,6 +85,15 @@ Rectangle {
                 sourceComponent: MovieControls {
                 }
             }
+            Loader {
+                id: whiteboardBar
+                width: parent.width
+                visible: status == Loader.Ready
+                active: (typeof window.content.brushColor !== "undefined")
+                        && !windowRect.isBackground
+                sourceComponent: WhiteboardControls {
+                }
+            }
         }
     }
 
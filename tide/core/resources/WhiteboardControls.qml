@@ -0,0 +1,70 @@
+// Copyright (c) 2019, EPFL/Blue Brain Project
+import QtQuick 2.0
+import Tide 1.0
+import "style.js" as Style
+
+Item {
+    property var whiteboard: window.content
+
+    height: Style.buttonsSize
+    width: parent.width
+
+    Row {
+        id: brushes
+        anchors.left: parent.left
+        anchors.leftMargin: Style.buttonsPadding
+        anchors.verticalCenter: parent.verticalCenter
+        spacing: Style.buttonsPadding
+
+        Repeater {
+            model: Style.whiteboardColors
+            delegate: Rectangle {
+                width: Style.whiteboardSwatchSize
+                height: width
+                anchors.verticalCenter: parent.verticalCenter
+                color: modelData
+                property bool selected: String(whiteboard.brushColor) === modelData
+                border.width: selected ? 4 : 1
+                border.color: selected ? Style.highlightColor : Style.contrastColor
+                ClickArea {
+                    anchors.fill: parent
+                    onClicked: contentcontroller.setBrushColor(modelData)
+                }
+            }
+        }
+        Repeater {
+            model: Style.whiteboardBrushSizes
+            delegate: Item {
+                width: Style.whiteboardSwatchSize
+                height: width
+                anchors.verticalCenter: parent.verticalCenter
+                Rectangle {
+                    anchors.centerIn: parent
+                    width: Math.min(parent.width, modelData)
+                    height: width
+                    radius: width / 2
+                    color: whiteboard.brushSize
+                           === modelData ? Style.highlightColor : Style.contrastColor
+                }
+                ClickArea {
+                    anchors.fill: parent
+                    onClicked: contentcontroller.setBrushSize(modelData)
+                }
+            }
+        }
+    }
+    Row {
+        anchors.right: parent.right
+        anchors.verticalCenter: parent.verticalCenter
+
+        ControlButton {
+            image: "qrc:/img/close.svg"
+            active: whiteboard.strokeCount > 0
+            onClicked: contentcontroller.clear()
+        }
+        ControlButton {
+            image: "qrc:/img/tick.svg"
+            onClicked: contentcontroller.saveImage()
+        }
+    }
+}
@@ -88,6 +88,10 @@ var windowSideButtonWidth = 64
 var movieControlsHandleDiameter = buttonsSize / 3
 var movieControlsLineThickness = movieControlsHandleDiameter / 9
 
+var whiteboardColors = ["#ff4444", "#000000", "#ffffff", "#33b5e5", "#99cc00", "#ffbb33"]
+var whiteboardBrushSizes = [5, 15, 25, 50]
+var whiteboardSwatchSize = buttonsSize * 0.6
+
 var transparentContentsBackgroundColor = "black"
 
 var windowFocusGlowColor = highlightColor
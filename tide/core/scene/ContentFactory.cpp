@@ -46,6 +46,7 @@
 #include "ImageContent.h"
 #include "PixelStreamContent.h"
 #include "SVGContent.h"
+#include "WhiteboardContent.h"
 #include "data/ImageReader.h"
 #if TIDE_USE_TIFF
 #include "ImagePyramidContent.h"
@@ -110,6 +111,11 @@ ContentType _getContentTypeForFile(const QString& uri)
             size.height() <= maxTextureSize.height())
             return ContentType::image;
 
+#if TIDE_USE_TIFF
+        // Larger images are converted to pyramids by the wall processes
+        if (!imageReader.isStereo())
+            return ContentType::image;
+#endif
         throw load_error(
             "Image is too big to open. Try converting it to a TIFF image "
             "pyramid using Tide's 'pyramidify' tool.");
@@ -164,6 +170,12 @@ ContentPtr ContentFactory::createPixelStreamContent(const QString& uri,
     return std::make_unique<PixelStreamContent>(uri, size, keyboard);
 }
 
+ContentPtr ContentFactory::createWhiteboardContent(const QString& uri,
+                                                   const QSize& size)
+{
+    return std::make_unique<WhiteboardContent>(uri, size);
+}
+
 ContentPtr ContentFactory::createErrorContent(const Content& content)
 {
     const auto& uri = content.getUri();
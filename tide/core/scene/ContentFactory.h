@@ -63,6 +63,10 @@ public:
         const QString& uri, const QSize& size,
         StreamType stream = StreamType::EXTERNAL);
 
+    /** Special case: a whiteboard is not associated with any file. */
+    static ContentPtr createWhiteboardContent(const QString& uri,
+                                              const QSize& size);
+
     /** Create a Content representing a loading error. */
     static ContentPtr createErrorContent(const Content& content);
 
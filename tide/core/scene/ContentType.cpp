@@ -48,6 +48,7 @@ bool contentTypeIsFile(const ContentType type)
     {
     case ContentType::invalid:
     case ContentType::pixel_stream:
+    case ContentType::whiteboard:
 #if TIDE_ENABLE_WEBBROWSER_SUPPORT
     case ContentType::webbrowser:
 #endif
@@ -96,6 +97,9 @@ std::ostream& operator<<(std::ostream& str, const ContentType type)
     case ContentType::image:
         str << "image";
         break;
+    case ContentType::whiteboard:
+        str << "whiteboard";
+        break;
     }
     return str;
 }
@@ -66,7 +66,8 @@ enum class ContentType
 #endif
     pixel_stream,
     svg,
-    image
+    image,
+    whiteboard
 };
 
 /**
@@ -77,9 +78,8 @@ enum class StreamType
     EXTERNAL,
     LAUNCHER,
 #if TIDE_ENABLE_WEBBROWSER_SUPPORT
-    WEBBROWSER,
+    WEBBROWSER
 #endif
-    WHITEBOARD
 };
 
 bool contentTypeIsFile(ContentType type);
@@ -45,6 +45,8 @@
 #include "utils/compilerMacros.h"
 #include "utils/log.h"
 
+#include <algorithm>
+
 IMPLEMENT_SERIALIZE_FOR_XML(DisplayGroup)
 
 DisplayGroupPtr DisplayGroup::create(const QSizeF& size)
@@ -73,6 +75,7 @@ void DisplayGroup::add(WindowPtr window)
     const auto empty = isEmpty();
 
     _windows.push_back(window);
+    _addToIndex(window);
     _watchChanges(*window);
 
     if (window->isPanel())
@@ -111,6 +114,7 @@ void DisplayGroup::remove(WindowPtr window)
 
     removeFocusedWindow(*it);
     _windows.erase(it);
+    _removeFromIndex(window);
 
     // disconnect any existing connections with the window
     disconnect(window.get(), 0, this, 0);
@@ -139,6 +143,11 @@ void DisplayGroup::moveToFront(WindowPtr window)
     _windows.erase(it);
     _windows.push_back(window);
 
+    auto& sameUriWindows = _uriIndex[_windowIndex[window->getID()].uri];
+    sameUriWindows.erase(std::find(sameUriWindows.begin(),
+                                   sameUriWindows.end(), window));
+    sameUriWindows.push_back(window);
+
     emit(windowMovedToFront(window));
     _sendDisplayGroup();
 }
@@ -155,22 +164,14 @@ const WindowPtrs& DisplayGroup::getWindows() const
 
 WindowPtr DisplayGroup::getWindow(const QUuid& id) const
 {
-    for (const auto& window : _windows)
-    {
-        if (window->getID() == id)
-            return window;
-    }
-    return WindowPtr();
+    const auto it = _windowIndex.find(id);
+    return it == _windowIndex.end() ? WindowPtr() : it->window;
 }
 
 WindowPtr DisplayGroup::findWindow(const QString& filename) const
 {
-    for (const auto& window : _windows)
-    {
-        if (window->getContent().getUri() == filename)
-            return window;
-    }
-    return WindowPtr();
+    const auto it = _uriIndex.find(filename);
+    return it == _uriIndex.end() ? WindowPtr() : it->front();
 }
 
 void DisplayGroup::replaceWindows(WindowPtrs windows)
@@ -340,6 +341,10 @@ void DisplayGroup::_watchChanges(Window& window)
     connect(&window, &Window::contentModified, this,
             &DisplayGroup::_sendDisplayGroup);
 
+    // The content of a window can be replaced, possibly changing its uri
+    connect(&window, &Window::contentModified, this,
+            [this, &window] { _updateUriIndex(window); });
+
     if (window.isPanel())
         connect(&window, &Window::hiddenChanged, this,
                 &DisplayGroup::hasVisiblePanelsChanged);
@@ -347,3 +352,54 @@ void DisplayGroup::_watchChanges(Window& window)
         connect(&window, &Window::selectedChanged, this,
                 &DisplayGroup::selectedUrisChanged);
 }
+
+void DisplayGroup::_addToIndex(const WindowPtr& window)
+{
+    const auto uri = window->getContent().getUri();
+    _windowIndex.insert(window->getID(), {window, uri});
+    _uriIndex[uri].push_back(window);
+}
+
+void DisplayGroup::_removeFromIndex(const WindowPtr& window)
+{
+    const auto it = _windowIndex.find(window->getID());
+    if (it == _windowIndex.end())
+        return;
+
+    auto uriIt = _uriIndex.find(it->uri);
+    uriIt->erase(std::find(uriIt->begin(), uriIt->end(), window));
+    if (uriIt->empty())
+        _uriIndex.erase(uriIt);
+
+    _windowIndex.erase(it);
+}
+
+void DisplayGroup::_updateUriIndex(const Window& window)
+{
+    const auto it = _windowIndex.find(window.getID());
+    if (it == _windowIndex.end() || it->uri == window.getContent().getUri())
+        return;
+
+    const auto windowPtr = it->window;
+    _removeFromIndex(windowPtr);
+
+    // Insert the window at its place in the stack among the new uri ones
+    const auto uri = window.getContent().getUri();
+    auto& sameUriWindows = _uriIndex[uri];
+    sameUriWindows.clear();
+    for (const auto& win : _windows)
+    {
+        if (win == windowPtr)
+            _windowIndex.insert(win->getID(), {win, uri});
+        if (_windowIndex.value(win->getID()).uri == uri)
+            sameUriWindows.push_back(win);
+    }
+}
+
+void DisplayGroup::_rebuildIndex()
+{
+    _windowIndex.clear();
+    _uriIndex.clear();
+    for (const auto& window : _windows)
+        _addToIndex(window);
+}
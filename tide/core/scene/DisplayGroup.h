@@ -47,6 +47,7 @@
 #include "serialization/includes.h"
 #include "types.h"
 
+#include <QHash>
 #include <QUuid>
 
 /**
@@ -102,10 +103,13 @@ public:
     /** Get all windows. */
     const WindowPtrs& getWindows() const;
 
-    /** Get a single window by its id. */
+    /** Get a single window by its id, in constant time. */
     WindowPtr getWindow(const QUuid& id) const;
 
-    /** Find a single window based on its filename. */
+    /**
+     * Find a single window based on its filename, in constant time.
+     * @return the lowest window in the stack showing this file, if any.
+     */
     WindowPtr findWindow(const QString& filename) const;
 
     /**
@@ -214,6 +218,8 @@ private:
         ar & _fullscreenWindow;
         ar & _panels;
         // clang-format on
+        if (Archive::is_loading::value)
+            _rebuildIndex();
     }
 
     /** Serialize for saving to an xml file */
@@ -247,6 +253,7 @@ private:
             // Make sure windows are not in an undefined state
             window->setState(Window::NONE);
         }
+        _rebuildIndex();
     }
 
     /** Saving to xml. */
@@ -259,10 +266,25 @@ private:
     void _sendDisplayGroup();
     void _watchChanges(Window& window);
 
+    void _addToIndex(const WindowPtr& window);
+    void _removeFromIndex(const WindowPtr& window);
+    void _updateUriIndex(const Window& window);
+    void _rebuildIndex();
+
     WindowPtrs _windows;
     WindowSet _focusedWindows;
     WindowPtr _fullscreenWindow;
     WindowSet _panels;
+
+    struct IndexEntry
+    {
+        WindowPtr window;
+        QString uri;
+    };
+    /** Lookup of the windows by id, with the uri they are indexed with. */
+    QHash<QUuid, IndexEntry> _windowIndex;
+    /** Lookup of the windows by content uri, in stacking order. */
+    QHash<QString, WindowPtrs> _uriIndex;
 };
 
 BOOST_CLASS_VERSION(DisplayGroup, FIRST_DISPLAYGROUP_VERSION)
@@ -99,6 +99,11 @@ ContextMenu& Surface::getContextMenu()
     return *_contextMenu;
 }
 
+const ContextMenu& Surface::getContextMenu() const
+{
+    return *_contextMenu;
+}
+
 TIDE_DISABLE_WARNING_SHADOW
 void Surface::moveToThread(QThread* thread)
 {
@@ -69,6 +69,7 @@ public:
     BackgroundPtr getBackgroundPtr() const;
 
     ContextMenu& getContextMenu();
+    const ContextMenu& getContextMenu() const;
 
     /**
      * Move this object and its member QObjects to the given QThread.
@@ -0,0 +1,230 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "WhiteboardContent.h"
+
+#include <QPainter>
+#include <QPainterPath>
+
+#include <algorithm>
+
+BOOST_CLASS_EXPORT_IMPLEMENT(WhiteboardContent)
+
+IMPLEMENT_SERIALIZE_FOR_XML(WhiteboardContent)
+
+namespace
+{
+void _draw(QPainter& painter, const WhiteboardStroke& stroke)
+{
+    if (stroke.points.empty())
+        return;
+
+    QPen pen{stroke.color, stroke.width, Qt::SolidLine, Qt::RoundCap,
+             Qt::RoundJoin};
+    painter.setPen(pen);
+
+    if (stroke.points.size() == 1)
+    {
+        painter.drawPoint(stroke.points.front());
+        return;
+    }
+
+    QPainterPath path{stroke.points.front()};
+    for (auto it = stroke.points.begin() + 1; it != stroke.points.end(); ++it)
+        path.lineTo(*it);
+    painter.drawPath(path);
+}
+}
+
+QRectF WhiteboardStroke::getBoundingRect() const
+{
+    if (points.empty())
+        return QRectF();
+
+    auto left = points.front().x();
+    auto right = left;
+    auto top = points.front().y();
+    auto bottom = top;
+    for (const auto& point : points)
+    {
+        left = std::min(left, point.x());
+        right = std::max(right, point.x());
+        top = std::min(top, point.y());
+        bottom = std::max(bottom, point.y());
+    }
+    const auto margin = width * 0.5;
+    return QRectF{QPointF{left, top}, QPointF{right, bottom}}.adjusted(
+        -margin, -margin, margin, margin);
+}
+
+bool WhiteboardStroke::operator==(const WhiteboardStroke& other) const
+{
+    return color == other.color && width == other.width &&
+           points == other.points;
+}
+
+bool WhiteboardStrokeUpdate::applyTo(
+    std::vector<WhiteboardStroke>& strokes) const
+{
+    if (strokeIndex >= strokes.size())
+        return false;
+
+    auto& strokePoints = strokes[strokeIndex].points;
+    if (offset > strokePoints.size())
+        return false;
+
+    strokePoints.resize(offset);
+    strokePoints.insert(strokePoints.end(), points.begin(), points.end());
+    return true;
+}
+
+WhiteboardContent::WhiteboardContent(const QString& uri, const QSize& size)
+    : VectorialContent{uri}
+{
+    setDimensions(size);
+}
+
+ContentType WhiteboardContent::getType() const
+{
+    return ContentType::whiteboard;
+}
+
+bool WhiteboardContent::readMetadata()
+{
+    return true;
+}
+
+const QColor& WhiteboardContent::getBrushColor() const
+{
+    return _brushColor;
+}
+
+void WhiteboardContent::setBrushColor(const QColor& color)
+{
+    if (color == _brushColor || !color.isValid())
+        return;
+
+    _brushColor = color;
+    emit brushChanged();
+    emit modified();
+}
+
+qreal WhiteboardContent::getBrushSize() const
+{
+    return _brushSize;
+}
+
+void WhiteboardContent::setBrushSize(const qreal size)
+{
+    if (size == _brushSize || size <= 0.0)
+        return;
+
+    _brushSize = size;
+    emit brushChanged();
+    emit modified();
+}
+
+size_t WhiteboardContent::beginStroke(const QPointF& point)
+{
+    _strokes.push_back(WhiteboardStroke{_brushColor, _brushSize, {point}});
+    emit strokesChanged();
+    emit modified();
+    return _strokes.size() - 1;
+}
+
+void WhiteboardContent::extendStroke(const size_t index, const QPointF& point)
+{
+    if (index >= _strokes.size())
+        return;
+
+    auto& points = _strokes[index].points;
+    if (!points.empty() && points.back() == point)
+        return;
+
+    points.push_back(point);
+
+    auto update = std::make_shared<WhiteboardStrokeUpdate>();
+    update->whiteboardId = getId();
+    update->strokeIndex = uint32_t(index);
+    update->offset = uint32_t(points.size() - 1);
+    update->points.push_back(point);
+    emit strokeExtended(update);
+}
+
+void WhiteboardContent::clear()
+{
+    if (_strokes.empty())
+        return;
+
+    _strokes.clear();
+    emit strokesChanged();
+    emit modified();
+}
+
+const std::vector<WhiteboardStroke>& WhiteboardContent::getStrokes() const
+{
+    return _strokes;
+}
+
+int WhiteboardContent::getStrokeCount() const
+{
+    return int(_strokes.size());
+}
+
+QImage WhiteboardContent::toImage(const QSize& size) const
+{
+    const auto imageSize = size.isEmpty() ? getDimensions() : size;
+    QImage image{imageSize, QImage::Format_RGB32};
+    image.fill(Qt::white);
+
+    if (getDimensions().isEmpty())
+        return image;
+
+    QPainter painter{&image};
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.scale(qreal(imageSize.width()) / width(),
+                  qreal(imageSize.height()) / height());
+    for (const auto& stroke : _strokes)
+        _draw(painter, stroke);
+    return image;
+}
+
+Content::Interaction WhiteboardContent::_getInteractionPolicy() const
+{
+    return Interaction::on;
+}
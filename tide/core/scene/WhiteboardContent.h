@@ -0,0 +1,265 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef WHITEBOARD_CONTENT_H
+#define WHITEBOARD_CONTENT_H
+
+#include "VectorialContent.h"
+
+#include <QColor>
+#include <QImage>
+#include <QPointF>
+#include <QRectF>
+#include <QUuid>
+
+#include <vector>
+
+/**
+ * A stroke drawn on a whiteboard, in content pixel coordinates.
+ */
+struct WhiteboardStroke
+{
+    QColor color;
+    qreal width = 0.0;
+    std::vector<QPointF> points;
+
+    /** @return the area covered by the stroke, including its width. */
+    QRectF getBoundingRect() const;
+
+    bool operator==(const WhiteboardStroke& other) const;
+
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int)
+    {
+        auto rgba = color.rgba();
+        // clang-format off
+        ar & boost::serialization::make_nvp("color", rgba);
+        ar & boost::serialization::make_nvp("width", width);
+        ar & boost::serialization::make_nvp("points", points);
+        // clang-format on
+        color = QColor::fromRgba(rgba);
+    }
+};
+
+/**
+ * Points added to a stroke of a whiteboard.
+ *
+ * While a stroke is being drawn, only its new points are sent to the wall
+ * processes instead of the whole scene.
+ */
+struct WhiteboardStrokeUpdate
+{
+    /** The id of the WhiteboardContent. */
+    QUuid whiteboardId;
+
+    /** The index of the stroke in the whiteboard. */
+    uint32_t strokeIndex = 0;
+
+    /** The index in the stroke of the first point. */
+    uint32_t offset = 0;
+
+    /** The points to add to the stroke, starting at offset. */
+    std::vector<QPointF> points;
+
+    /**
+     * Add the points to a copy of the strokes of the whiteboard.
+     *
+     * Any existing points from the offset onwards are replaced.
+     * @param strokes to update.
+     * @return false if the stroke does not exist or has less points than the
+     *         offset, in which case the strokes are not modified.
+     */
+    bool applyTo(std::vector<WhiteboardStroke>& strokes) const;
+
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int)
+    {
+        // clang-format off
+        ar & whiteboardId;
+        ar & strokeIndex;
+        ar & offset;
+        ar & points;
+        // clang-format on
+    }
+};
+
+/**
+ * A whiteboard whose strokes are part of the scene.
+ *
+ * Wall processes render the strokes natively at the resolution of their
+ * screens instead of receiving them as a pixel stream.
+ */
+class WhiteboardContent : public VectorialContent
+{
+    Q_OBJECT
+    Q_PROPERTY(QColor brushColor READ getBrushColor NOTIFY brushChanged)
+    Q_PROPERTY(qreal brushSize READ getBrushSize NOTIFY brushChanged)
+    Q_PROPERTY(int strokeCount READ getStrokeCount NOTIFY strokesChanged)
+
+public:
+    /**
+     * Constructor.
+     * @param uri The unique identifier of the whiteboard.
+     * @param size The size of the drawing area.
+     */
+    WhiteboardContent(const QString& uri, const QSize& size);
+
+    /** @copydoc Content::getType **/
+    ContentType getType() const override;
+
+    /**
+     * Content method overload, the strokes are stored in the content.
+     * @return always returns true
+     */
+    bool readMetadata() override;
+
+    /** @return the color of new strokes. */
+    const QColor& getBrushColor() const;
+
+    /** Set the color of new strokes. */
+    void setBrushColor(const QColor& color);
+
+    /** @return the width of new strokes in content pixels. */
+    qreal getBrushSize() const;
+
+    /** Set the width of new strokes in content pixels. */
+    void setBrushSize(qreal size);
+
+    /**
+     * Start a new stroke with the current brush.
+     * @param point the first point of the stroke in content coordinates.
+     * @return the index of the new stroke.
+     */
+    size_t beginStroke(const QPointF& point);
+
+    /**
+     * Add a point to an existing stroke.
+     *
+     * Emits strokeExtended() instead of modified(), see below.
+     * @param index of the stroke returned by beginStroke().
+     * @param point to add in content coordinates.
+     */
+    void extendStroke(size_t index, const QPointF& point);
+
+    /** Remove all the strokes. */
+    void clear();
+
+    /** @return the strokes, in drawing order. */
+    const std::vector<WhiteboardStroke>& getStrokes() const;
+
+    /** @return the number of strokes. */
+    int getStrokeCount() const;
+
+    /**
+     * Render the whiteboard to an image.
+     * @param size of the image, the content dimensions if empty.
+     * @return the image with a white background.
+     */
+    QImage toImage(const QSize& size = QSize()) const;
+
+signals:
+    /** @name QProperty notifiers */
+    //@{
+    void brushChanged();
+    void strokesChanged();
+    //@}
+
+    /**
+     * Emitted when a point is added to a stroke.
+     *
+     * Unlike the other changes, extending a stroke does not emit modified()
+     * so that the whole scene is not sent to the walls for every new point.
+     * @param update the new point of the stroke.
+     */
+    void strokeExtended(WhiteboardStrokeUpdatePtr update);
+
+private:
+    /** @return ON, drawing on the whiteboard is its only interaction. */
+    Interaction _getInteractionPolicy() const final;
+
+    friend class boost::serialization::access;
+
+    // Default constructor required for boost::serialization
+    WhiteboardContent() = default;
+
+    /** Serialize for sending to Wall applications. */
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int)
+    {
+        // clang-format off
+        ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Content);
+        ar & _brushColor;
+        ar & _brushSize;
+        ar & _strokes;
+        // clang-format on
+    }
+
+    /** Serialize for saving to an xml file. */
+    template <class Archive>
+    void serialize_members_xml(Archive& ar, const unsigned int)
+    {
+        // clang-format off
+        ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Content);
+        ar & boost::serialization::make_nvp("strokes", _strokes);
+        // clang-format on
+    }
+
+    /** Loading from xml. */
+    void serialize_for_xml(boost::archive::xml_iarchive& ar,
+                           const unsigned int version)
+    {
+        serialize_members_xml(ar, version);
+    }
+
+    /** Saving to xml. */
+    void serialize_for_xml(boost::archive::xml_oarchive& ar,
+                           const unsigned int version)
+    {
+        serialize_members_xml(ar, version);
+    }
+
+    QColor _brushColor{Qt::black};
+    qreal _brushSize = 15.0;
+    std::vector<WhiteboardStroke> _strokes;
+};
+
+DECLARE_SERIALIZE_FOR_XML(WhiteboardContent)
+
+BOOST_CLASS_EXPORT_KEY(WhiteboardContent)
+
+#endif
@@ -245,7 +245,7 @@ public:
     bool setState(Window::WindowState state);
 
 signals:
-    /** Emitted when the Content signals that it has been modified. */
+    /** Emitted when the Content is modified or replaced. */
     void contentModified();
 
     /**
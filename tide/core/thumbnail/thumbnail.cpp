@@ -43,6 +43,7 @@
 #include "ThumbnailGeneratorFactory.h"
 #include "config.h"
 #include "scene/Content.h"
+#include "scene/WhiteboardContent.h"
 
 #if TIDE_ENABLE_WEBBROWSER_SUPPORT
 #include "WebbrowserThumbnailGenerator.h"
@@ -56,6 +57,13 @@ QImage create(const Content& content, const QSize& size)
     if (content.getType() == ContentType::pixel_stream)
         return StreamThumbnailGenerator{size}.generate(content.getTitle());
 
+    if (auto whiteboard = dynamic_cast<const WhiteboardContent*>(&content))
+    {
+        const auto imageSize =
+            whiteboard->getDimensions().scaled(size, Qt::KeepAspectRatio);
+        return whiteboard->toImage(imageSize);
+    }
+
 #if TIDE_ENABLE_WEBBROWSER_SUPPORT
     if (auto web = dynamic_cast<const WebbrowserContent*>(&content))
         return WebbrowserThumbnailGenerator{size}.generate(web->getUrl());
@@ -120,6 +120,7 @@ class FFMPEGFrame;
 class FFMPEGMovie;
 class FFMPEGPicture;
 class FFMPEGVideoStream;
+class GLTexture;
 class Image;
 class ImageReader;
 class ImageSource;
@@ -128,6 +129,7 @@ class InactivityTimer;
 class KeyboardState;
 class LodTools;
 class Markers;
+class MetricsAggregator;
 class MovieContent;
 class MovieUpdater;
 class MPICommunicator;
@@ -154,6 +156,7 @@ class WallSurfaceRenderer;
 class WallToWallChannel;
 class WallWindow;
 class WebbrowserContent;
+struct WhiteboardStrokeUpdate;
 class Window;
 
 typedef std::shared_ptr<Background> BackgroundPtr;
@@ -164,6 +167,7 @@ typedef std::shared_ptr<CountdownStatus> CountdownStatusPtr;
 typedef std::shared_ptr<DataSource> DataSourceSharedPtr;
 typedef std::shared_ptr<DisplayGroup> DisplayGroupPtr;
 typedef std::shared_ptr<FFMPEGPicture> PicturePtr;
+typedef std::shared_ptr<GLTexture> GLTexturePtr;
 typedef std::shared_ptr<Image> ImagePtr;
 typedef std::shared_ptr<Markers> MarkersPtr;
 typedef std::shared_ptr<Options> OptionsPtr;
@@ -172,6 +176,7 @@ typedef std::shared_ptr<ScreenLock> ScreenLockPtr;
 typedef std::shared_ptr<Surface> SurfacePtr;
 typedef std::shared_ptr<Tile> TilePtr;
 typedef std::weak_ptr<Tile> TileWeakPtr;
+typedef std::shared_ptr<WhiteboardStrokeUpdate> WhiteboardStrokeUpdatePtr;
 typedef std::shared_ptr<Window> WindowPtr;
 typedef std::unique_ptr<WallWindow> WallWindowPtr;
 
@@ -44,11 +44,13 @@
 #include "configuration/Configuration.h"
 #include "configuration/SurfaceConfigValidator.h"
 #include "control/AppController.h"
+#include "control/WhiteboardController.h"
 #include "gui/MasterQuickView.h"
 #include "gui/MasterWindow.h"
 #include "network/MasterFromWallChannel.h"
 #include "network/MasterToForkerChannel.h"
 #include "network/MasterToWallChannel.h"
+#include "network/PixelStreamRouter.h"
 #include "qml/MasterSurfaceRenderer.h"
 #include "scene/Background.h"
 #include "scene/ContentFactory.h"
@@ -58,13 +60,16 @@
 #include "scene/Scene.h"
 #include "scene/ScreenLock.h"
 #include "scene/VectorialContent.h"
+#include "scene/WhiteboardContent.h"
 #include "tools/MarkersUpdater.h"
+#include "tools/PixelStreamFlowController.h"
 #include "tools/ScreenshotAssembler.h"
 #include "utils/log.h"
 
 #if TIDE_ENABLE_REST_INTERFACE
 #include "rest/RestInterface.h"
 #include "tools/ActivityLogger.h"
+#include "tools/MetricsAggregator.h"
 #endif
 
 #include <deflect/qt/QuickRenderer.h>
@@ -94,12 +99,14 @@ std::unique_ptr<deflect::server::Server> _createDeflectServer()
 MasterApplication::MasterApplication(int& argc_, char** argv_,
                                      const QString& config,
                                      MPICommunicator& wallSendComm,
+                                     MPICommunicator& wallPayloadComm,
                                      MPICommunicator& wallRecvComm,
                                      MPICommunicator& forkerSendComm)
     : QApplication{argc_, argv_}
     , _config{new Configuration{config}}
     , _masterToForkerChannel{new MasterToForkerChannel{forkerSendComm}}
-    , _masterToWallChannel{new MasterToWallChannel{wallSendComm}}
+    , _masterToWallChannel{
+          new MasterToWallChannel{wallSendComm, wallPayloadComm}}
     , _masterFromWallChannel{new MasterFromWallChannel{wallRecvComm}}
     , _scene{Scene::create(_config->surfaces)}
     , _session{_scene}
@@ -111,6 +118,7 @@ MasterApplication::MasterApplication(int& argc_, char** argv_,
     , _restInterface{new RestInterface{_config->master.webservicePort, _options,
                                        _session, *_config}}
     , _logger{new ActivityLogger}
+    , _metrics{new MetricsAggregator}
 #endif
     , _appController{new AppController{_session, *_lock, *_deflectServer,
                                        *_options, *_config}}
@@ -121,6 +129,7 @@ MasterApplication::MasterApplication(int& argc_, char** argv_,
     qml::registerTypes();
     Content::setMaxScale(_config->settings.contentMaxScale);
     VectorialContent::setMaxScale(_config->settings.contentMaxScaleVectorial);
+    WhiteboardController::setSaveDir(_config->whiteboard.saveDir);
 
     // don't create touch points for mouse events and vice versa
     setAttribute(Qt::AA_SynthesizeTouchForUnhandledMouseEvents, false);
@@ -267,6 +276,11 @@ void MasterApplication::_connectRestInterface()
 {
     _logger->monitor(*_scene);
     _restInterface->exposeStatistics(*_logger);
+    _restInterface->exposeMetrics(*_metrics);
+
+    connect(_masterFromWallChannel.get(),
+            &MasterFromWallChannel::receivedMetrics, _metrics.get(),
+            &MetricsAggregator::update);
 
     connect(_lock.get(), &ScreenLock::lockChanged,
             [this](const bool locked) { _restInterface->lock(locked); });
@@ -346,12 +360,20 @@ void MasterApplication::_setupMPIConnections()
             },
             Qt::DirectConnection);
 
-    connect(_masterFromWallChannel.get(),
-            &MasterFromWallChannel::receivedRequestFrame, _deflectServer.get(),
-            &deflect::server::Server::requestFrame);
+    _setupWhiteboardStrokes();
+    _setupPixelStreamFlowControl();
 
-    connect(_deflectServer.get(), &deflect::server::Server::receivedFrame,
-            _masterToWallChannel.get(), &MasterToWallChannel::sendFrame);
+    if (_config->master.directStreaming)
+    {
+        _pixelStreamRouter.reset(new PixelStreamRouter(*_config));
+        connect(_deflectServer.get(), &deflect::server::Server::receivedFrame,
+                this, &MasterApplication::_sendFrame);
+    }
+    else
+    {
+        connect(_deflectServer.get(), &deflect::server::Server::receivedFrame,
+                _masterToWallChannel.get(), &MasterToWallChannel::sendFrame);
+    }
 
     connect(_masterFromWallChannel.get(),
             &MasterFromWallChannel::pixelStreamClose, _appController.get(),
@@ -364,6 +386,70 @@ void MasterApplication::_setupMPIConnections()
     _mpiReceiveThread.start();
 }
 
+void MasterApplication::_setupPixelStreamFlowControl()
+{
+    _flowController.reset(
+        new PixelStreamFlowController(_config->settings.streamFramesInFlight));
+
+    connect(_masterFromWallChannel.get(),
+            &MasterFromWallChannel::receivedRequestFrame, _flowController.get(),
+            &PixelStreamFlowController::restart);
+
+    connect(_masterFromWallChannel.get(),
+            &MasterFromWallChannel::receivedFrameCredits, _flowController.get(),
+            &PixelStreamFlowController::returnCredits);
+
+    connect(_deflectServer.get(), &deflect::server::Server::receivedFrame,
+            _flowController.get(), &PixelStreamFlowController::registerFrame);
+
+    connect(_deflectServer.get(), &deflect::server::Server::pixelStreamClosed,
+            _flowController.get(), &PixelStreamFlowController::remove);
+
+    // Queued, requests may be emitted while the server is dispatching a frame
+    connect(_flowController.get(), &PixelStreamFlowController::requestFrame,
+            _deflectServer.get(), &deflect::server::Server::requestFrame,
+            Qt::QueuedConnection);
+}
+
+void MasterApplication::_setupWhiteboardStrokes()
+{
+    // Only the new points of a stroke are sent while it is being drawn, the
+    // whole scene is sent when a stroke begins or the whiteboard is cleared.
+    const auto forwardStrokes = [this](WindowPtr window) {
+        auto content = &window->getContent();
+        if (auto whiteboard = dynamic_cast<WhiteboardContent*>(content))
+        {
+            connect(whiteboard, &WhiteboardContent::strokeExtended,
+                    _masterToWallChannel.get(),
+                    [this](WhiteboardStrokeUpdatePtr update) {
+                        _masterToWallChannel->sendAsync(std::move(update));
+                    },
+                    Qt::DirectConnection);
+        }
+    };
+
+    for (auto&& surface : _scene->getSurfaces())
+    {
+        auto& group = surface.getGroup();
+        for (const auto& window : group.getWindows())
+            forwardStrokes(window);
+        connect(&group, &DisplayGroup::windowAdded, this, forwardStrokes);
+    }
+}
+
+void MasterApplication::_sendFrame(deflect::server::FramePtr frame)
+{
+    auto frames = _pixelStreamRouter->split(*frame, *_scene);
+    if (frames.empty())
+    {
+        QMetaObject::invokeMethod(_masterToWallChannel.get(), "sendFrame",
+                                  Qt::QueuedConnection,
+                                  Q_ARG(deflect::server::FramePtr, frame));
+    }
+    else
+        _masterToWallChannel->sendAsync(frames);
+}
+
 void MasterApplication::_takeScreenshot(const uint surfaceIndex,
                                         const QString filename)
 {
@@ -57,6 +57,8 @@ class MasterToWallChannel;
 class MasterToForkerChannel;
 class MasterFromWallChannel;
 class MasterWindow;
+class PixelStreamFlowController;
+class PixelStreamRouter;
 class RestInterface;
 class ScreenshotAssembler;
 
@@ -74,12 +76,15 @@ public:
      * @param argv Command line arguments (required by QApplication)
      * @param config The configuration file for the application
      * @param wallSendComm The communicator to send messages to wall processes
+     * @param wallPayloadComm The communicator to send the payload of broadcast
+     *        messages to one wall process per host
      * @param wallRecvComm The communicator to receive from wall processes
      * @param forkerSendComm The communicator for the forker process
      * @throw std::runtime_error if an error occured during initialization
      */
     MasterApplication(int& argc, char** argv, const QString& config,
                       MPICommunicator& wallSendComm,
+                      MPICommunicator& wallPayloadComm,
                       MPICommunicator& wallRecvComm,
                       MPICommunicator& forkerSendComm);
 
@@ -112,9 +117,12 @@ private:
     std::vector<std::unique_ptr<MasterSurfaceRenderer>> _surfaceRenderers;
 
     std::unique_ptr<deflect::server::Server> _deflectServer;
+    std::unique_ptr<PixelStreamRouter> _pixelStreamRouter;
+    std::unique_ptr<PixelStreamFlowController> _flowController;
 #if TIDE_ENABLE_REST_INTERFACE
     std::unique_ptr<RestInterface> _restInterface;
     std::unique_ptr<ActivityLogger> _logger;
+    std::unique_ptr<MetricsAggregator> _metrics;
 #endif
     std::unique_ptr<AppController> _appController;
     std::unique_ptr<ScreenshotAssembler> _screenshotAssembler;
@@ -133,6 +141,9 @@ private:
     void _connectRestInterface();
 #endif
     void _setupMPIConnections();
+    void _setupPixelStreamFlowControl();
+    void _setupWhiteboardStrokes();
+    void _sendFrame(deflect::server::FramePtr frame);
 
     void _takeScreenshot(uint surfaceIndex, QString filename);
 
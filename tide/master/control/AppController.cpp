@@ -126,7 +126,8 @@ void AppController::openWebbrowser(uint surfaceIndex, QString url, QSize size,
 
 void AppController::openWhiteboard(uint surfaceIndex)
 {
-    _pixelStreamerLauncher->openWhiteboard(surfaceIndex);
+    _sceneController->openWhiteboard(surfaceIndex,
+                                     _config.whiteboard.defaultSize);
 }
 
 void AppController::terminateStream(const QString& uri)
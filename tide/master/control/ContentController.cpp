@@ -49,6 +49,7 @@
 #include "MovieController.h"
 #endif
 #include "PixelStreamController.h"
+#include "WhiteboardController.h"
 #include "ZoomController.h"
 
 std::unique_ptr<ContentController> ContentController::create(Window& window)
@@ -75,6 +76,8 @@ std::unique_ptr<ContentController> ContentController::create(Window& window)
     case ContentType::movie:
         return std::make_unique<MovieController>(window);
 #endif
+    case ContentType::whiteboard:
+        return std::make_unique<WhiteboardController>(window);
     case ContentType::invalid:
         // For unit-testing purposes
         return window.getContent().canBeZoomed()
@@ -84,7 +84,14 @@ void ContentLoader::load(const QString& filename,
     if (isAlreadyOpen(filename))
         throw load_error("File is already open: " + filename.toStdString());
 
-    auto content = ContentFactory::createContent(filename);
+    load(ContentFactory::createContent(filename), windowCenterPosition,
+         windowSize);
+}
+
+void ContentLoader::load(ContentPtr content,
+                         const QPointF& windowCenterPosition,
+                         const QSizeF& windowSize)
+{
     auto window = std::make_shared<Window>(std::move(content));
     WindowController controller(*window, _group);
 
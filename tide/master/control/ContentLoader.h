@@ -88,6 +88,20 @@ public:
               const QPointF& windowCenterPosition = QPointF(),
               const QSizeF& windowSize = QSizeF());
 
+    /**
+     * Create a window for a Content which does not originate from a file.
+     *
+     * @param content The content to open.
+     * @param windowCenterPosition The point around which to center the window.
+     *        If empty (default), the  window is automatically centered on the
+     *        DisplayGroup.
+     * @param windowSize The size of the window. If empty, the size of the
+     *        window is automatically adjusted to its content dimensions.
+     */
+    void load(ContentPtr content,
+              const QPointF& windowCenterPosition = QPointF(),
+              const QSizeF& windowSize = QSizeF());
+
     /**
      * Load all the supported files from a directory.
      *
@@ -41,6 +41,7 @@
 
 #include "ContentLoader.h"
 #include "control/DisplayGroupController.h"
+#include "scene/ContentFactory.h"
 #include "scene/Scene.h"
 
 #include <QDir>
@@ -49,6 +50,26 @@
 namespace
 {
 const auto surface0 = 0u;
+
+bool _isOpen(const Scene& scene, const QString& uri)
+{
+    for (const auto& surface : scene.getSurfaces())
+    {
+        if (surface.getGroup().findWindow(uri))
+            return true;
+    }
+    return false;
+}
+
+QString _getAvailableWhiteboardUri(const Scene& scene)
+{
+    static int whiteboardCounter = 0;
+    auto uri = QString();
+    do
+        uri = QString("Whiteboard%1").arg(whiteboardCounter++);
+    while (_isOpen(scene, uri));
+    return uri;
+}
 }
 
 SceneController::SceneController(Scene& scene_,
@@ -97,6 +118,21 @@ void SceneController::open(const uint surfaceIndex, const QString& uri,
         callback(success, message);
 }
 
+void SceneController::openWhiteboard(const uint surfaceIndex,
+                                     const QSize& size)
+{
+    try
+    {
+        const auto uri = _getAvailableWhiteboardUri(_scene);
+        auto loader = ContentLoader{_scene.getGroup(surfaceIndex)};
+        loader.load(ContentFactory::createWhiteboardContent(uri, size));
+    }
+    catch (const invalid_surface_index_error& e)
+    {
+        put_log(LOG_DEBUG, LOG_CONTENT, "%s: %d", e.what(), surfaceIndex);
+    }
+}
+
 void SceneController::clear(const uint surfaceIndex)
 {
     try
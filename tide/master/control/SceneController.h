@@ -61,6 +61,7 @@ public:
     void openAll(const QStringList& uris);
     void open(uint surfaceIndex, const QString& uri, const QPointF& coords,
               BoolMsgCallback callback);
+    void openWhiteboard(uint surfaceIndex, const QSize& size);
     void clear(uint surfaceIndex);
 
     void hideLauncher();
@@ -0,0 +1,124 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "WhiteboardController.h"
+
+#include "scene/WhiteboardContent.h"
+#include "utils/log.h"
+
+#include <QDateTime>
+#include <QDir>
+
+QString WhiteboardController::_saveDir = QDir::tempPath();
+
+WhiteboardController::WhiteboardController(Window& window)
+    : ContentController{window}
+    , _whiteboard{dynamic_cast<WhiteboardContent&>(getContent())}
+{
+}
+
+void WhiteboardController::setBrushColor(const QColor& color)
+{
+    _whiteboard.setBrushColor(color);
+}
+
+void WhiteboardController::setBrushSize(const qreal size)
+{
+    _whiteboard.setBrushSize(size);
+}
+
+void WhiteboardController::clear()
+{
+    _strokes.clear();
+    _whiteboard.clear();
+}
+
+QString WhiteboardController::saveImage()
+{
+    const auto timestamp =
+        QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss");
+    const auto filename =
+        QString("%1_%2.png").arg(_whiteboard.getUri(), timestamp);
+    const auto path = QDir{_saveDir}.absoluteFilePath(filename);
+
+    if (!_whiteboard.toImage().save(path))
+    {
+        print_log(LOG_WARN, LOG_CONTENT, "could not save whiteboard: '%s'",
+                  path.toLocal8Bit().constData());
+        return QString();
+    }
+    print_log(LOG_INFO, LOG_CONTENT, "saved whiteboard: '%s'",
+              path.toLocal8Bit().constData());
+    return path;
+}
+
+void WhiteboardController::setSaveDir(const QString& dir)
+{
+    _saveDir = dir;
+}
+
+void WhiteboardController::_addTouchPoint(const int id,
+                                          const QPointF& position)
+{
+    _strokes[id] = _whiteboard.beginStroke(_toContentCoordinates(position));
+}
+
+void WhiteboardController::_updateTouchPoint(const int id,
+                                             const QPointF& position)
+{
+    const auto it = _strokes.find(id);
+    if (it != _strokes.end())
+        _whiteboard.extendStroke(it->second, _toContentCoordinates(position));
+}
+
+void WhiteboardController::_removeTouchPoint(const int id,
+                                             const QPointF& position)
+{
+    _updateTouchPoint(id, position);
+    _strokes.erase(id);
+}
+
+QPointF WhiteboardController::_toContentCoordinates(
+    const QPointF& position) const
+{
+    const auto window = getWindowSize();
+    const auto& zoom = _whiteboard.getZoomRect();
+    const auto x = zoom.x() + position.x() / window.width() * zoom.width();
+    const auto y = zoom.y() + position.y() / window.height() * zoom.height();
+    return {x * _whiteboard.width(), y * _whiteboard.height()};
+}
@@ -0,0 +1,94 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef WHITEBOARDCONTROLLER_H
+#define WHITEBOARDCONTROLLER_H
+
+#include "ContentController.h"
+
+#include <QColor>
+
+#include <map>
+
+class WhiteboardContent;
+
+/**
+ * Handle user interaction with a whiteboard.
+ *
+ * Each touch point draws its own stroke, so that several users can draw at the
+ * same time.
+ */
+class WhiteboardController : public ContentController
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Constructor.
+     * @param window which holds a WhiteboardContent.
+     * @throw std::bad_cast if the content is not a WhiteboardContent.
+     */
+    WhiteboardController(Window& window);
+
+    Q_INVOKABLE void setBrushColor(const QColor& color);
+    Q_INVOKABLE void setBrushSize(qreal size);
+    Q_INVOKABLE void clear();
+
+    /**
+     * Save the whiteboard as a png image in the save directory.
+     * @return the path of the saved image, or an empty string on failure.
+     */
+    Q_INVOKABLE QString saveImage();
+
+    /** Set the directory used for saving whiteboard images. */
+    static void setSaveDir(const QString& dir);
+
+private:
+    WhiteboardContent& _whiteboard;
+    std::map<int, size_t> _strokes; // touch point id -> stroke index
+
+    static QString _saveDir;
+
+    void _addTouchPoint(int id, const QPointF& position) override;
+    void _updateTouchPoint(int id, const QPointF& position) override;
+    void _removeTouchPoint(int id, const QPointF& position) override;
+
+    QPointF _toContentCoordinates(const QPointF& position) const;
+};
+
+#endif
@@ -70,7 +70,6 @@ void CommandLineOptions::parse(const int argc, char** argv)
     webservicePort = vm["webservicePort"].as<uint16_t>();
     demoServiceUrl = vm["demoServiceUrl"].as<std::string>().c_str();
     showPowerButton = vm["showPowerButton"].as<bool>();
-    saveDir = vm["saveDir"].as<std::string>().c_str();
 }
 
 void CommandLineOptions::_fillDesc()
@@ -86,7 +85,7 @@ void CommandLineOptions::_fillDesc()
         ("url", po::value<std::string>()->default_value(""),
          "web browser only: url to open")
         ("config", po::value<std::string>()->default_value(""),
-         "launcher & whiteboard: Tide configuation file for extra settings")
+         "launcher: Tide configuation file for extra settings")
         ("contentsDir", po::value<std::string>()->default_value(""),
          "launcher: directory where the contents are located")
         ("sessionsDir", po::value<std::string>()->default_value(""),
@@ -97,8 +96,6 @@ void CommandLineOptions::_fillDesc()
          "launcher: url for the demo service")
         ("showPowerButton", po::bool_switch()->default_value(false),
          "launcher: show the power button")
-        ("saveDir", po::value<std::string>()->default_value(""),
-         "whiteboard: directory to use for saving images")
     ;
     // clang-format on
 }
@@ -148,8 +145,5 @@ QStringList CommandLineOptions::getCommandLineArguments() const
     if (showPowerButton)
         arguments << "--showPowerButton";
 
-    if (!saveDir.isEmpty())
-        arguments << "--saveDir" << saveDir;
-
     return arguments;
 }
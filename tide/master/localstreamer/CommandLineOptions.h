@@ -83,9 +83,6 @@ public:
     QString demoServiceUrl;
     bool showPowerButton = false;
 
-    // Whiteboard only
-    QString saveDir;
-
 private:
     void _fillDesc();
 };
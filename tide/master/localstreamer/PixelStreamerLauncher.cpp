@@ -59,7 +59,6 @@ namespace
 {
 const QString LAUNCHER_BIN("tideLauncher");
 const QString WEBBROWSER_BIN("tideWebbrowser");
-const QString WHITEBOARD_BIN("tideWhiteboard");
 
 QString _getAppsDir()
 {
@@ -102,11 +101,6 @@ QStringList _getWebbrowserEnv(const ushort debugPort)
 }
 #endif
 
-QString _getWhiteboardCommand(const QString& args)
-{
-    return QString("%1/%2 %3").arg(_getAppsDir(), WHITEBOARD_BIN, args);
-}
-
 const QString PixelStreamerLauncher::launcherUri = QString("Launcher");
 
 PixelStreamerLauncher::PixelStreamerLauncher(PixelStreamWindowManager& manager,
@@ -197,23 +191,6 @@ void PixelStreamerLauncher::openLauncher()
     _startProcess(uri, command, env);
 }
 
-void PixelStreamerLauncher::openWhiteboard(const uint surfaceIndex)
-{
-    static int whiteboardCounter = 0;
-    const auto uri = QString("Whiteboard%1").arg(whiteboardCounter++);
-    const auto size = _config.whiteboard.defaultSize;
-
-    _windowManager.openWindow(surfaceIndex, uri, size, QPointF(),
-                              StreamType::WHITEBOARD);
-
-    CommandLineOptions options;
-    options.streamId = uri;
-    options.saveDir = _config.whiteboard.saveDir;
-    const auto command = _getWhiteboardCommand(options.getCommandLine());
-
-    _startProcess(uri, command, {});
-}
-
 void PixelStreamerLauncher::_startProcess(const QString& uri,
                                           const QString& command,
                                           const QStringList& env)
@@ -92,9 +92,6 @@ public slots:
     /** Open the Qml launcher. */
     void openLauncher();
 
-    /** Open the Qml whiteboard. */
-    void openWhiteboard(uint surfaceIndex);
-
 signals:
     /** Request the launch of a command in a working directory and given ENV. */
     void start(QString command, QString workingDir, QStringList env);
@@ -46,6 +46,7 @@
 
 MasterFromWallChannel::MasterFromWallChannel(MPICommunicator& communicator)
     : _communicator{communicator}
+    , _remainingQuits{communicator.getSize() - 1}
 {
     if (_communicator.getSize() < 2)
     {
@@ -77,6 +78,15 @@ void MasterFromWallChannel::processMessages()
             emit receivedRequestFrame(serialization::get<QString>(_buffer));
             break;
         }
+        case MessageType::PIXELSTREAM_CREDIT:
+        {
+            QString uri;
+            uint frames = 0;
+            uint dropped = 0;
+            serialization::fromBinary(_buffer, uri, frames, dropped);
+            emit receivedFrameCredits(uri, frames, dropped);
+            break;
+        }
         case MessageType::IMAGE:
         {
             QImage image;
@@ -88,8 +98,12 @@ void MasterFromWallChannel::processMessages()
         case MessageType::PIXELSTREAM_CLOSE:
             emit pixelStreamClose(serialization::get<QString>(_buffer));
             break;
+        case MessageType::METRICS:
+            emit receivedMetrics(result.src - 1,
+                                 serialization::get<MetricFamilies>(_buffer));
+            break;
         case MessageType::QUIT:
-            _processMessages = false;
+            _processMessages = --_remainingQuits > 0;
             break;
         default:
             print_log(LOG_WARN, LOG_MPI, "Invalid message type: %d",
@@ -41,6 +41,7 @@
 #ifndef MASTERFROMWALLCHANNEL_H
 #define MASTERFROMWALLCHANNEL_H
 
+#include "metrics/MetricsRegistry.h"
 #include "network/MessageHeader.h"
 #include "network/ReceiveBuffer.h"
 #include "types.h"
@@ -62,7 +63,8 @@ public:
 
 public slots:
     /**
-     * Process messages until the QUIT message is received.
+     * Process messages until the QUIT message is received from all wall
+     * processes.
      */
     void processMessages();
 
@@ -73,6 +75,14 @@ signals:
      */
     void receivedRequestFrame(QString uri);
 
+    /**
+     * Emitted when the wall has consumed frames of the given pixel stream.
+     * @param uri The URI of the pixel stream
+     * @param frames The number of frames consumed
+     * @param dropped The number of consumed frames that were not displayed
+     */
+    void receivedFrameCredits(QString uri, uint frames, uint dropped);
+
     /**
      * Emitted after each wall process has rendered a screenshot
      * @param image The rendered image
@@ -87,10 +97,18 @@ signals:
      */
     void pixelStreamClose(QString uri);
 
+    /**
+     * Emitted when a wall process has sent a snapshot of its metrics.
+     * @param rank The rank of the wall process (starting at 0)
+     * @param metrics The metrics of the wall process
+     */
+    void receivedMetrics(int rank, MetricFamilies metrics);
+
 private:
     MPICommunicator& _communicator;
     ReceiveBuffer _buffer;
     bool _processMessages = true;
+    int _remainingQuits = 0;
 };
 
 #endif
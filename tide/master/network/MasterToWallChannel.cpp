@@ -39,12 +39,14 @@
 
 #include "MasterToWallChannel.h"
 
+#include "metrics/MetricsRegistry.h"
 #include "network/MPICommunicator.h"
 #include "scene/CountdownStatus.h"
 #include "scene/Markers.h"
 #include "scene/Options.h"
 #include "scene/Scene.h"
 #include "scene/ScreenLock.h"
+#include "scene/WhiteboardContent.h"
 #include "scene/Window.h"
 #include "serialization/utils.h"
 #include "json/serialization.h"
@@ -52,15 +54,18 @@
 
 #include <deflect/server/Frame.h>
 
-MasterToWallChannel::MasterToWallChannel(MPICommunicator& communicator)
+MasterToWallChannel::MasterToWallChannel(MPICommunicator& communicator,
+                                         MPICommunicator& payloadComm)
     : _communicator{communicator}
+    , _payloadComm{payloadComm}
 {
 }
 
 template <typename T>
 void MasterToWallChannel::broadcast(const T& object, const MessageType type)
 {
-    _communicator.broadcast(type, serialization::toBinary(object));
+    _communicator.broadcast(type, serialization::toBinary(object),
+                            _payloadComm);
 }
 
 template <typename T>
@@ -99,9 +104,27 @@ void MasterToWallChannel::sendAsync(MarkersPtr markers)
     broadcastAsync(markers, MessageType::MARKERS);
 }
 
+void MasterToWallChannel::sendAsync(WhiteboardStrokeUpdatePtr update)
+{
+    broadcastAsync(update, MessageType::WHITEBOARD_STROKE);
+}
+
+namespace
+{
+void _countFrame(const QString& uri)
+{
+    MetricsRegistry::instance()
+        .counter("tide_stream_frames_total",
+                 "Pixel stream frames forwarded to the wall",
+                 {{"uri", uri.toStdString()}})
+        .increment();
+}
+}
+
 void MasterToWallChannel::sendFrame(deflect::server::FramePtr frame)
 {
     assert(!frame->tiles.empty() && "received an empty frame");
+    _countFrame(frame->uri);
 #if BOOST_VERSION >= 106000
     broadcast(frame, MessageType::PIXELSTREAM);
 #else
@@ -110,9 +133,27 @@ void MasterToWallChannel::sendFrame(deflect::server::FramePtr frame)
 #endif
 }
 
+void MasterToWallChannel::sendAsync(
+    const std::vector<deflect::server::Frame>& frames)
+{
+    assert(!frames.empty() && "no frames to send");
+    _countFrame(frames.front().uri);
+
+    std::vector<std::string> data;
+    data.reserve(frames.size());
+    for (const auto& frame : frames)
+        data.emplace_back(serialization::toBinary(frame));
+
+    const auto type = MessageType::PIXELSTREAM_DIRECT;
+    QMetaObject::invokeMethod(this, "_sendToEach", Qt::QueuedConnection,
+                              Q_ARG(MessageType, type),
+                              Q_ARG(std::vector<std::string>, data));
+}
+
 void MasterToWallChannel::send(const Configuration& config)
 {
-    _communicator.broadcast(MessageType::CONFIG, json::pack(config));
+    _communicator.broadcast(MessageType::CONFIG, json::pack(config),
+                            _payloadComm);
 }
 
 void MasterToWallChannel::sendRequestScreenshot()
@@ -129,5 +170,16 @@ void MasterToWallChannel::sendQuit()
 void MasterToWallChannel::_broadcast(const MessageType type,
                                      const std::string data)
 {
-    _communicator.broadcast(type, data);
+    _communicator.broadcast(type, data, _payloadComm);
+}
+
+// cppcheck-suppress passedByValue
+void MasterToWallChannel::_sendToEach(const MessageType type,
+                                      const std::vector<std::string> data)
+{
+    // The header is broadcast to preserve the ordering with other messages.
+    // Each wall process then receives its own payload (rank 0 is the master).
+    _communicator.broadcast(type);
+    for (size_t i = 0; i < data.size(); ++i)
+        _communicator.send(type, data[i], i + 1);
 }
@@ -45,6 +45,9 @@
 
 #include <QObject>
 
+#include <string>
+#include <vector>
+
 /**
  * Sending channel from the master application to the wall processes.
  *
@@ -68,8 +71,14 @@ class MasterToWallChannel : public QObject
     Q_DISABLE_COPY(MasterToWallChannel)
 
 public:
-    /** Constructor */
-    MasterToWallChannel(MPICommunicator& communicator);
+    /**
+     * Constructor
+     * @param communicator The communicator of the master and wall processes.
+     * @param payloadComm The communicator of the master and the host leaders
+     *        which receive the payload of broadcast messages for their host.
+     */
+    MasterToWallChannel(MPICommunicator& communicator,
+                        MPICommunicator& payloadComm);
 
 public slots:
     /**
@@ -102,12 +111,24 @@ public slots:
      */
     void sendAsync(MarkersPtr markers);
 
+    /**
+     * Send the new points of a whiteboard stroke to the wall processes.
+     * @param update The points to send
+     */
+    void sendAsync(WhiteboardStrokeUpdatePtr update);
+
     /**
      * Send pixel stream frame to the wall processes.
      * @param frame The frame to send
      */
     void sendFrame(deflect::server::FramePtr frame);
 
+    /**
+     * Send a different part of a pixel stream frame to each wall process.
+     * @param frames The frames to send, one per wall process ordered by rank
+     */
+    void sendAsync(const std::vector<deflect::server::Frame>& frames);
+
     /**
      * Send the configuration to the wall processes.
      * @param config The configuration to send
@@ -126,6 +147,7 @@ public slots:
 
 private:
     MPICommunicator& _communicator;
+    MPICommunicator& _payloadComm;
 
     template <typename T>
     void broadcast(const T& object, const MessageType type);
@@ -134,6 +156,7 @@ private:
 
 private slots:
     void _broadcast(MessageType type, std::string data);
+    void _sendToEach(MessageType type, std::vector<std::string> data);
 };
 
 #endif
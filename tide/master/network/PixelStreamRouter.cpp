@@ -0,0 +1,193 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "PixelStreamRouter.h"
+
+#include "configuration/Configuration.h"
+#include "scene/Scene.h"
+#include "scene/Window.h"
+
+#include <algorithm>
+
+namespace
+{
+QRect _toRect(const deflect::server::Tile& tile)
+{
+    return QRect(tile.x, tile.y, tile.width, tile.height);
+}
+
+/** @return the area of the stream frame that is visible in a screen. */
+QRect _mapToStream(const QRect& screen, const Window& window)
+{
+    const auto& windowRect = window.getDisplayCoordinates();
+    const auto visible = QRectF(screen).intersected(windowRect);
+    if (visible.isEmpty())
+        return QRect();
+
+    const auto& content = window.getContent();
+    const auto size = QSizeF(content.getDimensions());
+    const auto& zoom = content.getZoomRect();
+
+    const auto scaleX = zoom.width() * size.width() / windowRect.width();
+    const auto scaleY = zoom.height() * size.height() / windowRect.height();
+    const auto x = zoom.x() * size.width() +
+                   (visible.x() - windowRect.x()) * scaleX;
+    const auto y = zoom.y() * size.height() +
+                   (visible.y() - windowRect.y()) * scaleY;
+
+    const auto area = QRectF(x, y, visible.width() * scaleX,
+                             visible.height() * scaleY);
+    const auto m = PixelStreamRouter::margin;
+    return area.toAlignedRect().adjusted(-m, -m, m, m);
+}
+}
+
+constexpr int PixelStreamRouter::margin;
+constexpr uint PixelStreamRouter::fullFramesAfterChange;
+
+bool PixelStreamRouter::WindowView::operator==(const WindowView& other) const
+{
+    return surfaceIndex == other.surfaceIndex &&
+           coordinates == other.coordinates && zoomRect == other.zoomRect &&
+           dimensions == other.dimensions && hidden == other.hidden;
+}
+
+PixelStreamRouter::PixelStreamRouter(const Configuration& config)
+{
+    for (const auto& process : config.processes)
+    {
+        std::vector<ScreenArea> screens;
+        for (const auto& screen : process.screens)
+        {
+            const auto& surface = config.surfaces.at(screen.surfaceIndex);
+            const auto rect = surface.getScreenRect(screen.globalIndex);
+            screens.push_back({screen.surfaceIndex, rect});
+        }
+        _processScreens.emplace_back(std::move(screens));
+    }
+}
+
+std::vector<deflect::server::Frame> PixelStreamRouter::split(
+    const deflect::server::Frame& frame, const Scene& scene)
+{
+    // The stream areas visible on each process
+    std::vector<std::vector<QRect>> visibleAreas(_processScreens.size());
+    std::vector<WindowView> windows;
+    bool isTransforming = false;
+
+    uint surfaceIndex = 0;
+    for (const auto& surface : scene.getSurfaces())
+    {
+        const auto window = surface.getGroup().findWindow(frame.uri);
+        if (window)
+        {
+            const auto& content = window->getContent();
+            windows.push_back({surfaceIndex, window->getDisplayCoordinates(),
+                               content.getZoomRect(), content.getDimensions(),
+                               window->isHidden()});
+
+            // Tiles may be needed anywhere while the window geometry changes
+            if (window->getState() == Window::MOVING ||
+                window->getState() == Window::RESIZING)
+            {
+                isTransforming = true;
+            }
+            if (!window->isHidden())
+            {
+                for (size_t i = 0; i < _processScreens.size(); ++i)
+                {
+                    for (const auto& screen : _processScreens[i])
+                    {
+                        if (screen.surfaceIndex != surfaceIndex)
+                            continue;
+                        const auto area = _mapToStream(screen.rect, *window);
+                        if (!area.isEmpty())
+                            visibleAreas[i].push_back(area);
+                    }
+                }
+            }
+        }
+        ++surfaceIndex;
+    }
+
+    // The walls may not have received the scene with the new windows yet
+    if (_hasChangedRecently(frame.uri, std::move(windows)) || isTransforming)
+        return {};
+
+    std::vector<deflect::server::Frame> frames(_processScreens.size(), frame);
+    for (size_t i = 0; i < frames.size(); ++i)
+    {
+        for (auto& tile : frames[i].tiles)
+        {
+            // The windows only show the first channel, keep the others intact
+            if (tile.channel != 0)
+                continue;
+            const auto rect = _toRect(tile);
+            const auto isVisible =
+                std::any_of(visibleAreas[i].begin(), visibleAreas[i].end(),
+                            [&rect](const QRect& area) {
+                                return area.intersects(rect);
+                            });
+            if (!isVisible)
+                tile.imageData = QByteArray();
+        }
+    }
+    return frames;
+}
+
+bool PixelStreamRouter::_hasChangedRecently(const QString& uri,
+                                            std::vector<WindowView> windows)
+{
+    // Streams without windows are forgotten, their next windows are new
+    if (windows.empty())
+    {
+        _streams.erase(uri);
+        return false;
+    }
+
+    auto& stream = _streams[uri];
+    if (!(windows == stream.windows))
+    {
+        stream.windows = std::move(windows);
+        stream.fullFrames = fullFramesAfterChange;
+    }
+    if (stream.fullFrames == 0)
+        return false;
+    --stream.fullFrames;
+    return true;
+}
@@ -0,0 +1,123 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef PIXELSTREAMROUTER_H
+#define PIXELSTREAMROUTER_H
+
+#include "types.h"
+
+#include <deflect/server/Frame.h>
+
+#include <QRect>
+
+#include <map>
+#include <vector>
+
+/**
+ * Split pixel stream frames into the parts needed by each wall process.
+ *
+ * Each wall process receives the complete list of tiles, so that frame
+ * dimensions and tile indices remain consistent, but only the tiles that
+ * overlap its screens carry their compressed image data.
+ *
+ * The scene used for culling can be ahead of the one rendered by the wall
+ * processes, so the full frames are sent for a few frames after the windows of
+ * a stream have changed.
+ */
+class PixelStreamRouter
+{
+public:
+    /**
+     * Create a router for the given configuration.
+     * @param config the configuration defining the screens of each process.
+     */
+    PixelStreamRouter(const Configuration& config);
+
+    /**
+     * Split a frame for each of the wall processes.
+     *
+     * @param frame the complete frame received from the stream.
+     * @param scene the scene in which the stream is displayed.
+     * @return one frame per wall process, ordered by rank; or an empty list if
+     *         the full frame must be sent to all processes because the windows
+     *         of the stream are being moved or resized, or changed recently.
+     */
+    std::vector<deflect::server::Frame> split(
+        const deflect::server::Frame& frame, const Scene& scene);
+
+    /**
+     * Margin around the visible area of a process, in stream pixels.
+     * It must not be smaller than the size of the tiles assembled by the wall
+     * processes, which need all the stream tiles that they are made of.
+     */
+    static constexpr int margin = 512;
+
+    /** Number of full frames sent after the windows of a stream changed. */
+    static constexpr uint fullFramesAfterChange = 2;
+
+private:
+    /** The screens of each wall process, in surface coordinates. */
+    struct ScreenArea
+    {
+        uint surfaceIndex;
+        QRect rect;
+    };
+    std::vector<std::vector<ScreenArea>> _processScreens;
+
+    /** The parameters of a window which affect the visible stream tiles. */
+    struct WindowView
+    {
+        uint surfaceIndex;
+        QRectF coordinates;
+        QRectF zoomRect;
+        QSize dimensions;
+        bool hidden;
+        bool operator==(const WindowView& other) const;
+    };
+    struct StreamViews
+    {
+        std::vector<WindowView> windows;
+        uint fullFrames = 0;
+    };
+    std::map<QString, StreamViews> _streams;
+
+    bool _hasChangedRecently(const QString& uri,
+                             std::vector<WindowView> windows);
+};
+
+#endif
@@ -0,0 +1,138 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "ChangeNotifier.h"
+
+#include "localstreamer/PixelStreamerLauncher.h"
+#include "rest/serialization.h"
+#include "scene/DisplayGroup.h"
+#include "scene/Options.h"
+#include "scene/Scene.h"
+#include "json/json.h"
+#include "json/serialization.h"
+
+namespace
+{
+bool _isExposed(const Window& window)
+{
+    return window.getContent().getUri() != PixelStreamerLauncher::launcherUri;
+}
+}
+
+ChangeNotifier::ChangeNotifier(const Scene& scene, const Options& options,
+                               SendFunc send)
+    : _send{std::move(send)}
+{
+    auto surfaceIndex = 0;
+    for (const auto& surface : scene.getSurfaces())
+        _monitor(surface.getGroup(), surfaceIndex++);
+
+    connect(&options, &Options::updated, this, [this](OptionsPtr options_) {
+        _notify("tide/options/modified",
+                QJsonObject{{"options", json::serialize(*options_)}});
+    });
+}
+
+uint64_t ChangeNotifier::getRevision() const
+{
+    return _revision;
+}
+
+void ChangeNotifier::update(const SessionInfo& info)
+{
+    if (info.filepath == _sessionInfo.filepath &&
+        info.version == _sessionInfo.version)
+    {
+        return;
+    }
+    _sessionInfo = info;
+    _notify("tide/session/modified",
+            QJsonObject{{"session", json::serialize(info)}});
+}
+
+void ChangeNotifier::_monitor(const DisplayGroup& group, const int surfaceIndex)
+{
+    for (const auto& window : group.getWindows())
+    {
+        if (_isExposed(*window))
+            _watchChanges(*window, group, surfaceIndex);
+    }
+
+    connect(&group, &DisplayGroup::windowAdded, this,
+            [this, &group, surfaceIndex](WindowPtr window) {
+                if (!_isExposed(*window))
+                    return;
+                _watchChanges(*window, group, surfaceIndex);
+                _notify("tide/windows/added",
+                        QJsonObject{{"surface", surfaceIndex},
+                                    {"window",
+                                     json::serialize(*window, group)}});
+            });
+
+    connect(&group, &DisplayGroup::windowRemoved, this,
+            [this, surfaceIndex](WindowPtr window) {
+                if (!_isExposed(*window))
+                    return;
+                window->disconnect(this);
+                _notify("tide/windows/removed",
+                        QJsonObject{{"surface", surfaceIndex},
+                                    {"uuid",
+                                     json::url_encode(window->getID())}});
+            });
+}
+
+void ChangeNotifier::_watchChanges(const Window& window,
+                                   const DisplayGroup& group,
+                                   const int surfaceIndex)
+{
+    const auto notifyModified = [this, &window, &group, surfaceIndex] {
+        _notify("tide/windows/modified",
+                QJsonObject{{"surface", surfaceIndex},
+                            {"window", json::serialize(window, group)}});
+    };
+    connect(&window, &Window::modified, this, notifyModified);
+    connect(&window, &Window::contentModified, this, notifyModified);
+}
+
+void ChangeNotifier::_notify(const QString& method, QJsonObject params)
+{
+    params["revision"] = static_cast<qint64>(++_revision);
+    _send(json::dump(QJsonObject{{"jsonrpc", "2.0"},
+                                 {"method", method},
+                                 {"params", params}}));
+}
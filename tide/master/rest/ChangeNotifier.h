@@ -0,0 +1,103 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef CHANGENOTIFIER_H
+#define CHANGENOTIFIER_H
+
+#include "types.h"
+
+#include "session/Session.h"
+
+#include <QJsonObject>
+#include <QObject>
+
+#include <functional>
+
+/**
+ * Push the changes of the scene exposed by the REST interface to clients.
+ *
+ * Each change increments a revision number which orders the JSON-RPC
+ * notifications sent to websocket clients, and serves as an entity tag for
+ * conditional GET requests.
+ *
+ * Example notification:
+ * {"jsonrpc": "2.0", "method": "tide/windows/modified",
+ *  "params": {"revision": 42, "surface": 0, "window": {"uuid": "abcd", ...}}}
+ */
+class ChangeNotifier : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(ChangeNotifier)
+
+public:
+    /** Function to send a notification to all the websocket clients. */
+    using SendFunc = std::function<void(const std::string&)>;
+
+    /**
+     * Construct a change notifier.
+     *
+     * @param scene to monitor.
+     * @param options to monitor.
+     * @param send function to broadcast notifications.
+     */
+    ChangeNotifier(const Scene& scene, const Options& options, SendFunc send);
+
+    /** @return the revision of the last change. */
+    uint64_t getRevision() const;
+
+    /**
+     * Check if the session information has changed since the last call.
+     *
+     * Sessions are loaded and saved asynchronously, so changes are detected
+     * when clients query the session rather than through signals.
+     * @param info the current session information.
+     */
+    void update(const SessionInfo& info);
+
+private:
+    SendFunc _send;
+    uint64_t _revision = 0;
+    SessionInfo _sessionInfo;
+
+    void _monitor(const DisplayGroup& group, int surfaceIndex);
+    void _watchChanges(const Window& window, const DisplayGroup& group,
+                       int surfaceIndex);
+    void _notify(const QString& method, QJsonObject params);
+};
+
+#endif
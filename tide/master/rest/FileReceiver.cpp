@@ -46,10 +46,17 @@
 #include "json/json.h"
 
 #include <QByteArray>
+#include <QCryptographicHash>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
+#include <QFuture>
+#include <QImageReader>
 #include <QUrl>
+#include <QtConcurrent>
+
+#include <vector>
 
 using namespace rockets;
 
@@ -58,6 +65,16 @@ namespace
 constexpr auto JSON_TYPE = "application/json";
 constexpr auto INFO_KEY = "info";
 constexpr auto URL_KEY = "url";
+constexpr auto OFFSET_KEY = "offset";
+constexpr auto SIZE_KEY = "size";
+constexpr auto MD5_KEY = "md5";
+
+// The header of an image is expected to be within the first bytes of a file
+constexpr qint64 MAX_HEADER_SIZE = 1024 * 1024;
+
+// Not part of http::Code
+constexpr auto CONFLICT = static_cast<http::Code>(409);
+constexpr auto PAYLOAD_TOO_LARGE = static_cast<http::Code>(413);
 
 inline QString _urlEncode(const QString& filename)
 {
@@ -86,6 +103,64 @@ std::future<http::Response> _makeReadyResponse(const http::Code code,
 {
     return make_ready_response(_makeResponse(code, key, info));
 }
+
+std::future<http::Response> _makeReadyResponse(const http::Code code,
+                                               const QJsonObject& obj)
+{
+    return make_ready_response(
+        http::Response{code, json::dump(obj), JSON_TYPE});
+}
+
+QString _getQueryItem(const http::Request& request, const std::string& key)
+{
+    const auto it = request.query.find(key);
+    if (it == request.query.end())
+        return QString();
+    return QString::fromStdString(it->second);
+}
+
+QString _md5(const char* data, const size_t size)
+{
+    const auto array = QByteArray::fromRawData(data, size);
+    return QCryptographicHash::hash(array, QCryptographicHash::Md5).toHex();
+}
+
+/**
+ * Image formats which store their header at the beginning of the file, so
+ * that their metadata can be read from a partially uploaded file.
+ */
+bool _canProbeHeader(const QString& filename)
+{
+    const auto suffix = QFileInfo{filename}.suffix().toLower();
+    if (suffix == "tif" || suffix == "tiff")
+        return false; // image directory can be anywhere in the file
+    return QImageReader::supportedImageFormats().contains(suffix.toLatin1());
+}
+
+struct HeaderProbe
+{
+    enum class Status
+    {
+        incomplete, // more data is needed to read the header
+        valid,
+        rejected
+    };
+    Status status = Status::incomplete;
+    QSize size; // invalid if the format does not store it in the header
+};
+
+HeaderProbe _probeImageHeader(const QString& filePath, const qint64 received)
+{
+    QImageReader reader{filePath};
+    if (reader.canRead())
+        return {HeaderProbe::Status::valid, reader.size()};
+
+    // A partial header can not be read, only reject the file once its header
+    // must have been received.
+    if (received < MAX_HEADER_SIZE)
+        return {HeaderProbe::Status::incomplete, QSize()};
+    return {HeaderProbe::Status::rejected, QSize()};
+}
 }
 
 struct FileReceiver::UploadParameters
@@ -95,25 +170,82 @@ struct FileReceiver::UploadParameters
         : filename{obj["filename"].toString()}
         , position{obj["x"].toDouble(), obj["y"].toDouble()}
         , surfaceIndex{static_cast<uint>(obj["surfaceIndex"].toInt())}
+        , size{static_cast<qint64>(obj[SIZE_KEY].toDouble(-1.0))}
+        , md5{obj[MD5_KEY].toString().toLower()}
     {
     }
     QString filename;
     QPointF position;
     uint surfaceIndex = 0;
+    qint64 size = -1;
+    QString md5;
+};
+
+struct FileReceiver::Upload
+{
+    Upload(const UploadParameters& params_, const QString& filePath)
+        : params{params_}
+        , file{filePath}
+    {
+        lastActivity.start();
+    }
+
+    ~Upload()
+    {
+        if (probe.isRunning())
+            probe.waitForFinished();
+    }
+
+    UploadParameters params;
+    QFile file;
+    qint64 received = 0;
+    QCryptographicHash hash{QCryptographicHash::Md5};
+    QFuture<HeaderProbe> probe;
+    bool probeStarted = false;
+    QElapsedTimer lastActivity;
+
+    bool isComplete() const
+    {
+        return params.size < 0 || received == params.size;
+    }
+
+    bool hasProbeStatus(const HeaderProbe::Status status) const
+    {
+        return probeStarted && probe.isFinished() &&
+               probe.result().status == status;
+    }
+
+    bool needsProbe() const
+    {
+        return !probeStarted || hasProbeStatus(HeaderProbe::Status::incomplete);
+    }
 };
 
-FileReceiver::FileReceiver(const QString& tmpDir)
+FileReceiver::FileReceiver(const QString& tmpDir, const qint64 maxUploadSize,
+                           const std::chrono::milliseconds idleTimeout)
     : _tmpDir{tmpDir}
+    , _maxUploadSize{maxUploadSize}
+    , _idleTimeout{idleTimeout}
 {
+    connect(&_idleTimer, &QTimer::timeout, this,
+            &FileReceiver::_abortIdleUploads);
+    _idleTimer.start(std::max(int(_idleTimeout.count() / 2), 1));
 }
 
 FileReceiver::~FileReceiver()
 {
+    for (const auto& upload : _uploads)
+    {
+        if (upload.second->file.isOpen())
+            upload.second->file.remove();
+    }
 }
 
 std::future<http::Response> FileReceiver::prepareUpload(
     const http::Request& request)
 {
+    _abortIdleUploads();
+
     const auto obj = json::parse(request.body);
     if (obj.empty())
         return make_ready_response(http::Code::BAD_REQUEST);
@@ -131,40 +263,132 @@ std::future<http::Response> FileReceiver::prepareUpload(
     if (!filters.contains(fileSuffix.toLower()))
         return make_ready_response(http::Code::NOT_SUPPORTED);
 
+    if (_maxUploadSize > 0 && params.size > _maxUploadSize)
+        return _makeReadyResponse(PAYLOAD_TOO_LARGE, INFO_KEY,
+                                  "file exceeds the upload size limit");
+
     const auto path =
         SessionSaver::findAvailableFilePath(params.filename, _tmpDir);
     const auto name = QFileInfo{path}.fileName();
-    _preparedPaths[name] = params;
+    _uploads[name] = std::make_unique<Upload>(params, path);
     return _makeReadyResponse(http::Code::OK, URL_KEY, _urlEncode(name));
 }
 
 std::future<http::Response> FileReceiver::handleUpload(
     const http::Request& request)
 {
+    _abortIdleUploads();
+
     const auto name = _urlDecode(QString::fromStdString(request.path));
-    if (!_preparedPaths.count(name))
+    if (!_uploads.count(name))
         return _makeReadyResponse(http::Code::FORBIDDEN, INFO_KEY,
                                   "upload not prepared");
 
-    const auto filePath = _tmpDir + "/" + name;
+    auto& upload = *_uploads[name];
+    upload.lastActivity.restart();
+    const auto filePath = upload.file.fileName();
+    const auto chunkSize = static_cast<qint64>(request.body.size());
 
-    const auto params = _preparedPaths[name];
-    _preparedPaths.erase(name);
+    const auto offsetItem = _getQueryItem(request, OFFSET_KEY);
+    if (!offsetItem.isEmpty() && offsetItem.toLongLong() != upload.received)
+        return _makeReadyResponse(CONFLICT,
+                                  QJsonObject{{OFFSET_KEY, upload.received}});
 
-    QFile file(filePath);
-    if (!file.open(QIODevice::WriteOnly) ||
-        !file.write(request.body.c_str(), request.body.size()))
+    const auto newSize = upload.received + chunkSize;
+    if ((upload.params.size >= 0 && newSize > upload.params.size) ||
+        (_maxUploadSize > 0 && newSize > _maxUploadSize))
+    {
+        _abortUpload(name);
+        return _makeReadyResponse(PAYLOAD_TOO_LARGE, INFO_KEY,
+                                  "file exceeds its size or the upload limit");
+    }
+
+    const auto md5 = _getQueryItem(request, MD5_KEY).toLower();
+    if (!md5.isEmpty() && md5 != _md5(request.body.data(), request.body.size()))
+        return _makeReadyResponse(http::Code::BAD_REQUEST, INFO_KEY,
+                                  "chunk checksum mismatch");
+
+    if (upload.hasProbeStatus(HeaderProbe::Status::rejected))
+    {
+        _abortUpload(name);
+        return _makeReadyResponse(http::Code::NOT_SUPPORTED, INFO_KEY,
+                                  "file header is not valid");
+    }
+
+    if ((!upload.file.isOpen() && !upload.file.open(QIODevice::WriteOnly)) ||
+        upload.file.write(request.body.data(), chunkSize) != chunkSize ||
+        !upload.file.flush())
     {
         print_log(LOG_ERROR, LOG_REST, "file not created as %s",
                   filePath.toLocal8Bit().constData());
+        _abortUpload(name);
         return _makeReadyResponse(http::Code::INTERNAL_SERVER_ERROR, INFO_KEY,
                                   "could not upload");
     }
-    file.close();
+    upload.hash.addData(request.body.data(), chunkSize);
+    upload.received = newSize;
+
+    if (!upload.isComplete())
+    {
+        // Probe again until the header has been received
+        if (upload.needsProbe() && _canProbeHeader(filePath))
+        {
+            upload.probe =
+                QtConcurrent::run(_probeImageHeader, filePath, upload.received);
+            upload.probeStarted = true;
+        }
+
+        return _makeReadyResponse(http::Code::ACCEPTED,
+                                  QJsonObject{{OFFSET_KEY, upload.received}});
+    }
+    return _completeUpload(name);
+}
+
+std::future<http::Response> FileReceiver::getUploadStatus(
+    const http::Request& request)
+{
+    _abortIdleUploads();
+
+    const auto name = _urlDecode(QString::fromStdString(request.path));
+    if (!_uploads.count(name))
+        return make_ready_response(http::Code::NOT_FOUND);
+
+    auto& upload = *_uploads[name];
+    upload.lastActivity.restart();
+    auto status = QJsonObject{{OFFSET_KEY, upload.received}};
+    if (upload.params.size >= 0)
+        status[SIZE_KEY] = upload.params.size;
+    if (upload.hasProbeStatus(HeaderProbe::Status::valid) &&
+        upload.probe.result().size.isValid())
+    {
+        status["width"] = upload.probe.result().size.width();
+        status["height"] = upload.probe.result().size.height();
+    }
+    return _makeReadyResponse(http::Code::OK, status);
+}
+
+std::future<http::Response> FileReceiver::_completeUpload(const QString& name)
+{
+    auto upload = std::move(_uploads[name]);
+    _uploads.erase(name);
+
+    const auto filePath = upload->file.fileName();
+    upload->file.close();
+
+    const auto expectedMd5 = upload->params.md5;
+    if (!expectedMd5.isEmpty() && expectedMd5 != upload->hash.result().toHex())
+    {
+        print_log(LOG_ERROR, LOG_REST, "checksum mismatch for %s",
+                  filePath.toLocal8Bit().constData());
+        QFile{filePath}.remove();
+        return _makeReadyResponse(http::Code::BAD_REQUEST, INFO_KEY,
+                                  "file checksum mismatch");
+    }
 
     print_log(LOG_INFO, LOG_REST, "file created as %s",
               filePath.toLocal8Bit().constData());
 
+    const auto params = upload->params;
     auto promise = std::make_shared<std::promise<Response>>();
     emit open(
         params.surfaceIndex, filePath, params.position,
@@ -192,3 +416,25 @@ std::future<http::Response> FileReceiver::handleUpload(
         });
     return promise->get_future();
 }
+
+void FileReceiver::_abortUpload(const QString& name)
+{
+    auto& upload = *_uploads[name];
+    print_log(LOG_WARN, LOG_REST, "upload aborted: %s",
+              upload.file.fileName().toLocal8Bit().constData());
+    if (upload.file.isOpen())
+        upload.file.remove();
+    _uploads.erase(name);
+}
+
+void FileReceiver::_abortIdleUploads()
+{
+    std::vector<QString> idleUploads;
+    for (const auto& upload : _uploads)
+    {
+        if (upload.second->lastActivity.hasExpired(_idleTimeout.count()))
+            idleUploads.push_back(upload.first);
+    }
+    for (const auto& name : idleUploads)
+        _abortUpload(name);
+}
@@ -46,6 +46,9 @@
 #include <rockets/server.h>
 
 #include <QObject>
+#include <QTimer>
+
+#include <chrono>
 
 /**
  * Receive HTTP file uploads.
@@ -59,13 +62,44 @@
  * PUT /api/upload/cool%20image.png
  * --- BINARY DATA ---
  * => 201
+ *
+ * Large files can be uploaded in chunks, which are written to disk as they
+ * arrive so that only one chunk at a time is held in memory:
+ *
+ * POST /api/upload
+ * { "filename": "movie.mp4", "size": 3000000000, "md5": "<hex digest>" }
+ * => 200 { "url" : "movie.mp4" }
+ *
+ * PUT /api/upload/movie.mp4?offset=0&md5=<hex digest of chunk>
+ * --- BINARY DATA (first chunk) ---
+ * => 202 { "offset" : 8388608 }
+ * ...
+ * PUT /api/upload/movie.mp4?offset=2994733056
+ * --- BINARY DATA (last chunk) ---
+ * => 201
+ *
+ * An interrupted upload can be resumed from the offset returned by:
+ * GET /api/upload/movie.mp4
+ * => 200 { "offset" : 8388608, "size" : 3000000000 }
+ *
+ * Uploads which receive no request for longer than the idle timeout are
+ * aborted and their partial file is removed.
  */
 class FileReceiver : public QObject
 {
     Q_OBJECT
 
 public:
-    FileReceiver(const QString& tmpDir);
+    /**
+     * Create a file receiver.
+     *
+     * @param tmpDir the directory where to save uploaded files.
+     * @param maxUploadSize the maximum size of a file in bytes, 0 for no limit.
+     * @param idleTimeout after which an interrupted upload is aborted.
+     */
+    FileReceiver(const QString& tmpDir, qint64 maxUploadSize = 0,
+                 std::chrono::milliseconds idleTimeout =
+                     std::chrono::minutes{10});
     ~FileReceiver();
 
     using Response = rockets::http::Response;
@@ -75,19 +109,39 @@ public:
      *
      * @param request JSON POST request with fields: { filename, x, y }.
      *        filename is the desired filename, x and y are the desired
-     *        coordinates for opening the content.
-     * @return JSON response with the url to use for handleUpload() as { url }.
+     *        coordinates for opening the content. The optional fields size
+     *        and md5 are the total size in bytes and the checksum of the file
+     *        for chunked uploads.
+     * @return JSON response with the url to use for handleUpload() as { url },
+     *         or 413 if the declared size exceeds the upload limit.
      */
     std::future<Response> prepareUpload(const rockets::http::Request& request);
 
     /**
      * Upload a file via REST Interface.
      *
+     * The data is appended to the file on disk. For chunked uploads, the
+     * optional query parameters 'offset' and 'md5' give the position of the
+     * chunk in the file and its checksum.
+     *
      * @param request binary PUT request to the url returned by prepareUpload().
-     * @return response with appropiate code and status (201 on success).
+     * @return response with appropiate code and status (201 on success, 202
+     *         with the next expected offset when more chunks are expected, 409
+     *         with the expected offset if the chunk is not contiguous, 413 if
+     *         the upload limit is exceeded).
      */
     std::future<Response> handleUpload(const rockets::http::Request& request);
 
+    /**
+     * Get the status of an upload, to resume it after an interruption.
+     *
+     * @param request GET request to the url returned by prepareUpload().
+     * @return JSON response with the number of bytes received as { offset }
+     *         and, if known, the total size and the image dimensions.
+     */
+    std::future<Response> getUploadStatus(
+        const rockets::http::Request& request);
+
 signals:
     /** Open the uploaded file at the given position. */
     void open(uint surfaceIndex, QString uri, QPointF position,
@@ -95,8 +149,16 @@ signals:
 
 private:
     QString _tmpDir;
+    qint64 _maxUploadSize = 0;
     struct UploadParameters;
-    std::map<QString, UploadParameters> _preparedPaths;
+    struct Upload;
+    std::map<QString, std::unique_ptr<Upload>> _uploads;
+    std::chrono::milliseconds _idleTimeout;
+    QTimer _idleTimer;
+
+    std::future<Response> _completeUpload(const QString& name);
+    void _abortUpload(const QString& name);
+    void _abortIdleUploads();
 };
 
 #endif
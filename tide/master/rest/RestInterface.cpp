@@ -39,6 +39,7 @@
 
 #include "RestInterface.h"
 
+#include "ChangeNotifier.h"
 #include "FileBrowser.h"
 #include "FileReceiver.h"
 #include "HtmlContent.h"
@@ -46,11 +47,13 @@
 #include "SceneRemoteController.h"
 #include "ThumbnailCache.h"
 #include "configuration/Configuration.h"
+#include "metrics/prometheus.h"
 #include "rest/serialization.h"
 #include "scene/ContentFactory.h"
 #include "scene/Scene.h"
 #include "session/Session.h"
 #include "tools/ActivityLogger.h"
+#include "tools/MetricsAggregator.h"
 #include "utils/log.h"
 #include "json/serialization.h"
 // include last
@@ -82,6 +85,12 @@ std::string to_json(const LockState& lockState)
 }
 }
 
+namespace
+{
+const auto jsonContentType = "application/json";
+const auto revisionParameter = "revision";
+}
+
 /** Use REST-specific serialization of Configuration. */
 std::string to_json(const Configuration& config)
 {
@@ -91,18 +100,24 @@ std::string to_json(const Configuration& config)
 class RestInterface::Impl
 {
 public:
-    Impl(const uint16_t port, OptionsPtr options_, Scene& scene,
+    Impl(const uint16_t port, OptionsPtr options_, Session& session_,
          const Configuration& config, const bool locked)
         : server{port}
         , options{options_}
+        , session{session_}
         , size{config.surfaces[0].getTotalSize()}
-        , thumbnailCache{scene}
+        , changeNotifier{*session.getScene(), *options,
+                         [this](const std::string& message) {
+                             server.broadcastText(message);
+                         }}
+        , thumbnailCache{*session.getScene()}
         , appRemoteController{config}
-        , sceneRemoteController{scene}
+        , sceneRemoteController{*session.getScene()}
         , contentBrowser{config.folders.contents,
                          ContentFactory::getSupportedFilesFilter()}
         , sessionBrowser{config.folders.sessions, QStringList{"*.dcx"}}
-        , fileReceiver{config.folders.tmp}
+        , fileReceiver{config.folders.tmp,
+                       qint64{config.master.uploadMaxSize} * 1024 * 1024}
         , htmlContent{server}
         , lockState{locked}
     {
@@ -124,9 +139,41 @@ public:
         return make_ready_response(http::Code::BAD_REQUEST);
     }
 
+    /**
+     * Serve an object unless the client already has its current revision.
+     * Rockets does not expose the request headers, so the revision is passed
+     * as a query parameter instead of an If-None-Match header.
+     */
+    template <typename Obj>
+    std::future<http::Response> getIfModified(const http::Request& request,
+                                              const Obj& object)
+    {
+        changeNotifier.update(session.getInfo());
+
+        const auto revision = std::to_string(changeNotifier.getRevision());
+        const auto it = request.query.find(revisionParameter);
+        if (it != request.query.end() && it->second == revision)
+            return make_ready_response(http::Code::NOT_MODIFIED);
+
+        return make_ready_response(http::Code::OK, to_json(object),
+                                   jsonContentType);
+    }
+
+    std::future<http::Response> getRevision()
+    {
+        changeNotifier.update(session.getInfo());
+
+        const auto revision = qint64(changeNotifier.getRevision());
+        const auto body = QJsonObject{{revisionParameter, revision}};
+        return make_ready_response(http::Code::OK, json::dump(body),
+                                   jsonContentType);
+    }
+
     RestServer server;
     OptionsPtr options;
+    Session& session;
     QSize size;
+    ChangeNotifier changeNotifier;
     ThumbnailCache thumbnailCache;
     AppRemoteController appRemoteController;
     SceneRemoteController sceneRemoteController;
@@ -139,7 +186,7 @@ public:
 
 RestInterface::RestInterface(const uint16_t port, OptionsPtr options,
                              Session& session, Configuration& config)
-    : _impl(new Impl(port, options, *session.getScene(), config, false))
+    : _impl(new Impl(port, options, session, config, false))
 {
     put_log(LOG_INFO, LOG_REST, "listening to REST messages on TCP port %hu",
             _impl->server.getPort());
@@ -159,13 +206,30 @@ RestInterface::RestInterface(const uint16_t port, OptionsPtr options,
     server.handleGET("tide/config", config);
     server.handleGET("tide/lock", _impl->lockState);
     server.handleGET("tide/size", _impl->size);
-    server.handleGET("tide/options", *_impl->options);
     server.handlePUT("tide/options", *_impl->options);
-    server.handleGET("tide/windows", *session.getScene());
-    server.handleGET("tide/session", session.getInfo());
 
     using namespace std::placeholders;
 
+    // Polling clients can get a cheap 304 by passing the revision they have
+    // (see tide/revision), others can follow the changes on a websocket.
+    auto impl = _impl.get();
+    server.handle(http::Method::GET, "tide/options",
+                  [impl](const http::Request& request) {
+                      return impl->getIfModified(request, *impl->options);
+                  });
+    server.handle(http::Method::GET, "tide/windows",
+                  [impl](const http::Request& request) {
+                      return impl->getIfModified(request,
+                                                 *impl->session.getScene());
+                  });
+    server.handle(http::Method::GET, "tide/session",
+                  [impl](const http::Request& request) {
+                      return impl->getIfModified(request,
+                                                 impl->session.getInfo());
+                  });
+    server.handle(http::Method::GET, "tide/revision",
+                  [impl](const http::Request&) { return impl->getRevision(); });
+
     server.handle(http::Method::GET, "tide/windows/",
                   std::bind(&Impl::getWindowInfo, _impl.get(), _1));
 
@@ -177,6 +241,10 @@ RestInterface::RestInterface(const uint16_t port, OptionsPtr options,
                   std::bind(&FileReceiver::handleUpload, &_impl->fileReceiver,
                             _1));
 
+    server.handle(http::Method::GET, "tide/upload/",
+                  std::bind(&FileReceiver::getUploadStatus,
+                            &_impl->fileReceiver, _1));
+
     server.handle(http::Method::GET, "tide/files/",
                   std::bind(&FileBrowser::list, &_impl->contentBrowser, _1));
 
@@ -191,6 +259,16 @@ void RestInterface::exposeStatistics(const ActivityLogger& logger) const
     _impl->server.handleGET("tide/stats", logger);
 }
 
+void RestInterface::exposeMetrics(const MetricsAggregator& metrics) const
+{
+    _impl->server.handle(http::Method::GET, "tide/metrics",
+                         [&metrics](const http::Request&) {
+                             return make_ready_response(
+                                 http::Code::OK, metrics.toPrometheus(),
+                                 prometheus::contentType);
+                         });
+}
+
 const AppRemoteController& RestInterface::getAppRemoteController() const
 {
     return _impl->appRemoteController;
@@ -53,6 +53,11 @@
  * curl -i -X PUT -d '{"uri": "image.png"}' http://localhost:8888/tide/open
  *
  * It also exposes a control html interface on 'http://hostname:port'.
+ *
+ * Changes to the windows, options and session are pushed as JSON-RPC
+ * notifications to websocket clients connected to 'ws://hostname:port'. The
+ * revision of the last change is available on GET 'tide/revision'; passing it
+ * as in 'tide/windows?revision=42' returns 304 if nothing has changed since.
  */
 class RestInterface
 {
@@ -76,6 +81,9 @@ public:
     /** Expose the statistics gathered by the given activity logger. */
     void exposeStatistics(const ActivityLogger& logger) const;
 
+    /** Expose the metrics of all processes in Prometheus text format. */
+    void exposeMetrics(const MetricsAggregator& metrics) const;
+
     const AppRemoteController& getAppRemoteController() const;
 
     /** Prevent modifying the wall via the interface. */
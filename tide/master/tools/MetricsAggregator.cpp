@@ -0,0 +1,93 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "tools/MetricsAggregator.h"
+
+#include "metrics/prometheus.h"
+
+namespace
+{
+void _merge(std::map<std::string, MetricFamily>& merged,
+            const MetricFamilies& families, const std::string& process)
+{
+    for (const auto& family : families)
+    {
+        auto it = merged.find(family.name);
+        if (it == merged.end())
+        {
+            it = merged.emplace(family.name, family).first;
+            it->second.samples.clear();
+        }
+        else if (it->second.type != family.type ||
+                 it->second.bounds != family.bounds)
+        {
+            continue; // inconsistent definitions can't be merged
+        }
+
+        for (auto sample : family.samples)
+        {
+            sample.labels["process"] = process;
+            it->second.samples.emplace_back(std::move(sample));
+        }
+    }
+}
+}
+
+MetricFamilies MetricsAggregator::getMetrics() const
+{
+    std::map<std::string, MetricFamily> merged;
+    _merge(merged, MetricsRegistry::instance().snapshot(), "master");
+    for (const auto& wall : _wallMetrics)
+        _merge(merged, wall.second, "wall" + std::to_string(wall.first));
+
+    MetricFamilies families;
+    families.reserve(merged.size());
+    for (auto& family : merged)
+        families.emplace_back(std::move(family.second));
+    return families;
+}
+
+std::string MetricsAggregator::toPrometheus() const
+{
+    return prometheus::toText(getMetrics());
+}
+
+void MetricsAggregator::update(const int rank, MetricFamilies metrics)
+{
+    _wallMetrics[rank] = std::move(metrics);
+}
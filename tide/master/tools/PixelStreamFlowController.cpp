@@ -0,0 +1,201 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "PixelStreamFlowController.h"
+
+#include "metrics/MetricsRegistry.h"
+
+#include <deflect/server/Frame.h>
+
+#include <algorithm>
+
+namespace
+{
+const auto inFlightMetric = "tide_stream_frames_in_flight";
+const auto windowMetric = "tide_stream_credit_window";
+const auto droppedMetric = "tide_stream_frames_dropped_total";
+const auto roundTripMetric = "tide_stream_frame_round_trip_seconds";
+
+MetricLabels _labels(const QString& uri)
+{
+    return {{"uri", uri.toStdString()}};
+}
+}
+
+PixelStreamFlowController::PixelStreamFlowController(
+    const uint maxFramesInFlight)
+    : _maxFramesInFlight{std::max(maxFramesInFlight, 1u)}
+{
+}
+
+PixelStreamFlowController::~PixelStreamFlowController()
+{
+    while (!_streams.empty())
+        remove(_streams.begin()->first);
+}
+
+uint PixelStreamFlowController::getFramesInFlight(const QString& uri) const
+{
+    const auto it = _streams.find(uri);
+    return it != _streams.end() ? it->second.framesInFlight : 0;
+}
+
+uint PixelStreamFlowController::getWindow(const QString& uri) const
+{
+    const auto it = _streams.find(uri);
+    return it != _streams.end() ? it->second.window : 1;
+}
+
+void PixelStreamFlowController::restart(const QString uri)
+{
+    // Frames sent before are lost, the wall has no more data source for them.
+    auto& stream = _streams[uri];
+    stream.framesInFlight = 0;
+    stream.displayedInWindow = 0;
+    stream.sendTimes.clear();
+    stream.requested = true;
+    _updateMetrics(uri, stream);
+    emit requestFrame(uri);
+}
+
+void PixelStreamFlowController::registerFrame(deflect::server::FramePtr frame)
+{
+    auto& stream = _streams[frame->uri];
+    ++stream.framesInFlight;
+    stream.requested = false;
+    stream.sendTimes.push_back(clock::now());
+    _requestIfAllowed(frame->uri, stream);
+    _updateMetrics(frame->uri, stream);
+}
+
+void PixelStreamFlowController::returnCredits(const QString uri,
+                                              const uint frames,
+                                              const uint dropped)
+{
+    const auto it = _streams.find(uri);
+    if (it == _streams.end())
+        return;
+
+    auto& stream = it->second;
+
+    // Credits of frames sent before a restart may still arrive, ignore them
+    const auto credits = std::min(frames, stream.framesInFlight);
+    stream.framesInFlight -= credits;
+
+    auto& registry = MetricsRegistry::instance();
+    auto& roundTrip =
+        registry.histogram(roundTripMetric,
+                           "Time between sending a pixel stream frame to the "
+                           "wall and getting its credit back",
+                           _labels(uri));
+    const auto now = clock::now();
+    for (uint i = 0; i < credits && !stream.sendTimes.empty(); ++i)
+    {
+        const auto elapsed = now - stream.sendTimes.front();
+        roundTrip.observe(std::chrono::duration<double>(elapsed).count());
+        stream.sendTimes.pop_front();
+    }
+
+    if (dropped > 0)
+    {
+        registry
+            .counter(droppedMetric,
+                     "Pixel stream frames skipped by the wall because it was "
+                     "too slow to display them",
+                     _labels(uri))
+            .increment(dropped);
+    }
+
+    // With more than one frame in flight, the next frame can arrive just
+    // before the previous one is swapped and replace it. Only skipping more
+    // than that one frame means that the wall can't keep up.
+    const auto expectedDrops = stream.window > 1 ? 1u : 0u;
+    if (dropped > expectedDrops)
+    {
+        stream.window = std::max(stream.window / 2, 1u);
+        stream.displayedInWindow = 0;
+    }
+    else if (dropped == 0 && ++stream.displayedInWindow >= stream.window)
+    {
+        stream.window = std::min(stream.window + 1, _maxFramesInFlight);
+        stream.displayedInWindow = 0;
+    }
+
+    _requestIfAllowed(uri, stream);
+    _updateMetrics(uri, stream);
+}
+
+void PixelStreamFlowController::remove(const QString uri)
+{
+    if (!_streams.erase(uri))
+        return;
+
+    const auto labels = _labels(uri);
+    auto& registry = MetricsRegistry::instance();
+    registry.remove(inFlightMetric, labels);
+    registry.remove(windowMetric, labels);
+    registry.remove(droppedMetric, labels);
+    registry.remove(roundTripMetric, labels);
+}
+
+void PixelStreamFlowController::_requestIfAllowed(const QString& uri,
+                                                  Stream& stream)
+{
+    if (stream.requested || stream.framesInFlight >= stream.window)
+        return;
+
+    stream.requested = true;
+    emit requestFrame(uri);
+}
+
+void PixelStreamFlowController::_updateMetrics(const QString& uri,
+                                               const Stream& stream) const
+{
+    auto& registry = MetricsRegistry::instance();
+    const auto labels = _labels(uri);
+    registry
+        .gauge(inFlightMetric,
+               "Pixel stream frames sent to the wall and not yet consumed",
+               labels)
+        .set(stream.framesInFlight);
+    registry
+        .gauge(windowMetric,
+               "Maximum pixel stream frames currently allowed in flight",
+               labels)
+        .set(stream.window);
+}
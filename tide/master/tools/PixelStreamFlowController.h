@@ -0,0 +1,136 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef PIXELSTREAMFLOWCONTROLLER_H
+#define PIXELSTREAMFLOWCONTROLLER_H
+
+#include "types.h"
+
+#include <QObject>
+
+#include <chrono>
+#include <deque>
+#include <map>
+
+/**
+ * Credit-based flow control of the frames sent from the pixel streams to the
+ * wall processes.
+ *
+ * Each frame forwarded to the wall consumes a credit, which the wall returns
+ * once it has displayed (or skipped) the frame on all of its processes. New
+ * frames are requested from a stream as long as it has credits left, so that
+ * transfers overlap with decoding on the wall.
+ *
+ * The number of credits of a stream adapts between one and the configured
+ * maximum: it is halved when the wall drops more than the one frame per swap
+ * that overlapping transfers can replace, and increased by one after a full
+ * window of frames was displayed without dropping any.
+ */
+class PixelStreamFlowController : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(PixelStreamFlowController)
+
+public:
+    /**
+     * Create a flow controller.
+     * @param maxFramesInFlight the maximum number of frames of a stream that
+     *        can be sent to the wall ahead of their display (minimum 1).
+     */
+    explicit PixelStreamFlowController(uint maxFramesInFlight);
+
+    /** Destructor. */
+    ~PixelStreamFlowController();
+
+    /** @return the number of frames of a stream not yet consumed by the wall */
+    uint getFramesInFlight(const QString& uri) const;
+
+    /** @return the current number of credits of a stream. */
+    uint getWindow(const QString& uri) const;
+
+public slots:
+    /**
+     * Reset the credits of a stream when the wall is ready to receive frames.
+     * @param uri of the stream
+     */
+    void restart(QString uri);
+
+    /**
+     * Register a frame that was sent to the wall.
+     * @param frame that was sent
+     */
+    void registerFrame(deflect::server::FramePtr frame);
+
+    /**
+     * Return credits after the wall has consumed frames of a stream.
+     * @param uri of the stream
+     * @param frames number of frames consumed by the wall
+     * @param dropped number of consumed frames that were not displayed
+     */
+    void returnCredits(QString uri, uint frames, uint dropped);
+
+    /**
+     * Remove a stream, for instance when it was closed.
+     * @param uri of the stream
+     */
+    void remove(QString uri);
+
+signals:
+    /** Emitted to request the next frame from a stream. */
+    void requestFrame(QString uri);
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    struct Stream
+    {
+        uint window = 1;
+        uint framesInFlight = 0;
+        uint displayedInWindow = 0;
+        bool requested = false;
+        std::deque<clock::time_point> sendTimes;
+    };
+
+    const uint _maxFramesInFlight;
+    std::map<QString, Stream> _streams;
+
+    void _requestIfAllowed(const QString& uri, Stream& stream);
+    void _updateMetrics(const QString& uri, const Stream& stream) const;
+};
+
+#endif
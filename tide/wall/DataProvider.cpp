@@ -42,6 +42,8 @@
 #include "config.h"
 #include "datasources/DataSourceFactory.h"
 #include "datasources/PixelStreamUpdater.h"
+#include "datasources/WhiteboardSource.h"
+#include "metrics/MetricsRegistry.h"
 #include "network/WallToWallChannel.h"
 #include "qml/Tile.h"
 #include "scene/Background.h"
@@ -51,12 +53,48 @@
 #include "synchronizers/ContentSynchronizerFactory.h"
 #include "utils/log.h"
 
+#if TIDE_USE_TIFF
+#include "datasources/ImagePyramidDataSource.h"
+#endif
+
 #include <deflect/server/Frame.h>
 
 #include <QtConcurrent>
 
+#include <chrono>
+
 namespace
 {
+MetricHistogram& _loadTimeHistogram()
+{
+    static auto& histogram = MetricsRegistry::instance().histogram(
+        "tide_tile_load_seconds",
+        "Time to load (read and decode) a tile image of any content");
+    return histogram;
+}
+
+MetricHistogram& _firstPixelHistogram()
+{
+    static auto& histogram = MetricsRegistry::instance().histogram(
+        "tide_tile_first_pixel_seconds",
+        "Time until a first (possibly coarse) image of a tile is available");
+    return histogram;
+}
+
+MetricHistogram& _fullQualityHistogram()
+{
+    static auto& histogram = MetricsRegistry::instance().histogram(
+        "tide_tile_full_quality_seconds",
+        "Time until the full quality image of a static tile is available");
+    return histogram;
+}
+
+double _secondsSince(const std::chrono::steady_clock::time_point start)
+{
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double>(elapsed).count();
+}
+
 template <typename Map>
 void remove_unused(Map& map, const std::set<typename Map::key_type>& validKeys)
 {
@@ -115,6 +153,16 @@ void DataProvider::updateDataSources(const Scene& scene)
     remove_unused(_dataSources, updatedSources);
 }
 
+bool DataProvider::updateWhiteboard(const WhiteboardStrokeUpdate& update)
+{
+    const auto it = _dataSources.find(update.whiteboardId);
+    if (it == _dataSources.end())
+        return false;
+
+    auto whiteboard = std::dynamic_pointer_cast<WhiteboardSource>(it->second);
+    return whiteboard && whiteboard->extendStroke(update);
+}
+
 std::unique_ptr<ContentSynchronizer> DataProvider::createSynchronizer(
     const Window& window, const deflect::View view)
 {
@@ -182,13 +230,22 @@ DataSourceSharedPtr DataProvider::_getOrCreateDataSource(const Content& content)
         _dataSources[id] = DataSourceFactory::create(content);
         if (auto stream = cast_to_stream_source(_dataSources[id]))
         {
-            connect(stream.get(), &PixelStreamUpdater::requestFrame, this,
-                    &DataProvider::requestPixelStreamFrame);
+            connect(stream.get(), &PixelStreamUpdater::framesConsumed, this,
+                    &DataProvider::pixelStreamFramesConsumed);
 
             // request the first frame now that the data source is ready to
             // accept it.
             emit requestPixelStreamFrame(content.getUri());
         }
+#if TIDE_USE_TIFF
+        else if (auto pyramid = std::dynamic_pointer_cast<
+                     ImagePyramidDataSource>(_dataSources[id]))
+        {
+            // Render again to request the tiles of the generated pyramid
+            connect(pyramid.get(), &ImagePyramidDataSource::pyramidReady, this,
+                    &DataProvider::imageLoaded);
+        }
+#endif
     }
     return _dataSources[id];
 }
@@ -248,6 +305,16 @@ void DataProvider::_handleStreamError(const QString& uri)
 void DataProvider::_load(DataSourceSharedPtr source,
                          const TileUpdateList& tilesToUpdate)
 {
+    const auto start = std::chrono::steady_clock::now();
+
+    // Show coarse images first for the sources which are slow to render
+    std::map<deflect::View, ImagePtr> coarseImage;
+    if (!source->isDynamic())
+        coarseImage = _loadCoarse(*source, tilesToUpdate);
+
+    if (!coarseImage.empty())
+        _firstPixelHistogram().observe(_secondsSince(start));
+
     // Request image only once for each view
     std::map<deflect::View, ImagePtr> image;
 
@@ -261,9 +328,23 @@ void DataProvider::_load(DataSourceSharedPtr source,
             {
                 if (!image.count(view))
                 {
+                    const auto loadStart = std::chrono::steady_clock::now();
                     image[view] = source->getTileImage(id, view);
-                    if (!image[view])
+                    if (!image[view] && !source->isDynamic())
                         throw std::logic_error("Unexpected empty image");
+                    _loadTimeHistogram().observe(_secondsSince(loadStart));
+                    if (coarseImage.empty() && image.size() == 1)
+                        _firstPixelHistogram().observe(_secondsSince(start));
+                    if (!source->isDynamic())
+                        _fullQualityHistogram().observe(_secondsSince(start));
+                }
+                if (!image[view])
+                {
+                    // No new image in this frame, the tile must still swap
+                    QMetaObject::invokeMethod(tile.get(), "keepFrontTexture",
+                                              Qt::QueuedConnection,
+                                              Q_ARG(TilePtr, tile));
+                    continue;
                 }
                 QMetaObject::invokeMethod(tile.get(), "updateBackTexture",
                                           Qt::QueuedConnection,
@@ -286,6 +367,48 @@ void DataProvider::_load(DataSourceSharedPtr source,
     }
 }
 
+std::map<deflect::View, ImagePtr> DataProvider::_loadCoarse(
+    const DataSource& source, const TileUpdateList& tilesToUpdate)
+{
+    std::map<deflect::View, ImagePtr> image;
+
+    for (const auto& it : tilesToUpdate)
+    {
+        auto tile = it.tile.lock();
+        if (!tile)
+            continue;
+
+        const auto view = it.view;
+        if (!image.count(view))
+        {
+            try
+            {
+                image[view] = source.getCoarseTileImage(tile->getId(), view);
+            }
+            catch (const std::exception& e)
+            {
+                // Not critical, the full quality tile is loaded next
+                print_log(LOG_DEBUG, LOG_GENERAL, "No coarse tile: %s",
+                          e.what());
+                image[view] = ImagePtr();
+            }
+        }
+        if (!image[view])
+            continue;
+
+        QMetaObject::invokeMethod(tile.get(), "updateBackTextureCoarse",
+                                  Qt::QueuedConnection,
+                                  Q_ARG(ImagePtr, image[view]),
+                                  Q_ARG(TilePtr, tile));
+        emit imageLoaded(); // Keep RenderController active
+    }
+
+    // Only keep the views which got a coarse image
+    for (auto it = image.begin(); it != image.end();)
+        it = it->second ? std::next(it) : image.erase(it);
+    return image;
+}
+
 void DataProvider::_handleFinished()
 {
     auto watcher = static_cast<Watcher*>(sender());
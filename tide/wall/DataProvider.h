@@ -92,6 +92,14 @@ public:
      */
     void synchronizeTilesUpdate(WallToWallChannel& channel);
 
+    /**
+     * Add the new points of a stroke to an existing whiteboard data source.
+     *
+     * @param update the points of the stroke.
+     * @return true if the strokes of the whiteboard have changed.
+     */
+    bool updateWhiteboard(const WhiteboardStrokeUpdate& update);
+
 public slots:
     /** Start loading a tile image asynchronously. */
     void loadAsync(TilePtr tile, deflect::View view);
@@ -100,9 +108,12 @@ public slots:
     void setNewFrame(deflect::server::FramePtr frame);
 
 signals:
-    /** Emitted to request a new frame for a stream after a successful swap. */
+    /** Emitted to request the first frame when a stream is opened. */
     void requestPixelStreamFrame(QString uri);
 
+    /** Emitted to return the credits of stream frames after a swap. */
+    void pixelStreamFramesConsumed(QString uri, uint frames, uint dropped);
+
     /** Emitted to request the pixel stream to close if an error occured. */
     void closePixelStream(QString uri);
 
@@ -130,6 +141,8 @@ private:
     void _startAsyncTileImageRequests(DataSourceSharedPtr source);
     void _handleStreamError(const QString& uri);
     void _load(DataSourceSharedPtr source, const TileUpdateList& tileList);
+    std::map<deflect::View, ImagePtr> _loadCoarse(
+        const DataSource& source, const TileUpdateList& tileList);
     void _handleFinished();
 };
 
@@ -41,13 +41,44 @@
 
 #include "DataProvider.h"
 #include "WallConfiguration.h"
+#include "metrics/MetricsRegistry.h"
 #include "network/WallToWallChannel.h"
 #include "qml/WallWindow.h"
 #include "scene/CountdownStatus.h"
 #include "scene/Options.h"
 #include "scene/Scene.h"
 #include "scene/ScreenLock.h"
+#include "scene/WhiteboardContent.h"
 #include "swapsync/SwapSynchronizer.h"
+#include "tools/MemoryBudget.h"
+
+#include <chrono>
+#include <set>
+
+namespace
+{
+MetricHistogram& _frameTimeHistogram()
+{
+    static auto& histogram = MetricsRegistry::instance().histogram(
+        "tide_wall_frame_time_seconds",
+        "Time to synchronize and render one frame on a wall process");
+    return histogram;
+}
+
+MetricCounter& _missedDeadlinesCounter()
+{
+    static auto& counter = MetricsRegistry::instance().counter(
+        "tide_wall_frame_deadline_missed_total",
+        "Frames which took longer than the target frame period");
+    return counter;
+}
+
+double _secondsSince(const std::chrono::steady_clock::time_point start)
+{
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double>(elapsed).count();
+}
+}
 
 RenderController::RenderController(const WallConfiguration& config,
                                    DataProvider& provider,
@@ -57,11 +88,16 @@ RenderController::RenderController(const WallConfiguration& config,
     : _windows{WallWindow::createWindows(config, provider)}
     , _provider{provider}
     , _wallChannel{wallChannel}
+    , _framePacer{config.targetFrameRate}
 {
     _connectSwapSyncObjects();
     _connectRedrawSignal();
     _connectScreenshotSignals();
     _setupSwapSynchronization(swapSyncBarrier, type);
+    MetricsRegistry::instance()
+        .gauge("tide_wall_target_frame_rate",
+               "Target frame rate of the wall processes")
+        .set(config.targetFrameRate);
     updateScene(Scene::create(config.surfaces));
 }
 
@@ -70,6 +106,11 @@ RenderController::~RenderController() = default;
 void RenderController::updateScene(ScenePtr scene)
 {
     _syncScene.update(scene);
+
+    // The scene already contains the stroke points received before it
+    _pendingWhiteboardStrokes.reset();
+    _syncWhiteboardStrokes.update(_pendingWhiteboardStrokes);
+
     _requestRender();
 }
 
@@ -79,6 +120,19 @@ void RenderController::updateMarkers(MarkersPtr markers)
     _requestRender();
 }
 
+void RenderController::updateWhiteboard(WhiteboardStrokeUpdatePtr update)
+{
+    // Accumulate the updates until they are synchronized
+    if (!_pendingWhiteboardStrokes ||
+        _pendingWhiteboardStrokes == _syncWhiteboardStrokes.get())
+    {
+        _pendingWhiteboardStrokes = std::make_shared<WhiteboardStrokeUpdates>();
+    }
+    _pendingWhiteboardStrokes->push_back(std::move(update));
+    _syncWhiteboardStrokes.update(_pendingWhiteboardStrokes);
+    _requestRender();
+}
+
 void RenderController::updateOptions(OptionsPtr options)
 {
     _syncOptions.update(options);
@@ -112,7 +166,11 @@ void RenderController::updateQuit()
 void RenderController::timerEvent(QTimerEvent* qtEvent)
 {
     if (qtEvent->timerId() == _renderTimer)
+    {
+        killTimer(_renderTimer);
+        _renderTimer = 0;
         _syncAndRender();
+    }
     else if (qtEvent->timerId() == _idleRedrawTimer)
         _requestRender();
     else if (qtEvent->timerId() == _stopRenderingDelayTimer)
@@ -126,6 +184,11 @@ void RenderController::_connectSwapSyncObjects()
         for (auto&& window : _windows)
             window->setSurface(scene->getSurfacePtr(window->getSurfaceIndex()));
     });
+    _syncWhiteboardStrokes.setCallback(
+        [this](WhiteboardStrokeUpdatesPtr updates) {
+            if (updates)
+                _updateWhiteboards(*updates);
+        });
     _syncMarkers.setCallback([this](MarkersPtr markers) {
         for (auto&& window : _windows)
             window->setMarkers(markers);
@@ -180,12 +243,25 @@ void RenderController::_requestRender()
     _stopRenderingDelayTimer = 0;
     _idleRedrawTimer = 0;
 
-    if (_renderTimer == 0)
-        _renderTimer = startTimer(5, Qt::PreciseTimer);
+    _startRenderTimer();
+}
+
+void RenderController::_startRenderTimer()
+{
+    if (_renderTimer != 0)
+        return;
+
+    const auto now = FramePacer::clock::now();
+    const auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(
+        _framePacer.getDelayToNextFrame(now));
+    _renderTimer = startTimer(delay.count(), Qt::PreciseTimer);
 }
 
 void RenderController::_syncAndRender()
 {
+    const auto start = FramePacer::clock::now();
+    _framePacer.startFrame(start);
+
     _synchronizeSceneUpdates();
     if (_syncQuit.get())
     {
@@ -194,8 +270,13 @@ void RenderController::_syncAndRender()
     }
 
     _synchronizeDataSourceUpdates();
+    _enforceMemoryBudget();
     _renderAllWindows();
     _scheduleRedraw();
+
+    _frameTimeHistogram().observe(_secondsSince(start));
+    if (!_framePacer.endFrame(FramePacer::clock::now()))
+        _missedDeadlinesCounter().increment();
 }
 
 void RenderController::_renderAllWindows()
@@ -217,8 +298,12 @@ void RenderController::_scheduleRedraw()
     for (const auto& window : _windows)
         _redrawNeeded = _redrawNeeded || window->needRedraw();
 
+    // Keep rendering at the target frame rate until rendering stops
     if (_wallChannel.allReady(!_redrawNeeded))
+    {
         _scheduleStopRendering();
+        _startRenderTimer();
+    }
     else
         _requestRender();
 
@@ -249,6 +334,7 @@ void RenderController::_synchronizeSceneUpdates()
                                       &_wallChannel, std::placeholders::_1);
 
     _syncScene.sync(versionCheckFunc);
+    _syncWhiteboardStrokes.sync(versionCheckFunc);
     _syncMarkers.sync(versionCheckFunc);
     _syncOptions.sync(versionCheckFunc);
     _syncLock.sync(versionCheckFunc);
@@ -264,6 +350,60 @@ void RenderController::_synchronizeDataSourceUpdates()
     _provider.synchronizeTilesUpdate(_wallChannel);
 }
 
+void RenderController::_updateWhiteboards(
+    const WhiteboardStrokeUpdates& updates)
+{
+    std::set<QUuid> updatedWhiteboards;
+    for (const auto& update : updates)
+    {
+        if (_provider.updateWhiteboard(*update))
+            updatedWhiteboards.insert(update->whiteboardId);
+    }
+
+    const auto scene = _syncScene.get();
+    if (updatedWhiteboards.empty() || !scene)
+        return;
+
+    for (auto&& wallWindow : _windows)
+    {
+        const auto& surface = scene->getSurface(wallWindow->getSurfaceIndex());
+        WindowPtrs windows;
+        for (const auto& window : surface.getGroup().getWindows())
+        {
+            if (updatedWhiteboards.count(window->getContent().getId()))
+                windows.push_back(window);
+        }
+        if (!windows.empty())
+            wallWindow->updateWindows(windows);
+    }
+}
+
+void RenderController::_enforceMemoryBudget()
+{
+    // The limit is either zero or not on all processes, which must take part
+    // in allReady() together.
+    auto& budget = MemoryBudget::instance();
+    if (budget.getLimit() == 0)
+        return;
+
+    // Degrade the contents on all processes together so that screens match
+    const auto overLimit = budget.enforce();
+    const auto constrained = !_wallChannel.allReady(!overLimit);
+    if (constrained == budget.isConstrained())
+        return;
+
+    print_log(LOG_INFO, LOG_GENERAL, "%s contents to fit the memory budget",
+              constrained ? "degrading" : "restoring");
+    budget.setConstrained(constrained);
+
+    // Update the windows to select the new level of detail
+    if (auto scene = _syncScene.get())
+    {
+        for (auto&& window : _windows)
+            window->setSurface(scene->getSurfacePtr(window->getSurfaceIndex()));
+    }
+}
+
 void RenderController::_terminateRendering()
 {
     killTimer(_renderTimer);
@@ -42,11 +42,14 @@
 
 #include "types.h"
 
+#include "tools/FramePacer.h"
 #include "tools/SwapSyncObject.h"
 
 #include <QImage>
 #include <QObject>
 
+#include <vector>
+
 /**
  * Setup the scene and control the rendering options during runtime.
  */
@@ -65,6 +68,7 @@ public slots:
     void requestRender() { _requestRender(); }
     void updateScene(ScenePtr scene);
     void updateMarkers(MarkersPtr markers);
+    void updateWhiteboard(WhiteboardStrokeUpdatePtr update);
     void updateOptions(OptionsPtr options);
     void updateLock(ScreenLockPtr lock);
     void updateCountdownStatus(CountdownStatusPtr status);
@@ -81,6 +85,10 @@ private:
     std::unique_ptr<SwapSynchronizer> _swapSynchronizer;
 
     SwapSyncObject<ScenePtr> _syncScene;
+    using WhiteboardStrokeUpdates = std::vector<WhiteboardStrokeUpdatePtr>;
+    using WhiteboardStrokeUpdatesPtr = std::shared_ptr<WhiteboardStrokeUpdates>;
+    SwapSyncObject<WhiteboardStrokeUpdatesPtr> _syncWhiteboardStrokes;
+    WhiteboardStrokeUpdatesPtr _pendingWhiteboardStrokes;
     SwapSyncObject<MarkersPtr> _syncMarkers;
     SwapSyncObject<OptionsPtr> _syncOptions;
     SwapSyncObject<ScreenLockPtr> _syncLock;
@@ -88,6 +96,7 @@ private:
     SwapSyncObject<bool> _syncScreenshot{false};
     SwapSyncObject<bool> _syncQuit{false};
 
+    FramePacer _framePacer;
     int _renderTimer = 0;
     int _stopRenderingDelayTimer = 0;
     int _idleRedrawTimer = 0;
@@ -104,6 +113,7 @@ private:
 
     /** Synchronization and rendering. */
     void _requestRender();
+    void _startRenderTimer();
     void _syncAndRender();
     void _renderAllWindows();
     void _scheduleRedraw();
@@ -111,6 +121,8 @@ private:
     void _stopRendering();
     void _synchronizeSceneUpdates();
     void _synchronizeDataSourceUpdates();
+    void _updateWhiteboards(const WhiteboardStrokeUpdates& updates);
+    void _enforceMemoryBudget();
 
     /** Shutdown. */
     void _terminateRendering();
@@ -43,22 +43,45 @@
 #include "QmlTypeRegistration.h"
 #include "RenderController.h"
 #include "WallConfiguration.h"
+#include "config.h"
+#include "datasources/CachedDataSource.h"
+#include "datasources/PixelStreamUpdater.h"
 #include "network/MPICommunicator.h"
 #include "network/WallFromMasterChannel.h"
 #include "network/WallToMasterChannel.h"
 #include "network/WallToWallChannel.h"
+#include "qml/WallWindow.h"
 #include "scene/VectorialContent.h"
+#include "tools/DocumentPool.h"
+#include "tools/MemoryBudget.h"
+#include "tools/SharedTileCache.h"
+
+#if TIDE_ENABLE_PDF_SUPPORT
+#include "datasources/PDFTiler.h"
+#endif
+#if TIDE_USE_TIFF
+#include "datasources/ImagePyramidDataSource.h"
+#endif
 
 #include <QThreadPool>
 
+namespace
+{
+const int METRICS_REPORT_INTERVAL_MS = 1000;
+}
+
 WallApplication::WallApplication(int& argc_, char** argv_,
                                  MPICommunicator& masterRecvComm,
+                                 MPICommunicator& masterPayloadComm,
+                                 MPICommunicator& masterHostComm,
                                  MPICommunicator& masterSendComm,
                                  MPICommunicator& wallToWallComm,
                                  NetworkBarrier& swapSyncBarrier)
     : QGuiApplication{argc_, argv_}
     , _provider{new DataProvider}
-    , _fromMasterChannel{new WallFromMasterChannel(masterRecvComm)}
+    , _fromMasterChannel{new WallFromMasterChannel(masterRecvComm,
+                                                   masterPayloadComm,
+                                                   masterHostComm)}
     , _toMasterChannel{new WallToMasterChannel(masterSendComm)}
     , _wallChannel{new WallToWallChannel{wallToWallComm}}
 {
@@ -70,12 +93,30 @@ WallApplication::WallApplication(int& argc_, char** argv_,
 
     Content::setMaxScale(config.settings.contentMaxScale);
     VectorialContent::setMaxScale(config.settings.contentMaxScaleVectorial);
+    PixelStreamUpdater::setDropLateFrames(config.settings.streamDropLateFrames);
+    DocumentPoolBase::setMaxInstances(config.settings.documentPoolSize);
+    CachedDataSource::setProgressiveRendering(
+        config.settings.progressiveRendering);
+    WallWindow::setSkipUnchangedFrames(config.settings.skipUnchangedScreens);
+    WallWindow::setMaxTileUploadsPerFrame(
+        config.settings.maxTileUploadsPerFrame);
+#if TIDE_ENABLE_PDF_SUPPORT
+    PDFTiler::setRenderAheadPageCount(config.settings.pdfRenderAheadPages);
+#endif
+#if TIDE_USE_TIFF
+    const auto& settings = config.settings;
+    ImagePyramidDataSource::setDecodeToYUV(settings.imagePyramidYUVTiles);
+    ImagePyramidDataSource::setImageTilingThreshold(
+        settings.imageTilingThreshold);
+#endif
 
     // avoid overcommit for async content loading; consider number of processes
     // on the same machine
     const auto prCount = _config->processCountForHost;
+    SharedTileCache::setEnabled(config.settings.sharedTileCache && prCount > 1);
     const auto maxThreads = std::max(QThread::idealThreadCount() / prCount, 2);
     QThreadPool::globalInstance()->setMaxThreadCount(maxThreads);
+    MemoryBudget::instance().setLimit(_config->memoryBudget);
 
     _renderController =
         std::make_unique<RenderController>(*_config, *_provider, *_wallChannel,
@@ -121,6 +162,11 @@ void WallApplication::_initMPIConnections()
     connect(_fromMasterChannel.get(), SIGNAL(received(MarkersPtr)),
             _renderController.get(), SLOT(updateMarkers(MarkersPtr)));
 
+    connect(_fromMasterChannel.get(),
+            SIGNAL(received(WhiteboardStrokeUpdatePtr)),
+            _renderController.get(),
+            SLOT(updateWhiteboard(WhiteboardStrokeUpdatePtr)));
+
     connect(_fromMasterChannel.get(),
             SIGNAL(received(deflect::server::FramePtr)),
             _renderController.get(), SLOT(requestRender()));
@@ -136,29 +182,35 @@ void WallApplication::_initMPIConnections()
     {
         connect(_provider.get(), &DataProvider::requestPixelStreamFrame,
                 _toMasterChannel.get(), &WallToMasterChannel::sendRequestFrame);
+        connect(_provider.get(), &DataProvider::pixelStreamFramesConsumed,
+                _toMasterChannel.get(), &WallToMasterChannel::sendFrameCredits);
         connect(_provider.get(), &DataProvider::closePixelStream,
                 _toMasterChannel.get(),
                 &WallToMasterChannel::sendPixelStreamClose);
     }
 
+    connect(&_metricsTimer, &QTimer::timeout, _toMasterChannel.get(),
+            &WallToMasterChannel::sendMetrics);
+
     connect(&_mpiReceiveThread, &QThread::started, _fromMasterChannel.get(),
             &WallFromMasterChannel::processMessages);
 
     _mpiReceiveThread.start();
     _mpiSendThread.start();
+    _metricsTimer.start(METRICS_REPORT_INTERVAL_MS);
 }
 
 void WallApplication::_terminateMPIConnections()
 {
-    if (_wallChannel->getRank() == 0)
-    {
-        // Make sure the send quit happens after any pending sendRequestFrame.
-        // The MasterFromWallChannel is waiting for this signal to exit.
-        // This step ensures that the queue of messages is flushed and the MPI
-        // connection will not block when closing itself.
-        QMetaObject::invokeMethod(_toMasterChannel.get(), "sendQuit",
-                                  Qt::BlockingQueuedConnection);
-    }
+    _metricsTimer.stop();
+
+    // Make sure the send quit happens after any pending message (frame
+    // requests, metrics). The MasterFromWallChannel is waiting for this signal
+    // from every wall process to exit. This step ensures that the queue of
+    // messages is flushed and the MPI connection will not block when closing
+    // itself.
+    QMetaObject::invokeMethod(_toMasterChannel.get(), "sendQuit",
+                              Qt::BlockingQueuedConnection);
 
     _mpiReceiveThread.quit();
     _mpiReceiveThread.wait();
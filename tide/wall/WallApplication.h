@@ -44,6 +44,7 @@
 
 #include <QGuiApplication>
 #include <QThread>
+#include <QTimer>
 
 class RenderController;
 class WallFromMasterChannel;
@@ -66,12 +67,18 @@ public:
      * @param argc Command line argument count (required by QApplication)
      * @param argv Command line arguments (required by QApplication)
      * @param masterRecvComm The communicator to receive from master process
+     * @param masterPayloadComm The communicator to receive the payload of
+     *        broadcast messages from the master process (host leaders only)
+     * @param masterHostComm The communicator to share the payload of broadcast
+     *        messages with the wall processes on the same host
      * @param masterSendComm The communicator to send messages to master process
      * @param wallToWallComm The communicator for scene synchronization
      * @param swapSyncBarrier The network barrier for frame swap synchronization
      * @throw std::runtime_error if an error occured during initialization
      */
     WallApplication(int& argc, char** argv, MPICommunicator& masterRecvComm,
+                    MPICommunicator& masterPayloadComm,
+                    MPICommunicator& masterHostComm,
                     MPICommunicator& masterSendComm,
                     MPICommunicator& wallToWallComm,
                     NetworkBarrier& swapSyncBarrier);
@@ -90,6 +97,7 @@ private:
 
     QThread _mpiSendThread;
     QThread _mpiReceiveThread;
+    QTimer _metricsTimer;
 
     void _initMPIConnections();
     void _terminateMPIConnections();
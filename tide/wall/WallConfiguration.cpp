@@ -39,6 +39,7 @@
 
 #include "WallConfiguration.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 namespace
@@ -58,10 +59,15 @@ WallConfiguration::WallConfiguration(const Configuration& config,
     : Process(getProcess(config, processIndex_))
     , processIndex{processIndex_}
     , surfaces{config.surfaces}
+    , targetFrameRate{config.settings.targetFrameRate}
 {
     processCountForHost =
         std::count_if(config.processes.begin(), config.processes.end(),
                       [& host = host](const auto& p) {
                           return p.host == host;
                       });
+
+    // The budget of the host is shared equally by its wall processes
+    const auto hostBudget = size_t(config.settings.wallMemoryBudget) << 20;
+    memoryBudget = hostBudget / std::max(processCountForHost, 1);
 }
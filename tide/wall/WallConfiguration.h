@@ -63,6 +63,12 @@ struct WallConfiguration : public Process
 
     /** The number of wall processes running on the same host. */
     int processCountForHost = 0;
+
+    /** The target frame rate of the wall processes. */
+    uint targetFrameRate = 60;
+
+    /** The memory budget of the process in bytes (0: no limit). */
+    size_t memoryBudget = 0;
 };
 
 #endif
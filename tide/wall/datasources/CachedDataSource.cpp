@@ -40,6 +40,52 @@
 #include "CachedDataSource.h"
 
 #include "data/QtImage.h"
+#include "metrics/MetricsRegistry.h"
+#include "tools/SharedTileCache.h"
+
+#include <algorithm>
+
+namespace
+{
+MetricCounter& _cacheHits()
+{
+    static auto& counter = MetricsRegistry::instance().counter(
+        "tide_tile_cache_hits_total",
+        "Tiles served from the cache of a static content");
+    return counter;
+}
+
+MetricCounter& _cacheMisses()
+{
+    static auto& counter = MetricsRegistry::instance().counter(
+        "tide_tile_cache_misses_total",
+        "Tiles missing from the cache of a static content");
+    return counter;
+}
+
+MetricCounter& _evictedTiles()
+{
+    static auto& counter = MetricsRegistry::instance().counter(
+        "tide_tile_cache_evictions_total",
+        "Tiles evicted from the cache of a static content to save memory");
+    return counter;
+}
+
+MetricCounter& _coarseTiles()
+{
+    static auto& counter = MetricsRegistry::instance().counter(
+        "tide_tile_coarse_total",
+        "Coarse tiles shown while rendering a vector content at full quality");
+    return counter;
+}
+}
+
+std::atomic_bool CachedDataSource::_progressiveRendering{true};
+
+void CachedDataSource::setProgressiveRendering(const bool enabled)
+{
+    _progressiveRendering = enabled;
+}
 
 ImagePtr CachedDataSource::getTileImage(const uint tileId,
                                         const deflect::View view) const
@@ -47,28 +93,120 @@ ImagePtr CachedDataSource::getTileImage(const uint tileId,
     auto& cache = _getCache(view);
     {
         const QMutexLocker lock(&_mutex);
-        if (cache.contains(tileId))
-            return std::make_shared<QtImage>(cache[tileId]);
+        const auto it = cache.find(tileId);
+        if (it != cache.end())
+        {
+            _cacheHits().increment();
+            it->lastUse = ++_lastUse;
+            return it->image;
+        }
     }
+    _cacheMisses().increment();
 
-    const auto image =
-        QtImage::toGlCompatibleFormat(getCachableTileImage(tileId, view));
-    if (image.isNull())
-        throw std::logic_error("Cachable tile images should not be null");
+    auto image = _getSharedTile(tileId, view);
+    {
+        const QMutexLocker lock(&_mutex);
+        auto& entry = cache[tileId];
+        const auto previous =
+            entry.image ? MemoryBudget::getByteCount(*entry.image) : 0;
+        _memory.add(int64_t(MemoryBudget::getByteCount(*image)) -
+                    int64_t(previous));
+        entry = CacheEntry{image, ++_lastUse};
+    }
+    return image;
+}
 
+ImagePtr CachedDataSource::getCoarseTileImage(const uint tileId,
+                                              const deflect::View view) const
+{
+    if (!_progressiveRendering)
+        return ImagePtr();
     {
         const QMutexLocker lock(&_mutex);
-        cache.insert(tileId, image);
+        if (_getCache(view).contains(tileId))
+            return ImagePtr();
     }
+
+    const auto image =
+        QtImage::toGlCompatibleFormat(getCoarseTileImageData(tileId, view));
+    if (image.isNull())
+        return ImagePtr();
+
+    _coarseTiles().increment();
+    return std::make_shared<QtImage>(image);
+}
+
+ImagePtr CachedDataSource::getCachableTile(const uint tileId,
+                                           const deflect::View view) const
+{
+    const auto image =
+        QtImage::toGlCompatibleFormat(getCachableTileImage(tileId, view));
+    if (image.isNull())
+        throw std::logic_error("Cachable tile images should not be null");
     return std::make_shared<QtImage>(image);
 }
 
+ImagePtr CachedDataSource::_getSharedTile(const uint tileId,
+                                          const deflect::View view) const
+{
+    if (!SharedTileCache::isEnabled())
+        return getCachableTile(tileId, view);
+
+    const auto sharedView = isStereo() ? view : deflect::View::mono;
+    const auto key = SharedTileCache::makeKey(getUri(), getTilesArea(0, 0),
+                                              tileId, sharedView);
+    return SharedTileCache::getTile(key, [this, tileId, view] {
+        return getCachableTile(tileId, view);
+    });
+}
+
 bool CachedDataSource::contains(const uint tileId) const
 {
     const QMutexLocker lock(&_mutex);
     return _cacheLeftOrMono.contains(tileId);
 }
 
+size_t CachedDataSource::_evictUnusedTiles(const size_t bytes)
+{
+    struct Candidate
+    {
+        uint64_t lastUse;
+        Cache* cache;
+        uint tileId;
+    };
+
+    const QMutexLocker lock(&_mutex);
+
+    // Tiles which are only referenced by the cache are not displayed anymore
+    std::vector<Candidate> candidates;
+    for (auto cache : {&_cacheLeftOrMono, &_cacheRight})
+    {
+        for (auto it = cache->begin(); it != cache->end(); ++it)
+        {
+            if (it->image.use_count() == 1)
+                candidates.push_back({it->lastUse, cache, it.key()});
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate& a, const Candidate& b) {
+                  return a.lastUse < b.lastUse;
+              });
+
+    auto evicted = size_t{0};
+    auto count = 0u;
+    for (const auto& candidate : candidates)
+    {
+        if (evicted >= bytes)
+            break;
+        evicted += MemoryBudget::getByteCount(
+            *candidate.cache->take(candidate.tileId).image);
+        ++count;
+    }
+    _memory.add(-int64_t(evicted));
+    _evictedTiles().increment(count);
+    return evicted;
+}
+
 CachedDataSource::Cache& CachedDataSource::_getCache(
     const deflect::View view) const
 {
@@ -42,12 +42,19 @@
 
 #include "DataSource.h"
 
+#include "tools/MemoryBudget.h"
+
 #include <QImage>
 #include <QMap>
 #include <QMutex>
 
+#include <atomic>
+
 /**
  * A data source which maintains a cache of the requested tiles.
+ *
+ * The cache is accounted in the MemoryBudget, which can evict the least
+ * recently used tiles that are not displayed anymore.
  */
 class CachedDataSource : public DataSource
 {
@@ -55,10 +62,38 @@ public:
     /** @copydoc DataSource::getTileImage threadsafe */
     ImagePtr getTileImage(uint tileId, deflect::View view) const override;
 
+    /** @copydoc DataSource::getCoarseTileImage threadsafe */
+    ImagePtr getCoarseTileImage(uint tileId, deflect::View view) const final;
+
+    /** Enable coarse tiles for the sources which support them (default: on) */
+    static void setProgressiveRendering(bool enabled);
+
 protected:
+    /** The resolution of the coarse tiles is reduced by this factor. */
+    static constexpr int coarseTileDownscale = 4;
+
+    /**
+     * Render a coarse version of a tile which will not be cached, threadsafe.
+     * @return the image, or a null QImage if the source has no coarse tiles.
+     */
+    virtual QImage getCoarseTileImageData(uint tileId, deflect::View view) const
+    {
+        Q_UNUSED(tileId);
+        Q_UNUSED(view);
+        return QImage();
+    }
+
     /** Check if the cache contains an image (used for SVGGpuImage only). */
     bool contains(const uint tileId) const;
 
+    /**
+     * Get a tile which will be cached, threadsafe.
+     *
+     * The default implementation wraps the result of getCachableTileImage(),
+     * data sources can override it to provide images in other formats (YUV).
+     */
+    virtual ImagePtr getCachableTile(uint tileId, deflect::View view) const;
+
 private:
     /** Get a tile image which will be cached. threadsafe */
     virtual QImage getCachableTileImage(uint tileId,
@@ -67,12 +102,29 @@ private:
     /** @return true is the source is stereo. */
     virtual bool isStereo() const = 0;
 
+    struct CacheEntry
+    {
+        ImagePtr image;
+        uint64_t lastUse = 0;
+    };
+
     mutable QMutex _mutex;
-    using Cache = QMap<uint, QImage>;
+    using Cache = QMap<uint, CacheEntry>;
     mutable Cache _cacheLeftOrMono;
     mutable Cache _cacheRight;
+    mutable uint64_t _lastUse = 0;
+
+    mutable MemoryBudget::Account _memory{MemoryCategory::tiles};
+    MemoryBudget::Reclaimer _reclaimer{MemoryCategory::tiles,
+                                       [this](const size_t bytes) {
+                                           return _evictUnusedTiles(bytes);
+                                       }};
 
     Cache& _getCache(deflect::View view) const;
+    ImagePtr _getSharedTile(uint tileId, deflect::View view) const;
+    size_t _evictUnusedTiles(size_t bytes);
+
+    static std::atomic_bool _progressiveRendering;
 };
 
 #endif
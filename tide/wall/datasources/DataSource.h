@@ -65,12 +65,25 @@ public:
     /**
      * Get a tile image by its id for a given view.
      * Called asynchronously but not concurrently. threadsafe.
-     * Implementations should throw if an error occured, not return nullptr
-     * which is reserved for future use.
+     * Implementations should throw if an error occured. Only dynamic sources
+     * may return nullptr when a tile has no new image, to keep the current one.
      * @throw std::exception on error.
      */
     virtual ImagePtr getTileImage(uint tileId, deflect::View view) const = 0;
 
+    /**
+     * Get a fast, low quality version of a tile which is not available yet.
+     * Called before getTileImage() so that the coarse image can be shown while
+     * the full quality one is being rendered. threadsafe.
+     * @return the coarse image, or nullptr if the source does not provide one.
+     */
+    virtual ImagePtr getCoarseTileImage(uint tileId, deflect::View view) const
+    {
+        Q_UNUSED(tileId);
+        Q_UNUSED(view);
+        return ImagePtr();
+    }
+
     /** @return the coordinates of a tile. */
     virtual QRect getTileRect(uint tileId) const = 0;
 
@@ -84,6 +97,13 @@ public:
     /** @return the max LOD level (top of pyramid, lowest resolution). */
     virtual uint getMaxLod() const = 0;
 
+    /**
+     * @return the highest resolution LOD for which tiles can be requested now.
+     * Sources that prepare their data in the background return a higher LOD
+     * until they are ready. threadsafe.
+     */
+    virtual uint getAvailableLod() const { return 0; }
+
     /** @return the index of the tile to use for a preview. */
     virtual uint getPreviewTileId() const { return 0; }
     /** Allow advancing to the next frame (synchronization / flow control). */
@@ -45,6 +45,7 @@
 #include "datasources/ImageSource.h"
 #include "datasources/PixelStreamUpdater.h"
 #include "datasources/SVGTiler.h"
+#include "datasources/WhiteboardSource.h"
 
 #if TIDE_ENABLE_MOVIE_SUPPORT
 #include "datasources/MovieUpdater.h"
@@ -76,7 +77,19 @@ std::unique_ptr<DataSource> DataSourceFactory::create(const Content& content)
         return std::make_unique<SVGTiler>(content.getUri(),
                                           content.getMaxDimensions());
     case ContentType::image:
+#if TIDE_USE_TIFF
+    {
+        // Large images are converted to pyramids on first use
+        const auto& uri = content.getUri();
+        std::unique_ptr<DataSource> source =
+            ImagePyramidDataSource::createForImage(uri);
+        if (source)
+            return source;
+        return std::make_unique<ImageSource>(uri);
+    }
+#else
         return std::make_unique<ImageSource>(content.getUri());
+#endif
 
 #if TIDE_ENABLE_PDF_SUPPORT
     case ContentType::pdf:
@@ -88,6 +101,8 @@ std::unique_ptr<DataSource> DataSourceFactory::create(const Content& content)
     case ContentType::image_pyramid:
         return std::make_unique<ImagePyramidDataSource>(content.getUri());
 #endif
+    case ContentType::whiteboard:
+        return std::make_unique<WhiteboardSource>(content.getUri());
     default:
         throw std::logic_error("No data source for this content type");
     }
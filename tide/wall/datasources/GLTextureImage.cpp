@@ -0,0 +1,91 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "GLTextureImage.h"
+
+#include "data/GLTexture.h"
+
+#include <QOpenGLFunctions>
+
+GLTextureImage::GLTextureImage(GLTexturePtr texture)
+    : _texture{std::move(texture)}
+{
+}
+
+int GLTextureImage::getWidth() const
+{
+    return _texture->getSize().width();
+}
+
+int GLTextureImage::getHeight() const
+{
+    return _texture->getSize().height();
+}
+
+const uint8_t* GLTextureImage::getData(const uint texture) const
+{
+    Q_UNUSED(texture);
+    return nullptr;
+}
+
+size_t GLTextureImage::getDataSize(const uint texture) const
+{
+    Q_UNUSED(texture);
+    return 0;
+}
+
+deflect::RowOrder GLTextureImage::getRowOrder() const
+{
+    // Framebuffer textures have their origin at the bottom-left
+    return deflect::RowOrder::bottom_up;
+}
+
+TextureFormat GLTextureImage::getFormat() const
+{
+    return TextureFormat::rgba;
+}
+
+uint GLTextureImage::getGLPixelFormat() const
+{
+    return GL_RGBA;
+}
+
+GLTexturePtr GLTextureImage::getGLTexture() const
+{
+    return _texture;
+}
@@ -0,0 +1,84 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef GLTEXTUREIMAGE_H
+#define GLTEXTUREIMAGE_H
+
+#include "data/Image.h"
+
+/**
+ * Image of a tile rendered into a GPU texture.
+ *
+ * The image has no data in core memory, it is displayed directly from the
+ * texture which must be shared with the render contexts.
+ */
+class GLTextureImage : public Image
+{
+public:
+    /** Constructor. */
+    explicit GLTextureImage(GLTexturePtr texture);
+
+    /** @copydoc Image::getWidth */
+    int getWidth() const final;
+
+    /** @copydoc Image::getHeight */
+    int getHeight() const final;
+
+    /** @copydoc Image::getData @return nullptr */
+    const uint8_t* getData(uint texture = 0) const final;
+
+    /** @copydoc Image::getDataSize @return 0 */
+    size_t getDataSize(uint texture = 0) const final;
+
+    /** @copydoc Image::getRowOrder */
+    deflect::RowOrder getRowOrder() const final;
+
+    /** @copydoc Image::getFormat */
+    TextureFormat getFormat() const final;
+
+    /** @copydoc Image::getGLPixelFormat */
+    uint getGLPixelFormat() const final;
+
+    /** @copydoc Image::getGLTexture */
+    GLTexturePtr getGLTexture() const final;
+
+private:
+    GLTexturePtr _texture;
+};
+
+#endif
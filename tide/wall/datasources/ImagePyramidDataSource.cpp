@@ -39,14 +39,27 @@
 
 #include "ImagePyramidDataSource.h"
 
+#include "JpegTileImage.h"
+
+#include "data/ImageReader.h"
 #include "data/TiffPyramidReader.h"
+#include "tools/ImagePyramidCache.h"
 #include "tools/LodTools.h"
 #include "utils/log.h"
 
+#include <QFileInfo>
+#include <QImageReader>
+
 namespace
 {
 const QSize previewSize{1920, 1920};
 
+// Below ImagePyramidCache::minUnusedSeconds to protect displayed pyramids
+const qint64 markUsedIntervalMs = 10 * 60 * 1000;
+
+// Images larger than this can't be opened by ContentFactory without tiling
+const uint maxTextureSize = 16384;
+
 uint _getTileSize(const TiffPyramidReader& tif)
 {
     const auto tileSize = tif.getTileSize();
@@ -56,8 +69,12 @@ uint _getTileSize(const TiffPyramidReader& tif)
 }
 }
 
+bool ImagePyramidDataSource::_decodeToYUV = true;
+uint ImagePyramidDataSource::_imageTilingThreshold = 8192;
+
 ImagePyramidDataSource::ImagePyramidDataSource(const QString& uri)
     : _uri{uri}
+    , _pyramidFile{uri}
 {
     try
     {
@@ -75,8 +92,55 @@ ImagePyramidDataSource::ImagePyramidDataSource(const QString& uri)
     }
 }
 
+ImagePyramidDataSource::ImagePyramidDataSource(const QString& uri,
+                                               const QSize& imageSize)
+    : _uri{uri}
+    , _lodTool{std::make_unique<LodTools>(imageSize,
+                                          ImagePyramidCache::tileSize)}
+{
+    // Same level as TiffPyramidReader::findLevel(previewSize) once generated
+    while (_previewLod < _lodTool->getMaxLod() &&
+           QSizeF(_lodTool->getTilesArea(_previewLod)) > QSizeF(previewSize))
+    {
+        ++_previewLod;
+    }
+    _previewImageSize = _lodTool->getTilesArea(_previewLod);
+
+    const auto cache = ImagePyramidCache();
+    const auto path = cache.getPyramidPath(uri);
+    if (QFileInfo::exists(path))
+    {
+        _pyramidFile = path;
+        return;
+    }
+
+    connect(&_pyramidWatcher, &QFutureWatcher<QString>::finished, this,
+            &ImagePyramidDataSource::pyramidReady);
+    _pyramid = cache.generatePyramid(uri);
+    _pyramidWatcher.setFuture(_pyramid);
+}
+
 ImagePyramidDataSource::~ImagePyramidDataSource() = default;
 
+std::unique_ptr<ImagePyramidDataSource> ImagePyramidDataSource::createForImage(
+    const QString& uri)
+{
+    const auto reader = ImageReader{uri};
+    const auto size = reader.getSize();
+    if (!reader.isValid() || reader.isStereo() ||
+        std::max(size.width(), size.height()) <= int(_imageTilingThreshold))
+    {
+        return nullptr;
+    }
+    return std::unique_ptr<ImagePyramidDataSource>(
+        new ImagePyramidDataSource(uri, size));
+}
+
+void ImagePyramidDataSource::setImageTilingThreshold(const uint size)
+{
+    _imageTilingThreshold = std::min(size, maxTextureSize);
+}
+
 QString ImagePyramidDataSource::getUri() const
 {
     return _uri;
@@ -95,6 +159,55 @@ uint ImagePyramidDataSource::getPreviewTileId() const
     return std::numeric_limits<uint>::max();
 }
 
+uint ImagePyramidDataSource::getAvailableLod() const
+{
+    return _getPyramidFile().isEmpty() ? _previewLod : 0;
+}
+
+void ImagePyramidDataSource::setDecodeToYUV(const bool enable)
+{
+    _decodeToYUV = enable;
+}
+
+ImagePtr ImagePyramidDataSource::getCachableTile(const uint tileId,
+                                                 const deflect::View view) const
+{
+    if (!_decodeToYUV || !_valid || tileId == getPreviewTileId() ||
+        !JpegTileImage::isSupported())
+    {
+        return LodTiler::getCachableTile(tileId, view);
+    }
+
+    const auto pyramidFile = _getPyramidFile();
+    if (pyramidFile.isEmpty())
+        return LodTiler::getCachableTile(tileId, view);
+
+    const auto index = _getLodTool().getTileIndex(tileId);
+    auto jpegData = QByteArray();
+    auto tileSize = QSize();
+    {
+        TiffPyramidReader tif{pyramidFile};
+        jpegData = tif.readJpegTile(index.x, index.y, index.lod);
+        tileSize = tif.getTileSize();
+    }
+    if (jpegData.isEmpty()) // not a YCbCr JPEG pyramid
+        return LodTiler::getCachableTile(tileId, view);
+
+    // Render only the valid area of padded tiles
+    const auto viewPort = QRect(QPoint(), getTileRect(tileId).size());
+    try
+    {
+        return std::make_shared<JpegTileImage>(std::move(jpegData), tileSize,
+                                               viewPort);
+    }
+    catch (const std::runtime_error& e)
+    {
+        print_log(LOG_DEBUG, LOG_TIFF, "YUV decoding failed, using RGB: %s",
+                  e.what());
+        return LodTiler::getCachableTile(tileId, view);
+    }
+}
+
 QImage ImagePyramidDataSource::getCachableTileImage(
     const uint tileId, const deflect::View view) const
 {
@@ -103,7 +216,16 @@ QImage ImagePyramidDataSource::getCachableTileImage(
     if (!_valid)
         throw std::runtime_error("TIFF data source is invalid");
 
-    TiffPyramidReader tif{_uri};
+    const auto pyramidFile = _getPyramidFile();
+    if (pyramidFile.isEmpty())
+        return _getDownscaledTile(tileId);
+
+    {
+        const QMutexLocker lock(&_downscaledImageMutex);
+        _downscaledImage = QImage();
+    }
+
+    TiffPyramidReader tif{pyramidFile};
 
     QImage image;
     if (tileId == getPreviewTileId())
@@ -122,3 +244,47 @@ QImage ImagePyramidDataSource::getCachableTileImage(
         image = image.copy(QRect(QPoint(), expectedSize));
     return image;
 }
+
+QString ImagePyramidDataSource::_getPyramidFile() const
+{
+    const QMutexLocker lock(&_pyramidMutex);
+    if (_pyramidFile.isEmpty() && _pyramid.isFinished())
+        _pyramidFile = _pyramid.result(); // empty if the generation failed
+
+    // Protect the generated pyramid from eviction while it is displayed
+    if (!_pyramidFile.isEmpty() && _pyramidFile != _uri &&
+        (!_lastMarkedUsed.isValid() ||
+         _lastMarkedUsed.hasExpired(markUsedIntervalMs)))
+    {
+        ImagePyramidCache::markUsed(_pyramidFile);
+        _lastMarkedUsed.start();
+    }
+    return _pyramidFile;
+}
+
+QImage ImagePyramidDataSource::_getDownscaledTile(const uint tileId) const
+{
+    const QMutexLocker lock(&_downscaledImageMutex);
+    if (_downscaledImage.isNull())
+    {
+        QImageReader reader{_uri};
+        reader.setScaledSize(_previewImageSize);
+        _downscaledImage = reader.read();
+        if (_downscaledImage.isNull())
+            throw std::runtime_error("Error reading image: " +
+                                     reader.errorString().toStdString());
+    }
+    if (tileId == getPreviewTileId())
+        return _downscaledImage;
+
+    const auto lod = _getLodTool().getTileIndex(tileId).lod;
+    if (lod < _previewLod)
+        throw std::logic_error("Tile unavailable until pyramid is generated");
+
+    auto level = _downscaledImage;
+    const auto levelSize = _getLodTool().getTilesArea(lod);
+    if (level.size() != levelSize)
+        level = level.scaled(levelSize, Qt::IgnoreAspectRatio,
+                             Qt::SmoothTransformation);
+    return level.copy(getTileRect(tileId));
+}
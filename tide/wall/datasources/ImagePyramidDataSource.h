@@ -42,15 +42,45 @@
 
 #include "datasources/LodTiler.h"
 
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QImage>
+#include <QMutex>
+#include <QObject>
+
 /**
  * A data source for tiled image pyramids.
+ *
+ * Large regular images can also be displayed as pyramids, which are generated
+ * in the background in the ImagePyramidCache of the host. Until then, only the
+ * levels of the pyramid up to the preview size are available; their tiles are
+ * read from a downscaled version of the image.
  */
-class ImagePyramidDataSource : public LodTiler
+class ImagePyramidDataSource : public QObject, public LodTiler
 {
+    Q_OBJECT
+    Q_DISABLE_COPY(ImagePyramidDataSource)
+
 public:
-    /** Constructor. */
+    /** Open a TIFF image pyramid. */
     explicit ImagePyramidDataSource(const QString& uri);
 
+    /**
+     * Open a large regular image as a pyramid.
+     * @param uri of the image
+     * @return the data source, or nullptr if the image should be displayed as
+     *         a single texture (small or stereo images).
+     */
+    static std::unique_ptr<ImagePyramidDataSource> createForImage(
+        const QString& uri);
+
+    /**
+     * Set the size above which regular images are displayed as pyramids.
+     * @param size in pixels, for the largest dimension of images; values above
+     *        the maximum texture size (16384) are clamped.
+     */
+    static void setImageTilingThreshold(uint size);
+
     /** Destructor. */
     ~ImagePyramidDataSource();
 
@@ -63,7 +93,27 @@ public:
     /** @copydoc DataSource::getPreviewTileId */
     virtual uint getPreviewTileId() const;
 
+    /** @copydoc DataSource::getAvailableLod threadsafe */
+    uint getAvailableLod() const final;
+
+    /**
+     * Decode JPEG tiles to YUV images instead of RGB.
+     *
+     * This skips the color conversion and halves the texture upload size.
+     * @param enable true to use the YUV path when possible (default), false
+     *        to always decode tiles to RGB.
+     */
+    static void setDecodeToYUV(bool enable);
+
+signals:
+    /** Emitted when the pyramid of a regular image has been generated. */
+    void pyramidReady();
+
 private:
+    ImagePyramidDataSource(const QString& uri, const QSize& imageSize);
+
+    /** threadsafe */
+    ImagePtr getCachableTile(uint tileId, deflect::View view) const final;
     /** threadsafe */
     QImage getCachableTileImage(uint tileId, deflect::View view) const final;
     bool isStereo() const final { return false; }
@@ -71,7 +121,26 @@ private:
     const QString _uri;
     std::unique_ptr<LodTools> _lodTool;
     QSize _previewImageSize;
+    uint _previewLod = 0;
     bool _valid = true;
+
+    mutable QMutex _pyramidMutex;
+    mutable QString _pyramidFile;
+    QFuture<QString> _pyramid;
+    QFutureWatcher<QString> _pyramidWatcher;
+    mutable QElapsedTimer _lastMarkedUsed;
+
+    mutable QMutex _downscaledImageMutex;
+    mutable QImage _downscaledImage;
+
+    /** @return the pyramid file, empty until it is generated. threadsafe */
+    QString _getPyramidFile() const;
+
+    /** @return a tile of the downscaled image. threadsafe */
+    QImage _getDownscaledTile(uint tileId) const;
+
+    static bool _decodeToYUV;
+    static uint _imageTilingThreshold;
 };
 
 #endif
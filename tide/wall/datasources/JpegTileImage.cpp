@@ -0,0 +1,122 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "JpegTileImage.h"
+
+#include <deflect/server/TileDecoder.h>
+
+#include <QThreadStorage>
+
+JpegTileImage::JpegTileImage(QByteArray jpegData, const QSize& size,
+                             const QRect& viewPort)
+    : _viewPort{viewPort}
+{
+    _tile.imageData = std::move(jpegData);
+    _tile.width = size.width();
+    _tile.height = size.height();
+    _tile.format = deflect::Format::jpeg;
+
+#ifndef DEFLECT_USE_LEGACY_LIBJPEGTURBO
+    // turbojpeg handles need to be per thread
+    static QThreadStorage<deflect::server::TileDecoder> tileDecoders;
+    tileDecoders.localData().decodeToYUV(_tile);
+#else
+    throw std::runtime_error("Deflect can't decode JPEG images to YUV");
+#endif
+}
+
+bool JpegTileImage::isSupported()
+{
+#ifndef DEFLECT_USE_LEGACY_LIBJPEGTURBO
+    return true;
+#else
+    return false;
+#endif
+}
+
+int JpegTileImage::getWidth() const
+{
+    return _tile.width;
+}
+
+int JpegTileImage::getHeight() const
+{
+    return _tile.height;
+}
+
+QRect JpegTileImage::getViewPort() const
+{
+    return _viewPort;
+}
+
+const uint8_t* JpegTileImage::getData(const uint texture) const
+{
+    const auto data =
+        reinterpret_cast<const uint8_t*>(_tile.imageData.constData());
+    switch (texture)
+    {
+    case 0:
+        return data;
+    case 1:
+        return data + getDataSize(0);
+    case 2:
+        return data + getDataSize(0) + getDataSize(1);
+    default:
+        return nullptr;
+    }
+}
+
+TextureFormat JpegTileImage::getFormat() const
+{
+    switch (_tile.format)
+    {
+    case deflect::Format::yuv444:
+        return TextureFormat::yuv444;
+    case deflect::Format::yuv422:
+        return TextureFormat::yuv422;
+    case deflect::Format::yuv420:
+        return TextureFormat::yuv420;
+    default:
+        throw std::runtime_error("JpegTileImage is not decoded to YUV");
+    }
+}
+
+ColorSpace JpegTileImage::getColorSpace() const
+{
+    return ColorSpace::yCbCrJpeg;
+}
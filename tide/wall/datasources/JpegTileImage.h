@@ -0,0 +1,91 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef JPEGTILEIMAGE_H
+#define JPEGTILEIMAGE_H
+
+#include "data/YUVImage.h"
+
+#include <deflect/server/Tile.h>
+
+/**
+ * YUV image of a JPEG tile, decoded without conversion to RGB.
+ *
+ * Only the view port is rendered, which allows using padded tiles (such as
+ * those of TIFF pyramids) without copying the image planes.
+ */
+class JpegTileImage : public YUVImage
+{
+public:
+    /**
+     * Decode a JPEG image using a per-thread decoder, threadsafe.
+     * @param jpegData the compressed image
+     * @param size the dimensions of the compressed image
+     * @param viewPort the area of the image to display
+     * @throw std::runtime_error if the image could not be decoded
+     */
+    JpegTileImage(QByteArray jpegData, const QSize& size,
+                  const QRect& viewPort);
+
+    /** @return true if JPEG images can be decoded to YUV by this build. */
+    static bool isSupported();
+
+    /** @copydoc Image::getWidth */
+    int getWidth() const final;
+
+    /** @copydoc Image::getHeight */
+    int getHeight() const final;
+
+    /** @copydoc Image::getViewPort */
+    QRect getViewPort() const final;
+
+    /** @copydoc Image::getData */
+    const uint8_t* getData(uint texture) const final;
+
+    /** @copydoc Image::getFormat */
+    TextureFormat getFormat() const final;
+
+    /** @copydoc Image::getColorSpace */
+    ColorSpace getColorSpace() const final;
+
+private:
+    deflect::server::Tile _tile;
+    const QRect _viewPort;
+};
+
+#endif
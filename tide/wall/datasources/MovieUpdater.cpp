@@ -42,11 +42,45 @@
 #include "data/FFMPEGFrame.h"
 #include "data/FFMPEGMovie.h"
 #include "data/FFMPEGPicture.h"
+#include "metrics/MetricsRegistry.h"
 #include "network/WallToWallChannel.h"
 #include "scene/MovieContent.h"
 #include "utils/log.h"
 
-#include <cmath>
+#include <chrono>
+
+namespace
+{
+// A frame displayed more than this number of frames after it was requested
+// means that a process could not keep up. Staying below the seek threshold of
+// FFMPEGMovie ensures that catching up decodes forward instead of seeking
+// again, which would make the slow process fall behind even further.
+const int maxLagFrames = 4;
+
+MetricHistogram& _decodeTimeHistogram()
+{
+    static auto& histogram = MetricsRegistry::instance().histogram(
+        "tide_movie_decode_seconds", "Time to decode a movie frame");
+    return histogram;
+}
+
+const auto seekMetric = "tide_movie_seek_seconds";
+
+MetricHistogram& _seekTimeHistogram(const QString& uri)
+{
+    return MetricsRegistry::instance().histogram(
+        seekMetric, "Time to seek to a movie position, including decoding",
+        {{"uri", uri.toStdString()}});
+}
+
+MetricCounter& _resyncCounter()
+{
+    static auto& counter = MetricsRegistry::instance().counter(
+        "tide_movie_resync_total",
+        "Movie playback re-anchored because a process fell behind");
+    return counter;
+}
+}
 
 MovieUpdater::MovieUpdater(const QString& uri)
     : _uri{uri}
@@ -54,6 +88,7 @@ MovieUpdater::MovieUpdater(const QString& uri)
     try
     {
         _ffmpegMovie = std::make_unique<FFMPEGMovie>(uri);
+        _ffmpegMovie->indexKeyframes();
         _duration = _ffmpegMovie->getDuration();
         _frameDuration = _ffmpegMovie->getFrameDuration();
     }
@@ -68,7 +103,11 @@ MovieUpdater::MovieUpdater(const QString& uri)
     }
 }
 
-MovieUpdater::~MovieUpdater() = default;
+MovieUpdater::~MovieUpdater()
+{
+    MetricsRegistry::instance().remove(seekMetric,
+                                       {{"uri", _uri.toStdString()}});
+}
 
 QString MovieUpdater::getUri() const
 {
@@ -86,6 +125,9 @@ void MovieUpdater::update(const Content& content)
     // must be received from master in case _ffmpegMovie is invalid on this node
     _duration = movie.getDuration();
     _frameDuration = movie.getFrameDuration();
+
+    _schedule.setTimeline(_duration, _frameDuration);
+    _schedule.setLoop(_loop);
 }
 
 QRect MovieUpdater::getTileRect(const uint tileIndex) const
@@ -144,31 +186,31 @@ ImagePtr MovieUpdater::getTileImage(const uint tileIndex,
         return _picture;
 
     double timestamp;
+    SeekMode mode;
     {
         const QMutexLocker lock(&_mutex);
         timestamp = _sharedTimestamp;
+        mode = _sharedScrubbing ? SeekMode::keyframe : SeekMode::exact;
     }
 
-    auto image = _ffmpegMovie->getFrame(timestamp);
+    const auto start = std::chrono::steady_clock::now();
+    auto image = _ffmpegMovie->getFrame(timestamp, mode);
+    if (const auto seekTime = _ffmpegMovie->getLastSeekTime())
+        _seekTimeHistogram(_uri).observe(seekTime);
 
-    const bool loopBack = _loop && !image;
-    if (loopBack)
+    if (_loop && !image)
         image = _ffmpegMovie->getFrame(0.0);
 
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    _decodeTimeHistogram().observe(
+        std::chrono::duration<double>(elapsed).count());
+
     // Warning: in rare cases image may still be null at this point, then we use
     // last picture. This will also make sure a frame is available at the
     // end of a non-looping movie.
     if (!image)
         image = _pictureLast;
 
-    {
-        const QMutexLocker lock(&_mutex);
-        _currentPosition = _ffmpegMovie->getPosition();
-        // stay inSync for start != 0.0 and loop conditions
-        _sharedTimestamp = _currentPosition;
-        // WAR a risk of deadlock when skipping movies with incorrect duration
-        _loopedBack = loopBack;
-    }
     if (_ffmpegMovie->isStereo())
     {
         image->setStereoView(view == deflect::View::right_eye
@@ -177,6 +219,7 @@ ImagePtr MovieUpdater::getTileImage(const uint tileIndex,
     }
 
     _picture = image;
+    _accountPictures();
     return image;
 }
 
@@ -219,83 +262,89 @@ void MovieUpdater::allowNextFrame()
 
 void MovieUpdater::synchronizeFrameAdvance(WallToWallChannel& channel)
 {
-    const bool visible = synchronizers.haveVisibleTiles();
-    const double frameDuration = _frameDuration;
-
-    bool inSync = false;
-    {
-        // protect _sharedTimestamp & _currentPosition from getTileImage()
-        const QMutexLocker lock(&_mutex);
-
-        // Jump to the skip position
-        if (_skipping && !_loopedBack)
-            _sharedTimestamp = _skipPosition;
+    advanceFrame(channel.getTime());
+}
 
-        inSync = std::abs(_sharedTimestamp - _currentPosition) <= frameDuration;
-    }
+void MovieUpdater::advanceFrame(const PlaybackSchedule::clock::time_point now)
+{
+    // The frame time and the scene (hence the movie controls) are identical on
+    // all processes, as is _readyForNextFrame which is only set after all
+    // processes agreed to swap in synchronizeTilesSwap(). The decisions below
+    // are thus the same everywhere without any additional communication.
+    _updateSchedule(now);
 
-    // If any visible updater is out-of-sync, only update those ones. This
-    // causes a seek in the movie to _sharedTimestamp. The time stands still in
-    // this case to avoid seeking of all processes if this seek takes longer
-    // than frameDuration.
-    if (!channel.allReady(inSync || !visible))
-    {
-        _timer.resetTime(channel.getTime());
-        if (_readyForNextFrame)
-            _triggerFrameUpdate();
+    if (!_readyForNextFrame)
         return;
-    }
 
-    // Don't advance time if paused or skipping
-    if (_paused || _skipping)
+    // A process that was late to swap the last frame makes the time stand
+    // still, to give it a chance to catch up instead of skipping frames.
+    if (_isLate(now))
     {
-        _timer.resetTime(channel.getTime());
-        if (_skipping && _readyForNextFrame)
-            if (channel.allReady(!inSync || !visible))
-                _triggerFrameUpdate();
-        return;
+        _schedule.seek(_requestedTimestamp, now);
+        _requestTime = now;
+        _resyncCounter().increment();
     }
 
-    // If everybody is in sync, do a proper increment and throttle to movie
-    // frame duration and decode speed accordingly.
-    _timer.setCurrentTime(channel.getTime());
-    _elapsedTime += _timer.getElapsedTimeInSeconds();
-    if (_elapsedTime < frameDuration || !_readyForNextFrame)
+    // Show the nearest keyframes while the user drags the slider, then the
+    // exact frame once it is released.
+    const auto timestamp = _schedule.getFrameTimestamp(now);
+    if (timestamp == _requestedTimestamp && _skipping == _sharedScrubbing)
         return;
+
     {
-        // protect _sharedTimestamp & _currentPosition from getTileImage()
+        // protect _sharedTimestamp & _sharedScrubbing from getTileImage()
         const QMutexLocker lock(&_mutex);
-
-        // advance to the next frame, keep correct elapsedTime as vsync
-        // frequency of this function might not match movie frequency.
-        _sharedTimestamp = _currentPosition + frameDuration;
-        _elapsedTime -= frameDuration;
-
-        // Always exchange timestamp for processes where _currentPosition is not
-        // advancing to allow seek if visible again.
-        _exchangeSharedTimestamp(channel, visible && inSync);
+        _sharedTimestamp = timestamp;
+        _sharedScrubbing = _skipping;
     }
+    _requestedTimestamp = timestamp;
+    _requestTime = now;
     // unlock _mutex before to avoid deadlocks
     _triggerFrameUpdate();
 }
 
+void MovieUpdater::_updateSchedule(
+    const PlaybackSchedule::clock::time_point now)
+{
+    // Skipping holds the schedule on the skip position, playback then resumes
+    // from the last position selected by the user.
+    if (_skipping)
+        _schedule.seek(_skipPosition, now);
+
+    if (_paused || _skipping)
+        _schedule.pause(now);
+    else if (_schedule.isPaused())
+    {
+        // The time spent paused must not count as lag of the current frame
+        _schedule.play(now);
+        _requestTime = now;
+    }
+}
+
+bool MovieUpdater::_isLate(const PlaybackSchedule::clock::time_point now) const
+{
+    if (_requestedTimestamp < 0.0 || _schedule.isPaused())
+        return false;
+
+    const auto lag = std::chrono::duration<double>(now - _requestTime);
+    return lag.count() > maxLagFrames * _frameDuration;
+}
+
 void MovieUpdater::_triggerFrameUpdate()
 {
     _readyForNextFrame = false;
     _pictureLast = _picture;
     _picture.reset();
+    _accountPictures();
     emit pictureUpdated();
 }
 
-void MovieUpdater::_exchangeSharedTimestamp(WallToWallChannel& channel,
-                                            const bool isCandidate)
+void MovieUpdater::_accountPictures() const
 {
-    const int leader = channel.electLeader(isCandidate);
-    if (leader < 0)
-        return;
-
-    if (leader == channel.getRank())
-        channel.broadcast(_sharedTimestamp);
-    else
-        _sharedTimestamp = channel.receiveTimestampBroadcast(leader);
+    auto bytes = size_t{0};
+    if (_picture)
+        bytes += MemoryBudget::getByteCount(*_picture);
+    if (_pictureLast && _pictureLast != _picture)
+        bytes += MemoryBudget::getByteCount(*_pictureLast);
+    _memory.set(bytes);
 }
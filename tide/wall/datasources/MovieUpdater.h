@@ -41,8 +41,9 @@
 #define MOVIEUPDATER_H
 
 #include "datasources/DataSource.h"
-#include "tools/ElapsedTimer.h"
 #include "tools/FpsCounter.h"
+#include "tools/MemoryBudget.h"
+#include "tools/PlaybackSchedule.h"
 #include "types.h"
 
 #include <QMutex>
@@ -53,6 +54,10 @@
  *
  * A single movie is designed to provide images to multiple windows on each
  * process.
+ *
+ * Playback follows a schedule anchored on the synchronized wall clock, which
+ * is re-anchored only when the movie is paused, skipped or when a process
+ * falls behind. Each process thus selects the frame to display locally.
  */
 class MovieUpdater : public QObject, public DataSource
 {
@@ -96,6 +101,15 @@ public:
     /** @copydoc DataSource::synchronizeFrameAdvance */
     void synchronizeFrameAdvance(WallToWallChannel& channel) final;
 
+    /**
+     * Select the frame to display at the given time.
+     *
+     * Called by synchronizeFrameAdvance() with the synchronized wall clock.
+     * @param now the time of the frame, which must be the same on all
+     *        processes.
+     */
+    void advanceFrame(PlaybackSchedule::clock::time_point now);
+
     /** @return current / max fps, movie position in percentage. */
     QString getStatistics() const;
 
@@ -116,8 +130,10 @@ signals:
     void pictureUpdated();
 
 private:
+    void _updateSchedule(PlaybackSchedule::clock::time_point now);
+    bool _isLate(PlaybackSchedule::clock::time_point now) const;
     void _triggerFrameUpdate();
-    void _exchangeSharedTimestamp(WallToWallChannel& channel, bool isCandidate);
+    void _accountPictures() const;
 
     QString _uri;
     std::unique_ptr<FFMPEGMovie> _ffmpegMovie;
@@ -133,16 +149,17 @@ private:
 
     bool _readyForNextFrame = true;
 
-    ElapsedTimer _timer;
-    double _elapsedTime = 0.0;
+    PlaybackSchedule _schedule;
+    double _requestedTimestamp = -1.0;
+    PlaybackSchedule::clock::time_point _requestTime;
 
     mutable QMutex _mutex;
-    mutable double _sharedTimestamp = 0.0;
-    mutable double _currentPosition = -1.0;
-    mutable bool _loopedBack = false;
+    double _sharedTimestamp = 0.0;
+    bool _sharedScrubbing = false;
 
     mutable PicturePtr _picture;
     mutable PicturePtr _pictureLast;
+    mutable MemoryBudget::Account _memory{MemoryCategory::movies};
 
     mutable QMutex _getImageMutex;
 };
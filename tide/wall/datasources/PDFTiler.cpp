@@ -40,11 +40,18 @@
 #include "PDFTiler.h"
 
 #include "data/PDF.h"
+#include "metrics/MetricsRegistry.h"
 #include "scene/PDFContent.h"
+#include "tools/DocumentPool.h"
 #include "tools/LodTools.h"
+#include "tools/MemoryBudget.h"
 #include "utils/log.h"
 
+#include <QFileInfo>
 #include <QThread>
+#include <QtConcurrent>
+
+#include <algorithm>
 
 namespace
 {
@@ -53,14 +60,38 @@ namespace
 // Rendering a small tile takes almost as long a rendering the whole page, so
 // it is more optimal to use a large tile size.
 const uint tileSize = 2048;
+
+// Retry interval of render-ahead while all the PDF instances are busy
+const unsigned long renderAheadRetryMs = 20;
+
+// Instance checked out by the render-ahead thread for its current tile
+thread_local DocumentPool<PDF>::Handle* renderAheadPdf = nullptr;
+
+DocumentPool<PDF>::Preference _isOnPage(const int page)
+{
+    return [page](const PDF& instance) { return instance.getPage() == page; };
+}
+
+MetricCounter& _renderedAheadTiles()
+{
+    static auto& counter = MetricsRegistry::instance().counter(
+        "tide_pdf_render_ahead_tiles_total",
+        "PDF tiles rendered ahead for the pages adjacent to the current one");
+    return counter;
+}
 }
 
+uint PDFTiler::_renderAheadPageCount = 1;
+
 PDFTiler::PDFTiler(const QString& uri, const QSize& maxImageSize)
     : _uri{uri}
 {
     try
     {
-        std::make_unique<PDF>(uri);
+        _pdfPool = DocumentPool<PDF>::getShared(
+            uri, "pdf", [uri] { return std::make_unique<PDF>(uri); },
+            QFileInfo(uri).size());
+        _pdfPool->checkout(); // parse (and validate) a first instance
         _lodTool = std::make_unique<LodTools>(maxImageSize, tileSize);
     }
     catch (const std::runtime_error& e)
@@ -70,9 +101,19 @@ PDFTiler::PDFTiler(const QString& uri, const QSize& maxImageSize)
                   uri.toLocal8Bit().constData(), e.what());
     }
     _tilesPerPage = _lodTool->getTilesCount();
+
+    // A single background thread, rendering ahead is not urgent
+    _renderAheadPool.setMaxThreadCount(1);
 }
 
-PDFTiler::~PDFTiler() = default;
+PDFTiler::~PDFTiler()
+{
+    {
+        const QMutexLocker lock(&_renderAheadMutex);
+        _renderAheadQueue.clear();
+    }
+    _renderAheadPool.waitForDone();
+}
 
 QString PDFTiler::getUri() const
 {
@@ -114,12 +155,18 @@ QImage PDFTiler::getCachableTileImage(const uint tileId,
 {
     Q_UNUSED(view);
 
-    auto& pdf = _getPdfForCurrentThread();
-    pdf.setPage(tileId / _tilesPerPage);
+    const auto page = int(tileId / _tilesPerPage);
+    const auto render = [this, tileId, page](PDF& pdf) {
+        pdf.setPage(page);
+        const auto imageSize = getTileRect(tileId).size();
+        const auto region =
+            LodTiler::getNormalizedTileRect(tileId % _tilesPerPage);
+        return pdf.renderToImage(imageSize, region);
+    };
 
-    const auto imageSize = getTileRect(tileId).size();
-    const auto region = LodTiler::getNormalizedTileRect(tileId % _tilesPerPage);
-    return pdf.renderToImage(imageSize, region);
+    if (renderAheadPdf)
+        return render(**renderAheadPdf);
+    return render(*_pdfPool->checkout(_isOnPage(page)));
 }
 
 uint PDFTiler::getPreviewTileId() const
@@ -132,11 +179,102 @@ QString PDFTiler::getStatistics() const
     return QString("page %1/%2").arg(_currentPage + 1).arg(_pageCount);
 }
 
-PDF& PDFTiler::_getPdfForCurrentThread() const
+void PDFTiler::setRenderAheadPageCount(const uint count)
+{
+    _renderAheadPageCount = count;
+}
+
+void PDFTiler::renderAhead(const Indices& tileIds)
 {
-    const auto id = QThread::currentThreadId();
-    QMutexLocker lock(&_threadMapMutex);
-    if (!_perThreadPDF.count(id))
-        _perThreadPDF[id] = std::make_unique<PDF>(_uri);
-    return *_perThreadPDF[id];
+    if (_renderAheadPageCount == 0 || MemoryBudget::instance().isConstrained())
+        return;
+
+    const QMutexLocker lock(&_renderAheadMutex);
+    if (_renderAheadPage != _currentPage)
+    {
+        _renderAheadQueue.clear();
+        _renderAheadPage = _currentPage;
+    }
+
+    // Next pages first, as presentations are mostly read forward
+    for (auto distance = 1; distance <= int(_renderAheadPageCount); ++distance)
+    {
+        for (const auto page :
+             {_currentPage + distance, _currentPage - distance})
+        {
+            if (page < 0 || page >= _pageCount)
+                continue;
+
+            for (const auto tileId : tileIds)
+            {
+                const auto id =
+                    uint(page) * _tilesPerPage + uint(tileId % _tilesPerPage);
+                if (!contains(id) &&
+                    std::find(_renderAheadQueue.begin(),
+                              _renderAheadQueue.end(),
+                              id) == _renderAheadQueue.end())
+                {
+                    _renderAheadQueue.push_back(id);
+                }
+            }
+        }
+    }
+
+    if (!_renderingAhead && !_renderAheadQueue.empty())
+    {
+        _renderingAhead = true;
+        QtConcurrent::run(&_renderAheadPool,
+                          [this] { _processRenderAheadQueue(); });
+    }
+}
+
+void PDFTiler::_processRenderAheadQueue()
+{
+    // Do not compete with the rendering of the visible tiles
+    QThread::currentThread()->setPriority(QThread::IdlePriority);
+
+    while (true)
+    {
+        uint tileId = 0;
+        int queuePage = -1;
+        {
+            const QMutexLocker lock(&_renderAheadMutex);
+            if (_renderAheadQueue.empty())
+            {
+                _renderingAhead = false;
+                return;
+            }
+            tileId = _renderAheadQueue.front();
+            _renderAheadQueue.pop_front();
+            queuePage = _renderAheadPage;
+        }
+
+        // Only use an idle instance, the visible tiles must never wait for
+        // the one rendering ahead (e.g. with a pool of a single instance).
+        const auto page = int(tileId / _tilesPerPage);
+        const auto pdf = _pdfPool->tryCheckout(_isOnPage(page));
+        if (!pdf)
+        {
+            {
+                const QMutexLocker lock(&_renderAheadMutex);
+                if (_renderAheadPage == queuePage)
+                    _renderAheadQueue.push_front(tileId);
+            }
+            QThread::msleep(renderAheadRetryMs);
+            continue;
+        }
+
+        renderAheadPdf = pdf.get();
+        try
+        {
+            getTileImage(tileId, deflect::View::mono); // cached
+            _renderedAheadTiles().increment();
+        }
+        catch (const std::exception& e)
+        {
+            print_log(LOG_WARN, LOG_CONTENT, "PDF render-ahead error: %s - %s",
+                      _uri.toLocal8Bit().constData(), e.what());
+        }
+        renderAheadPdf = nullptr;
+    }
 }
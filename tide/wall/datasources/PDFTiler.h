@@ -43,8 +43,13 @@
 #include "LodTiler.h"
 
 #include <QObject>
+#include <QThreadPool>
+
+#include <deque>
 
 class PDF;
+template <typename Document>
+class DocumentPool;
 
 /**
  * Represent a PDF document as a multi-LOD tiled data source.
@@ -80,6 +85,24 @@ public:
     /** @return the current page / total number of pages of the document. */
     QString getStatistics() const;
 
+    /**
+     * Set the number of pages before and after the current one to render
+     * ahead in the background (default: 1, 0 disables render-ahead).
+     */
+    static void setRenderAheadPageCount(uint count);
+
+    /**
+     * Render the given tiles of the adjacent pages in the background.
+     *
+     * The tiles are rendered at low priority into the cache, so that they are
+     * available immediately when the user flips to one of these pages.
+     * Requests made for a previous page are discarded. Nothing is rendered
+     * ahead while the MemoryBudget is constrained, nor while all the document
+     * instances of the pool are busy rendering.
+     * @param tileIds the visible tiles of the current page
+     */
+    void renderAhead(const Indices& tileIds);
+
 signals:
     /** Emitted when the PDF page has changed. */
     void pageChanged();
@@ -88,7 +111,7 @@ private:
     QImage getCachableTileImage(uint tileId, deflect::View view) const final;
     bool isStereo() const final { return false; }
     const LodTools& _getLodTool() const final { return *_lodTool; }
-    PDF& _getPdfForCurrentThread() const;
+    void _processRenderAheadQueue();
 
     const QString _uri;
     std::unique_ptr<LodTools> _lodTool;
@@ -96,8 +119,15 @@ private:
     int _currentPage = 0;
     int _pageCount = 0;
 
-    mutable QMutex _threadMapMutex;
-    mutable std::map<Qt::HANDLE, std::unique_ptr<PDF>> _perThreadPDF;
+    std::shared_ptr<DocumentPool<PDF>> _pdfPool;
+
+    QMutex _renderAheadMutex;
+    std::deque<uint> _renderAheadQueue;
+    int _renderAheadPage = -1;
+    bool _renderingAhead = false;
+    QThreadPool _renderAheadPool;
+
+    static uint _renderAheadPageCount;
 };
 
 #endif
@@ -39,6 +39,7 @@
 
 #include "PixelStreamUpdater.h"
 
+#include "metrics/MetricsRegistry.h"
 #include "network/WallToWallChannel.h"
 #include "tools/PixelStreamAssembler.h"
 #include "tools/PixelStreamPassthrough.h"
@@ -62,6 +63,37 @@ void _splitByView(const deflect::server::Tiles& tiles,
     assert(right.empty() || right.size() == leftOrMono.size());
 }
 
+const auto fpsMetric = "tide_stream_fps";
+const auto latencyMetric = "tide_stream_frame_latency_seconds";
+
+MetricHistogram& _decodeTimeHistogram()
+{
+    static auto& histogram = MetricsRegistry::instance().histogram(
+        "tide_stream_tile_decode_seconds",
+        "Time to decode a pixel stream tile");
+    return histogram;
+}
+
+double _secondsSince(const std::chrono::steady_clock::time_point start)
+{
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double>(elapsed).count();
+}
+
+/** Frames are decoded in place, count JPEG tiles at their decoded size. */
+size_t _getByteCount(const deflect::server::Frame& frame)
+{
+    auto bytes = size_t{0};
+    for (const auto& tile : frame.tiles)
+    {
+        const auto decodedSize = size_t(tile.width) * tile.height * 4;
+        bytes += tile.format == deflect::Format::jpeg
+                     ? std::max(decodedSize, size_t(tile.imageData.size()))
+                     : size_t(tile.imageData.size());
+    }
+    return bytes;
+}
+
 void _sortByChannelAndPosition(deflect::server::Tiles& tiles)
 {
     std::sort(tiles.begin(), tiles.end(), [](const auto& t1, const auto& t2) {
@@ -72,6 +104,8 @@ void _sortByChannelAndPosition(deflect::server::Tiles& tiles)
 }
 }
 
+bool PixelStreamUpdater::_dropLateFrames = true;
+
 PixelStreamUpdater::PixelStreamUpdater(const QString& uri)
     : _uri{uri}
 {
@@ -81,6 +115,10 @@ PixelStreamUpdater::PixelStreamUpdater(const QString& uri)
 
 PixelStreamUpdater::~PixelStreamUpdater()
 {
+    const auto labels = MetricLabels{{"uri", _uri.toStdString()}};
+    auto& registry = MetricsRegistry::instance();
+    registry.remove(fpsMetric, labels);
+    registry.remove(latencyMetric, labels);
 }
 
 QString PixelStreamUpdater::getUri() const
@@ -113,7 +151,11 @@ ImagePtr PixelStreamUpdater::getTileImage(const uint tileIndex,
         // turbojpeg handles need to be per thread, and this function may be
         // called from multiple threads
         static QThreadStorage<deflect::server::TileDecoder> tileDecoders;
-        return processor->getTileImage(tileIndex, tileDecoders.localData());
+        const auto start = std::chrono::steady_clock::now();
+        auto image =
+            processor->getTileImage(tileIndex, tileDecoders.localData());
+        _decodeTimeHistogram().observe(_secondsSince(start));
+        return image;
     }
     catch (const std::runtime_error& e)
     {
@@ -166,14 +208,30 @@ void PixelStreamUpdater::synchronizeFrameAdvance(WallToWallChannel& channel)
 
     const auto versionCheckFunc = std::bind(&WallToWallChannel::checkVersion,
                                             &channel, std::placeholders::_1);
-    _swapSyncFrame.sync(versionCheckFunc);
+    if (_swapSyncFrame.sync(versionCheckFunc))
+        _dequeueNextFrame();
 }
 
 void PixelStreamUpdater::setNextFrame(deflect::server::FramePtr frame)
 {
     assert(frame->uri == getUri());
 
+    ++_receivedFrames;
+    if (!_dropLateFrames && _hasNextFrame)
+    {
+        _queuedFrames.push_back(frame);
+        _accountFrames();
+        return;
+    }
+
+    _frameReceivedTime = std::chrono::steady_clock::now();
     _swapSyncFrame.update(frame);
+    _hasNextFrame = true;
+}
+
+void PixelStreamUpdater::setDropLateFrames(const bool drop)
+{
+    _dropLateFrames = drop;
 }
 
 void PixelStreamUpdater::_onFrameSwapped(deflect::server::FramePtr frame)
@@ -194,9 +252,41 @@ void PixelStreamUpdater::_onFrameSwapped(deflect::server::FramePtr frame)
         _createFrameProcessors();
         _createPerTileMutexes();
     }
+    _accountFrames();
+
+    _fpsCounter.tick();
+    const auto labels = MetricLabels{{"uri", _uri.toStdString()}};
+    auto& registry = MetricsRegistry::instance();
+    registry.gauge(fpsMetric, "Frame rate of a pixel stream", labels)
+        .set(_fpsCounter.getFps());
+    registry
+        .histogram(latencyMetric,
+                   "Time between the reception of a pixel stream frame and "
+                   "its display",
+                   labels)
+        .observe(_secondsSince(_frameReceivedTime));
+
+    // All processes have received the same frames when swapping, the frames
+    // not displayed since the previous swap were skipped.
+    const auto frames = _dropLateFrames ? _receivedFrames : 1u;
+    _receivedFrames -= frames;
+    _hasNextFrame = false;
 
     emit pictureUpdated();
-    emit requestFrame(frame->uri);
+    emit framesConsumed(frame->uri, frames, frames - 1);
+}
+
+void PixelStreamUpdater::_dequeueNextFrame()
+{
+    // Must be done after the swap, the frame would be swapped in otherwise
+    if (_queuedFrames.empty())
+        return;
+
+    _frameReceivedTime = std::chrono::steady_clock::now();
+    _swapSyncFrame.update(_queuedFrames.front());
+    _queuedFrames.pop_front();
+    _hasNextFrame = true;
+    _accountFrames();
 }
 
 void PixelStreamUpdater::_createFrameProcessors()
@@ -228,3 +318,16 @@ void PixelStreamUpdater::_createPerTileMutexes()
     if (!_perTileLock || _perTileLock->size() < tiles)
         _perTileLock = std::make_unique<std::vector<std::mutex>>(tiles);
 }
+
+void PixelStreamUpdater::_accountFrames()
+{
+    auto bytes = size_t{0};
+    for (const auto& frame : {_frameLeftOrMono, _frameRight})
+    {
+        if (frame)
+            bytes += _getByteCount(*frame);
+    }
+    for (const auto& frame : _queuedFrames)
+        bytes += _getByteCount(*frame);
+    _memory.set(bytes);
+}
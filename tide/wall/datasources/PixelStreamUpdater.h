@@ -43,15 +43,22 @@
 #include "types.h"
 
 #include "DataSource.h"
+#include "tools/FpsCounter.h"
+#include "tools/MemoryBudget.h"
 #include "tools/SwapSyncObject.h"
 
 #include <QObject>
 #include <QReadWriteLock>
 
+#include <deque>
+
 class PixelStreamProcessor;
 
 /**
- * Synchronize the update of PixelStreams and send new frame requests.
+ * Synchronize the update of PixelStreams and return frame credits.
+ *
+ * Frames are swapped collectively on all wall processes, so the credits only
+ * come back once the slowest process is ready for the next frame.
  */
 class PixelStreamUpdater : public QObject, public DataSource
 {
@@ -98,12 +105,25 @@ public:
     /** Set the frame to be rendered next. */
     void setNextFrame(deflect::server::FramePtr frame);
 
+    /**
+     * Skip frames received while the previous one is still being displayed.
+     * @param drop true to keep only the latest frame (default), false to
+     *        display all frames in order.
+     */
+    static void setDropLateFrames(bool drop);
+
 signals:
     /** Emitted when a new picture has become available. */
     void pictureUpdated();
 
-    /** Emitted to request a new frame after a successful swap. */
-    void requestFrame(QString uri);
+    /**
+     * Emitted after a successful swap to return the credits of the frames
+     * consumed since the previous swap.
+     * @param uri of the stream
+     * @param frames number of frames consumed, including the dropped ones
+     * @param dropped number of frames that were skipped
+     */
+    void framesConsumed(QString uri, uint frames, uint dropped);
 
 private:
     QString _uri;
@@ -116,9 +136,22 @@ private:
     mutable std::unique_ptr<std::vector<std::mutex>> _perTileLock;
     bool _readyToSwap = true;
 
+    std::deque<deflect::server::FramePtr> _queuedFrames;
+    bool _hasNextFrame = false;
+    uint _receivedFrames = 0;
+
+    FpsCounter _fpsCounter;
+    std::chrono::steady_clock::time_point _frameReceivedTime;
+
+    MemoryBudget::Account _memory{MemoryCategory::streams};
+
     void _onFrameSwapped(deflect::server::FramePtr frame);
+    void _dequeueNextFrame();
     void _createFrameProcessors();
     void _createPerTileMutexes();
+    void _accountFrames();
+
+    static bool _dropLateFrames;
 };
 
 #endif
@@ -42,12 +42,14 @@
 #include "tools/LodTools.h"
 #include "utils/log.h"
 
-#if !(TIDE_USE_CAIRO && TIDE_USE_RSVG)
+#if TIDE_USE_CAIRO && TIDE_USE_RSVG
+#include "tools/DocumentPool.h"
+#else
+#include "GLTextureImage.h"
 #include "SVGGpuImage.h"
+#include "data/GLTexture.h"
 #endif
 
-#include <QThread>
-
 namespace
 {
 const uint tileSize = 1024;
@@ -58,6 +60,13 @@ SVGTiler::SVGTiler(const QString& uri, const QSize& maxImageSize)
     try
     {
         _svg = std::make_unique<SVG>(uri);
+#if TIDE_USE_CAIRO && TIDE_USE_RSVG
+        // The SvgCairoRSVGBackend is called from multiple threads
+        const auto data = _svg->getData();
+        _svgPool = DocumentPool<SVG>::getShared(
+            uri, "svg", [data] { return std::make_unique<SVG>(data); },
+            data.size());
+#endif
         _lodTool = std::make_unique<LodTools>(maxImageSize, tileSize);
     }
     catch (const std::runtime_error& e)
@@ -93,6 +102,20 @@ ImagePtr SVGTiler::renderAndCacheGpuImage(const uint tileId,
 {
     return CachedDataSource::getTileImage(tileId, view);
 }
+
+ImagePtr SVGTiler::getCachableTile(const uint tileId,
+                                   const deflect::View view) const
+{
+    if (_svg && GLTexture::isSharingAvailable())
+    {
+        const auto imageSize = getTileRect(tileId).size();
+        const auto zoomRect = getNormalizedTileRect(tileId);
+        if (auto texture = _svg->renderToTexture(imageSize, zoomRect))
+            return std::make_shared<GLTextureImage>(std::move(texture));
+    }
+    // Fallback: read back the pixels for uploading them again to a texture
+    return CachedDataSource::getCachableTile(tileId, view);
+}
 #endif
 
 QImage SVGTiler::getCachableTileImage(const uint tileId,
@@ -106,20 +129,26 @@ QImage SVGTiler::getCachableTileImage(const uint tileId,
     const auto imageSize = getTileRect(tileId).size();
     const auto zoomRect = getNormalizedTileRect(tileId);
 
-    return _getSvgForCurrentThread().renderToImage(imageSize, zoomRect);
-}
-
-SVG& SVGTiler::_getSvgForCurrentThread() const
-{
 #if TIDE_USE_CAIRO && TIDE_USE_RSVG
-    // The SvgCairoRSVGBackend is called from multiple threads
-    const auto id = QThread::currentThreadId();
-    const QMutexLocker lock(&_threadMapMutex);
-    if (!_perThreadSVG.count(id))
-        _perThreadSVG[id] = std::make_unique<SVG>(_svg->getData());
-    return *_perThreadSVG[id];
+    return _svgPool->checkout()->renderToImage(imageSize, zoomRect);
 #else
     // The SvgQtGpuBackend is always called from the render thread (GPU)
-    return *_svg;
+    return _svg->renderToImage(imageSize, zoomRect);
 #endif
 }
+
+#if TIDE_USE_CAIRO && TIDE_USE_RSVG
+QImage SVGTiler::getCoarseTileImageData(const uint tileId,
+                                        const deflect::View view) const
+{
+    Q_UNUSED(view);
+
+    if (!_svg)
+        return QImage();
+
+    const auto imageSize =
+        (getTileRect(tileId).size() / coarseTileDownscale).expandedTo({1, 1});
+    const auto zoomRect = getNormalizedTileRect(tileId);
+    return _svgPool->checkout()->renderToImage(imageSize, zoomRect);
+}
+#endif
@@ -44,6 +44,11 @@
 
 #include "data/SVG.h"
 
+#if (TIDE_USE_CAIRO && TIDE_USE_RSVG)
+template <typename Document>
+class DocumentPool;
+#endif
+
 /**
  * Represent an SVG image as a multi-LOD tiled data source.
  */
@@ -71,22 +76,35 @@ public:
 #endif
 
 private:
+#if !(TIDE_USE_CAIRO && TIDE_USE_RSVG)
+    /**
+     * Render the tile into a GPU texture when the render contexts share their
+     * textures, otherwise read it back as a regular image.
+     */
+    ImagePtr getCachableTile(uint tileId, deflect::View view) const final;
+#endif
+
     /**
      * Get a tile image which will be cached.
      * Unlike other DataSource classes, this method may need to be called from a
      * thread with an OpenGL context depending on the SVG backend used.
      */
     QImage getCachableTileImage(uint tileId, deflect::View view) const final;
+#if TIDE_USE_CAIRO && TIDE_USE_RSVG
+    /**
+     * Render a tile at a reduced resolution. Only used with the Cairo backend,
+     * the GPU backend renders full quality tiles on the render thread.
+     */
+    QImage getCoarseTileImageData(uint tileId, deflect::View view) const final;
+#endif
     bool isStereo() const final { return false; }
     const LodTools& _getLodTool() const final { return *_lodTool; }
-    SVG& _getSvgForCurrentThread() const;
 
     std::unique_ptr<SVG> _svg;
     std::unique_ptr<LodTools> _lodTool;
 
 #if (TIDE_USE_CAIRO && TIDE_USE_RSVG)
-    mutable QMutex _threadMapMutex;
-    mutable std::map<Qt::HANDLE, std::unique_ptr<SVG>> _perThreadSVG;
+    std::shared_ptr<DocumentPool<SVG>> _svgPool;
 #endif
 };
 
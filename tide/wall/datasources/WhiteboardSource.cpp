@@ -0,0 +1,107 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "WhiteboardSource.h"
+
+#include "scene/WhiteboardContent.h"
+
+WhiteboardSource::WhiteboardSource(const QString& uri)
+    : _uri{uri}
+{
+}
+
+QString WhiteboardSource::getUri() const
+{
+    return _uri;
+}
+
+void WhiteboardSource::update(const Content& content)
+{
+    _size = content.getDimensions();
+    _strokes = dynamic_cast<const WhiteboardContent&>(content).getStrokes();
+}
+
+bool WhiteboardSource::extendStroke(const WhiteboardStrokeUpdate& update)
+{
+    return update.applyTo(_strokes);
+}
+
+const std::vector<WhiteboardStroke>& WhiteboardSource::getStrokes() const
+{
+    return _strokes;
+}
+
+ImagePtr WhiteboardSource::getTileImage(const uint tileId,
+                                        const deflect::View view) const
+{
+    Q_UNUSED(tileId);
+    Q_UNUSED(view);
+
+    throw std::logic_error("whiteboards are rendered without tiles");
+}
+
+QRect WhiteboardSource::getTileRect(const uint tileId) const
+{
+    Q_UNUSED(tileId);
+
+    return QRect{QPoint(), _size};
+}
+
+QSize WhiteboardSource::getTilesArea(const uint lod, const uint channel) const
+{
+    Q_UNUSED(lod);
+    Q_UNUSED(channel);
+
+    return _size;
+}
+
+Indices WhiteboardSource::computeVisibleSet(const QRectF& visibleTilesArea,
+                                           const uint lod,
+                                           const uint channel) const
+{
+    Q_UNUSED(visibleTilesArea);
+    Q_UNUSED(lod);
+    Q_UNUSED(channel);
+
+    return Indices();
+}
+
+uint WhiteboardSource::getMaxLod() const
+{
+    return 0;
+}
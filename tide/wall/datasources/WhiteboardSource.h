@@ -0,0 +1,101 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef WHITEBOARDSOURCE_H
+#define WHITEBOARDSOURCE_H
+
+#include "DataSource.h"
+
+#include "scene/WhiteboardContent.h"
+
+/**
+ * Data source for whiteboards.
+ *
+ * Whiteboards are rendered natively from their strokes by the
+ * WhiteboardSynchronizer. This source keeps a copy of the strokes, which is
+ * replaced on each scene update and extended with the new points of the stroke
+ * being drawn in between.
+ */
+class WhiteboardSource : public DataSource
+{
+public:
+    /**
+     * Construct a whiteboard source.
+     * @param uri of the whiteboard.
+     */
+    explicit WhiteboardSource(const QString& uri);
+
+    /** @copydoc DataSource::getUri */
+    QString getUri() const final;
+
+    /** Update the dimensions and the strokes of the whiteboard. */
+    void update(const Content& content) final;
+
+    /**
+     * Add the new points of a stroke.
+     * @param update the points to add.
+     * @return true if the stroke was extended, false if it does not exist.
+     */
+    bool extendStroke(const WhiteboardStrokeUpdate& update);
+
+    /** @return the strokes, in drawing order. */
+    const std::vector<WhiteboardStroke>& getStrokes() const;
+
+    /** @throw std::logic_error whiteboards do not have tiles. */
+    ImagePtr getTileImage(uint tileId, deflect::View view) const final;
+
+    /** @copydoc DataSource::getTileRect */
+    QRect getTileRect(uint tileId) const final;
+
+    /** @copydoc DataSource::getTilesArea */
+    QSize getTilesArea(uint lod, uint channel) const final;
+
+    /** @return an empty set, whiteboards do not have tiles. */
+    Indices computeVisibleSet(const QRectF& visibleTilesArea, uint lod,
+                              uint channel) const final;
+
+    /** @copydoc DataSource::getMaxLod */
+    uint getMaxLod() const final;
+
+private:
+    const QString _uri;
+    QSize _size;
+    std::vector<WhiteboardStroke> _strokes;
+};
+
+#endif
@@ -40,12 +40,14 @@
 #include "WallFromMasterChannel.h"
 
 #include "configuration/Configuration.h"
+#include "metrics/MetricsRegistry.h"
 #include "network/MPICommunicator.h"
 #include "scene/CountdownStatus.h"
 #include "scene/Markers.h"
 #include "scene/Options.h"
 #include "scene/Scene.h"
 #include "scene/ScreenLock.h"
+#include "scene/WhiteboardContent.h"
 #include "scene/Window.h"
 #include "serialization/utils.h"
 #include "json/serialization.h"
@@ -58,10 +60,24 @@
 namespace
 {
 const int RANK0 = 0;
+
+MetricCounter& _sharedBytesCounter()
+{
+    static auto& counter = MetricsRegistry::instance().counter(
+        "tide_mpi_host_shared_bytes_total",
+        "Broadcast payload bytes read from host shared memory instead of the "
+        "network");
+    return counter;
+}
 }
 
-WallFromMasterChannel::WallFromMasterChannel(MPICommunicator& communicator)
+WallFromMasterChannel::WallFromMasterChannel(MPICommunicator& communicator,
+                                             MPICommunicator& payloadComm,
+                                             MPICommunicator& hostComm)
     : _communicator{communicator}
+    , _payloadComm{payloadComm}
+    , _isHostLeader{hostComm.getRank() == RANK0}
+    , _sharedBuffer{hostComm}
 {
 }
 
@@ -99,6 +115,10 @@ void WallFromMasterChannel::receiveMessage()
     case MessageType::COUNTDOWN_STATUS:
         emit received(receiveQObjectBroadcast<CountdownStatusPtr>(mh.size));
         break;
+    case MessageType::WHITEBOARD_STROKE:
+        emit received(
+            receiveBinaryBroadcast<WhiteboardStrokeUpdatePtr>(mh.size));
+        break;
     case MessageType::PIXELSTREAM:
 #if BOOST_VERSION >= 106000
         emit received(
@@ -111,6 +131,11 @@ void WallFromMasterChannel::receiveMessage()
             receiveBinaryBroadcast<deflect::server::Frame>(mh.size)));
 #endif
         break;
+    case MessageType::PIXELSTREAM_DIRECT:
+        // Only the header is broadcast, the frame is specific to this process
+        emit received(std::make_shared<deflect::server::Frame>(
+            receiveBinaryMessage<deflect::server::Frame>(mh.type)));
+        break;
     case MessageType::IMAGE:
         emit receivedScreenshotRequest();
         break;
@@ -128,22 +153,39 @@ void WallFromMasterChannel::receiveMessage()
 
 void WallFromMasterChannel::receiveBroadcast(const size_t messageSize)
 {
-    _buffer.setSize(messageSize);
-    _communicator.receiveBroadcast(RANK0, _buffer.data(), messageSize);
+    // Wait until the processes of the host are done reading the previous
+    // payload before the leader overwrites it.
+    _sharedBuffer.synchronize();
+    _sharedBuffer.setSize(messageSize);
+    if (_isHostLeader)
+        _payloadComm.receiveBroadcast(RANK0, _sharedBuffer.data(), messageSize);
+    else
+        _sharedBytesCounter().increment(messageSize);
+    _sharedBuffer.synchronize();
+}
+
+template <typename T>
+T WallFromMasterChannel::receiveBinaryMessage(const MessageType type)
+{
+    const auto result = _communicator.probe(RANK0, int(type));
+    _buffer.setSize(result.size);
+    _communicator.receive(RANK0, _buffer.data(), result.size, int(type));
+    return serialization::get<T>(_buffer);
 }
 
 template <typename T>
 T WallFromMasterChannel::receiveBinaryBroadcast(const size_t messageSize)
 {
     receiveBroadcast(messageSize);
-    return serialization::get<T>(_buffer);
+    return serialization::get<T>(_sharedBuffer);
 }
 
 template <typename T>
 T WallFromMasterChannel::receiveJsonBroadcast(const size_t messageSize)
 {
     receiveBroadcast(messageSize);
-    const auto data = QByteArray::fromRawData(_buffer.data(), _buffer.size());
+    const auto data = QByteArray::fromRawData(_sharedBuffer.data(),
+                                              _sharedBuffer.size());
     return json::unpack<T>(data);
 }
 
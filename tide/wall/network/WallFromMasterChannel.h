@@ -40,6 +40,8 @@
 #ifndef WALLFROMMASTERCHANNEL_H
 #define WALLFROMMASTERCHANNEL_H
 
+#include "network/MPISharedBuffer.h"
+#include "network/MessageHeader.h"
 #include "network/ReceiveBuffer.h"
 #include "types.h"
 
@@ -47,6 +49,9 @@
 
 /**
  * Receiving channel from the master application to the wall processes.
+ *
+ * Only one process per host receives the payload of broadcast messages from the
+ * network, the others read it in place from the memory shared on the host.
  */
 class WallFromMasterChannel : public QObject
 {
@@ -54,8 +59,16 @@ class WallFromMasterChannel : public QObject
     Q_DISABLE_COPY(WallFromMasterChannel)
 
 public:
-    /** Constructor */
-    WallFromMasterChannel(MPICommunicator& communicator);
+    /**
+     * Constructor, collective on the wall processes of each host.
+     * @param communicator The communicator of the master and wall processes.
+     * @param payloadComm The communicator of the master and the host leaders.
+     * @param hostComm The communicator of the wall processes on this host,
+     *        whose process of rank 0 is the host leader.
+     */
+    WallFromMasterChannel(MPICommunicator& communicator,
+                          MPICommunicator& payloadComm,
+                          MPICommunicator& hostComm);
 
     /**
      * Receive the inital Configuration sent by the master process.
@@ -100,6 +113,12 @@ signals:
      */
     void received(MarkersPtr markers);
 
+    /**
+     * Emitted when new points of a whiteboard stroke were received.
+     * @param update The points that were received.
+     */
+    void received(WhiteboardStrokeUpdatePtr update);
+
     /**
      * Emitted when a new PixelStream frame was recieved.
      * @param frame The frame that was received.
@@ -118,13 +137,18 @@ signals:
 
 private:
     MPICommunicator& _communicator;
+    MPICommunicator& _payloadComm;
+    const bool _isHostLeader;
     ReceiveBuffer _buffer;
+    MPISharedBuffer _sharedBuffer;
     bool _processMessages = true;
 
     void receiveMessage();
 
     void receiveBroadcast(const size_t messageSize);
     template <typename T>
+    T receiveBinaryMessage(MessageType type);
+    template <typename T>
     T receiveBinaryBroadcast(const size_t messageSize);
     template <typename T>
     T receiveJsonBroadcast(const size_t messageSize);
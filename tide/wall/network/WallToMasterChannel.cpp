@@ -40,6 +40,7 @@
 
 #include "WallToMasterChannel.h"
 
+#include "metrics/MetricsRegistry.h"
 #include "network/MPICommunicator.h"
 #include "serialization/utils.h"
 
@@ -60,12 +61,26 @@ void WallToMasterChannel::sendRequestFrame(const QString uri)
     _communicator.send(MessageType::REQUEST_FRAME, data, 0);
 }
 
+void WallToMasterChannel::sendFrameCredits(const QString uri, const uint frames,
+                                           const uint dropped)
+{
+    const auto data = serialization::toBinary(uri, frames, dropped);
+    _communicator.send(MessageType::PIXELSTREAM_CREDIT, data, 0);
+}
+
 void WallToMasterChannel::sendPixelStreamClose(const QString uri)
 {
     const auto data = serialization::toBinary(uri);
     _communicator.send(MessageType::PIXELSTREAM_CLOSE, data, 0);
 }
 
+void WallToMasterChannel::sendMetrics()
+{
+    const auto metrics = MetricsRegistry::instance().snapshot();
+    const auto data = serialization::toBinary(metrics);
+    _communicator.send(MessageType::METRICS, data, 0);
+}
+
 void WallToMasterChannel::sendQuit()
 {
     _communicator.send(MessageType::QUIT, "", 0);
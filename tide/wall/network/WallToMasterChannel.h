@@ -65,6 +65,14 @@ public slots:
      */
     void sendRequestFrame(QString uri);
 
+    /**
+     * Return the credits of frames consumed by the wall for a pixel stream.
+     * @param uri The URI of the pixel stream
+     * @param frames The number of frames consumed
+     * @param dropped The number of consumed frames that were not displayed
+     */
+    void sendFrameCredits(QString uri, uint frames, uint dropped);
+
     /**
      * Send a request to the master application to close the given pixel stream.
      * @param uri The URI of the pixel stream
@@ -78,6 +86,11 @@ public slots:
      */
     void sendScreenshot(QImage image, QPoint index);
 
+    /**
+     * Send a snapshot of the metrics of this process to the master application.
+     */
+    void sendMetrics();
+
     /**
      * Send quit message to the master application to stop the receiver.
      */
@@ -44,10 +44,13 @@
 #include "serialization/utils.h"
 #include "utils/log.h"
 
+#include <limits>
+
 #define RANK0 0
 
 WallToWallChannel::WallToWallChannel(MPICommunicator& communicator)
     : _communicator{communicator}
+    , _hierarchy{communicator}
 {
 }
 
@@ -58,12 +61,12 @@ int WallToWallChannel::getRank() const
 
 int WallToWallChannel::globalSum(const int localValue) const
 {
-    return _communicator.globalSum(localValue);
+    return _hierarchy.globalSum(localValue);
 }
 
 bool WallToWallChannel::allReady(const bool isReady) const
 {
-    return _communicator.globalSum(isReady ? 1 : 0) == _communicator.getSize();
+    return _hierarchy.globalSum(isReady ? 1 : 0) == _communicator.getSize();
 }
 
 WallToWallChannel::clock::time_point WallToWallChannel::getTime() const
@@ -92,19 +95,12 @@ bool WallToWallChannel::checkVersion(const uint64_t version) const
 
 int WallToWallChannel::electLeader(const bool isCandidate)
 {
-    const int status = isCandidate ? (1 << getRank()) : 0;
-    int globalStatus = globalSum(status);
-
-    if (globalStatus <= 0)
-        return -1;
-
-    int leader = 0;
-    while (globalStatus > 1)
-    {
-        globalStatus = globalStatus >> 1;
-        ++leader;
-    }
-    return leader;
+    // A single reduction on the ranks of the candidates, which unlike a
+    // bitmask of candidates works for any number of processes.
+    const auto noCandidate = std::numeric_limits<int>::max();
+    const auto leader =
+        _hierarchy.globalMin(isCandidate ? getRank() : noCandidate);
+    return leader == noCandidate ? -1 : leader;
 }
 
 void WallToWallChannel::broadcast(const double timestamp)
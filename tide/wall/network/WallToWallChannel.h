@@ -40,6 +40,7 @@
 #ifndef WALLTOWALLCHANNEL_H
 #define WALLTOWALLCHANNEL_H
 
+#include "network/MPIHierarchy.h"
 #include "network/ReceiveBuffer.h"
 #include "types.h"
 
@@ -49,6 +50,9 @@
 
 /**
  * Communication channel between the Wall processes.
+ *
+ * The collective operations are hierarchical: within each host first, then
+ * between one process per host.
  */
 class WallToWallChannel : public QObject
 {
@@ -58,7 +62,7 @@ class WallToWallChannel : public QObject
 public:
     using clock = std::chrono::high_resolution_clock;
 
-    /** Constructor */
+    /** Constructor, collective on all the wall processes. */
     WallToWallChannel(MPICommunicator& communicator);
 
     /** @return The rank of this process. */
@@ -86,7 +90,8 @@ public:
     /**
      * Elect a leader amongst wall processes.
      * @param isCandidate Is this process a candidate.
-     * @return the rank of the leader, or -1 if no leader could be elected.
+     * @return the rank of the leader, which is the lowest-ranked candidate, or
+     *         -1 if there is no candidate.
      */
     int electLeader(bool isCandidate);
 
@@ -101,6 +106,7 @@ public:
 
 private:
     MPICommunicator& _communicator;
+    MPIHierarchy _hierarchy;
     ReceiveBuffer _buffer;
     clock::time_point _timestamp;
 
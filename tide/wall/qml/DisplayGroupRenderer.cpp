@@ -67,6 +67,18 @@ void DisplayGroupRenderer::setDisplayGroup(DisplayGroupPtr displayGroup)
     _displayGroup = std::move(displayGroup);
 }
 
+void DisplayGroupRenderer::updateWindows(const WindowPtrs& windows)
+{
+    const auto helper = VisibilityHelper{*_displayGroup, _context.screenRect,
+                                         _context.isAlphaBlendingEnabled()};
+    for (const auto& window : windows)
+    {
+        const auto it = _windowItems.find(window->getID());
+        if (it != _windowItems.end())
+            it.value()->update(window, helper.getVisibleArea(*window));
+    }
+}
+
 void DisplayGroupRenderer::_updateWindowItems(const DisplayGroup& displayGroup)
 {
     QSet<QUuid> updatedWindows;
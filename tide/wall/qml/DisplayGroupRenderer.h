@@ -66,6 +66,9 @@ public:
     /** Set the DisplayGroup to render, replacing the previous one. */
     void setDisplayGroup(DisplayGroupPtr displayGroup);
 
+    /** Update windows of the current DisplayGroup whose contents changed. */
+    void updateWindows(const WindowPtrs& windows);
+
 private:
     WallRenderContext _context;
     std::unique_ptr<QQmlContext> _qmlContext;
@@ -0,0 +1,122 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "StrokeNode.h"
+
+#include "scene/WhiteboardContent.h"
+
+#include <QSGFlatColorMaterial>
+
+#include <cmath>
+
+namespace
+{
+const int discSegments = 12;
+
+using Vertices = std::vector<QSGGeometry::Point2D>;
+
+void _addTriangle(Vertices& vertices, const QPointF& a, const QPointF& b,
+                  const QPointF& c)
+{
+    for (const auto& p : {a, b, c})
+    {
+        vertices.emplace_back();
+        vertices.back().set(p.x(), p.y());
+    }
+}
+
+void _addDisc(Vertices& vertices, const QPointF& center, const qreal radius)
+{
+    auto previous = center + QPointF{radius, 0.0};
+    for (int i = 1; i <= discSegments; ++i)
+    {
+        const auto angle = 2.0 * M_PI * i / discSegments;
+        const auto offset = QPointF{std::cos(angle), std::sin(angle)};
+        const auto next = center + offset * radius;
+        _addTriangle(vertices, center, previous, next);
+        previous = next;
+    }
+}
+
+void _addSegment(Vertices& vertices, const QPointF& a, const QPointF& b,
+                 const qreal radius)
+{
+    const auto d = b - a;
+    const auto length = std::hypot(d.x(), d.y());
+    if (length == 0.0)
+        return;
+
+    const auto n = QPointF{-d.y(), d.x()} * (radius / length);
+    _addTriangle(vertices, a + n, a - n, b + n);
+    _addTriangle(vertices, b + n, a - n, b - n);
+}
+
+Vertices _tessellate(const WhiteboardStroke& stroke)
+{
+    const auto radius = stroke.width * 0.5;
+    const auto& points = stroke.points;
+
+    Vertices vertices;
+    vertices.reserve(points.size() * (discSegments + 2) * 3);
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        // Discs at each point make the caps and joins round
+        _addDisc(vertices, points[i], radius);
+        if (i > 0)
+            _addSegment(vertices, points[i - 1], points[i], radius);
+    }
+    return vertices;
+}
+}
+
+StrokeNode::StrokeNode(const WhiteboardStroke& stroke)
+{
+    const auto vertices = _tessellate(stroke);
+
+    setGeometry(new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(),
+                                vertices.size()));
+    geometry()->setDrawingMode(GL_TRIANGLES);
+    std::copy(vertices.begin(), vertices.end(),
+              geometry()->vertexDataAsPoint2D());
+    setFlag(QSGNode::OwnsGeometry);
+
+    auto material = new QSGFlatColorMaterial;
+    material->setColor(stroke.color);
+    setMaterial(material);
+    setFlag(QSGNode::OwnsMaterial);
+}
@@ -1,6 +1,5 @@
 /*********************************************************************/
-/* Copyright (c) 2016, EPFL/Blue Brain Project                       */
-/*                     Pawel Podhajski  <pawel.podhajski@epfl.ch>    */
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
 /* All rights reserved.                                              */
 /*                                                                   */
 /* Redistribution and use in source and binary forms, with or        */
@@ -37,29 +36,21 @@
 /* or implied, of Ecole polytechnique federale de Lausanne.          */
 /*********************************************************************/
 
-#ifndef WHITEBOARD_H
-#define WHITEBOARD_H
+#ifndef STROKENODE_H
+#define STROKENODE_H
 
-#include "tide/master/qml/FileInfoHelper.h"
+#include <QSGGeometryNode>
 
-#include <QGuiApplication>
-#include <deflect/qt/QmlStreamer.h>
+struct WhiteboardStroke;
 
 /**
- * Separate application which streams a whiteboard using deflect::Qt API.
+ * A whiteboard stroke tessellated into triangles with round caps and joins.
  */
-class Whiteboard : public QGuiApplication
+class StrokeNode : public QSGGeometryNode
 {
-    Q_OBJECT
-
 public:
-    Whiteboard(int& argc, char* argv[]);
-
-private:
-    std::unique_ptr<deflect::qt::QmlStreamer> _qmlStreamer;
-    FileInfoHelper _fileInfoHelper;
-
-    bool event(QEvent* event) final;
+    /** Constructor. */
+    explicit StrokeNode(const WhiteboardStroke& stroke);
 };
 
 #endif
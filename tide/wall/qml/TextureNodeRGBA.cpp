@@ -39,6 +39,7 @@
 
 #include "TextureNodeRGBA.h"
 
+#include "data/GLTexture.h"
 #include "data/Image.h"
 #include "textureUtils.h"
 
@@ -74,24 +75,67 @@ void TextureNodeRGBA::uploadTexture(const Image& image)
     else
         setTextureCoordinatesTransform(QSGSimpleTextureNode::NoTransform);
 
+    _nextGLTexture = image.getGLTexture();
+    if (_nextGLTexture)
+        return;
+
     if (!_pbo)
         _pbo = textureUtils::createPbo(_dynamicTexture);
 
     textureUtils::upload(image, 0, *_pbo);
+    _pboBytes = image.getDataSize(0);
 
     _nextTextureSize = image.getTextureSize();
     _glImageFormat = image.getGLPixelFormat();
+    _accountMemory();
 }
 
 void TextureNodeRGBA::swap()
 {
-    if (_texture->textureSize() != _nextTextureSize)
+    if (_nextGLTexture)
+    {
+        _swapGLTexture();
+        return;
+    }
+
+    // Never copy pixels to the texture of an image displayed previously
+    if (_texture->textureSize() != _nextTextureSize || _glTexture)
+    {
         _texture = textureUtils::createTextureRgba(_nextTextureSize, _window);
+        _glTexture.reset();
+    }
 
     textureUtils::copy(*_pbo, *_texture, _glImageFormat);
     setTexture(_texture.get());
     markDirty(DirtyMaterial);
 
     if (!_dynamicTexture)
+    {
         _pbo.reset();
+        _pboBytes = 0;
+    }
+    _accountMemory();
+}
+
+void TextureNodeRGBA::_swapGLTexture()
+{
+    const auto textureFlags = QQuickWindow::CreateTextureOptions(
+        QQuickWindow::TextureHasMipmaps | QQuickWindow::TextureHasAlphaChannel);
+
+    // The texture is owned by the image, keep it while it is displayed
+    _glTexture = std::move(_nextGLTexture);
+    _glTexture->waitForRendering();
+    _texture.reset(_window.createTextureFromId(
+        _glTexture->getId(), _glTexture->getSize(), textureFlags));
+    setTexture(_texture.get());
+    markDirty(DirtyMaterial);
+    _accountMemory();
+}
+
+void TextureNodeRGBA::_accountMemory()
+{
+    // The textures of GPU images belong to the images, only count our own
+    const auto size =
+        _texture && !_glTexture ? _texture->textureSize() : QSize();
+    _memory.set(textureUtils::getByteCount(size, 4) + _pboBytes);
 }
@@ -42,6 +42,8 @@
 
 #include "TextureNode.h"
 
+#include "tools/MemoryBudget.h"
+
 #include <QOpenGLBuffer>
 #include <QSGSimpleTextureNode>
 #include <memory>
@@ -59,6 +61,9 @@ class QQuickWindow;
  * * In the dynamic case, two PBOs are used for real-time texture updates.
  * * In the static case, a single PBO is used for the initial texture upload and
  *   then released in the first call to swap() so that no memory is wasted.
+ *
+ * Images which are already resident on the GPU (Image::getGLTexture()) are
+ * displayed directly from their texture, without any copy.
  */
 class TextureNodeRGBA : public QSGSimpleTextureNode, public TextureNode
 {
@@ -85,8 +90,17 @@ private:
     std::unique_ptr<QSGTexture> _texture;
     std::unique_ptr<QOpenGLBuffer> _pbo;
 
+    GLTexturePtr _glTexture;
+    GLTexturePtr _nextGLTexture;
+
     QSize _nextTextureSize;
     uint _glImageFormat = 0;
+
+    size_t _pboBytes = 0;
+    MemoryBudget::Account _memory{MemoryCategory::textures};
+
+    void _swapGLTexture();
+    void _accountMemory();
 };
 
 #endif
@@ -250,6 +250,7 @@ void TextureNodeYUV::uploadTexture(const Image& image)
         _createPbos();
 
     _uploadToPbos(image);
+    _pboBytes = MemoryBudget::getByteCount(image);
 
     _nextTextureSize = image.getTextureSize();
     _nextFormat = image.getFormat();
@@ -269,6 +270,7 @@ void TextureNodeYUV::uploadTexture(const Image& image)
     state->reverseOrientation =
         image.getRowOrder() == deflect::RowOrder::bottom_up;
     state->colorSpace = image.getColorSpace();
+    _accountMemory();
 }
 
 void TextureNodeYUV::swap()
@@ -281,6 +283,7 @@ void TextureNodeYUV::swap()
 
     if (!_dynamicTexture)
         _deletePbos();
+    _accountMemory();
 }
 
 bool TextureNodeYUV::_needTextureChange() const
@@ -324,6 +327,7 @@ void TextureNodeYUV::_deletePbos()
     state->pboY.reset();
     state->pboU.reset();
     state->pboV.reset();
+    _pboBytes = 0;
 }
 
 void TextureNodeYUV::_uploadToPbos(const Image& image)
@@ -341,3 +345,16 @@ void TextureNodeYUV::_copyPbosToTextures()
     textureUtils::copy(*state->pboU, *state->textureU, GL_RED);
     textureUtils::copy(*state->pboV, *state->textureV, GL_RED);
 }
+
+void TextureNodeYUV::_accountMemory()
+{
+    const auto state = _getMaterialState(_node);
+    auto bytes = _pboBytes;
+    for (const auto& texture :
+         {state->textureY.get(), state->textureU.get(), state->textureV.get()})
+    {
+        if (texture)
+            bytes += textureUtils::getByteCount(texture->textureSize(), 1);
+    }
+    _memory.set(bytes);
+}
@@ -42,6 +42,8 @@
 
 #include "TextureNode.h"
 
+#include "tools/MemoryBudget.h"
+
 #include <QSGNode>
 
 class QQuickWindow;
@@ -84,6 +86,9 @@ private:
     QSize _nextTextureSize;
     TextureFormat _nextFormat;
 
+    size_t _pboBytes = 0;
+    MemoryBudget::Account _memory{MemoryCategory::textures};
+
     bool _needTextureChange() const;
     void _createTextures(const QSize& size, TextureFormat format);
     std::unique_ptr<QSGTexture> _createTexture(const QSize& size) const;
@@ -92,6 +97,7 @@ private:
     void _uploadToPbos(const Image& image);
     void _copyPbosToTextures();
     void _swapPbos();
+    void _accountMemory();
 };
 
 #endif
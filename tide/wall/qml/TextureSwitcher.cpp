@@ -49,6 +49,11 @@ void TextureSwitcher::setNextImage(ImagePtr image)
     _image = image;
 }
 
+bool TextureSwitcher::hasNextImage() const
+{
+    return !!_image;
+}
+
 void TextureSwitcher::requestSwap()
 {
     _swapRequested = true;
@@ -51,6 +51,9 @@ public:
     /** Set the image used to update the back texture in the next update(). */
     void setNextImage(ImagePtr image);
 
+    /** @return true if an image is waiting to be uploaded by update(). */
+    bool hasNextImage() const;
+
     /** Request a swap of the front/back textures in the next update(). */
     void requestSwap();
 
@@ -40,10 +40,23 @@
 #include "qml/Tile.h"
 
 #include "TextureNodeFactory.h"
+#include "WallWindow.h"
+#include "metrics/MetricsRegistry.h"
 #include "utils/log.h"
 
 #include <QSGNode>
 
+namespace
+{
+MetricCounter& _deferredUploadsCounter()
+{
+    static auto& counter = MetricsRegistry::instance().counter(
+        "tide_tile_uploads_deferred_total",
+        "Tile uploads deferred to the next frame to respect the frame budget");
+    return counter;
+}
+}
+
 TilePtr Tile::create(const uint id, const QRect& rect, const TextureType type)
 {
     return TilePtr{new Tile{id, rect, type}};
@@ -72,6 +85,11 @@ bool Tile::getShowBorder() const
     return _textureSwitcher.showBorder;
 }
 
+bool Tile::isCoarse() const
+{
+    return _coarse;
+}
+
 void Tile::setShowBorder(const bool set)
 {
     if (_textureSwitcher.showBorder == set)
@@ -100,11 +118,35 @@ void Tile::updateBackTexture(ImagePtr image, TilePtr self)
         return;
     }
 
-    if (_type == TextureType::static_ && _firstImageUploaded)
+    if (_type == TextureType::static_ && _firstImageUploaded &&
+        !_nextImageCoarse)
+    {
         throw std::logic_error("Static tiles can't be updated");
+    }
+
+    _setNextImage(std::move(image), std::move(self), false);
+}
+
+void Tile::updateBackTextureCoarse(ImagePtr image, TilePtr self)
+{
+    // The full quality image may already be there if it was cached meanwhile
+    if (!image || _firstImageUploaded)
+        return;
+
+    _setNextImage(std::move(image), std::move(self), true);
+}
 
+void Tile::keepFrontTexture(TilePtr self)
+{
+    emit readyToSwap(std::move(self));
+}
+
+void Tile::_setNextImage(ImagePtr image, TilePtr self, const bool coarse)
+{
     _textureSwitcher.setNextImage(std::move(image));
     _firstImageUploaded = true;
+    _nextImageCoarse = coarse;
+    _nextImagePending = true;
 
     // Note: readToSwap() must happen immediately and not in _updateTextureNode,
     // otherwise tiles don't update faster than 30 fps. The reason for this
@@ -123,8 +165,19 @@ void Tile::setSizePolicy(const SizePolicy policy)
 
 void Tile::swapImage()
 {
+    // A swap requested without a new image would apply to the next one
+    if (!_nextImagePending)
+        return;
+    _nextImagePending = false;
+
     _textureSwitcher.requestSwap();
 
+    if (_coarse != _nextImageCoarse)
+    {
+        _coarse = _nextImageCoarse;
+        emit coarseChanged();
+    }
+
     if (!isVisible())
         setVisible(true);
 
@@ -139,6 +192,16 @@ void Tile::swapImage()
 
 QSGNode* Tile::updatePaintNode(QSGNode* node, QQuickItem::UpdatePaintNodeData*)
 {
+    if (_type == TextureType::static_ && _textureSwitcher.hasNextImage() &&
+        !_consumeUpload())
+    {
+        // Keep the current texture and upload the image in the next frame.
+        // Dynamic tiles are never deferred, they must swap synchronously.
+        _deferredUploadsCounter().increment();
+        QMetaObject::invokeMethod(this, "update", Qt::QueuedConnection);
+        return node;
+    }
+
     auto textureNode =
         std::unique_ptr<TextureNode>(dynamic_cast<TextureNode*>(node));
 
@@ -154,6 +217,12 @@ QSGNode* Tile::updatePaintNode(QSGNode* node, QQuickItem::UpdatePaintNodeData*)
     return dynamic_cast<QSGNode*>(textureNode.release());
 }
 
+bool Tile::_consumeUpload()
+{
+    auto wallWindow = qobject_cast<WallWindow*>(window());
+    return !wallWindow || wallWindow->getTileUploadBudget().consume();
+}
+
 void Tile::_onParentChanged(QQuickItem* newParent)
 {
     if (!newParent)
@@ -58,6 +58,7 @@ class Tile : public QQuickItem, public std::enable_shared_from_this<Tile>
     Q_PROPERTY(uint id READ getId CONSTANT)
     Q_PROPERTY(bool showBorder READ getShowBorder WRITE setShowBorder NOTIFY
                    showBorderChanged)
+    Q_PROPERTY(bool coarse READ isCoarse NOTIFY coarseChanged)
 
 public:
     enum SizePolicy
@@ -81,6 +82,9 @@ public:
     /** @return true if this tile displays its borders. */
     bool getShowBorder() const;
 
+    /** @return true if the tile shows a coarse image, pending refinement. */
+    bool isCoarse() const;
+
     /**
      * Request an update of the back texture, resing it if necessary.
      * @param rect the new size for the back texture.
@@ -109,6 +113,24 @@ public slots:
      */
     void updateBackTexture(ImagePtr image, TilePtr self);
 
+    /**
+     * Upload a coarse image to the back texture of a tile without any image.
+     *
+     * The coarse image is shown until the full quality image is uploaded with
+     * updateBackTexture(), which static tiles accept once in this case.
+     * @see updateBackTexture for the *self* parameter.
+     */
+    void updateBackTextureCoarse(ImagePtr image, TilePtr self);
+
+    /**
+     * Keep the front texture at the next swap of a dynamic tile.
+     *
+     * Used when the data source has no new image for the tile in the current
+     * frame, so that synchronized swaps can still proceed.
+     * @see updateBackTexture for the *self* parameter.
+     */
+    void keepFrontTexture(TilePtr self);
+
     /** Show a border around the tile (for debugging purposes). */
     void setShowBorder(bool set);
 
@@ -119,6 +141,9 @@ signals:
     /** Notifier for the showBorder property. */
     void showBorderChanged();
 
+    /** Notifier for the coarse property. */
+    void coarseChanged();
+
     /**
      * Request a texture update from the DataProvider.
      *
@@ -136,13 +161,19 @@ private:
     SizePolicy _policy = AdjustToTexture;
 
     bool _firstImageUploaded = false;
+    bool _nextImageCoarse = false;
+    bool _nextImagePending = false;
+    bool _coarse = false;
     QRect _nextCoord;
     TextureBorderSwitcher _textureSwitcher;
 
     Tile(uint id, const QRect& rect, TextureType type);
 
+    void _setNextImage(ImagePtr image, TilePtr self, bool coarse);
+
     /** Called on the render thread to update the scene graph. */
     QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData*) final;
+    bool _consumeUpload();
     void _onParentChanged(QQuickItem* newParent);
 
     QMetaObject::Connection _widthConn;
@@ -55,6 +55,8 @@
 #include <QQmlContext>
 #include <QQuickItem>
 
+#include <algorithm>
+
 namespace
 {
 const QUrl QML_CONTROL_SURFACE_URL("qrc:/qml/wall/WallControlSurface.qml");
@@ -65,6 +67,7 @@ WallSurfaceRenderer::WallSurfaceRenderer(WallRenderContext context,
                                          QQuickItem& parentItem)
     : _context{std::move(context)}
     , _qmlContext{*_context.engine.rootContext()}
+    , _damage{_context.screenRect}
     , _surface{new Surface{0, DisplayGroup::create(QSize(1, 1))}}
     , _markers{Markers::create(_context.surfaceIndex)}
     , _options{Options::create()}
@@ -91,6 +94,11 @@ void WallSurfaceRenderer::setSurface(SurfacePtr surface)
     _surface = std::move(surface);
 }
 
+void WallSurfaceRenderer::updateWindows(const WindowPtrs& windows)
+{
+    _displayGroupRenderer->updateWindows(windows);
+}
+
 void WallSurfaceRenderer::setMarkers(MarkersPtr markers)
 {
     if (markers->getSurfaceIndex() != _context.surfaceIndex)
@@ -124,6 +132,26 @@ bool WallSurfaceRenderer::needRedraw() const
     return _options->getShowStatistics() || _options->getShowClock();
 }
 
+bool WallSurfaceRenderer::isDamagedBy(const Surface& surface) const
+{
+    return _damage.isDamaged(*_surface, surface);
+}
+
+bool WallSurfaceRenderer::isDamagedBy(const Markers& markers) const
+{
+    if (markers.getSurfaceIndex() != _context.surfaceIndex)
+        return false;
+    return _damage.isDamaged(*_markers, markers);
+}
+
+bool WallSurfaceRenderer::isDamagedBy(const WindowPtrs& windows) const
+{
+    return std::any_of(windows.begin(), windows.end(),
+                       [this](const WindowPtr& window) {
+                           return _damage.isDamaged(*window);
+                       });
+}
+
 void WallSurfaceRenderer::updateRenderedFrames()
 {
     const int frames = _surfaceItem->property("frames").toInt();
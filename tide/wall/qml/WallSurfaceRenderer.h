@@ -44,6 +44,7 @@
 
 #include "BackgroundRenderer.h"
 #include "WallRenderContext.h"
+#include "tools/ScreenDamage.h"
 
 #include <QObject>
 
@@ -71,6 +72,9 @@ public:
     /** Set the Surface to render, replacing the previous one. */
     void setSurface(SurfacePtr surface);
 
+    /** Update windows of the current Surface whose contents changed. */
+    void updateWindows(const WindowPtrs& windows);
+
     /** Set the touchpoint's markers. */
     void setMarkers(MarkersPtr markers);
 
@@ -86,6 +90,15 @@ public:
     /** @return true if the renderer requires a redraw. */
     bool needRedraw() const;
 
+    /** @return true if setSurface() would change the rendering of the screen */
+    bool isDamagedBy(const Surface& surface) const;
+
+    /** @return true if setMarkers() would change the rendering of the screen */
+    bool isDamagedBy(const Markers& markers) const;
+
+    /** @return true if updateWindows() would change the rendering */
+    bool isDamagedBy(const WindowPtrs& windows) const;
+
 public slots:
     /** Increment number of rendered/swapped frames for FPS display. */
     void updateRenderedFrames();
@@ -93,6 +106,7 @@ public slots:
 private:
     WallRenderContext _context;
     QQmlContext& _qmlContext;
+    ScreenDamage _damage;
 
     SurfacePtr _surface;
     MarkersPtr _markers;
@@ -41,10 +41,13 @@
 
 #include "WallConfiguration.h"
 #include "WallRenderContext.h"
+#include "data/GLTexture.h"
+#include "metrics/MetricsRegistry.h"
 #include "qml/TestPattern.h"
 #include "qml/WallSurfaceRenderer.h"
 #include "qml/qscreens.h"
 #include "scene/Background.h"
+#include "scene/Markers.h"
 #include "scene/Options.h"
 #include "scene/Surface.h"
 #include "swapsync/SwapSynchronizer.h"
@@ -58,6 +61,23 @@
 #include <QQmlEngine>
 #include <QQuickRenderControl>
 #include <QThread>
+#include <QTimer>
+
+namespace
+{
+MetricCounter& _framesCounter(const QPoint& globalIndex, const char* result)
+{
+    const auto screen = QString("%1,%2").arg(globalIndex.x()).arg(
+        globalIndex.y());
+    return MetricsRegistry::instance().counter(
+        "tide_wall_screen_frames_total",
+        "Frames rendered or skipped (unchanged) per screen",
+        {{"screen", screen.toStdString()}, {"result", result}});
+}
+}
+
+std::atomic<bool> WallWindow::_skipUnchangedFrames{true};
+std::atomic<uint> WallWindow::_maxTileUploadsPerFrame{0};
 
 WallWindowPtr WallWindow::create(const WallConfiguration& config,
                                  const uint windowIndex, DataProvider& provider)
@@ -112,6 +132,10 @@ WallWindow::WallWindow(const WallConfiguration& config, const uint windowIndex,
         show();
 
     _setupScene(config, windowIndex);
+    _trackDamage();
+
+    _renderedFrames = &_framesCounter(_globalIndex, "rendered");
+    _skippedFrames = &_framesCounter(_globalIndex, "skipped");
 }
 
 WallWindow::~WallWindow()
@@ -138,46 +162,93 @@ bool WallWindow::isInitialized() const
 
 bool WallWindow::needRedraw() const
 {
-    return _surfaceRenderer->needRedraw();
+    return _surfaceRenderer->needRedraw() ||
+           _tileUploadBudget.hasDeferredUploads();
+}
+
+void WallWindow::setSkipUnchangedFrames(const bool enabled)
+{
+    _skipUnchangedFrames = enabled;
+}
+
+void WallWindow::setMaxTileUploadsPerFrame(const uint maxUploads)
+{
+    _maxTileUploadsPerFrame = maxUploads;
+}
+
+TileUploadBudget& WallWindow::getTileUploadBudget()
+{
+    return _tileUploadBudget;
 }
 
 void WallWindow::render(const bool grab)
 {
+    if (!grab && _canSkipFrame())
+    {
+        _skipFrame();
+        return;
+    }
+
+    _damaged = false;
     _grabImage = grab;
+    _tileUploadBudget.reset(_maxTileUploadsPerFrame);
 
     _renderControl->polishItems();
     _quickRenderer->render();
+    _renderedFrames->increment();
 }
 
 void WallWindow::setSurface(SurfacePtr surface)
 {
+    _damaged = _damaged || _surfaceRenderer->isDamagedBy(*surface);
+
+    _ignoreSceneChanges = true;
     setColor(surface->getBackground().getColor());
     _surfaceRenderer->setSurface(surface);
+    _ignoreSceneChanges = false;
+}
+
+void WallWindow::updateWindows(const WindowPtrs& windows)
+{
+    _damaged = _damaged || _surfaceRenderer->isDamagedBy(windows);
+
+    _ignoreSceneChanges = true;
+    _surfaceRenderer->updateWindows(windows);
+    _ignoreSceneChanges = false;
 }
 
 void WallWindow::setScreenLock(ScreenLockPtr lock)
 {
+    _damaged = true;
     _surfaceRenderer->setScreenLock(lock);
 }
 
 void WallWindow::setCountdownStatus(CountdownStatusPtr status)
 {
+    _damaged = true;
     _surfaceRenderer->setCountdownStatus(status);
 }
 
 void WallWindow::setMarkers(MarkersPtr markers)
 {
+    _damaged = _damaged || _surfaceRenderer->isDamagedBy(*markers);
+
+    _ignoreSceneChanges = true;
     _surfaceRenderer->setMarkers(markers);
+    _ignoreSceneChanges = false;
 }
 
 void WallWindow::setRenderOptions(OptionsPtr options)
 {
+    _damaged = true;
     _testPattern->setVisible(options->getShowTestPattern());
     _surfaceRenderer->setRenderingOptions(options);
 }
 
 void WallWindow::exposeEvent(QExposeEvent*)
 {
+    _damaged = true;
+
     // Initialize the renderer once the window is shown for correct GL
     // context realisiation
     if (!_quickRenderer)
@@ -209,6 +280,7 @@ void WallWindow::_startQuickRenderer()
 
                 _quickRenderer->context()->swapBuffers(this);
                 _quickRenderer->context()->functions()->glFlush();
+                GLTexture::deleteReleasedTextures();
                 QMetaObject::invokeMethod(_surfaceRenderer.get(),
                                           "updateRenderedFrames",
                                           Qt::QueuedConnection);
@@ -226,6 +298,38 @@ void WallWindow::_startQuickRenderer()
             });
 }
 
+void WallWindow::_trackDamage()
+{
+    // Changes of the Qml scene that do not come from a scene update, such as
+    // new tile textures or animations, are reported by the render control.
+    const auto setDamaged = [this] {
+        if (!_ignoreSceneChanges)
+            _damaged = true;
+    };
+    connect(_renderControl.get(), &QQuickRenderControl::sceneChanged,
+            setDamaged);
+    connect(_renderControl.get(), &QQuickRenderControl::renderRequested,
+            setDamaged);
+}
+
+bool WallWindow::_canSkipFrame() const
+{
+    if (_damaged || !_skipUnchangedFrames || needRedraw())
+        return false;
+    return !_synchronizer || _synchronizer->canSkipSwap();
+}
+
+void WallWindow::_skipFrame()
+{
+    // The other windows may have changed, join their barrier from the render
+    // thread as the afterRender callback would have done.
+    QTimer::singleShot(0, _quickRenderer.get(), [this] {
+        if (_synchronizer)
+            _synchronizer->globalBarrier(*this);
+    });
+    _skippedFrames->increment();
+}
+
 void WallWindow::_setupScene(const WallConfiguration& config,
                              const uint windowIndex)
 {
@@ -42,10 +42,15 @@
 
 #include "types.h"
 
+#include "tools/TileUploadBudget.h"
+
 #include <deflect/qt/types.h>
 
 #include <QQuickWindow>
 
+#include <atomic>
+
+class MetricCounter;
 class QQuickRenderControl;
 class QQmlEngine;
 
@@ -91,9 +96,28 @@ public:
     bool isInitialized() const;
     bool needRedraw() const;
 
+    /**
+     * Skip rendering the frames in which nothing changed on this screen.
+     *
+     * The window still joins the swap barrier for these frames, if the swap
+     * synchronizer allows it (default: on).
+     */
+    static void setSkipUnchangedFrames(bool enabled);
+
+    /**
+     * Set the maximum number of tile textures uploaded per frame.
+     *
+     * Additional uploads are deferred to the next frame (default: 0, no limit).
+     */
+    static void setMaxTileUploadsPerFrame(uint maxUploads);
+
+    /** @return the budget of tile uploads for the current frame. */
+    TileUploadBudget& getTileUploadBudget();
+
     /**
      * Synchronize scene objects with render thread and trigger frame rendering.
      *
+     * Frames without changes on this screen only join the swap barrier.
      * @param grab indicate that the frame should be grabbed after rendering.
      */
     void render(bool grab = false);
@@ -101,6 +125,13 @@ public:
     /** Set new surface. */
     void setSurface(SurfacePtr surface);
 
+    /**
+     * Update windows whose contents changed without a new surface.
+     * @param windows of the current surface, such as whiteboards whose strokes
+     *        were extended.
+     */
+    void updateWindows(const WindowPtrs& windows);
+
     /** Set new screen lock. */
     void setScreenLock(ScreenLockPtr lock);
 
@@ -126,6 +157,9 @@ private:
 
     void _startQuickRenderer();
     void _setupScene(const WallConfiguration& config, uint windowIndex);
+    void _trackDamage();
+    bool _canSkipFrame() const;
+    void _skipFrame();
 
     DataProvider& _provider;
 
@@ -136,11 +170,22 @@ private:
     SwapSynchronizer* _synchronizer = nullptr;
     bool _grabImage = false;
 
+    /** Set when the scene changes on this screen, reset when rendering. */
+    bool _damaged = true;
+    /** Scene changes caused by updates are checked with ScreenDamage. */
+    bool _ignoreSceneChanges = false;
+    TileUploadBudget _tileUploadBudget;
+    MetricCounter* _renderedFrames = nullptr;
+    MetricCounter* _skippedFrames = nullptr;
+
     std::unique_ptr<deflect::qt::QuickRenderer> _quickRenderer;
     std::unique_ptr<QThread> _quickRendererThread;
     std::unique_ptr<QQmlEngine> _qmlEngine;
     std::unique_ptr<WallSurfaceRenderer> _surfaceRenderer;
     std::unique_ptr<TestPattern> _testPattern;
+
+    static std::atomic<bool> _skipUnchangedFrames;
+    static std::atomic<uint> _maxTileUploadsPerFrame;
 };
 
 #endif
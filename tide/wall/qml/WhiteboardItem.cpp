@@ -0,0 +1,109 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "WhiteboardItem.h"
+
+#include "StrokeNode.h"
+
+#include <QSGSimpleRectNode>
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+const auto noDirtyStroke = std::numeric_limits<size_t>::max();
+}
+
+WhiteboardItem::WhiteboardItem()
+{
+    setFlag(QQuickItem::ItemHasContents, true);
+}
+
+void WhiteboardItem::setStrokes(const std::vector<WhiteboardStroke>& strokes,
+                                const QRectF& visibleArea)
+{
+    std::vector<WhiteboardStroke> visibleStrokes;
+    for (const auto& stroke : strokes)
+    {
+        if (stroke.getBoundingRect().intersects(visibleArea))
+            visibleStrokes.push_back(stroke);
+    }
+
+    const auto mismatch = std::mismatch(_strokes.begin(), _strokes.end(),
+                                        visibleStrokes.begin(),
+                                        visibleStrokes.end());
+    const auto firstChange = size_t(mismatch.first - _strokes.begin());
+    if (mismatch.first == _strokes.end() &&
+        mismatch.second == visibleStrokes.end())
+    {
+        return;
+    }
+
+    _firstDirtyStroke = std::min(_firstDirtyStroke, firstChange);
+    _strokes = std::move(visibleStrokes);
+    update();
+}
+
+size_t WhiteboardItem::getVisibleStrokeCount() const
+{
+    return _strokes.size();
+}
+
+QSGNode* WhiteboardItem::updatePaintNode(QSGNode* oldNode,
+                                         UpdatePaintNodeData*)
+{
+    auto node = static_cast<QSGSimpleRectNode*>(oldNode);
+    if (!node)
+        node = new QSGSimpleRectNode(boundingRect(), Qt::white);
+    else
+        node->setRect(boundingRect());
+
+    while (size_t(node->childCount()) > std::min(_firstDirtyStroke,
+                                                 _strokes.size()))
+    {
+        auto child = node->lastChild();
+        node->removeChildNode(child);
+        delete child;
+    }
+    for (auto i = size_t(node->childCount()); i < _strokes.size(); ++i)
+        node->appendChildNode(new StrokeNode(_strokes[i]));
+
+    _firstDirtyStroke = noDirtyStroke;
+    return node;
+}
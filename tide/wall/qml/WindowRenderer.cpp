@@ -75,6 +75,9 @@ WindowRenderer::WindowRenderer(
                                 _windowContext.get());
     _windowItem->setParentItem(&parentItem);
     _windowItem->setProperty("isBackground", isBackground);
+
+    if (auto contentItem = _synchronizer->getContentItem())
+        contentItem->setParentItem(_getTilesParentItem(0));
 }
 
 WindowRenderer::~WindowRenderer()
@@ -85,6 +88,9 @@ WindowRenderer::~WindowRenderer()
     for (auto& tile : _tiles)
         tile.second->setParentItem(nullptr);
     _tiles.clear();
+
+    if (auto contentItem = _synchronizer->getContentItem())
+        contentItem->setParentItem(nullptr);
 }
 
 void WindowRenderer::update(WindowPtr window, const QRectF& visibleArea)
@@ -122,6 +128,12 @@ void WindowRenderer::_addTile(TilePtr tile, const uint zOrder)
     tile->requestNextFrame(tile);
 }
 
+QQuickItem* WindowRenderer::_getTilesParentItem(const uint zOrder) const
+{
+    auto item = _windowItem->findChild<QQuickItem*>(TILES_PARENT_OBJECT_NAME);
+    return item->childItems().at(zOrder);
+}
+
 QQuickItem* WindowRenderer::_getZoomContextParentItem() const
 {
     return _windowItem->findChild<QQuickItem*>(ZOOM_CONTEXT_PARENT_OBJECT_NAME);
@@ -126,6 +126,13 @@ std::unique_ptr<QSGTexture> createTextureRgba(const QSize& size,
         window.createTextureFromId(textureID, size, textureFlags)};
 }
 
+size_t getByteCount(const QSize& size, const uint bytesPerPixel)
+{
+    // The mipmaps add up to a third of the base level
+    const auto bytes = size_t(size.width()) * size.height() * bytesPerPixel;
+    return bytes + bytes / 3;
+}
+
 std::unique_ptr<QOpenGLBuffer> createPbo(const bool dynamic)
 {
     auto pbo =
@@ -70,6 +70,15 @@ std::unique_ptr<QSGTexture> createTexture(const QSize& size,
 std::unique_ptr<QSGTexture> createTextureRgba(const QSize& size,
                                               QQuickWindow& window);
 
+/**
+ * Estimate the memory used by a texture.
+ *
+ * @param size in pixels.
+ * @param bytesPerPixel of the texture format.
+ * @return the size in bytes, including the mipmaps.
+ */
+size_t getByteCount(const QSize& size, uint bytesPerPixel);
+
 /**
  * Create a Pixel Buffer Object.
  *
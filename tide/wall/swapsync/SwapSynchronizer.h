@@ -57,6 +57,12 @@ public:
 
     /** Remove a window from the barrier, sequentially for each window. */
     virtual void exitBarrier(const QWindow& window) = 0;
+
+    /**
+     * @return true if windows may join the barrier without swapping their
+     *         buffers, to skip rendering frames which have not changed.
+     */
+    virtual bool canSkipSwap() const { return true; }
 };
 
 /**
@@ -78,6 +78,9 @@ public:
     void globalBarrier(const QWindow& window) final;
     void exitBarrier(const QWindow& window) final;
 
+    /** All windows of a swap group must swap together. */
+    bool canSkipSwap() const final { return false; }
+
 private:
     NetworkBarrier& _networkBarrier;
     SharedNetworkBarrier _globalBarrier;
@@ -44,6 +44,8 @@
 
 #include <QObject>
 
+class QQuickItem;
+
 /**
  * Interface for synchronizing QML content rendering.
  *
@@ -117,6 +119,12 @@ public:
     virtual uint getLod() const { return 0; }
     /** @return the number of level of detail. */
     virtual uint getLodCount() const { return 1; }
+
+    /**
+     * @return an item which renders the content natively instead of tiles,
+     *         or nullptr (default).
+     */
+    virtual QQuickItem* getContentItem() const { return nullptr; }
 public slots:
     /**
      * Called when a tile is ready to swap.
@@ -44,9 +44,11 @@
 #include "scene/MultiChannelContent.h"
 
 #include "datasources/PixelStreamUpdater.h"
+#include "datasources/WhiteboardSource.h"
 #include "synchronizers/BasicSynchronizer.h"
 #include "synchronizers/LodSynchronizer.h"
 #include "synchronizers/PixelStreamSynchronizer.h"
+#include "synchronizers/WhiteboardSynchronizer.h"
 
 #if TIDE_ENABLE_MOVIE_SUPPORT
 #include "datasources/MovieUpdater.h"
@@ -58,6 +60,10 @@
 #include "synchronizers/PDFSynchronizer.h"
 #endif
 
+#if TIDE_USE_TIFF
+#include "datasources/ImagePyramidDataSource.h"
+#endif
+
 std::unique_ptr<ContentSynchronizer> ContentSynchronizerFactory::create(
     const Content& content, const deflect::View view,
     std::shared_ptr<DataSource> source)
@@ -101,8 +107,18 @@ std::unique_ptr<ContentSynchronizer> ContentSynchronizerFactory::create(
     }
     case ContentType::image:
     {
+#if TIDE_USE_TIFF
+        // Large images are tiled
+        if (std::dynamic_pointer_cast<ImagePyramidDataSource>(source))
+            return std::make_unique<LodSynchronizer>(source);
+#endif
         return std::make_unique<BasicSynchronizer>(source, view);
     }
+    case ContentType::whiteboard:
+    {
+        return std::make_unique<WhiteboardSynchronizer>(
+            std::dynamic_pointer_cast<WhiteboardSource>(source));
+    }
     default:
         throw std::runtime_error("No ContentSynchronizer for ContentType");
     }
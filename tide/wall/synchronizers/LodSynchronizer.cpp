@@ -43,9 +43,12 @@
 #include "qml/Tile.h"
 #include "scene/Window.h"
 #include "scene/ZoomHelper.h"
+#include "tools/MemoryBudget.h"
 
 #include <QTextStream>
 
+#include <algorithm>
+
 LodSynchronizer::LodSynchronizer(DataSourceSharedPtr source)
     : TiledSynchronizer{TileSwapPolicy::SwapTilesIndependently}
     , _source{std::move(source)}
@@ -168,7 +171,13 @@ QRectF LodSynchronizer::_computeVisibleTilesArea(const Window& window,
 
 uint LodSynchronizer::_findCurrentLod(const Window& window) const
 {
-    return _findLod(ZoomHelper{window}.getContentRect().size().toSize());
+    const auto lod =
+        _findLod(ZoomHelper{window}.getContentRect().size().toSize());
+
+    // Use the next lower resolution while the wall is short of memory
+    if (MemoryBudget::instance().isConstrained())
+        return std::min(lod + 1, getDataSource().getMaxLod());
+    return lod;
 }
 
 uint LodSynchronizer::_findLod(const QSize& targetDisplaySize) const
@@ -84,9 +84,11 @@ protected:
     void update(const Window& window, const QRectF& visibleArea,
                 bool forceUpdate);
 
+    /** @return the visible area in the tiles coordinates of the given lod. */
+    QRectF getVisibleTilesArea(uint lod) const final;
+
 private:
     const DataSource& getDataSource() const final;
-    QRectF getVisibleTilesArea(uint lod) const final;
     QSize _getTilesArea(uint lod) const final;
 
     void _updateLod(const uint lod);
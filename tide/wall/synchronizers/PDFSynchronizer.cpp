@@ -39,12 +39,31 @@
 
 #include "PDFSynchronizer.h"
 
+#include "metrics/MetricsRegistry.h"
+#include "qml/Tile.h"
+
+namespace
+{
+// Page changes taking longer are not measured, e.g. while the wall is busy
+const auto pageChangeTimeout = std::chrono::seconds{10};
+
+MetricHistogram& _pageChangeHistogram()
+{
+    static auto& histogram = MetricsRegistry::instance().histogram(
+        "tide_pdf_page_change_seconds",
+        "Time from a PDF page change until all its visible tiles are shown");
+    return histogram;
+}
+}
+
 PDFSynchronizer::PDFSynchronizer(std::shared_ptr<PDFTiler> source)
     : LodSynchronizer{source}
     , _source{std::move(source)}
 {
-    connect(_source.get(), &PDFTiler::pageChanged,
-            [this] { _pageChanged = true; });
+    connect(_source.get(), &PDFTiler::pageChanged, [this] {
+        _pageChanged = true;
+        _pageChangeTime = clock::now();
+    });
 }
 
 void PDFSynchronizer::update(const Window& window, const QRectF& visibleArea)
@@ -54,11 +73,71 @@ void PDFSynchronizer::update(const Window& window, const QRectF& visibleArea)
     if (_pageChanged)
     {
         _pageChanged = false;
+        _pendingPageLod = getLod();
+        _pendingPageArea = getVisibleTilesArea(_pendingPageLod);
+        _pendingPageTiles = _computeVisibleTiles(_pendingPageLod);
+        _visibleTilesArea = QRectF(); // render the adjacent pages ahead
         emit statisticsChanged();
     }
 }
 
+void PDFSynchronizer::updateTiles()
+{
+    LodSynchronizer::updateTiles();
+
+    const auto lod = getLod();
+    const auto area = getVisibleTilesArea(lod);
+
+    // The tiles of the new page are no longer all going to be shown if the
+    // view changed in the meantime, don't report a wrong flip latency.
+    if (!_pendingPageTiles.empty() &&
+        (area != _pendingPageArea || lod != _pendingPageLod ||
+         clock::now() - _pageChangeTime > pageChangeTimeout))
+    {
+        _pendingPageTiles.clear();
+    }
+
+    if (area == _visibleTilesArea && lod == _visibleTilesLod)
+        return;
+
+    _visibleTilesArea = area;
+    _visibleTilesLod = lod;
+
+    Indices tiles;
+    for (auto i = lod; i < getLodCount(); ++i)
+    {
+        const auto tilesLod = _computeVisibleTiles(i);
+        tiles.insert(tilesLod.begin(), tilesLod.end());
+    }
+    _source->renderAhead(tiles);
+}
+
 QString PDFSynchronizer::getStatistics() const
 {
-    return LodSynchronizer::getStatistics() + " " + _source->getStatistics();
+    auto stats =
+        LodSynchronizer::getStatistics() + " " + _source->getStatistics();
+    if (_pageChangeLatency > 0.0)
+        stats += QString("  flip: %1 ms").arg(_pageChangeLatency, 0, 'f', 0);
+    return stats;
+}
+
+void PDFSynchronizer::onSwapReady(TilePtr tile)
+{
+    const auto id = tile->getId();
+    LodSynchronizer::onSwapReady(std::move(tile));
+
+    if (_pendingPageTiles.erase(id) && _pendingPageTiles.empty())
+    {
+        const auto elapsed = clock::now() - _pageChangeTime;
+        const auto seconds = std::chrono::duration<double>(elapsed).count();
+        _pageChangeHistogram().observe(seconds);
+        _pageChangeLatency = seconds * 1000.0;
+        emit statisticsChanged();
+    }
+}
+
+Indices PDFSynchronizer::_computeVisibleTiles(const uint lod) const
+{
+    return _source->computeVisibleSet(getVisibleTilesArea(lod), lod,
+                                      getChannel());
 }
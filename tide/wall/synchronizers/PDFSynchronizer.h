@@ -44,6 +44,8 @@
 
 #include "datasources/PDFTiler.h" // member
 
+#include <chrono>
+
 /**
  * Synchronize PDF content.
  */
@@ -59,12 +61,30 @@ public:
     /** @copydoc ContentSynchronizer::update */
     void update(const Window& window, const QRectF& visibleArea) final;
 
+    /** @copydoc ContentSynchronizer::updateTiles */
+    void updateTiles() final;
+
     /** @copydoc ContentSynchronizer::getStatistics */
     QString getStatistics() const final;
 
+    /** @copydoc ContentSynchronizer::onSwapReady */
+    void onSwapReady(TilePtr tile) final;
+
 private:
+    using clock = std::chrono::steady_clock;
+
     std::shared_ptr<PDFTiler> _source;
     bool _pageChanged = false;
+    QRectF _visibleTilesArea;
+    uint _visibleTilesLod = 0;
+
+    clock::time_point _pageChangeTime;
+    Indices _pendingPageTiles;
+    QRectF _pendingPageArea;
+    uint _pendingPageLod = 0;
+    double _pageChangeLatency = 0.0;
+
+    Indices _computeVisibleTiles(uint lod) const;
 };
 
 #endif
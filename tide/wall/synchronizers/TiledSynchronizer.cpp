@@ -62,6 +62,14 @@ void TiledSynchronizer::onSwapReady(TilePtr tile)
 
 void TiledSynchronizer::updateTiles()
 {
+    // Higher resolutions may have become available since the last update
+    const auto availableLod = getDataSource().getAvailableLod();
+    if (availableLod != _availableLod)
+    {
+        _availableLod = availableLod;
+        _tilesDirty = true;
+    }
+
     if (!_tilesDirty)
         return;
 
@@ -145,6 +153,9 @@ Indices TiledSynchronizer::_computeVisibleTilesAndAddMissingOnes()
 
 Indices TiledSynchronizer::_computeVisibleTiles(const uint lod) const
 {
+    if (lod < _availableLod)
+        return Indices();
+
     return getDataSource().computeVisibleSet(getVisibleTilesArea(lod), lod,
                                              getChannel());
 }
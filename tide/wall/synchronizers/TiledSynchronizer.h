@@ -115,6 +115,7 @@ private:
 
     bool _tilesDirty = true;
     bool _updateExistingTiles = false;
+    uint _availableLod = 0;
 };
 
 #endif
@@ -0,0 +1,128 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "WhiteboardSynchronizer.h"
+
+#include "datasources/WhiteboardSource.h"
+#include "qml/WhiteboardItem.h"
+#include "scene/Window.h"
+#include "scene/ZoomHelper.h"
+
+#include <QTextStream>
+
+WhiteboardSynchronizer::WhiteboardSynchronizer(
+    std::shared_ptr<WhiteboardSource> source)
+    : _dataSource{std::move(source)}
+    , _item{new WhiteboardItem}
+{
+    _dataSource->synchronizers.register_(this);
+}
+
+WhiteboardSynchronizer::~WhiteboardSynchronizer()
+{
+    _dataSource->synchronizers.deregister(this);
+}
+
+void WhiteboardSynchronizer::update(const Window& window,
+                                    const QRectF& visibleArea)
+{
+    const auto tilesArea = getTilesArea(0);
+    if (QSizeF{_item->width(), _item->height()} != QSizeF(tilesArea))
+    {
+        _item->setSize(QSizeF(tilesArea));
+        emit tilesAreasChanged();
+    }
+
+    const auto visibleTilesArea =
+        ZoomHelper{window}.toTilesArea(visibleArea, tilesArea);
+    const auto& strokes = _dataSource->getStrokes();
+    _item->setStrokes(strokes, visibleTilesArea);
+
+    if (_strokeCount != strokes.size())
+    {
+        _strokeCount = strokes.size();
+        emit statisticsChanged();
+    }
+}
+
+void WhiteboardSynchronizer::updateTiles()
+{
+}
+
+bool WhiteboardSynchronizer::canSwapTiles() const
+{
+    return false;
+}
+
+void WhiteboardSynchronizer::swapTiles()
+{
+}
+
+QString WhiteboardSynchronizer::getStatistics() const
+{
+    QString stats;
+    QTextStream stream(&stats);
+    stream << "  strokes: " << _item->getVisibleStrokeCount() << "/"
+           << _strokeCount;
+    return stats;
+}
+
+void WhiteboardSynchronizer::onSwapReady(TilePtr tile)
+{
+    Q_UNUSED(tile);
+}
+
+bool WhiteboardSynchronizer::hasVisibleTiles() const
+{
+    return _item->getVisibleStrokeCount() > 0;
+}
+
+QQuickItem* WhiteboardSynchronizer::getContentItem() const
+{
+    return _item.get();
+}
+
+const DataSource& WhiteboardSynchronizer::getDataSource() const
+{
+    return *_dataSource;
+}
+
+QSize WhiteboardSynchronizer::_getTilesArea(const uint lod) const
+{
+    return getDataSource().getTilesArea(lod, 0);
+}
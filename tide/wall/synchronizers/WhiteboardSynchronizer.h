@@ -0,0 +1,97 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef WHITEBOARDSYNCHRONIZER_H
+#define WHITEBOARDSYNCHRONIZER_H
+
+#include "synchronizers/ContentSynchronizer.h"
+
+class WhiteboardItem;
+class WhiteboardSource;
+
+/**
+ * Synchronizer for whiteboards, which are rendered natively without tiles.
+ *
+ * The strokes of the WhiteboardSource, which follow the scene updates and the
+ * new points of the strokes being drawn, are passed directly to a
+ * WhiteboardItem which draws them at the resolution of the screen.
+ */
+class WhiteboardSynchronizer : public ContentSynchronizer
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(WhiteboardSynchronizer)
+
+public:
+    /** Constructor */
+    explicit WhiteboardSynchronizer(std::shared_ptr<WhiteboardSource> source);
+    ~WhiteboardSynchronizer();
+
+    /** @copydoc ContentSynchronizer::update */
+    void update(const Window& window, const QRectF& visibleArea) override;
+
+    /** @copydoc ContentSynchronizer::updateTiles */
+    void updateTiles() override;
+
+    /** @copydoc ContentSynchronizer::canSwapTiles */
+    bool canSwapTiles() const override;
+
+    /** @copydoc ContentSynchronizer::swapTiles */
+    void swapTiles() override;
+
+    /** @copydoc ContentSynchronizer::getStatistics */
+    QString getStatistics() const override;
+
+    /** @copydoc ContentSynchronizer::onSwapReady */
+    void onSwapReady(TilePtr tile) override;
+
+    /** @copydoc ContentSynchronizer::hasVisibleTiles */
+    bool hasVisibleTiles() const override;
+
+    /** @copydoc ContentSynchronizer::getContentItem */
+    QQuickItem* getContentItem() const override;
+
+private:
+    const DataSource& getDataSource() const final;
+    QSize _getTilesArea(uint lod) const final;
+
+    std::shared_ptr<WhiteboardSource> _dataSource;
+    std::unique_ptr<WhiteboardItem> _item;
+    size_t _strokeCount = 0;
+};
+
+#endif
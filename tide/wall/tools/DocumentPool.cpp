@@ -0,0 +1,80 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "DocumentPool.h"
+
+#include "metrics/MetricsRegistry.h"
+
+std::atomic<size_t> DocumentPoolBase::_maxInstances{2};
+
+void DocumentPoolBase::setMaxInstances(const size_t count)
+{
+    _maxInstances = std::max(count, size_t{1});
+}
+
+size_t DocumentPoolBase::getMaxInstances()
+{
+    return MemoryBudget::instance().isConstrained() ? 1 : _maxInstances.load();
+}
+
+DocumentPoolBase::DocumentPoolBase(const std::string& type,
+                                   const size_t instanceBytes)
+    : _instanceBytes{instanceBytes}
+    , _instancesGauge{MetricsRegistry::instance().gauge(
+          "tide_document_pool_instances",
+          "Parsed document instances held by the document pools",
+          {{"type", type}})}
+    , _bytesGauge{MetricsRegistry::instance().gauge(
+          "tide_document_pool_bytes",
+          "Estimated memory used by the parsed documents of the pools",
+          {{"type", type}})}
+{
+}
+
+DocumentPoolBase::~DocumentPoolBase()
+{
+    accountInstances(-_accountedInstances);
+}
+
+void DocumentPoolBase::accountInstances(const int count)
+{
+    _accountedInstances += count;
+    _instancesGauge.add(count);
+    _bytesGauge.add(double(count) * _instanceBytes);
+    _memory.add(int64_t(count) * int64_t(_instanceBytes));
+}
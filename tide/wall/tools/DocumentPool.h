@@ -0,0 +1,302 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef DOCUMENTPOOL_H
+#define DOCUMENTPOOL_H
+
+#include "MemoryBudget.h"
+
+#include <QString>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class MetricGauge;
+
+/**
+ * Settings and memory accounting common to all the DocumentPool types.
+ */
+class DocumentPoolBase
+{
+public:
+    /** Set the max number of parsed instances of each document (default 2). */
+    static void setMaxInstances(size_t count);
+
+    /**
+     * @return the max number of parsed instances of each document, only one
+     *         while the MemoryBudget is constrained.
+     */
+    static size_t getMaxInstances();
+
+protected:
+    /**
+     * @param type of documents, used to label the metrics
+     * @param instanceBytes estimated memory usage of one instance
+     */
+    DocumentPoolBase(const std::string& type, size_t instanceBytes);
+    ~DocumentPoolBase();
+
+    /** Account for created (positive) or destroyed (negative) instances. */
+    void accountInstances(int count);
+
+    /** @return the estimated memory usage of one instance. */
+    size_t getInstanceBytes() const { return _instanceBytes; }
+
+private:
+    const size_t _instanceBytes;
+    std::atomic<int> _accountedInstances{0};
+    MetricGauge& _instancesGauge;
+    MetricGauge& _bytesGauge;
+    MemoryBudget::Account _memory{MemoryCategory::documents};
+
+    static std::atomic<size_t> _maxInstances;
+};
+
+/**
+ * A bounded pool of parsed documents shared by concurrent render tasks.
+ *
+ * Parsing a document is expensive and its instances can't be used by several
+ * threads at once. Render tasks check out an instance for the duration of a
+ * render call; instances are created on demand up to getMaxInstances(), after
+ * which tasks wait for an instance to be returned to the pool.
+ *
+ * @tparam Document the type of documents, which must not be shared by threads
+ */
+template <typename Document>
+class DocumentPool : public DocumentPoolBase
+{
+public:
+    using Factory = std::function<std::unique_ptr<Document>()>;
+    using Preference = std::function<bool(const Document&)>;
+
+    /** An instance checked out of the pool, returned when destroyed. */
+    class Handle
+    {
+    public:
+        Handle(Handle&& other) = default;
+        ~Handle()
+        {
+            if (_document)
+                _pool->_checkin(std::move(_document));
+        }
+
+        Document& operator*() const { return *_document; }
+        Document* operator->() const { return _document.get(); }
+    private:
+        friend class DocumentPool;
+        Handle(DocumentPool& pool, std::unique_ptr<Document> document)
+            : _pool{&pool}
+            , _document{std::move(document)}
+        {
+        }
+
+        DocumentPool* _pool;
+        std::unique_ptr<Document> _document;
+    };
+
+    /**
+     * Create a pool.
+     * @param type of documents, used to label the metrics
+     * @param factory to create (parse) new instances of the document
+     * @param instanceBytes estimated memory usage of one instance
+     */
+    DocumentPool(const std::string& type, Factory factory,
+                 const size_t instanceBytes)
+        : DocumentPoolBase{type, instanceBytes}
+        , _factory{std::move(factory)}
+    {
+    }
+
+    /**
+     * Get the pool of a document, shared by all its users in the process.
+     * @param uri of the document
+     * @param type @see DocumentPool()
+     * @param factory @see DocumentPool(), only used for creating a new pool
+     * @param instanceBytes @see DocumentPool()
+     */
+    static std::shared_ptr<DocumentPool> getShared(const QString& uri,
+                                                   const std::string& type,
+                                                   Factory factory,
+                                                   const size_t instanceBytes)
+    {
+        static std::mutex mutex;
+        static std::map<QString, std::weak_ptr<DocumentPool>> pools;
+
+        const std::lock_guard<std::mutex> lock{mutex};
+        for (auto it = pools.begin(); it != pools.end();)
+        {
+            if (it->second.expired())
+                it = pools.erase(it);
+            else
+                ++it;
+        }
+
+        auto pool = pools[uri].lock();
+        if (!pool)
+        {
+            pool = std::make_shared<DocumentPool>(type, std::move(factory),
+                                                  instanceBytes);
+            pools[uri] = pool;
+        }
+        return pool;
+    }
+
+    /**
+     * Check out an instance, blocking until one is available. Threadsafe.
+     *
+     * @param preferred optional function to select among the idle instances,
+     *        for example the one already positioned on the page to render
+     * @throw any exception thrown by the factory
+     */
+    Handle checkout(const Preference& preferred = Preference())
+    {
+        std::unique_lock<std::mutex> lock{_mutex};
+        while (true)
+        {
+            if (!_idle.empty())
+                return Handle{*this, _takeIdle(preferred)};
+
+            if (_instanceCount < getMaxInstances())
+            {
+                ++_instanceCount;
+                lock.unlock();
+                try
+                {
+                    auto document = _factory();
+                    accountInstances(1);
+                    return Handle{*this, std::move(document)};
+                }
+                catch (...)
+                {
+                    lock.lock();
+                    --_instanceCount;
+                    _available.notify_one();
+                    throw;
+                }
+            }
+            _available.wait(lock);
+        }
+    }
+
+    /**
+     * Check out an idle instance without waiting or creating one. Threadsafe.
+     *
+     * @param preferred @see checkout()
+     * @return the instance, or nullptr if none is idle
+     */
+    std::unique_ptr<Handle> tryCheckout(
+        const Preference& preferred = Preference())
+    {
+        const std::lock_guard<std::mutex> lock{_mutex};
+        if (_idle.empty())
+            return nullptr;
+        return std::unique_ptr<Handle>{new Handle{*this, _takeIdle(preferred)}};
+    }
+
+    /** @return the number of instances created by the pool. */
+    size_t getInstanceCount() const
+    {
+        const std::lock_guard<std::mutex> lock{_mutex};
+        return _instanceCount;
+    }
+
+private:
+    const Factory _factory;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _available;
+    std::vector<std::unique_ptr<Document>> _idle;
+    size_t _instanceCount = 0;
+
+    MemoryBudget::Reclaimer _reclaimer{MemoryCategory::documents,
+                                       [this](const size_t bytes) {
+                                           return _releaseIdle(bytes);
+                                       }};
+
+    std::unique_ptr<Document> _takeIdle(const Preference& preferred)
+    {
+        auto it = _idle.end() - 1; // most recently used
+        if (preferred)
+        {
+            const auto match = std::find_if(
+                _idle.begin(), _idle.end(),
+                [&preferred](const auto& doc) { return preferred(*doc); });
+            if (match != _idle.end())
+                it = match;
+        }
+        auto document = std::move(*it);
+        _idle.erase(it);
+        return document;
+    }
+
+    /** Release the least recently used idle instances, keeping one. */
+    size_t _releaseIdle(const size_t bytes)
+    {
+        std::vector<std::unique_ptr<Document>> released;
+        {
+            const std::lock_guard<std::mutex> lock{_mutex};
+            while (!_idle.empty() && _instanceCount > 1 &&
+                   released.size() * getInstanceBytes() < bytes)
+            {
+                released.push_back(std::move(_idle.front()));
+                _idle.erase(_idle.begin());
+                --_instanceCount;
+            }
+        }
+        accountInstances(-int(released.size()));
+        return released.size() * getInstanceBytes();
+    }
+
+    void _checkin(std::unique_ptr<Document> document)
+    {
+        {
+            const std::lock_guard<std::mutex> lock{_mutex};
+            _idle.push_back(std::move(document));
+        }
+        _available.notify_one();
+    }
+};
+
+#endif
@@ -1,6 +1,5 @@
 /*********************************************************************/
-/* Copyright (c) 2016-2018, EPFL/Blue Brain Project                  */
-/*                          Pawel Podhajski <pawel.podhajski@epfl.ch>*/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
 /* All rights reserved.                                              */
 /*                                                                   */
 /* Redistribution and use in source and binary forms, with or        */
@@ -37,47 +36,65 @@
 /* or implied, of Ecole polytechnique federale de Lausanne.          */
 /*********************************************************************/
 
-#include "Whiteboard.h"
+#include "FramePacer.h"
 
-#include "tide/master/localstreamer/CommandLineOptions.h"
-#include "tide/master/localstreamer/QmlKeyInjector.h"
-
-#include <QQmlContext>
+#include <stdexcept>
 
 namespace
 {
-const std::string deflectHost("localhost");
-const QString deflectQmlFile("qrc:/whiteboard/qml/Whiteboard.qml");
+FramePacer::clock::duration _toPeriod(const unsigned int frameRate)
+{
+    if (frameRate == 0)
+        throw std::invalid_argument("target frame rate must be positive");
+
+    const auto period = std::chrono::duration<double>(1.0 / frameRate);
+    return std::chrono::duration_cast<FramePacer::clock::duration>(period);
+}
+}
+
+FramePacer::FramePacer(const unsigned int targetFrameRate)
+    : _targetFrameRate{targetFrameRate}
+    , _period{_toPeriod(targetFrameRate)}
+{
+}
+
+unsigned int FramePacer::getTargetFrameRate() const
+{
+    return _targetFrameRate;
 }
 
-Whiteboard::Whiteboard(int& argc, char* argv[])
-    : QGuiApplication(argc, argv)
+FramePacer::clock::duration FramePacer::getFramePeriod() const
 {
-    const CommandLineOptions options(argc, argv);
+    return _period;
+}
 
-    const auto deflectStreamId = options.streamId.toStdString();
-    _qmlStreamer.reset(new deflect::qt::QmlStreamer(deflectQmlFile, deflectHost,
-                                                    deflectStreamId));
+FramePacer::clock::duration FramePacer::getDelayToNextFrame(
+    const clock::time_point now) const
+{
+    const auto nextFrame = getDeadline();
+    return nextFrame > now ? nextFrame - now : clock::duration::zero();
+}
 
-    connect(_qmlStreamer.get(), &deflect::qt::QmlStreamer::streamClosed, this,
-            &QCoreApplication::quit);
+void FramePacer::startFrame(const clock::time_point now)
+{
+    _frameStart = now;
+}
 
-    auto item = _qmlStreamer->getRootItem();
-    item->setProperty("saveURL", options.saveDir);
+bool FramePacer::endFrame(const clock::time_point now)
+{
+    if (now <= getDeadline())
+        return true;
 
-    // General setup
-    if (options.width)
-        item->setProperty("width", options.width);
-    if (options.height)
-        item->setProperty("height", options.height);
+    ++_missedDeadlines;
+    return false;
+}
 
-    QQmlEngine* engine = _qmlStreamer->getQmlEngine();
-    engine->rootContext()->setContextProperty("fileInfo", &_fileInfoHelper);
+FramePacer::clock::time_point FramePacer::getDeadline() const
+{
+    return _frameStart + _period;
 }
 
-bool Whiteboard::event(QEvent* event_)
+size_t FramePacer::getMissedDeadlines() const
 {
-    if (auto inputEvent = dynamic_cast<QInputMethodEvent*>(event_))
-        return QmlKeyInjector::send(inputEvent, _qmlStreamer->getRootItem());
-    return QGuiApplication::event(event_);
+    return _missedDeadlines;
 }
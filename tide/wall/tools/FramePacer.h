@@ -0,0 +1,94 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include <chrono>
+
+/**
+ * Schedule wall frames at a target rate and track their deadlines.
+ *
+ * Each frame has until the start of the next one to complete. Frames which
+ * overrun it are counted as missed and the next frame starts immediately, so
+ * that an occasional slow frame does not delay all the following ones.
+ */
+class FramePacer
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * Create a frame pacer.
+     * @param targetFrameRate in frames per second.
+     * @throw std::invalid_argument if the frame rate is zero.
+     */
+    explicit FramePacer(unsigned int targetFrameRate);
+
+    /** @return the target frame rate. */
+    unsigned int getTargetFrameRate() const;
+
+    /** @return the period between the start of two frames. */
+    clock::duration getFramePeriod() const;
+
+    /** @return the time to wait before starting the next frame. */
+    clock::duration getDelayToNextFrame(clock::time_point now) const;
+
+    /** Mark the start of a frame. */
+    void startFrame(clock::time_point now);
+
+    /**
+     * Mark the end of the current frame.
+     * @return false if the frame missed its deadline.
+     */
+    bool endFrame(clock::time_point now);
+
+    /** @return the deadline of the current frame. */
+    clock::time_point getDeadline() const;
+
+    /** @return the number of frames which missed their deadline. */
+    size_t getMissedDeadlines() const;
+
+private:
+    const unsigned int _targetFrameRate;
+    const clock::duration _period;
+    clock::time_point _frameStart;
+    size_t _missedDeadlines = 0;
+};
+
+#endif
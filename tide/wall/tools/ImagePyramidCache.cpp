@@ -0,0 +1,225 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "ImagePyramidCache.h"
+
+#include "data/TiffPyramidWriter.h"
+#include "utils/log.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QLockFile>
+#include <QMutex>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <map>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+namespace
+{
+// Generating a pyramid can take minutes, which must not hold the threads of
+// the global pool used for loading tiles. The pool is never destroyed so that
+// exiting does not wait for a generation in progress.
+QThreadPool& _generationPool()
+{
+    static auto pool = [] {
+        auto threadPool = new QThreadPool;
+        threadPool->setMaxThreadCount(1);
+        return threadPool;
+    }();
+    return *pool;
+}
+}
+
+ImagePyramidCache::ImagePyramidCache(const QString& folder,
+                                     const qint64 maxBytes)
+    : _folder{folder}
+    , _maxBytes{maxBytes}
+{
+}
+
+QString ImagePyramidCache::getDefaultFolder()
+{
+    const auto user = QString::fromLocal8Bit(qgetenv("USER"));
+    return QDir::temp().filePath("tide-pyramids-" + user);
+}
+
+QString ImagePyramidCache::getPyramid(const QString& imageUri) const
+{
+    const auto path = getPyramidPath(imageUri);
+    if (QFileInfo::exists(path))
+        return path;
+
+    if (!QDir().mkpath(_folder))
+        throw std::runtime_error("Could not create pyramid cache folder");
+
+    // Generating a pyramid can take minutes, rely only on the process id to
+    // detect locks left by processes which crashed.
+    QLockFile lock{path + ".lock"};
+    lock.setStaleLockTime(0);
+    if (!lock.lock())
+        throw std::runtime_error("Could not lock pyramid cache");
+
+    // Another process may have generated the pyramid while we were waiting
+    if (QFileInfo::exists(path))
+        return path;
+
+    evict();
+
+    print_log(LOG_INFO, LOG_TIFF, "Generating image pyramid for: %s",
+              imageUri.toLocal8Bit().constData());
+    QElapsedTimer timer;
+    timer.start();
+
+    // Write to a temporary file so that incomplete pyramids are never used
+    const auto tmpPath = path + ".tmp";
+    auto options = TiffPyramidWriter::Options();
+    options.tileSize = QSize(tileSize, tileSize);
+    try
+    {
+        TiffPyramidWriter{options}.write(imageUri, tmpPath);
+    }
+    catch (...)
+    {
+        QFile::remove(tmpPath);
+        throw;
+    }
+    if (!QFile::rename(tmpPath, path))
+    {
+        QFile::remove(tmpPath);
+        throw std::runtime_error("Could not move pyramid to cache");
+    }
+
+    print_log(LOG_INFO, LOG_TIFF, "Image pyramid generated in %.1f s",
+              timer.elapsed() / 1000.0);
+    return path;
+}
+
+QFuture<QString> ImagePyramidCache::generatePyramid(
+    const QString& imageUri) const
+{
+    static QMutex mutex;
+    static std::map<QString, QFuture<QString>> generations;
+
+    const auto path = getPyramidPath(imageUri);
+    const QMutexLocker lock(&mutex);
+
+    // The pyramids of the finished generations are on disk, or have failed
+    for (auto it = generations.begin(); it != generations.end();)
+        it = it->second.isFinished() ? generations.erase(it) : std::next(it);
+
+    const auto it = generations.find(path);
+    if (it != generations.end())
+        return it->second;
+
+    const auto cache = *this;
+    auto future = QtConcurrent::run(&_generationPool(), [cache, imageUri] {
+        try
+        {
+            return cache.getPyramid(imageUri);
+        }
+        catch (const std::runtime_error& e)
+        {
+            print_log(LOG_WARN, LOG_TIFF,
+                      "Could not generate image pyramid for: %s - %s",
+                      imageUri.toLocal8Bit().constData(), e.what());
+            return QString();
+        }
+    });
+    generations[path] = future;
+    return future;
+}
+
+QString ImagePyramidCache::getPyramidPath(const QString& imageUri) const
+{
+    const auto info = QFileInfo(imageUri);
+    const auto key = QString("%1:%2:%3")
+                         .arg(info.absoluteFilePath())
+                         .arg(info.size())
+                         .arg(info.lastModified().toMSecsSinceEpoch());
+    const auto hash =
+        QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1);
+    return QDir(_folder).filePath(QString::fromLatin1(hash.toHex()) + ".tif");
+}
+
+void ImagePyramidCache::markUsed(const QString& pyramidPath)
+{
+    // The modification time tells when the pyramid was generated, keep it
+    const timespec times[2] = {{0, UTIME_NOW}, {0, UTIME_OMIT}};
+    utimensat(AT_FDCWD, QFile::encodeName(pyramidPath).constData(), times, 0);
+}
+
+void ImagePyramidCache::evict() const
+{
+    auto files = QDir(_folder).entryInfoList({"*.tif"}, QDir::Files);
+    std::sort(files.begin(), files.end(),
+              [](const QFileInfo& a, const QFileInfo& b) {
+                  return a.lastRead() < b.lastRead();
+              });
+
+    auto totalBytes = qint64{0};
+    for (const auto& file : files)
+        totalBytes += file.size();
+
+    const auto now = QDateTime::currentDateTime();
+    const auto maxUnusedSeconds = qint64{maxUnusedDays} * 24 * 3600;
+    for (const auto& file : files)
+    {
+        const auto unusedSeconds = file.lastRead().secsTo(now);
+        const auto expired = unusedSeconds > maxUnusedSeconds;
+        const auto overLimit =
+            totalBytes > _maxBytes && unusedSeconds > minUnusedSeconds;
+        if (!expired && !overLimit)
+            continue;
+
+        if (QFile::remove(file.absoluteFilePath()))
+        {
+            totalBytes -= file.size();
+            print_log(LOG_INFO, LOG_TIFF, "Removed unused image pyramid: %s",
+                      file.absoluteFilePath().toLocal8Bit().constData());
+        }
+    }
+}
@@ -0,0 +1,125 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef IMAGEPYRAMIDCACHE_H
+#define IMAGEPYRAMIDCACHE_H
+
+#include <QFuture>
+#include <QString>
+
+/**
+ * Cache of TIFF pyramids generated from large regular images.
+ *
+ * The cache is stored on disk and shared by all the wall processes of a host.
+ * A lock file guarantees that each pyramid is generated only once, the other
+ * processes wait for it and then reuse it. Pyramids are identified by the path,
+ * size and modification time of their source image.
+ *
+ * The pyramids which have not been used for a long time, then the least
+ * recently used ones above the size limit of the cache are removed before
+ * generating a new one.
+ */
+class ImagePyramidCache
+{
+public:
+    /** Tile size of the generated pyramids. */
+    static constexpr int tileSize = 512;
+
+    /** Default size limit of the cache. */
+    static constexpr qint64 defaultMaxBytes = qint64(20) << 30;
+
+    /** Pyramids unused for this number of days are removed. */
+    static constexpr int maxUnusedDays = 30;
+
+    /** Pyramids used within this number of seconds are never removed. */
+    static constexpr int minUnusedSeconds = 3600;
+
+    /**
+     * Create a cache in the given folder.
+     * @param folder where the pyramids are stored
+     * @param maxBytes size above which the least recently used pyramids are
+     *        removed
+     */
+    explicit ImagePyramidCache(const QString& folder = getDefaultFolder(),
+                               qint64 maxBytes = defaultMaxBytes);
+
+    /** @return the default folder, in the temporary folder of the host. */
+    static QString getDefaultFolder();
+
+    /**
+     * Get the pyramid of an image, generating it if needed.
+     *
+     * Blocks until the pyramid is available. Threadsafe and safe to call from
+     * multiple processes.
+     * @param imageUri the source image
+     * @return the path of the TIFF pyramid
+     * @throw std::runtime_error if the pyramid could not be generated
+     */
+    QString getPyramid(const QString& imageUri) const;
+
+    /**
+     * Get the pyramid of an image in the background, generating it if needed.
+     *
+     * The pyramids are generated in a dedicated thread, and only once per
+     * process for concurrent requests, so that the global thread pool used to
+     * load the tiles is never blocked for the duration of a generation.
+     * Threadsafe.
+     * @param imageUri the source image
+     * @return the future path of the TIFF pyramid, which is empty if the
+     *         pyramid could not be generated
+     */
+    QFuture<QString> generatePyramid(const QString& imageUri) const;
+
+    /** @return the path where the pyramid of an image is (to be) cached. */
+    QString getPyramidPath(const QString& imageUri) const;
+
+    /**
+     * Mark a pyramid as used now, to protect it from being removed.
+     * @param pyramidPath the path of the TIFF pyramid
+     */
+    static void markUsed(const QString& pyramidPath);
+
+    /** Remove the expired pyramids, then reduce the cache to its size limit. */
+    void evict() const;
+
+private:
+    QString _folder;
+    qint64 _maxBytes;
+};
+
+#endif
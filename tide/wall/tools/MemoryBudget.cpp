@@ -0,0 +1,223 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "MemoryBudget.h"
+
+#include "data/Image.h"
+#include "metrics/MetricsRegistry.h"
+#include "utils/log.h"
+
+#include <algorithm>
+
+namespace
+{
+const std::array<const char*, 5> categoryNames{
+    {"tiles", "documents", "movies", "streams", "textures"}};
+
+MetricCounter& _reclaimedBytes()
+{
+    static auto& counter = MetricsRegistry::instance().counter(
+        "tide_wall_memory_reclaimed_bytes_total",
+        "Memory released to stay within the memory budget of the process");
+    return counter;
+}
+
+size_t _toMB(const size_t bytes)
+{
+    return bytes / (1024 * 1024);
+}
+}
+
+constexpr double MemoryBudget::reclaimTarget;
+constexpr double MemoryBudget::lowWatermark;
+constexpr std::chrono::seconds MemoryBudget::minConstrainedTime;
+
+MemoryBudget::Account::Account(const MemoryCategory category)
+    : _usage(MemoryBudget::instance()._getGauge(category))
+{
+}
+
+MemoryBudget::Account::~Account()
+{
+    _usage.add(-double(_bytes.load()));
+}
+
+void MemoryBudget::Account::add(const int64_t bytes)
+{
+    _bytes += bytes;
+    _usage.add(double(bytes));
+}
+
+void MemoryBudget::Account::set(const size_t bytes)
+{
+    const auto previous = _bytes.exchange(int64_t(bytes));
+    _usage.add(double(int64_t(bytes) - previous));
+}
+
+MemoryBudget::Reclaimer::Reclaimer(const MemoryCategory category,
+                                   ReclaimFunc func)
+    : _category{category}
+    , _func{std::move(func)}
+{
+    auto& budget = MemoryBudget::instance();
+    const std::lock_guard<std::mutex> lock{budget._mutex};
+    budget._reclaimers.push_back(this);
+}
+
+MemoryBudget::Reclaimer::~Reclaimer()
+{
+    // Waits for the completion of enforce() if it is in progress
+    auto& budget = MemoryBudget::instance();
+    const std::lock_guard<std::mutex> lock{budget._mutex};
+    budget._reclaimers.remove(this);
+}
+
+MemoryBudget& MemoryBudget::instance()
+{
+    static MemoryBudget budget;
+    return budget;
+}
+
+size_t MemoryBudget::getByteCount(const Image& image)
+{
+    const auto planes = image.getFormat() == TextureFormat::rgba ? 1u : 3u;
+    auto bytes = size_t{0};
+    for (auto plane = 0u; plane < planes; ++plane)
+        bytes += image.getDataSize(plane);
+    return bytes;
+}
+
+MemoryBudget::MemoryBudget()
+    : _limitGauge(MetricsRegistry::instance().gauge(
+          "tide_wall_memory_budget_bytes",
+          "Memory budget of the wall process (0: no limit)"))
+    , _constrainedGauge(MetricsRegistry::instance().gauge(
+          "tide_wall_memory_constrained",
+          "Whether contents are degraded to stay within the memory budget"))
+{
+    auto& registry = MetricsRegistry::instance();
+    for (size_t i = 0; i < _usage.size(); ++i)
+    {
+        _usage[i] = &registry.gauge("tide_wall_memory_bytes",
+                                    "Memory accounted by the wall process",
+                                    {{"category", categoryNames[i]}});
+    }
+}
+
+void MemoryBudget::setLimit(const size_t bytes)
+{
+    _limit = bytes;
+    _limitGauge.set(bytes);
+}
+
+size_t MemoryBudget::getUsage() const
+{
+    auto usage = 0.0;
+    for (const auto gauge : _usage)
+        usage += gauge->get();
+    return size_t(std::max(usage, 0.0));
+}
+
+size_t MemoryBudget::getUsage(const MemoryCategory category) const
+{
+    return size_t(std::max(_getGauge(category).get(), 0.0));
+}
+
+bool MemoryBudget::enforce(const clock::time_point now)
+{
+    const auto limit = getLimit();
+    if (limit == 0)
+        return false;
+
+    // While over the limit recently, release all that can be to go below the
+    // low watermark. Otherwise leave a margin to avoid reclaiming every frame.
+    auto usage = getUsage();
+    const auto target =
+        size_t(limit * (_overLimit ? lowWatermark : reclaimTarget));
+    if (usage > target && (_overLimit || usage > limit))
+        usage -= std::min(usage, _reclaim(usage - target));
+
+    if (usage > limit)
+    {
+        if (!_overLimit)
+        {
+            print_log(LOG_WARN, LOG_GENERAL,
+                      "memory usage of %zu MB exceeds the budget of %zu MB",
+                      _toMB(usage), _toMB(limit));
+        }
+        _overLimit = true;
+        _lastOverLimit = now;
+    }
+    else if (_overLimit && usage < limit * lowWatermark &&
+             now - _lastOverLimit >= minConstrainedTime)
+    {
+        _overLimit = false;
+    }
+    return _overLimit;
+}
+
+void MemoryBudget::setConstrained(const bool constrained)
+{
+    _constrained = constrained;
+    _constrainedGauge.set(constrained ? 1.0 : 0.0);
+}
+
+MetricGauge& MemoryBudget::_getGauge(const MemoryCategory category) const
+{
+    return *_usage[size_t(category)];
+}
+
+size_t MemoryBudget::_reclaim(const size_t bytes)
+{
+    auto reclaimed = size_t{0};
+    {
+        const std::lock_guard<std::mutex> lock{_mutex};
+        for (auto i = 0u; i < _usage.size() && reclaimed < bytes; ++i)
+        {
+            for (const auto reclaimer : _reclaimers)
+            {
+                if (reclaimed >= bytes)
+                    break;
+                if (size_t(reclaimer->_category) == i)
+                    reclaimed += reclaimer->_func(bytes - reclaimed);
+            }
+        }
+    }
+    _reclaimedBytes().increment(reclaimed);
+    return reclaimed;
+}
@@ -0,0 +1,190 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef MEMORYBUDGET_H
+#define MEMORYBUDGET_H
+
+#include "types.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <list>
+#include <mutex>
+
+class MetricGauge;
+
+/** The categories of memory accounted by the MemoryBudget. */
+enum class MemoryCategory
+{
+    tiles,     // Cached tiles of static contents
+    documents, // Parsed PDF/SVG document instances
+    movies,    // Decoded movie frames
+    streams,   // Pixel stream frames
+    textures   // GPU textures and pixel buffers
+};
+
+/**
+ * Memory accounting and budget of a wall process.
+ *
+ * The components which hold large amounts of memory account for it in a
+ * category, and those which can release memory on demand register a reclaimer.
+ * When the usage exceeds the limit, enforce() calls the reclaimers until the
+ * usage is back under the limit (with some margin). If that is not enough, the
+ * budget becomes constrained and the wall degrades the quality of the contents
+ * until the usage has been back under a low watermark for a while.
+ *
+ * The usage of each category is published as a metric, which is reported to
+ * the master application. Accounting is threadsafe and lock-free.
+ */
+class MemoryBudget
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    /** The memory accounted for a component, released when destroyed. */
+    class Account
+    {
+    public:
+        explicit Account(MemoryCategory category);
+        ~Account();
+
+        Account(const Account&) = delete;
+        Account& operator=(const Account&) = delete;
+
+        /** Add (or remove if negative) bytes to the account, threadsafe. */
+        void add(int64_t bytes);
+
+        /** Set the number of bytes of the account, threadsafe. */
+        void set(size_t bytes);
+
+        /** @return the number of bytes of the account. */
+        size_t get() const { return size_t(_bytes.load()); }
+    private:
+        MetricGauge& _usage;
+        std::atomic<int64_t> _bytes{0};
+    };
+
+    /**
+     * Function to release some memory.
+     * @param bytes the amount of memory that should be released
+     * @return the amount of memory actually released
+     */
+    using ReclaimFunc = std::function<size_t(size_t bytes)>;
+
+    /** A ReclaimFunc registered with the budget while this object lives. */
+    class Reclaimer
+    {
+    public:
+        Reclaimer(MemoryCategory category, ReclaimFunc func);
+        ~Reclaimer();
+
+        Reclaimer(const Reclaimer&) = delete;
+        Reclaimer& operator=(const Reclaimer&) = delete;
+
+    private:
+        friend class MemoryBudget;
+        const MemoryCategory _category;
+        const ReclaimFunc _func;
+    };
+
+    /** The usage is reduced to this fraction of the limit when reclaiming. */
+    static constexpr double reclaimTarget = 0.9;
+
+    /** The budget stays constrained until the usage goes below this. */
+    static constexpr double lowWatermark = 0.75;
+
+    /** Minimum duration of the constrained state. */
+    static constexpr std::chrono::seconds minConstrainedTime{10};
+
+    /** @return the budget of the current process. */
+    static MemoryBudget& instance();
+
+    /** @return the estimated memory used by the pixels of an image. */
+    static size_t getByteCount(const Image& image);
+
+    /** Set the limit in bytes (default: 0, no limit). */
+    void setLimit(size_t bytes);
+
+    /** @return the limit in bytes, 0 if there is no limit. */
+    size_t getLimit() const { return _limit; }
+    /** @return the total memory accounted. */
+    size_t getUsage() const;
+
+    /** @return the memory accounted in a category. */
+    size_t getUsage(MemoryCategory category) const;
+
+    /**
+     * Release memory if the usage exceeds the limit.
+     *
+     * The reclaimers are called by category, in the order of MemoryCategory.
+     * @param now the current time
+     * @return true if the usage could not be kept under the limit recently,
+     *         i.e. the contents should be degraded.
+     */
+    bool enforce(clock::time_point now = clock::now());
+
+    /**
+     * Degrade the contents to save memory: lower the LOD of tiled contents,
+     * do not render ahead and keep a single instance of each document.
+     */
+    void setConstrained(bool constrained);
+
+    /** @return true if the contents should be degraded to save memory. */
+    bool isConstrained() const { return _constrained; }
+private:
+    MemoryBudget();
+
+    std::array<MetricGauge*, 5> _usage;
+    MetricGauge& _limitGauge;
+    MetricGauge& _constrainedGauge;
+    std::atomic<size_t> _limit{0};
+    std::atomic_bool _constrained{false};
+
+    bool _overLimit = false;
+    clock::time_point _lastOverLimit;
+
+    std::mutex _mutex;
+    std::list<const Reclaimer*> _reclaimers;
+
+    MetricGauge& _getGauge(MemoryCategory category) const;
+    size_t _reclaim(size_t bytes);
+};
+
+#endif
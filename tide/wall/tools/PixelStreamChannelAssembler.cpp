@@ -93,6 +93,11 @@ ImagePtr PixelStreamChannelAssembler::getTileImage(
     const uint tileIndex, deflect::server::TileDecoder& decoder)
 {
     const auto sourceTiles = _findSourceTiles(tileIndex);
+    for (auto i : sourceTiles)
+    {
+        if (_frame->tiles.at(i).imageData.isEmpty())
+            return ImagePtr();
+    }
 
     _decodeSourceTiles(sourceTiles, decoder);
     _assembleTargetTile(tileIndex, sourceTiles);
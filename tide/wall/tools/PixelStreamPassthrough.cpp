@@ -53,6 +53,9 @@ ImagePtr PixelStreamPassthrough::getTileImage(
     const uint tileIndex, deflect::server::TileDecoder& decoder)
 {
     auto& tile = _frame->tiles.at(tileIndex);
+    if (tile.imageData.isEmpty())
+        return ImagePtr();
+
     if (tile.format == deflect::Format::jpeg)
     {
 #ifndef DEFLECT_USE_LEGACY_LIBJPEGTURBO
@@ -56,7 +56,8 @@ public:
      *
      * @param tileIndex for the target image.
      * @param decoder for jpeg decompression.
-     * @return the assembled image.
+     * @return the assembled image, or nullptr if the frame carries no data for
+     *         the tile (culled by the master application).
      * @throw std::runtime_error on tile decoding error.
      */
     virtual ImagePtr getTileImage(uint tileIndex,
@@ -0,0 +1,135 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "PlaybackSchedule.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Absorb rounding errors so that a timestamp computed as n * frameDuration
+// maps to frame n and not to frame n - 1.
+const double frameEpsilon = 1e-6;
+}
+
+void PlaybackSchedule::setTimeline(const double duration,
+                                   const double frameDuration)
+{
+    _duration = duration;
+    _frameDuration = frameDuration;
+}
+
+void PlaybackSchedule::setLoop(const bool loop)
+{
+    _loop = loop;
+}
+
+void PlaybackSchedule::setRate(const double rate, const clock::time_point now)
+{
+    seek(getTimestamp(now), now);
+    _rate = rate;
+}
+
+double PlaybackSchedule::getRate() const
+{
+    return _rate;
+}
+
+void PlaybackSchedule::play(const clock::time_point now)
+{
+    if (!_paused)
+        return;
+
+    _startTime = now;
+    _paused = false;
+}
+
+void PlaybackSchedule::pause(const clock::time_point now)
+{
+    if (_paused)
+        return;
+
+    _startTimestamp = getTimestamp(now);
+    _paused = true;
+}
+
+bool PlaybackSchedule::isPaused() const
+{
+    return _paused;
+}
+
+void PlaybackSchedule::seek(const double timestamp, const clock::time_point now)
+{
+    _startTimestamp = _wrap(timestamp);
+    _startTime = now;
+}
+
+double PlaybackSchedule::getTimestamp(const clock::time_point now) const
+{
+    if (_paused)
+        return _startTimestamp;
+
+    const auto elapsed = std::chrono::duration<double>(now - _startTime);
+    return _wrap(_startTimestamp + elapsed.count() * _rate);
+}
+
+double PlaybackSchedule::getFrameTimestamp(const clock::time_point now) const
+{
+    const auto timestamp = getTimestamp(now);
+    if (_frameDuration <= 0.0)
+        return timestamp;
+
+    const auto frame = std::floor(timestamp / _frameDuration + frameEpsilon);
+    return frame * _frameDuration;
+}
+
+double PlaybackSchedule::_wrap(const double timestamp) const
+{
+    if (_duration <= 0.0)
+        return std::max(timestamp, 0.0);
+
+    if (_loop)
+    {
+        const auto wrapped = std::fmod(timestamp, _duration);
+        return wrapped < 0.0 ? wrapped + _duration : wrapped;
+    }
+
+    const auto lastFrame = std::max(_duration - _frameDuration, 0.0);
+    return std::min(std::max(timestamp, 0.0), lastFrame);
+}
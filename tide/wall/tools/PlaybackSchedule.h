@@ -0,0 +1,102 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef PLAYBACKSCHEDULE_H
+#define PLAYBACKSCHEDULE_H
+
+#include <chrono>
+
+/**
+ * Map the synchronized wall clock to a movie presentation timestamp.
+ *
+ * The schedule is anchored on a start timestamp, a start time and a rate. As
+ * long as it is only re-anchored at the same clock time on all processes,
+ * each process can compute the frame to display locally.
+ */
+class PlaybackSchedule
+{
+public:
+    using clock = std::chrono::high_resolution_clock;
+
+    /**
+     * Set the timeline of the movie.
+     * @param duration of the movie in seconds.
+     * @param frameDuration of a single frame in seconds.
+     */
+    void setTimeline(double duration, double frameDuration);
+
+    /** Wrap around at the end of the movie instead of stopping. */
+    void setLoop(bool loop);
+
+    /** Set the playback rate (1.0 is normal speed), effective from now. */
+    void setRate(double rate, clock::time_point now);
+
+    /** @return the playback rate. */
+    double getRate() const;
+
+    /** Resume playback from the current timestamp. */
+    void play(clock::time_point now);
+
+    /** Freeze playback at the current timestamp. */
+    void pause(clock::time_point now);
+
+    /** @return true if playback is paused. */
+    bool isPaused() const;
+
+    /** Move to a timestamp, keeping the current play / pause state. */
+    void seek(double timestamp, clock::time_point now);
+
+    /** @return the timestamp in seconds at the given time. */
+    double getTimestamp(clock::time_point now) const;
+
+    /** @return the timestamp of the frame to display at the given time. */
+    double getFrameTimestamp(clock::time_point now) const;
+
+private:
+    double _duration = 0.0;
+    double _frameDuration = 0.0;
+    bool _loop = true;
+    double _rate = 1.0;
+    bool _paused = true;
+    double _startTimestamp = 0.0;
+    clock::time_point _startTime;
+
+    double _wrap(double timestamp) const;
+};
+
+#endif
@@ -0,0 +1,179 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "ScreenDamage.h"
+
+#include "scene/Background.h"
+#include "scene/ContextMenu.h"
+#include "scene/DisplayGroup.h"
+#include "scene/Markers.h"
+#include "scene/Surface.h"
+#include "scene/Window.h"
+
+#include <QHash>
+
+namespace
+{
+// Window title, borders and side controls extend around the window (style.js)
+const qreal windowDecorationsMargin = 250.0;
+// Half the size of a touch point marker, rounded up (style.js)
+const qreal markerMargin = 20.0;
+
+struct WindowState
+{
+    size_t version;
+    size_t zIndex;
+    QRectF coordinates;
+};
+
+bool _isDamaged(const Background& previous, const Background& next)
+{
+    return previous.getColor() != next.getColor() ||
+           previous.getText() != next.getText() ||
+           previous.getUri() != next.getUri();
+}
+
+bool _isDamaged(const ContextMenu& previous, const ContextMenu& next)
+{
+    return previous.isVisible() != next.isVisible() ||
+           (next.isVisible() &&
+            (previous.getPosition() != next.getPosition() ||
+             previous.getCopiedUris() != next.getCopiedUris()));
+}
+
+QUuid _getFullscreenWindowId(const DisplayGroup& group)
+{
+    const auto window = group.getFullscreenWindow();
+    return window ? window->getID() : QUuid();
+}
+}
+
+ScreenDamage::ScreenDamage(const QRect& screenRect)
+    : _screenRect{screenRect}
+{
+}
+
+bool ScreenDamage::isDamaged(const Surface& previous, const Surface& next) const
+{
+    return _isDamaged(previous.getBackground(), next.getBackground()) ||
+           _isDamaged(previous.getContextMenu(), next.getContextMenu()) ||
+           _isDamaged(previous.getGroup(), next.getGroup());
+}
+
+bool ScreenDamage::isDamaged(const Markers& previous,
+                             const Markers& next) const
+{
+    return _hasMarkersOnScreen(previous) || _hasMarkersOnScreen(next);
+}
+
+bool ScreenDamage::isDamaged(const Window& window) const
+{
+    return _isVisible(window.getDisplayCoordinates(), 0.0);
+}
+
+bool ScreenDamage::_isVisible(const QRectF& rect, const qreal margin) const
+{
+    return rect.adjusted(-margin, -margin, margin, margin)
+        .intersects(_screenRect);
+}
+
+bool ScreenDamage::_isDamaged(const DisplayGroup& previous,
+                              const DisplayGroup& next) const
+{
+    // Focus, fullscreen and panels change the appearance of the whole surface
+    if (previous.hasFocusedWindows() != next.hasFocusedWindows() ||
+        previous.hasVisiblePanels() != next.hasVisiblePanels() ||
+        _getFullscreenWindowId(previous) != _getFullscreenWindowId(next))
+    {
+        return true;
+    }
+
+    QHash<QUuid, WindowState> previousWindows;
+    const auto& windows = previous.getWindows();
+    for (size_t z = 0; z < windows.size(); ++z)
+    {
+        const auto& window = *windows[z];
+        previousWindows.insert(window.getID(),
+                               {window.getVersion(), z,
+                                window.getDisplayCoordinates()});
+    }
+
+    const auto& nextWindows = next.getWindows();
+    for (size_t z = 0; z < nextWindows.size(); ++z)
+    {
+        const auto& window = *nextWindows[z];
+        const auto& coordinates = window.getDisplayCoordinates();
+
+        const auto it = previousWindows.find(window.getID());
+        if (it == previousWindows.end())
+        {
+            if (_isVisible(coordinates, windowDecorationsMargin))
+                return true;
+            continue;
+        }
+
+        if ((it->version != window.getVersion() || it->zIndex != z) &&
+            (_isVisible(it->coordinates, windowDecorationsMargin) ||
+             _isVisible(coordinates, windowDecorationsMargin)))
+        {
+            return true;
+        }
+        previousWindows.erase(it);
+    }
+
+    // Removed windows
+    for (const auto& state : previousWindows)
+    {
+        if (_isVisible(state.coordinates, windowDecorationsMargin))
+            return true;
+    }
+    return false;
+}
+
+bool ScreenDamage::_hasMarkersOnScreen(const Markers& markers) const
+{
+    for (auto row = 0; row < markers.rowCount(); ++row)
+    {
+        const auto index = markers.index(row);
+        const auto x = markers.data(index, Markers::XPOSITION_ROLE).toReal();
+        const auto y = markers.data(index, Markers::YPOSITION_ROLE).toReal();
+        if (_isVisible(QRectF(x, y, 0.0, 0.0), markerMargin))
+            return true;
+    }
+    return false;
+}
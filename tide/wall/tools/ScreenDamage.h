@@ -0,0 +1,77 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef SCREENDAMAGE_H
+#define SCREENDAMAGE_H
+
+#include "types.h"
+
+#include <QRectF>
+
+/**
+ * Determine if changes to the scene are visible on a screen.
+ *
+ * Screens which are not affected by an update can skip rendering. The checks
+ * are conservative: any change which is not clearly outside of the screen,
+ * including window decorations, counts as damage.
+ */
+class ScreenDamage
+{
+public:
+    /** @param screenRect the area of the screen in surface coordinates. */
+    explicit ScreenDamage(const QRect& screenRect);
+
+    /** @return true if replacing a surface by the next one affects it. */
+    bool isDamaged(const Surface& previous, const Surface& next) const;
+
+    /** @return true if the touch markers moved in or out of the screen. */
+    bool isDamaged(const Markers& previous, const Markers& next) const;
+
+    /** @return true if a change to the contents of a window affects it. */
+    bool isDamaged(const Window& window) const;
+
+private:
+    QRectF _screenRect;
+
+    bool _isVisible(const QRectF& rect, qreal margin) const;
+    bool _isDamaged(const DisplayGroup& previous,
+                    const DisplayGroup& next) const;
+    bool _hasMarkersOnScreen(const Markers& markers) const;
+};
+
+#endif
@@ -0,0 +1,719 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "SharedTileCache.h"
+
+#include "data/Image.h"
+#include "metrics/MetricsRegistry.h"
+#include "utils/log.h"
+
+#include <QCryptographicHash>
+#include <QSharedMemory>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+std::atomic<bool> enabled{false};
+
+MetricCounter& _hits()
+{
+    static auto& counter = MetricsRegistry::instance().counter(
+        "tide_shared_tile_cache_hits_total",
+        "Tiles mapped from the shared cache of the host");
+    return counter;
+}
+
+MetricCounter& _misses()
+{
+    static auto& counter = MetricsRegistry::instance().counter(
+        "tide_shared_tile_cache_misses_total",
+        "Tiles decoded and published to the shared cache of the host");
+    return counter;
+}
+
+MetricCounter& _fallbacks()
+{
+    static auto& counter = MetricsRegistry::instance().counter(
+        "tide_shared_tile_cache_fallbacks_total",
+        "Tiles decoded locally because the shared cache was unusable");
+    return counter;
+}
+}
+
+#ifdef __linux__
+namespace
+{
+const uint32_t magic = 0x54494c45; // "TILE"
+const uint32_t layoutVersion = 2;
+const uint planesCount = 3;
+const size_t keySize = 48;
+const size_t maxEntries = 4096;
+const size_t maxProcesses = 64;
+const size_t noEntry = maxEntries;
+const uint64_t poolDataSize = uint64_t(1) << 30;
+const uint64_t blockAlignment = 64;
+// Waiting processes wake up regularly to detect owners which have crashed
+const auto waitInterval = std::chrono::seconds{1};
+const auto claimTimeout = std::chrono::seconds{30};
+
+/** Description of a tile, whose texture planes are stored in the pool. */
+struct TileInfo
+{
+    int32_t width;
+    int32_t height;
+    int32_t viewPort[4];
+    int32_t textureSize[planesCount][2];
+    uint64_t dataSize[planesCount];
+    uint32_t format;
+    uint32_t colorSpace;
+    uint32_t glPixelFormat;
+    uint32_t rowOrder;
+};
+
+enum class EntryState : uint32_t
+{
+    free,
+    decoding,
+    ready
+};
+
+/** A tile in the index of the pool. */
+struct Entry
+{
+    char key[keySize];
+    EntryState state;
+    uint32_t owner;  // process slot which decodes the tile
+    uint64_t users;  // bitmask of the process slots which use the tile
+    uint64_t offset; // location of the texture planes in the data of the pool
+    uint64_t size;
+    TileInfo info;
+};
+
+/** Layout of the pool, followed by the data of the tiles. */
+struct PoolHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    pthread_mutex_t mutex;
+    pthread_cond_t changed;
+    pid_t processes[maxProcesses];
+    Entry entries[maxEntries];
+};
+static_assert(maxProcesses <= 64, "the users of an entry are a 64 bits mask");
+static_assert(sizeof(PoolHeader) % 8 == 0, "tile data must be 8 bytes aligned");
+
+TileInfo _describe(const Image& image)
+{
+    auto info = TileInfo();
+    info.width = image.getWidth();
+    info.height = image.getHeight();
+    const auto viewPort = image.getViewPort();
+    info.viewPort[0] = viewPort.x();
+    info.viewPort[1] = viewPort.y();
+    info.viewPort[2] = viewPort.width();
+    info.viewPort[3] = viewPort.height();
+    for (uint i = 0; i < planesCount; ++i)
+    {
+        const auto textureSize = image.getTextureSize(i);
+        info.textureSize[i][0] = textureSize.width();
+        info.textureSize[i][1] = textureSize.height();
+        info.dataSize[i] = image.getDataSize(i);
+    }
+    info.format = static_cast<uint32_t>(image.getFormat());
+    info.colorSpace = static_cast<uint32_t>(image.getColorSpace());
+    info.glPixelFormat = image.getGLPixelFormat();
+    info.rowOrder = static_cast<uint32_t>(image.getRowOrder());
+    return info;
+}
+
+/**
+ * Lock of the pool mutex.
+ *
+ * The mutex is robust: if a process dies while holding it, the next process
+ * locking it marks it consistent again. The index is only ever modified by a
+ * few assignments, so it remains usable.
+ */
+class PoolLock
+{
+public:
+    explicit PoolLock(PoolHeader& header)
+        : _header{header}
+    {
+        lock();
+    }
+    ~PoolLock()
+    {
+        if (_locked)
+            unlock();
+    }
+
+    void lock()
+    {
+        _recover(pthread_mutex_lock(&_header.mutex));
+        _locked = true;
+    }
+
+    void unlock()
+    {
+        pthread_mutex_unlock(&_header.mutex);
+        _locked = false;
+    }
+
+    void wait(const std::chrono::seconds timeout)
+    {
+        timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout.count();
+        _recover(pthread_cond_timedwait(&_header.changed, &_header.mutex,
+                                        &deadline));
+    }
+
+private:
+    PoolHeader& _header;
+    bool _locked = false;
+
+    void _recover(const int result)
+    {
+        if (result == EOWNERDEAD)
+            pthread_mutex_consistent(&_header.mutex);
+    }
+};
+
+/** The shared memory pool of the host, opened once per process. */
+class TilePool : public std::enable_shared_from_this<TilePool>
+{
+public:
+    /** Open the pool, creating it if needed. @throw std::runtime_error */
+    TilePool();
+    ~TilePool();
+
+    /** @return the pool of the process, or nullptr if it is unavailable. */
+    static std::shared_ptr<TilePool> instance();
+
+    ImagePtr getTile(const QByteArray& key,
+                     const SharedTileCache::DecodeFunc& decode);
+
+    /** Release a reference of a SharedTileImage. */
+    void release(size_t index);
+
+private:
+    QSharedMemory _memory;
+    PoolHeader* _header = nullptr;
+    uint8_t* _data = nullptr;
+    uint32_t _slot = 0;
+    // References of this process per entry, protected by the pool mutex
+    std::map<size_t, size_t> _references;
+
+    void _initialize();
+    void _register();
+    bool _isAlive(uint32_t slot) const;
+    bool _hasLiveProcesses() const;
+    void _releaseProcess(uint32_t slot);
+    void _releaseDeadProcesses();
+    size_t _find(const QByteArray& key) const;
+    size_t _claim(const QByteArray& key);
+    bool _allocate(Entry& entry, uint64_t size) const;
+    void _free(size_t index);
+    ImagePtr _decodeAndPublish(size_t index,
+                               const SharedTileCache::DecodeFunc& decode);
+    ImagePtr _createImage(size_t index);
+};
+
+/** Image of a tile stored in the pool. */
+class SharedTileImage : public Image
+{
+public:
+    SharedTileImage(std::shared_ptr<TilePool> pool, const size_t index,
+                    const TileInfo& info, const uint8_t* data)
+        : _pool{std::move(pool)}
+        , _index{index}
+        , _info(info)
+        , _data{data}
+    {
+    }
+
+    ~SharedTileImage() { _pool->release(_index); }
+    int getWidth() const final { return _info.width; }
+    int getHeight() const final { return _info.height; }
+    QRect getViewPort() const final
+    {
+        const auto& vp = _info.viewPort;
+        return QRect(vp[0], vp[1], vp[2], vp[3]);
+    }
+
+    QSize getTextureSize(const uint texture) const final
+    {
+        if (texture >= planesCount)
+            return QSize();
+        const auto& size = _info.textureSize[texture];
+        return QSize(size[0], size[1]);
+    }
+
+    const uint8_t* getData(const uint texture) const final
+    {
+        if (texture >= planesCount || _info.dataSize[texture] == 0)
+            return nullptr;
+        auto data = _data;
+        for (uint i = 0; i < texture; ++i)
+            data += _info.dataSize[i];
+        return data;
+    }
+
+    size_t getDataSize(const uint texture) const final
+    {
+        return texture < planesCount ? _info.dataSize[texture] : 0;
+    }
+
+    deflect::RowOrder getRowOrder() const final
+    {
+        return static_cast<deflect::RowOrder>(_info.rowOrder);
+    }
+
+    TextureFormat getFormat() const final
+    {
+        return static_cast<TextureFormat>(_info.format);
+    }
+
+    ColorSpace getColorSpace() const final
+    {
+        return static_cast<ColorSpace>(_info.colorSpace);
+    }
+
+    uint getGLPixelFormat() const final { return _info.glPixelFormat; }
+private:
+    std::shared_ptr<TilePool> _pool;
+    const size_t _index;
+    const TileInfo _info;
+    const uint8_t* _data;
+};
+
+TilePool::TilePool()
+    : _memory{QString("tide-tiles-%1").arg(qgetenv("USER").constData())}
+{
+    const auto size = int(sizeof(PoolHeader) + poolDataSize);
+    if (!_memory.create(size) &&
+        (_memory.error() != QSharedMemory::AlreadyExists || !_memory.attach()))
+    {
+        throw std::runtime_error(_memory.errorString().toStdString());
+    }
+    if (_memory.size() < size)
+        throw std::runtime_error("the pool has an incompatible size");
+
+    _header = static_cast<PoolHeader*>(_memory.data());
+    _data = static_cast<uint8_t*>(_memory.data()) + sizeof(PoolHeader);
+
+    // The semaphore of the QSharedMemory serializes the setup of the pool and
+    // the registration of the processes.
+    if (!_memory.lock())
+        throw std::runtime_error(_memory.errorString().toStdString());
+    try
+    {
+        _register();
+    }
+    catch (...)
+    {
+        _memory.unlock();
+        throw;
+    }
+    _memory.unlock();
+}
+
+TilePool::~TilePool()
+{
+    _memory.lock();
+    {
+        PoolLock lock{*_header};
+        _releaseProcess(_slot);
+    }
+    _memory.unlock();
+}
+
+std::shared_ptr<TilePool> TilePool::instance()
+{
+    static std::once_flag once;
+    static std::shared_ptr<TilePool> pool;
+    std::call_once(once, [] {
+        try
+        {
+            pool = std::make_shared<TilePool>();
+        }
+        catch (const std::runtime_error& e)
+        {
+            print_log(LOG_WARN, LOG_CONTENT,
+                      "shared tile cache unavailable: %s", e.what());
+        }
+    });
+    return pool;
+}
+
+ImagePtr TilePool::getTile(const QByteArray& key,
+                           const SharedTileCache::DecodeFunc& decode)
+{
+    const auto deadline = std::chrono::steady_clock::now() + claimTimeout;
+
+    PoolLock lock{*_header};
+    while (true)
+    {
+        auto index = _find(key);
+        if (index == noEntry)
+        {
+            // This process decodes the tile while the others wait for it
+            index = _claim(key);
+            lock.unlock();
+            if (index == noEntry)
+            {
+                _fallbacks().increment();
+                return decode();
+            }
+            _misses().increment();
+            return _decodeAndPublish(index, decode);
+        }
+
+        const auto& entry = _header->entries[index];
+        if (entry.state == EntryState::ready)
+        {
+            _hits().increment();
+            return _createImage(index);
+        }
+
+        if (!_isAlive(entry.owner))
+        {
+            _free(index);
+            _releaseDeadProcesses();
+            continue;
+        }
+
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            lock.unlock();
+            _fallbacks().increment();
+            return decode();
+        }
+        lock.wait(waitInterval);
+    }
+}
+
+void TilePool::release(const size_t index)
+{
+    PoolLock lock{*_header};
+    auto it = _references.find(index);
+    if (it == _references.end() || --it->second > 0)
+        return;
+
+    _references.erase(it);
+    auto& entry = _header->entries[index];
+    entry.users &= ~(uint64_t(1) << _slot);
+    if (entry.users == 0)
+        _free(index);
+}
+
+void TilePool::_initialize()
+{
+    std::memset(static_cast<void*>(_header), 0, sizeof(PoolHeader));
+
+    pthread_mutexattr_t mutexAttr;
+    pthread_mutexattr_init(&mutexAttr);
+    pthread_mutexattr_setpshared(&mutexAttr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&mutexAttr, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(&_header->mutex, &mutexAttr);
+    pthread_mutexattr_destroy(&mutexAttr);
+
+    pthread_condattr_t condAttr;
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setpshared(&condAttr, PTHREAD_PROCESS_SHARED);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    pthread_cond_init(&_header->changed, &condAttr);
+    pthread_condattr_destroy(&condAttr);
+
+    _header->version = layoutVersion;
+    _header->magic = magic;
+}
+
+void TilePool::_register()
+{
+    // A pool left over by crashed processes may have its mutex or condition
+    // in any state; it is safe to reset it when no process is using it.
+    if (_header->magic != magic || _header->version != layoutVersion ||
+        !_hasLiveProcesses())
+    {
+        _initialize();
+    }
+
+    PoolLock lock{*_header};
+    _releaseDeadProcesses();
+    for (uint32_t slot = 0; slot < maxProcesses; ++slot)
+    {
+        if (_header->processes[slot] == 0)
+        {
+            _header->processes[slot] = getpid();
+            _slot = slot;
+            return;
+        }
+    }
+    throw std::runtime_error("too many processes use the pool");
+}
+
+bool TilePool::_isAlive(const uint32_t slot) const
+{
+    const auto pid = _header->processes[slot];
+    return pid != 0 && (kill(pid, 0) == 0 || errno == EPERM);
+}
+
+bool TilePool::_hasLiveProcesses() const
+{
+    for (uint32_t slot = 0; slot < maxProcesses; ++slot)
+    {
+        if (_isAlive(slot))
+            return true;
+    }
+    return false;
+}
+
+void TilePool::_releaseProcess(const uint32_t slot)
+{
+    const auto mask = uint64_t(1) << slot;
+    for (size_t i = 0; i < maxEntries; ++i)
+    {
+        auto& entry = _header->entries[i];
+        if (entry.state == EntryState::free)
+            continue;
+
+        entry.users &= ~mask;
+        if ((entry.state == EntryState::decoding && entry.owner == slot) ||
+            (entry.state == EntryState::ready && entry.users == 0))
+        {
+            _free(i);
+        }
+    }
+    _header->processes[slot] = 0;
+}
+
+void TilePool::_releaseDeadProcesses()
+{
+    for (uint32_t slot = 0; slot < maxProcesses; ++slot)
+    {
+        if (_header->processes[slot] != 0 && !_isAlive(slot))
+            _releaseProcess(slot);
+    }
+}
+
+size_t TilePool::_find(const QByteArray& key) const
+{
+    for (size_t i = 0; i < maxEntries; ++i)
+    {
+        const auto& entry = _header->entries[i];
+        if (entry.state != EntryState::free &&
+            std::strncmp(entry.key, key.constData(), keySize) == 0)
+        {
+            return i;
+        }
+    }
+    return noEntry;
+}
+
+size_t TilePool::_claim(const QByteArray& key)
+{
+    for (size_t i = 0; i < maxEntries; ++i)
+    {
+        auto& entry = _header->entries[i];
+        if (entry.state != EntryState::free)
+            continue;
+
+        std::strncpy(entry.key, key.constData(), keySize - 1);
+        entry.state = EntryState::decoding;
+        entry.owner = _slot;
+        return i;
+    }
+    return noEntry;
+}
+
+bool TilePool::_allocate(Entry& entry, uint64_t size) const
+{
+    size = (size + blockAlignment - 1) / blockAlignment * blockAlignment;
+
+    std::vector<std::pair<uint64_t, uint64_t>> blocks;
+    for (const auto& other : _header->entries)
+    {
+        if (other.state != EntryState::free && other.size > 0)
+            blocks.emplace_back(other.offset, other.size);
+    }
+    std::sort(blocks.begin(), blocks.end());
+
+    // First fit
+    auto offset = uint64_t{0};
+    for (const auto& block : blocks)
+    {
+        if (block.first >= offset + size)
+            break;
+        offset = std::max(offset, block.first + block.second);
+    }
+    if (offset + size > poolDataSize)
+        return false;
+
+    entry.offset = offset;
+    entry.size = size;
+    return true;
+}
+
+void TilePool::_free(const size_t index)
+{
+    std::memset(static_cast<void*>(&_header->entries[index]), 0,
+                sizeof(Entry));
+    pthread_cond_broadcast(&_header->changed);
+}
+
+ImagePtr TilePool::_decodeAndPublish(const size_t index,
+                                     const SharedTileCache::DecodeFunc& decode)
+{
+    ImagePtr image;
+    try
+    {
+        image = decode();
+    }
+    catch (...)
+    {
+        PoolLock lock{*_header};
+        _free(index);
+        throw;
+    }
+
+    auto size = uint64_t{0};
+    for (uint i = 0; i < planesCount; ++i)
+        size += image->getDataSize(i);
+
+    PoolLock lock{*_header};
+    auto& entry = _header->entries[index];
+    if (image->isGpuImage() || image->getGLTexture() ||
+        !_allocate(entry, size))
+    {
+        _free(index);
+        lock.unlock();
+        _fallbacks().increment();
+        return image;
+    }
+    lock.unlock();
+
+    // The block is reserved, copy the tile without blocking the other processes
+    entry.info = _describe(*image);
+    auto data = _data + entry.offset;
+    for (uint i = 0; i < planesCount; ++i)
+    {
+        const auto dataSize = image->getDataSize(i);
+        if (dataSize > 0)
+        {
+            std::memcpy(data, image->getData(i), dataSize);
+            data += dataSize;
+        }
+    }
+
+    lock.lock();
+    entry.state = EntryState::ready;
+    pthread_cond_broadcast(&_header->changed);
+    return _createImage(index);
+}
+
+ImagePtr TilePool::_createImage(const size_t index)
+{
+    auto& entry = _header->entries[index];
+    if (_references[index]++ == 0)
+        entry.users |= uint64_t(1) << _slot;
+
+    return std::make_shared<SharedTileImage>(shared_from_this(), index,
+                                             entry.info, _data + entry.offset);
+}
+}
+#endif
+
+void SharedTileCache::setEnabled(const bool enable)
+{
+#ifdef __linux__
+    enabled = enable;
+#else
+    Q_UNUSED(enable);
+#endif
+}
+
+bool SharedTileCache::isEnabled()
+{
+    return enabled;
+}
+
+QString SharedTileCache::makeKey(const QString& uri, const QSize& contentSize,
+                                 const uint tileId, const deflect::View view)
+{
+    const auto id = QString("%1|%2x%3|%4|%5")
+                        .arg(uri)
+                        .arg(contentSize.width())
+                        .arg(contentSize.height())
+                        .arg(tileId)
+                        .arg(static_cast<int>(view));
+    const auto hash =
+        QCryptographicHash::hash(id.toUtf8(), QCryptographicHash::Sha1);
+    return QString::fromLatin1(hash.toHex());
+}
+
+ImagePtr SharedTileCache::getTile(const QString& key, const DecodeFunc& decode)
+{
+#ifdef __linux__
+    const auto keyData = key.toLatin1();
+    auto pool = keyData.size() < int(keySize) ? TilePool::instance() : nullptr;
+    if (pool)
+        return pool->getTile(keyData, decode);
+#else
+    Q_UNUSED(key);
+#endif
+    _fallbacks().increment();
+    return decode();
+}
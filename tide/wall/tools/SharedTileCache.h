@@ -0,0 +1,97 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef SHAREDTILECACHE_H
+#define SHAREDTILECACHE_H
+
+#include "types.h"
+
+#include <functional>
+
+/**
+ * Cache of decoded tiles shared by all the wall processes of a host.
+ *
+ * The tiles are stored in a single shared memory pool per host and user, which
+ * the other processes read instead of decoding the tiles again. An index in
+ * the header of the pool records, for each tile, its location in the pool and
+ * the processes using it; a tile is removed once no process uses it anymore.
+ * While a tile is being decoded, the other processes requesting it wait on a
+ * process-shared condition variable rather than decoding it concurrently. The
+ * references of crashed processes are released by the next processes which
+ * open the pool or wait for one of their tiles.
+ *
+ * Any error (unsupported image, pool full, owner not publishing in time...)
+ * falls back to decoding the tile locally. The pool is only available on
+ * Linux.
+ */
+class SharedTileCache
+{
+public:
+    using DecodeFunc = std::function<ImagePtr()>;
+
+    /** Enable or disable the cache for all data sources (default: off). */
+    static void setEnabled(bool enabled);
+
+    /** @return true if the cache is enabled. */
+    static bool isEnabled();
+
+    /**
+     * Build the key of a tile, a fixed size hash of its parameters.
+     *
+     * @param uri the uri of the content
+     * @param contentSize the full resolution size of the content, which
+     *        determines the layout of the tiles
+     * @param tileId the id of the tile (which also identifies the page and the
+     *        LOD for multi-page and multi-resolution contents)
+     * @param view the view of the tile
+     */
+    static QString makeKey(const QString& uri, const QSize& contentSize,
+                           uint tileId, deflect::View view);
+
+    /**
+     * Get a tile from the cache, or decode and publish it. Threadsafe.
+     *
+     * @param key the key of the tile, see makeKey()
+     * @param decode function called to decode the tile if it is not available
+     * @return the tile image, which keeps the tile in the pool while alive
+     * @throw any exception thrown by the decode function
+     */
+    static ImagePtr getTile(const QString& key, const DecodeFunc& decode);
+};
+
+#endif
@@ -0,0 +1,92 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef TILEUPLOADBUDGET_H
+#define TILEUPLOADBUDGET_H
+
+#include <atomic>
+
+/**
+ * Limit the number of tile textures uploaded in a single frame.
+ *
+ * The budget is reset on the GUI thread before each frame and consumed by the
+ * tiles on the render thread during the scene graph synchronization.
+ */
+class TileUploadBudget
+{
+public:
+    /**
+     * Start a new frame.
+     * @param maxUploads the number of uploads allowed, 0 for unlimited.
+     */
+    void reset(const unsigned int maxUploads)
+    {
+        _remaining = maxUploads;
+        _unlimited = maxUploads == 0;
+        _deferred = false;
+    }
+
+    /**
+     * Consume one upload.
+     * @return false if the budget is exhausted and the upload must wait for the
+     *         next frame.
+     */
+    bool consume()
+    {
+        if (_unlimited)
+            return true;
+
+        auto remaining = _remaining.load();
+        while (remaining > 0)
+        {
+            if (_remaining.compare_exchange_weak(remaining, remaining - 1))
+                return true;
+        }
+        _deferred = true;
+        return false;
+    }
+
+    /** @return true if some uploads were deferred in the current frame. */
+    bool hasDeferredUploads() const { return _deferred; }
+private:
+    std::atomic<unsigned int> _remaining{0};
+    std::atomic<bool> _unlimited{true};
+    std::atomic<bool> _deferred{false};
+};
+
+#endif
@@ -48,7 +48,10 @@ VisibilityHelper::VisibilityHelper(const DisplayGroup& displayGroup,
     : _displayGroup{displayGroup}
     , _visibleArea{visibleArea}
     , _alphaBlending{alphaBlending}
+    , _index{displayGroup.getCoordinates(), displayGroup.getWindows().size()}
 {
+    for (const auto& window : displayGroup.getWindows())
+        _index.insert(*window);
 }
 
 QRectF _cutOverlap(const QRectF& window, const QRectF& other)
@@ -107,21 +110,23 @@ QRectF VisibilityHelper::getVisibleArea(const Window& window) const
     if (window.isFocused())
         return _globalToWindowCoordinates(area, windowCoords);
 
-    auto winIsAbove = false;
-    for (const auto& win : _displayGroup.getWindows())
+    // Only the windows overlapping this one can hide parts of it
+    // (panels are above regular windows)
+    const auto stackOrder = _index.getStackOrder(window);
+    const auto canBeBelow = stackOrder >= 0 && !window.isPanel();
+
+    for (const auto& item : _index.query(area))
     {
-        if (win->getID() == window.getID())
-        {
-            winIsAbove = !window.isPanel(); // panels are above regular windows
-            continue;
-        }
-        if (win->isHidden())
+        const auto& win = *item.window;
+        if (win.getID() == window.getID() || win.isHidden())
             continue;
 
-        if ((winIsAbove || win->isFocused()) &&
-            (!_alphaBlending || !win->getContent().hasTransparency()))
+        const auto winIsAbove = canBeBelow && item.stackOrder > stackOrder;
+
+        if ((winIsAbove || win.isFocused()) &&
+            (!_alphaBlending || !win.getContent().hasTransparency()))
         {
-            area = _cutOverlap(area, win->getDisplayCoordinates());
+            area = _cutOverlap(area, win.getDisplayCoordinates());
         }
 
         if (area.isEmpty())
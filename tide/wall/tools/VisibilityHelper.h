@@ -42,8 +42,16 @@
 
 #include "types.h"
 
+#include "WindowSpatialIndex.h"
+
+#include <QRectF>
+
 /**
  * Helper to determine the visible parts of windows on the wall.
+ *
+ * The windows of the display group are indexed spatially when the helper is
+ * created, so that each query only considers the windows which overlap the
+ * queried one. A new helper must be created after the group has changed.
  */
 class VisibilityHelper
 {
@@ -57,6 +65,7 @@ private:
     const DisplayGroup& _displayGroup;
     const QRect& _visibleArea;
     bool _alphaBlending = false;
+    WindowSpatialIndex _index;
 };
 
 #endif
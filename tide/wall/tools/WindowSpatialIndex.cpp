@@ -0,0 +1,149 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#include "WindowSpatialIndex.h"
+
+#include "scene/Window.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+const int maxGridSize = 32;
+
+/** About one cell per window, the grid is rebuilt on each scene update. */
+int _getGridSize(const size_t windowCount)
+{
+    const auto size = int(std::ceil(std::sqrt(double(windowCount))));
+    return qBound(1, size, maxGridSize);
+}
+}
+
+WindowSpatialIndex::WindowSpatialIndex(const QRectF& area,
+                                       const size_t windowCount)
+    : _area{area}
+    , _gridSize{_getGridSize(windowCount)}
+    , _cellSize{area.width() / _gridSize, area.height() / _gridSize}
+    , _cells(_gridSize * _gridSize)
+{
+    _entries.reserve(windowCount);
+}
+
+void WindowSpatialIndex::insert(const Window& window)
+{
+    if (_entries.contains(window.getID()))
+        return;
+
+    const auto& rect = window.getDisplayCoordinates();
+    _entries.insert(window.getID(), Entry{rect, qint64(_entries.size())});
+
+    const auto cells = _getCellRange(rect);
+    for (auto y = cells.top(); y <= cells.bottom(); ++y)
+        for (auto x = cells.left(); x <= cells.right(); ++x)
+            _cells[y * _gridSize + x].push_back(&window);
+
+    if (!_area.contains(rect))
+        _overflow.push_back(&window);
+}
+
+size_t WindowSpatialIndex::size() const
+{
+    return _entries.size();
+}
+
+qint64 WindowSpatialIndex::getStackOrder(const Window& window) const
+{
+    const auto it = _entries.find(window.getID());
+    return it == _entries.end() ? -1 : it.value().stackOrder;
+}
+
+std::vector<WindowSpatialIndex::Item> WindowSpatialIndex::query(
+    const QRectF& region) const
+{
+    std::vector<Item> items;
+
+    const auto cells = _getCellRange(region);
+    for (auto y = cells.top(); y <= cells.bottom(); ++y)
+        for (auto x = cells.left(); x <= cells.right(); ++x)
+            _collect(_cells[y * _gridSize + x], region, items);
+
+    if (!_area.contains(region))
+        _collect(_overflow, region, items);
+
+    // Windows spanning multiple cells are found more than once
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+        return a.stackOrder < b.stackOrder;
+    });
+    items.erase(std::unique(items.begin(), items.end(),
+                            [](const Item& a, const Item& b) {
+                                return a.window == b.window;
+                            }),
+                items.end());
+    return items;
+}
+
+QRect WindowSpatialIndex::_getCellRange(const QRectF& rect) const
+{
+    const auto clipped = rect.intersected(_area);
+    if (clipped.isEmpty())
+        return QRect();
+
+    const auto column = [this](const qreal x) {
+        return qBound(0, int((x - _area.left()) / _cellSize.width()),
+                      _gridSize - 1);
+    };
+    const auto row = [this](const qreal y) {
+        return qBound(0, int((y - _area.top()) / _cellSize.height()),
+                      _gridSize - 1);
+    };
+    return QRect{QPoint{column(clipped.left()), row(clipped.top())},
+                 QPoint{column(clipped.right()), row(clipped.bottom())}};
+}
+
+void WindowSpatialIndex::_collect(const std::vector<const Window*>& windows,
+                                  const QRectF& region,
+                                  std::vector<Item>& items) const
+{
+    for (const auto window : windows)
+    {
+        const auto entry = _entries.constFind(window->getID());
+        if (entry->rect.intersects(region))
+            items.push_back({window, entry->stackOrder});
+    }
+}
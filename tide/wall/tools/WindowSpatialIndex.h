@@ -0,0 +1,115 @@
+/*********************************************************************/
+/* Copyright (c) 2019, EPFL/Blue Brain Project                       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE  IS  PROVIDED  BY  THE  ECOLE  POLYTECHNIQUE    */
+/*    FEDERALE DE LAUSANNE  ''AS IS''  AND ANY EXPRESS OR IMPLIED    */
+/*    WARRANTIES, INCLUDING, BUT  NOT  LIMITED  TO,  THE  IMPLIED    */
+/*    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR  A PARTICULAR    */
+/*    PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL  THE  ECOLE    */
+/*    POLYTECHNIQUE  FEDERALE  DE  LAUSANNE  OR  CONTRIBUTORS  BE    */
+/*    LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,    */
+/*    EXEMPLARY,  OR  CONSEQUENTIAL  DAMAGES  (INCLUDING, BUT NOT    */
+/*    LIMITED TO,  PROCUREMENT  OF  SUBSTITUTE GOODS OR SERVICES;    */
+/*    LOSS OF USE, DATA, OR  PROFITS;  OR  BUSINESS INTERRUPTION)    */
+/*    HOWEVER CAUSED AND  ON ANY THEORY OF LIABILITY,  WHETHER IN    */
+/*    CONTRACT, STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE    */
+/*    OR OTHERWISE) ARISING  IN ANY WAY  OUT OF  THE USE OF  THIS    */
+/*    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.   */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+#ifndef WINDOWSPATIALINDEX_H
+#define WINDOWSPATIALINDEX_H
+
+#include "types.h"
+
+#include <QHash>
+#include <QRectF>
+#include <QUuid>
+
+#include <vector>
+
+/**
+ * A uniform grid over the display group area to find the windows which
+ * overlap a given region without testing all of them.
+ *
+ * The index is built once for a given state of the windows, which are inserted
+ * from bottom to top to record their stacking order.
+ */
+class WindowSpatialIndex
+{
+public:
+    /** An indexed window which overlaps the query region. */
+    struct Item
+    {
+        const Window* window;
+        qint64 stackOrder;
+    };
+
+    /**
+     * Create an empty index.
+     * @param area the region covered by the grid; windows may extend beyond it.
+     * @param windowCount the expected number of windows, to size the grid.
+     */
+    WindowSpatialIndex(const QRectF& area, size_t windowCount);
+
+    /** Add a window on top of the others, ignored if already indexed. */
+    void insert(const Window& window);
+
+    /** @return the number of indexed windows. */
+    size_t size() const;
+
+    /**
+     * @return the stacking order of a window (higher is above), or -1 if the
+     *         window is not indexed.
+     */
+    qint64 getStackOrder(const Window& window) const;
+
+    /**
+     * Find the windows overlapping a region.
+     *
+     * The cost is proportional to the number of grid cells covered by the
+     * region and the number of windows in them, not to the total count.
+     * @param region the query region, in display group coordinates.
+     * @return the windows which intersect the region, from bottom to top.
+     */
+    std::vector<Item> query(const QRectF& region) const;
+
+private:
+    struct Entry
+    {
+        QRectF rect;
+        qint64 stackOrder = 0;
+    };
+
+    QRectF _area;
+    int _gridSize;
+    QSizeF _cellSize;
+    std::vector<std::vector<const Window*>> _cells;
+    std::vector<const Window*> _overflow;
+    QHash<QUuid, Entry> _entries;
+
+    QRect _getCellRange(const QRectF& rect) const;
+    void _collect(const std::vector<const Window*>& windows,
+                  const QRectF& region, std::vector<Item>& items) const;
+};
+
+#endif